@@ -0,0 +1,405 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <exchange/core/CommandFuture.h>
+#include <exchange/core/ExchangeApi.h>
+#include <exchange/core/ExchangeCore.h>
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/api/ApiBinaryDataCommand.h>
+#include <exchange/core/common/api/ApiCancelOrder.h>
+#include <exchange/core/common/api/ApiCommandValue.h>
+#include <exchange/core/common/api/ApiMoveOrder.h>
+#include <exchange/core/common/api/ApiNop.h>
+#include <exchange/core/common/api/ApiPlaceOrder.h>
+#include <exchange/core/common/api/ApiReduceOrder.h>
+#include <exchange/core/common/api/binary/BatchAddAccountsCommand.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/ingress/WireFrameReader.h>
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+// Producer-side cost per submitted command: heap-allocated polymorphic
+// ApiCommand vs value-type ApiCommandValue vs direct methods.
+// Every iteration submits one batch of mixed place/move/cancel/reduce commands,
+// smaller than the ring buffer, so the producer does not wait for consumers;
+// the pipeline is drained with timing paused.
+// Wire ingress: same commands arriving as binary batch frames, decoded
+// straight into ring slots vs decoded into ApiCommand objects first.
+// Async round trip: submit + wait for result (completion table or completion
+// callbacks) with a number of commands in flight.
+// Onboarding: users with accounts added by one BatchAddAccountsCommand,
+// submitted and waited for (single ring buffer slot carrying the payload).
+
+using namespace exchange::core;
+
+namespace {
+
+constexpr int32_t kBatch = 4 * 1024;  // default ring buffer is 16K
+constexpr int32_t kSymbol = 100;
+
+class Core {
+public:
+  Core()
+    : config_(common::config::ExchangeConfiguration::Default())
+    , core_([](common::cmd::OrderCommand*, int64_t) {}, &config_) {
+    core_.Startup();
+  }
+
+  ~Core() {
+    core_.Shutdown();
+  }
+
+  IExchangeApi* Api() {
+    return core_.GetApi();
+  }
+
+private:
+  common::config::ExchangeConfiguration config_;
+  ExchangeCore core_;
+};
+
+IExchangeApi* Api() {
+  static Core core;
+  return core.Api();
+}
+
+void Drain(IExchangeApi* api) {
+  common::api::ApiNop nop;
+  api->SubmitCommandAsync(&nop).wait();
+}
+
+std::unique_ptr<common::api::ApiCommand> NewApiCommand(int32_t i) {
+  const int64_t uid = i & 1023;
+  switch (i & 3) {
+    case 0:
+      return std::make_unique<common::api::ApiPlaceOrder>(
+        10'000 + i, 1, i, common::OrderAction::BID, common::OrderType::GTC, uid, kSymbol, 0, 0);
+    case 1:
+      return std::make_unique<common::api::ApiMoveOrder>(i, 10'001 + i, uid, kSymbol);
+    case 2:
+      return std::make_unique<common::api::ApiCancelOrder>(i, uid, kSymbol);
+    default:
+      return std::make_unique<common::api::ApiReduceOrder>(i, uid, kSymbol, 1);
+  }
+}
+
+common::api::ApiCommandValue NewCommandValue(int32_t i) {
+  using common::api::ApiCommandValue;
+  const int64_t uid = i & 1023;
+  switch (i & 3) {
+    case 0:
+      return ApiCommandValue::PlaceOrder(uid, kSymbol, i, common::OrderAction::BID,
+                                         common::OrderType::GTC, 10'000 + i, 0, 1);
+    case 1:
+      return ApiCommandValue::MoveOrder(uid, kSymbol, i, 10'001 + i);
+    case 2:
+      return ApiCommandValue::CancelOrder(uid, kSymbol, i);
+    default:
+      return ApiCommandValue::ReduceOrder(uid, kSymbol, i, 1);
+  }
+}
+
+void BM_SubmitApiCommand(benchmark::State& state) {
+  auto* api = Api();
+  for (auto _ : state) {
+    for (int32_t i = 0; i < kBatch; i++) {
+      auto cmd = NewApiCommand(i);
+      api->SubmitCommand(cmd.get());
+    }
+    state.PauseTiming();
+    Drain(api);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+void BM_SubmitCommandValue(benchmark::State& state) {
+  auto* api = Api();
+  for (auto _ : state) {
+    for (int32_t i = 0; i < kBatch; i++) {
+      api->SubmitCommand(NewCommandValue(i));
+    }
+    state.PauseTiming();
+    Drain(api);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+void BM_SubmitDirect(benchmark::State& state) {
+  auto* api = Api();
+  for (auto _ : state) {
+    for (int32_t i = 0; i < kBatch; i++) {
+      const int64_t uid = i & 1023;
+      switch (i & 3) {
+        case 0:
+          api->PlaceOrder(uid, kSymbol, i, common::OrderAction::BID, common::OrderType::GTC,
+                          10'000 + i, 0, 1, 0, 0);
+          break;
+        case 1:
+          api->MoveOrder(uid, kSymbol, i, 10'001 + i, 0);
+          break;
+        case 2:
+          api->CancelOrder(uid, kSymbol, i, 0);
+          break;
+        default:
+          api->ReduceOrder(uid, kSymbol, i, 1, 0);
+          break;
+      }
+    }
+    state.PauseTiming();
+    Drain(api);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+// Arg: commands per SubmitCommandsBatch call
+void BM_SubmitCommandsBatchValue(benchmark::State& state) {
+  auto* api = Api();
+  const auto batchSize = static_cast<int32_t>(state.range(0));
+  std::vector<common::api::ApiCommandValue> cmds(static_cast<size_t>(batchSize));
+  for (auto _ : state) {
+    for (int32_t i = 0; i < kBatch; i += batchSize) {
+      for (int32_t j = 0; j < batchSize; j++) {
+        cmds[static_cast<size_t>(j)] = NewCommandValue(i + j);
+      }
+      api->SubmitCommandsBatch(cmds.data(), cmds.size());
+    }
+    state.PauseTiming();
+    Drain(api);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+// kBatch commands encoded as wire batch frames of batchSize commands
+std::vector<std::vector<uint8_t>> NewWireMessages(int32_t batchSize) {
+  std::vector<std::vector<uint8_t>> messages;
+  for (int32_t i = 0; i < kBatch; i += batchSize) {
+    ingress::WireFrameWriter writer(messages.emplace_back());
+    writer.Batch(static_cast<uint32_t>(batchSize));
+    for (int32_t j = i; j < i + batchSize; j++) {
+      const int64_t uid = j & 1023;
+      switch (j & 3) {
+        case 0:
+          writer.PlaceOrder(uid, kSymbol, j, common::OrderAction::BID, common::OrderType::GTC,
+                            10'000 + j, 0, 1, 0, 0);
+          break;
+        case 1:
+          writer.MoveOrder(uid, kSymbol, j, 10'001 + j, 0);
+          break;
+        case 2:
+          writer.CancelOrder(uid, kSymbol, j, 0);
+          break;
+        default:
+          writer.ReduceOrder(uid, kSymbol, j, 1, 0);
+          break;
+      }
+    }
+  }
+  return messages;
+}
+
+// Gateway-style decoding of one wire frame into an ApiCommand object
+std::unique_ptr<common::api::ApiCommand> NewApiCommand(const common::cmd::OrderCommand& cmd) {
+  using common::cmd::OrderCommandType;
+  std::unique_ptr<common::api::ApiCommand> apiCmd;
+  switch (cmd.command) {
+    case OrderCommandType::PLACE_ORDER:
+      apiCmd = std::make_unique<common::api::ApiPlaceOrder>(
+        cmd.price, cmd.size, cmd.orderId, cmd.action, cmd.orderType, cmd.uid, cmd.symbol,
+        cmd.userCookie, cmd.reserveBidPrice);
+      break;
+    case OrderCommandType::MOVE_ORDER:
+      apiCmd =
+        std::make_unique<common::api::ApiMoveOrder>(cmd.orderId, cmd.price, cmd.uid, cmd.symbol);
+      break;
+    case OrderCommandType::CANCEL_ORDER:
+      apiCmd = std::make_unique<common::api::ApiCancelOrder>(cmd.orderId, cmd.uid, cmd.symbol);
+      break;
+    default:
+      apiCmd =
+        std::make_unique<common::api::ApiReduceOrder>(cmd.orderId, cmd.uid, cmd.symbol, cmd.size);
+      break;
+  }
+  apiCmd->timestamp = cmd.timestamp;
+  return apiCmd;
+}
+
+// Arg: commands per wire batch frame, decoded into ApiCommand objects
+// and submitted with SubmitCommandsBatch
+void BM_WireFramesViaApiCommands(benchmark::State& state) {
+  auto* api = Api();
+  const auto messages = NewWireMessages(static_cast<int32_t>(state.range(0)));
+  std::vector<std::unique_ptr<common::api::ApiCommand>> objects;
+  std::vector<common::api::ApiCommand*> cmds;
+  common::cmd::OrderCommand scratch;
+  for (auto _ : state) {
+    for (const auto& message : messages) {
+      ingress::WireFrameReader reader(message.data(), message.size());
+      const size_t count = reader.Validate(kBatch);
+      objects.clear();
+      cmds.clear();
+      for (size_t i = 0; i < count; i++) {
+        reader.DecodeNext(scratch);
+        cmds.push_back(objects.emplace_back(NewApiCommand(scratch)).get());
+      }
+      api->SubmitCommandsBatch(cmds);
+    }
+    state.PauseTiming();
+    Drain(api);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+// Arg: commands per wire batch frame, decoded straight into ring slots
+void BM_SubmitWireFrames(benchmark::State& state) {
+  auto* api = Api();
+  const auto messages = NewWireMessages(static_cast<int32_t>(state.range(0)));
+  for (auto _ : state) {
+    for (const auto& message : messages) {
+      api->SubmitWireFrames(message.data(), message.size());
+    }
+    state.PauseTiming();
+    Drain(api);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+// Arg: commands in flight (submitted before waiting for the first result)
+void BM_AsyncRoundTrip(benchmark::State& state) {
+  auto* api = Api();
+  const auto inFlight = static_cast<size_t>(state.range(0));
+  std::vector<CommandFuture> futures(inFlight);
+  int32_t i = 0;
+  for (auto _ : state) {
+    for (auto& future : futures) {
+      future = api->SubmitCommandAsyncLight(NewCommandValue(i++));
+    }
+    for (const auto& future : futures) {
+      benchmark::DoNotOptimize(future.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(inFlight));
+}
+
+// Same with std::future (promise registered in promise map per command)
+void BM_AsyncRoundTripPromise(benchmark::State& state) {
+  auto* api = Api();
+  const auto inFlight = static_cast<size_t>(state.range(0));
+  std::vector<std::future<common::cmd::CommandResultCode>> futures(inFlight);
+  int32_t i = 0;
+  for (auto _ : state) {
+    for (auto& future : futures) {
+      future = api->SubmitCommandAsync(NewCommandValue(i++));
+    }
+    for (auto& future : futures) {
+      benchmark::DoNotOptimize(future.get());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(inFlight));
+}
+
+// Arg: commands in flight, completion reported by callbacks (no futures)
+void BM_CallbackRoundTrip(benchmark::State& state) {
+  auto* api = Api();
+  const auto inFlight = static_cast<int64_t>(state.range(0));
+  std::atomic<int64_t> completed{0};
+  int64_t submitted = 0;
+  int32_t i = 0;
+  for (auto _ : state) {
+    for (int64_t n = 0; n < inFlight; n++) {
+      api->SubmitCommand(NewCommandValue(i++), [&completed](const common::cmd::OrderCommand&) {
+        completed.fetch_add(1, std::memory_order_release);
+      });
+    }
+    submitted += inFlight;
+    while (completed.load(std::memory_order_acquire) != submitted) {
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inFlight);
+}
+
+// Arg: commands per batch, one completion callback per batch
+void BM_BatchCallbackRoundTrip(benchmark::State& state) {
+  auto* api = Api();
+  const auto batchSize = static_cast<int32_t>(state.range(0));
+  std::vector<common::api::ApiCommandValue> cmds(static_cast<size_t>(batchSize));
+  std::atomic<bool> done{false};
+  int32_t i = 0;
+  for (auto _ : state) {
+    for (auto& cmd : cmds) {
+      cmd = NewCommandValue(i++);
+    }
+    done.store(false, std::memory_order_relaxed);
+    api->SubmitCommandsBatch(cmds.data(), cmds.size(), [&done](const CompletedBatch& batch) {
+      benchmark::DoNotOptimize(batch.ResultCode(batch.Size() - 1));
+      done.store(true, std::memory_order_release);
+    });
+    while (!done.load(std::memory_order_acquire)) {
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batchSize);
+}
+
+// Arg: users per BatchAddAccountsCommand
+void BM_BatchAddAccounts(benchmark::State& state) {
+  auto* api = Api();
+  const auto usersNum = static_cast<int64_t>(state.range(0));
+  // uids not used by other benchmarks
+  static int64_t nextUid = 1'000'000'000;
+  int32_t transferId = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    ankerl::unordered_dense::map<int64_t, ankerl::unordered_dense::map<int32_t, int64_t>> users;
+    users.reserve(static_cast<size_t>(usersNum));
+    for (int64_t n = 0; n < usersNum; n++) {
+      users[nextUid++] = {{1, 1'000'000}, {2, 1'000}};
+    }
+    common::api::ApiBinaryDataCommand cmd(
+      transferId++, std::make_unique<common::api::binary::BatchAddAccountsCommand>(users));
+    state.ResumeTiming();
+    api->SubmitCommandAsync(&cmd).wait();
+  }
+  state.SetItemsProcessed(state.iterations() * usersNum);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SubmitApiCommand);
+BENCHMARK(BM_SubmitCommandValue);
+BENCHMARK(BM_SubmitDirect);
+BENCHMARK(BM_SubmitCommandsBatchValue)->Arg(16)->Arg(256);
+BENCHMARK(BM_WireFramesViaApiCommands)->Arg(16)->Arg(256);
+BENCHMARK(BM_SubmitWireFrames)->Arg(16)->Arg(256);
+BENCHMARK(BM_AsyncRoundTrip)->Arg(1)->Arg(64)->Arg(1024)->UseRealTime();
+BENCHMARK(BM_AsyncRoundTripPromise)->Arg(1)->Arg(64)->Arg(1024)->UseRealTime();
+BENCHMARK(BM_CallbackRoundTrip)->Arg(1)->Arg(64)->Arg(1024)->UseRealTime();
+BENCHMARK(BM_BatchCallbackRoundTrip)->Arg(64)->Arg(1024)->UseRealTime();
+BENCHMARK(BM_BatchAddAccounts)
+  ->Arg(10'000)
+  ->Arg(1'000'000)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <exchange/core/CoroutineExchangeClient.h>
+#include <exchange/core/ExchangeApi.h>
+#include <exchange/core/ExchangeCore.h>
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/api/ApiCommandValue.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+
+// Coroutine client with many outstanding requests: every iteration starts
+// Arg coroutines, each awaits one command (mixed place/move/cancel/reduce),
+// iteration ends when all of them are resumed and finished.
+// Polling executor resumes on benchmark thread, inline executor on results
+// thread. Unpooled variant allocates frames with default operator new.
+
+using namespace exchange::core;
+
+namespace {
+
+constexpr int32_t kSymbol = 100;
+
+class Core {
+public:
+  Core()
+    : config_(common::config::ExchangeConfiguration::Default())
+    , core_([](common::cmd::OrderCommand*, int64_t) {}, &config_) {
+    core_.Startup();
+  }
+
+  ~Core() {
+    core_.Shutdown();
+  }
+
+  IExchangeApi* Api() {
+    return core_.GetApi();
+  }
+
+private:
+  common::config::ExchangeConfiguration config_;
+  ExchangeCore core_;
+};
+
+IExchangeApi* Api() {
+  static Core core;
+  return core.Api();
+}
+
+// Same as ExchangeTask, frames allocated with default operator new
+struct UnpooledTask {
+  struct promise_type {
+    UnpooledTask get_return_object() noexcept {
+      return {};
+    }
+    std::suspend_never initial_suspend() noexcept {
+      return {};
+    }
+    std::suspend_never final_suspend() noexcept {
+      return {};
+    }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept {
+      std::terminate();
+    }
+  };
+};
+
+common::api::ApiCommandValue NewCommandValue(int64_t i) {
+  using common::api::ApiCommandValue;
+  const int64_t uid = i & 1023;
+  switch (i & 3) {
+    case 0:
+      return ApiCommandValue::PlaceOrder(uid, kSymbol, i, common::OrderAction::BID,
+                                         common::OrderType::GTC, 10'000 + (i & 1023), 0, 1);
+    case 1:
+      return ApiCommandValue::MoveOrder(uid, kSymbol, i, 10'001);
+    case 2:
+      return ApiCommandValue::CancelOrder(uid, kSymbol, i);
+    default:
+      return ApiCommandValue::ReduceOrder(uid, kSymbol, i, 1);
+  }
+}
+
+template <typename Task>
+Task Request(CoroutineExchangeClient& client, int64_t i, std::atomic<int64_t>& finished) {
+  const auto resultCode = co_await client.Submit(NewCommandValue(i));
+  benchmark::DoNotOptimize(resultCode);
+  finished.fetch_add(1, std::memory_order_release);
+}
+
+// Arg: outstanding requests per iteration
+template <typename Task>
+void BM_PollingExecutor(benchmark::State& state) {
+  PollingCoroutineExecutor executor;
+  CoroutineExchangeClient client(Api(), &executor);
+  const int64_t outstanding = state.range(0);
+  std::atomic<int64_t> finished{0};
+  int64_t started = 0;
+  for (auto _ : state) {
+    for (int64_t n = 0; n < outstanding; n++) {
+      Request<Task>(client, started++, finished);
+    }
+    while (finished.load(std::memory_order_acquire) != started) {
+      executor.Poll();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * outstanding);
+}
+
+// Arg: outstanding requests per iteration
+void BM_InlineExecutor(benchmark::State& state) {
+  InlineCoroutineExecutor executor;
+  CoroutineExchangeClient client(Api(), &executor);
+  const int64_t outstanding = state.range(0);
+  std::atomic<int64_t> finished{0};
+  int64_t started = 0;
+  for (auto _ : state) {
+    for (int64_t n = 0; n < outstanding; n++) {
+      Request<ExchangeTask>(client, started++, finished);
+    }
+    while (finished.load(std::memory_order_acquire) != started) {
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * outstanding);
+}
+
+}  // namespace
+
+BENCHMARK(BM_PollingExecutor<ExchangeTask>)->Arg(100'000)->UseRealTime();
+BENCHMARK(BM_PollingExecutor<UnpooledTask>)->Arg(100'000)->UseRealTime();
+BENCHMARK(BM_InlineExecutor)->Arg(100'000)->UseRealTime();
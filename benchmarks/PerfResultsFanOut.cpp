@@ -0,0 +1,105 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <benchmark/benchmark.h>
+#include <exchange/core/ExchangeApi.h>
+#include <exchange/core/ExchangeCore.h>
+#include <exchange/core/common/api/ApiCommandValue.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/utils/FastNanoTime.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Ack latency (submit one command, wait for its result) with deliberately
+// slow market data consumer, Arg: microseconds it spends per command.
+// Serial: consumer runs before command completion on single results
+// processor, every ack waits for it. Fan-out: consumer has its own processor,
+// acks are not affected until it falls behind by whole ring buffer
+// (backpressure) - mdBacklog counter is how far behind it ended.
+
+using namespace exchange::core;
+
+namespace {
+
+class Core {
+public:
+  Core(bool fanOut, int64_t consumerDelayNs)
+    : config_(common::config::ExchangeConfiguration::Default()) {
+    ExchangeCore::ResultsConsumer marketData = [this, consumerDelayNs](common::cmd::OrderCommand*,
+                                                                        int64_t seq) {
+      const int64_t until = utils::FastNanoTime::Now() + consumerDelayNs;
+      while (utils::FastNanoTime::Now() < until) {
+      }
+      consumed_.store(seq + 1, std::memory_order_release);
+    };
+    core_ = fanOut ? std::make_unique<ExchangeCore>(
+                       std::vector<ExchangeCore::ResultsConsumer>{std::move(marketData)}, &config_)
+                   : std::make_unique<ExchangeCore>(std::move(marketData), &config_);
+    core_->Startup();
+  }
+
+  ~Core() {
+    core_->Shutdown();
+  }
+
+  IExchangeApi* Api() {
+    return core_->GetApi();
+  }
+
+  int64_t Consumed() const {
+    return consumed_.load(std::memory_order_acquire);
+  }
+
+private:
+  common::config::ExchangeConfiguration config_;
+  std::unique_ptr<ExchangeCore> core_;
+  std::atomic<int64_t> consumed_{0};
+};
+
+void AckLatency(benchmark::State& state, bool fanOut) {
+  Core core(fanOut, state.range(0) * 1000);
+  IExchangeApi* api = core.Api();
+  int64_t orderId = 0;
+  int64_t lastSeq = -1;
+  for (auto _ : state) {
+    // unknown order - rejected by matching engine, result is still published
+    const auto future =
+      api->SubmitCommandAsyncLight(common::api::ApiCommandValue::CancelOrder(1, 100, orderId++));
+    benchmark::DoNotOptimize(future.get());
+    lastSeq = future.Sequence();
+  }
+  state.counters["mdBacklog"] = static_cast<double>(lastSeq + 1 - core.Consumed());
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Arg: market data consumer delay per command (us)
+void BM_AckLatencySerial(benchmark::State& state) {
+  AckLatency(state, false);
+}
+
+// Arg: market data consumer delay per command (us)
+void BM_AckLatencyFanOut(benchmark::State& state) {
+  AckLatency(state, true);
+}
+
+}  // namespace
+
+BENCHMARK(BM_AckLatencySerial)->Arg(0)->Arg(1)->Arg(10)->UseRealTime();
+BENCHMARK(BM_AckLatencyFanOut)->Arg(0)->Arg(1)->Arg(10)->UseRealTime();
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <exchange/core/common/CoreSymbolSpecification.h>
+#include <exchange/core/common/L2MarketData.h>
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/SymbolType.h>
+#include <exchange/core/common/UserProfile.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/processors/RiskEngine.h>
+#include <exchange/core/processors/SharedPool.h>
+#include <exchange/core/processors/journaling/DummySerializationProcessor.h>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// R1 margin order risk check latency vs number of open futures positions.
+// Single risk engine shard, no matching engine: R1 is called directly.
+
+using namespace exchange::core;
+
+namespace {
+
+constexpr int32_t kQuoteCurrency = 840;
+constexpr int32_t kSymbolBase = 1000;
+constexpr int64_t kUid = 1;
+
+class MarginFixture {
+public:
+  explicit MarginFixture(int32_t positionsNum)
+    : config_(common::config::ExchangeConfiguration::Default())
+    , sharedPool_(processors::SharedPool::CreateTestSharedPool())
+    , engine_(0,
+              1,
+              processors::journaling::DummySerializationProcessor::Instance(),
+              sharedPool_.get(),
+              &config_) {
+    for (int32_t i = 0; i < positionsNum; i++) {
+      specs_.push_back(std::make_unique<common::CoreSymbolSpecification>(
+        kSymbolBase + i, common::SymbolType::FUTURES_CONTRACT, 0, kQuoteCurrency, 1, 1, 0, 0,
+        1000, 1000));
+      engine_.GetSymbolSpecificationProvider()->AddSymbol(specs_.back().get());
+    }
+
+    engine_.GetUserProfileService()->AddUser(kUid);
+    engine_.GetUserProfileService()->GetUserProfile(kUid)->accounts[kQuoteCurrency] =
+      1'000'000'000'000'000L;
+
+    // open one pending position per symbol
+    for (int32_t i = 0; i < positionsNum; i++) {
+      PlaceBid(kSymbolBase + i);
+    }
+  }
+
+  void PlaceBid(int32_t symbol) {
+    auto cmd = common::cmd::OrderCommand::NewOrder(common::OrderType::GTC, ++orderId_, kUid,
+                                                   10'000, 10'000, 1, common::OrderAction::BID);
+    cmd.symbol = symbol;
+    engine_.PreProcessCommand(orderId_, &cmd);
+    if (cmd.resultCode != common::cmd::CommandResultCode::VALID_FOR_MATCHING_ENGINE) {
+      throw std::runtime_error("order rejected");
+    }
+  }
+
+  // publish new top of book for symbol (invalidates cached free margin)
+  void UpdatePrice(int32_t symbol, int64_t price) {
+    common::cmd::OrderCommand cmd;
+    cmd.command = common::cmd::OrderCommandType::PLACE_ORDER;
+    cmd.symbol = symbol;
+    cmd.marketData = std::make_shared<common::L2MarketData>(1, 1);
+    cmd.marketData->askPrices[0] = price + 1;
+    cmd.marketData->bidPrices[0] = price;
+    engine_.PostProcessCommand(orderId_, &cmd);
+  }
+
+private:
+  common::config::ExchangeConfiguration config_;
+  std::unique_ptr<processors::SharedPool> sharedPool_;
+  std::vector<std::unique_ptr<common::CoreSymbolSpecification>> specs_;
+  processors::RiskEngine engine_;
+  int64_t orderId_ = 0;
+};
+
+// Repeated orders, prices not moving: free margin served from cache
+void BM_MarginOrderStablePrices(benchmark::State& state) {
+  MarginFixture fixture(static_cast<int32_t>(state.range(0)));
+  for (auto _ : state) {
+    fixture.PlaceBid(kSymbolBase);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Price of another symbol moves before every order: free margin recalculated
+void BM_MarginOrderMovingPrices(benchmark::State& state) {
+  const auto positionsNum = static_cast<int32_t>(state.range(0));
+  MarginFixture fixture(positionsNum);
+  int64_t price = 10'000;
+  for (auto _ : state) {
+    state.PauseTiming();
+    fixture.UpdatePrice(kSymbolBase + positionsNum - 1, (++price & 1023) + 10'000);
+    state.ResumeTiming();
+    fixture.PlaceBid(kSymbolBase);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_MarginOrderStablePrices)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(BM_MarginOrderMovingPrices)->RangeMultiplier(4)->Range(1, 256);
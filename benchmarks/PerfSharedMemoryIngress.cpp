@@ -0,0 +1,234 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <exchange/core/CommandFuture.h>
+#include <exchange/core/ExchangeApi.h>
+#include <exchange/core/ExchangeCore.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/ingress/SharedMemoryIngress.h>
+#include <exchange/core/ingress/WireFrameReader.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Cross-process round trip of one command: benchmark process is the gateway,
+// forked child process runs ExchangeCore. Command goes through the whole
+// pipeline (cancel of unknown order book), result comes back to the gateway.
+// Shared-memory ingress (command ring -> bridge -> results ring) vs loopback
+// TCP connection served by a thread of the exchange process (same fixed-size
+// records, TCP_NODELAY, result written by completion callback).
+// Both sides busy-poll, so the exchange process needs spare cores.
+
+using namespace exchange::core;
+
+namespace {
+
+void ReadFully(int fd, void* data, size_t size) {
+  auto* p = static_cast<uint8_t*>(data);
+  while (size > 0) {
+    const ssize_t n = ::recv(fd, p, size, 0);
+    if (n <= 0) {
+      throw std::runtime_error("connection closed");
+    }
+    p += n;
+    size -= static_cast<size_t>(n);
+  }
+}
+
+void WriteFully(int fd, const void* data, size_t size) {
+  auto* p = static_cast<const uint8_t*>(data);
+  while (size > 0) {
+    const ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+    if (n <= 0) {
+      throw std::runtime_error("connection closed");
+    }
+    p += n;
+    size -= static_cast<size_t>(n);
+  }
+}
+
+void SetNoDelay(int fd) {
+  const int one = 1;
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+// Loopback TCP gateway inside exchange process: one connection, one command in flight
+void ServeTcp(IExchangeApi* api, int listenFd) {
+  const int fd = ::accept(listenFd, nullptr, nullptr);
+  if (fd < 0) {
+    return;
+  }
+  SetNoDelay(fd);
+  ingress::ShmCommandRecord record;
+  try {
+    for (;;) {
+      ReadFully(fd, &record, sizeof(record));
+      const uint64_t correlationId = record.correlationId;
+      api->SubmitWireFrames(record.frame, record.frameLength,
+                            [fd, correlationId](const CompletedBatch& batch) {
+                              const ingress::ShmResultRecord result{
+                                correlationId, batch.Sequence(0),
+                                static_cast<int32_t>(batch.ResultCode(0)), 0};
+                              WriteFully(fd, &result, sizeof(result));
+                            });
+    }
+  } catch (const std::exception&) {
+    ::close(fd);  // gateway disconnected
+  }
+}
+
+[[noreturn]] void RunExchangeProcess(const std::string& shmName, int listenFd, int controlFd) {
+  auto config = common::config::ExchangeConfiguration::Default();
+  config.performanceCfg.sharedMemoryIngressName = shmName;
+  config.performanceCfg.sharedMemoryIngressClients = 1;
+  ExchangeCore core([](common::cmd::OrderCommand*, int64_t) {}, &config);
+  core.Startup();
+  std::thread tcp(ServeTcp, core.GetApi(), listenFd);
+
+  const char ready = 1;
+  (void)::write(controlFd, &ready, 1);
+  // gateway process closes control pipe on exit
+  char ignored;
+  while (::read(controlFd, &ignored, 1) > 0) {
+  }
+  ::shutdown(listenFd, SHUT_RDWR);
+  core.Shutdown();
+  std::_Exit(0);
+}
+
+class ExchangeProcess {
+public:
+  ExchangeProcess() : shmName_("exchange-bench-" + std::to_string(::getpid())) {
+    listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (::bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(listenFd_, 1) != 0
+        || ::getsockname(listenFd_, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+      throw std::runtime_error("Can not listen on loopback");
+    }
+
+    int control[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, control) != 0) {
+      throw std::runtime_error("Can not create control socket");
+    }
+    // forked before benchmark threads exist
+    child_ = ::fork();
+    if (child_ == 0) {
+      ::close(control[0]);
+      RunExchangeProcess(shmName_, listenFd_, control[1]);
+    }
+    ::close(control[1]);
+    controlFd_ = control[0];
+    char ready = 0;
+    if (::read(controlFd_, &ready, 1) != 1) {
+      throw std::runtime_error("Exchange process failed to start");
+    }
+
+    shmClient_ = std::make_unique<ingress::SharedMemoryIngressClient>(shmName_, 0);
+    tcpFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (::connect(tcpFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+      throw std::runtime_error("Can not connect to exchange process");
+    }
+    SetNoDelay(tcpFd_);
+  }
+
+  ~ExchangeProcess() {
+    ::close(tcpFd_);
+    ::close(controlFd_);
+    ::waitpid(child_, nullptr, 0);
+    ::close(listenFd_);
+  }
+
+  ingress::SharedMemoryIngressClient& ShmClient() {
+    return *shmClient_;
+  }
+
+  int TcpFd() const {
+    return tcpFd_;
+  }
+
+private:
+  std::string shmName_;
+  int listenFd_ = -1;
+  int controlFd_ = -1;
+  int tcpFd_ = -1;
+  pid_t child_ = -1;
+  std::unique_ptr<ingress::SharedMemoryIngressClient> shmClient_;
+};
+
+ExchangeProcess& Exchange() {
+  static ExchangeProcess process;
+  return process;
+}
+
+std::vector<uint8_t> CancelFrame() {
+  std::vector<uint8_t> frame;
+  ingress::WireFrameWriter(frame).CancelOrder(1, 100, 1, 0);
+  return frame;
+}
+
+void BM_SharedMemoryRoundTrip(benchmark::State& state) {
+  auto& client = Exchange().ShmClient();
+  const auto frame = CancelFrame();
+  ingress::ShmResultRecord result;
+  uint64_t correlationId = 0;
+  for (auto _ : state) {
+    while (!client.TrySubmit(correlationId, frame.data(), frame.size())) {
+    }
+    while (client.PollResults(&result, 1) == 0) {
+    }
+    benchmark::DoNotOptimize(result);
+    correlationId++;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_TcpRoundTrip(benchmark::State& state) {
+  const int fd = Exchange().TcpFd();
+  const auto frame = CancelFrame();
+  ingress::ShmCommandRecord record{};
+  record.frameLength = static_cast<uint32_t>(frame.size());
+  std::copy(frame.begin(), frame.end(), record.frame);
+  ingress::ShmResultRecord result;
+  for (auto _ : state) {
+    WriteFully(fd, &record, sizeof(record));
+    ReadFully(fd, &result, sizeof(result));
+    benchmark::DoNotOptimize(result);
+    record.correlationId++;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_SharedMemoryRoundTrip)->UseRealTime();
+BENCHMARK(BM_TcpRoundTrip)->UseRealTime();
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <exchange/core/common/CoreSymbolSpecification.h>
+#include <exchange/core/common/L2MarketData.h>
+#include <exchange/core/common/SymbolType.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/processors/RiskEngine.h>
+#include <exchange/core/processors/SharedPool.h>
+#include <exchange/core/processors/SymbolSpecificationProvider.h>
+#include <exchange/core/processors/journaling/DummySerializationProcessor.h>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Symbol specification lookup (done by R1, ME and R2 for every command):
+// direct-indexed dense ids vs hash map only.
+// Args: symbols number, dense id limit (0 - hash map only)
+// Also R2 market data of symbols without last price yet (last price index
+// is extended, not rebuilt, for every new symbol).
+
+using namespace exchange::core;
+
+namespace {
+
+void BM_SymbolSpecificationLookup(benchmark::State& state) {
+  const auto symbolsNum = static_cast<int32_t>(state.range(0));
+  const auto denseSymbolIdLimit = static_cast<int32_t>(state.range(1));
+
+  processors::SymbolSpecificationProvider provider(denseSymbolIdLimit);
+  std::vector<std::unique_ptr<common::CoreSymbolSpecification>> specs;
+  for (int32_t i = 0; i < symbolsNum; i++) {
+    specs.push_back(std::make_unique<common::CoreSymbolSpecification>(
+      i, common::SymbolType::CURRENCY_EXCHANGE_PAIR, 1, 2, 1, 1, 0, 0, 0, 0));
+    provider.AddSymbol(specs.back().get());
+  }
+
+  // random access pattern, similar to mixed order flow
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int32_t> dist(0, symbolsNum - 1);
+  std::vector<int32_t> symbols(4096);
+  for (auto& symbol : symbols) {
+    symbol = dist(rng);
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(provider.GetSymbolSpecification(symbols[i++ & 4095]));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// R2 processing first market data of every futures symbol, per symbol
+void BM_FirstLastPriceUpdates(benchmark::State& state) {
+  const auto symbolsNum = static_cast<int32_t>(state.range(0));
+  auto config = common::config::ExchangeConfiguration::Default();
+  config.performanceCfg.denseSymbolIdLimit = static_cast<int32_t>(state.range(1));
+  config.ordersProcessingCfg.marginTradingMode =
+    common::config::OrdersProcessingConfiguration::MarginTradingMode::MARGIN_TRADING_ENABLED;
+  const auto sharedPool = processors::SharedPool::CreateTestSharedPool();
+
+  std::vector<std::unique_ptr<common::CoreSymbolSpecification>> specs;
+  for (int32_t i = 0; i < symbolsNum; i++) {
+    specs.push_back(std::make_unique<common::CoreSymbolSpecification>(
+      i, common::SymbolType::FUTURES_CONTRACT, 0, 840, 1, 1, 0, 0, 1000, 1000));
+  }
+  common::cmd::OrderCommand cmd;
+  cmd.command = common::cmd::OrderCommandType::PLACE_ORDER;
+  cmd.marketData = std::make_shared<common::L2MarketData>(1, 1);
+  cmd.marketData->askPrices[0] = 10'001;
+  cmd.marketData->bidPrices[0] = 10'000;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto engine = std::make_unique<processors::RiskEngine>(
+      0, 1, processors::journaling::DummySerializationProcessor::Instance(), sharedPool.get(),
+      &config);
+    for (const auto& spec : specs) {
+      engine->GetSymbolSpecificationProvider()->AddSymbol(spec.get());
+    }
+    state.ResumeTiming();
+    for (int32_t symbol = 0; symbol < symbolsNum; symbol++) {
+      cmd.symbol = symbol;
+      engine->PostProcessCommand(symbol, &cmd);
+    }
+    state.PauseTiming();
+    engine.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * symbolsNum);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SymbolSpecificationLookup)
+  ->ArgsProduct({{100, 10'000, 100'000}, {0, 100'000}});
+BENCHMARK(BM_FirstLastPriceUpdates)
+  ->ArgsProduct({{10'000, 100'000}, {0, 100'000}})
+  ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <exchange/core/common/CoreSymbolSpecification.h>
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/SymbolType.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/processors/RiskEngine.h>
+#include <exchange/core/processors/SharedPool.h>
+#include <exchange/core/processors/UserProfileService.h>
+#include <exchange/core/processors/journaling/DummySerializationProcessor.h>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#ifdef __GLIBC__
+#include <malloc.h>
+#include <unistd.h>
+#endif
+
+// User profiles memory and R1 PLACE_ORDER cost vs number of users.
+// Second argument: 1 - sequential uids (dense uid index), 0 - random 63-bit
+// uids (uid map only), or prefetch distance for the lookahead benchmark.
+// Single risk engine shard, R1 is called directly.
+
+using namespace exchange::core;
+
+namespace {
+
+constexpr int32_t kBaseCurrency = 978;
+constexpr int32_t kQuoteCurrency = 840;
+constexpr int32_t kSymbol = 1000;
+constexpr int64_t kBalance = 1'000'000'000'000'000L;
+constexpr size_t kUidsNum = 1 << 20;
+constexpr int64_t kRingSize = 1024;
+
+int64_t UserId(int64_t i, bool dense) {
+  if (dense) {
+    return i + 1;
+  }
+  // splitmix64 - distinct for distinct i
+  uint64_t z = static_cast<uint64_t>(i) + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return static_cast<int64_t>((z ^ (z >> 31)) >> 1);
+}
+
+void AddUsers(processors::UserProfileService* service, int64_t usersNum, bool dense) {
+  for (int64_t i = 0; i < usersNum; i++) {
+    const int64_t uid = UserId(i, dense);
+    service->AddUser(uid);
+    service->BalanceAdjustment(uid, kQuoteCurrency, kBalance, 1);
+  }
+}
+
+// resident set size (Linux), 0 if not available
+size_t ResidentBytes() {
+  std::ifstream statm("/proc/self/statm");
+  size_t pages = 0;
+  size_t residentPages = 0;
+  if (!(statm >> pages >> residentPages)) {
+    return 0;
+  }
+#ifdef __GLIBC__
+  return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+  return residentPages * 4096;
+#endif
+}
+
+// RSS growth per user: profile arena, uid map and dense index, one account per user
+void BM_UserProfilesMemory(benchmark::State& state) {
+  const int64_t usersNum = state.range(0);
+  const bool dense = state.range(1) != 0;
+  for (auto _ : state) {
+#ifdef __GLIBC__
+    malloc_trim(0);  // memory of previous runs would be reused
+#endif
+    const size_t before = ResidentBytes();
+    processors::UserProfileService service;
+    AddUsers(&service, usersNum, dense);
+    state.counters["bytes_per_user"] = static_cast<double>(ResidentBytes() - before)
+                                       / static_cast<double>(usersNum);
+  }
+}
+
+class ExchangeOrderFixture {
+public:
+  ExchangeOrderFixture(int64_t usersNum, bool dense)
+    : config_(common::config::ExchangeConfiguration::Default())
+    , sharedPool_(processors::SharedPool::CreateTestSharedPool())
+    , spec_(kSymbol,
+            common::SymbolType::CURRENCY_EXCHANGE_PAIR,
+            kBaseCurrency,
+            kQuoteCurrency,
+            1,
+            1,
+            0,
+            0,
+            0,
+            0)
+    , engine_(0,
+              1,
+              processors::journaling::DummySerializationProcessor::Instance(),
+              sharedPool_.get(),
+              &config_) {
+    engine_.GetSymbolSpecificationProvider()->AddSymbol(&spec_);
+    AddUsers(engine_.GetUserProfileService(), usersNum, dense);
+
+    // random users, uid generation is not measured
+    std::mt19937_64 random(1);
+    uids_.reserve(kUidsNum);
+    for (size_t i = 0; i < kUidsNum; i++) {
+      uids_.push_back(UserId(static_cast<int64_t>(random() % usersNum), dense));
+    }
+    // commands ahead of processed one are already published, as in the ring buffer
+    ring_.resize(kRingSize);
+    for (int64_t seq = 0; seq < kRingSize; seq++) {
+      PublishBid(seq);
+    }
+  }
+
+  // R1 loop step, with lookahead as TwoStepMasterProcessor (0 - disabled)
+  void PlaceBid(int32_t prefetchDistance = 0) {
+    if (prefetchDistance > 0) {
+      engine_.PrefetchCommandIndex(&Command(seq_ + 2 * prefetchDistance));
+      engine_.PrefetchCommand(&Command(seq_ + prefetchDistance));
+    }
+    common::cmd::OrderCommand& cmd = Command(seq_);
+    engine_.PreProcessCommand(seq_, &cmd);
+    if (cmd.resultCode != common::cmd::CommandResultCode::VALID_FOR_MATCHING_ENGINE) {
+      throw std::runtime_error("order rejected");
+    }
+    PublishBid(seq_ + kRingSize);
+    seq_++;
+  }
+
+private:
+  common::cmd::OrderCommand& Command(int64_t seq) {
+    return ring_[static_cast<size_t>(seq & (kRingSize - 1))];
+  }
+
+  void PublishBid(int64_t seq) {
+    const int64_t uid = uids_[static_cast<size_t>(seq) & (kUidsNum - 1)];
+    Command(seq) = common::cmd::OrderCommand::NewOrder(common::OrderType::GTC, seq + 1, uid, 10'000,
+                                                       10'000, 1, common::OrderAction::BID);
+    Command(seq).symbol = kSymbol;
+  }
+
+  common::config::ExchangeConfiguration config_;
+  std::unique_ptr<processors::SharedPool> sharedPool_;
+  common::CoreSymbolSpecification spec_;
+  processors::RiskEngine engine_;
+  std::vector<int64_t> uids_;
+  std::vector<common::cmd::OrderCommand> ring_;
+  int64_t seq_ = 0;
+};
+
+// R1 exchange order check for random users: profile lookup and quote currency hold
+void BM_PlaceExchangeOrder(benchmark::State& state) {
+  ExchangeOrderFixture fixture(state.range(0), state.range(1) != 0);
+  for (auto _ : state) {
+    fixture.PlaceBid();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Same for sequential uids, with R1 prefetch lookahead (PerformanceConfiguration::prefetchDistance)
+void BM_PlaceExchangeOrderLookahead(benchmark::State& state) {
+  ExchangeOrderFixture fixture(state.range(0), true);
+  const auto prefetchDistance = static_cast<int32_t>(state.range(1));
+  for (auto _ : state) {
+    fixture.PlaceBid(prefetchDistance);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_UserProfilesMemory)
+  ->ArgsProduct({{1'000'000, 10'000'000}, {1, 0}})
+  ->Iterations(1)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PlaceExchangeOrder)->ArgsProduct({{1'000'000, 10'000'000}, {1, 0}});
+BENCHMARK(BM_PlaceExchangeOrderLookahead)->ArgsProduct({{10'000'000}, {0, 2, 4, 8, 16}});
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Coroutine client example: the whole trading flow of ITCoreExample written
+// as one coroutine. Commands are awaited without blocking, the coroutine is
+// resumed by PollingCoroutineExecutor on the main thread (event loop).
+
+#include <exchange/core/CoroutineExchangeClient.h>
+#include <exchange/core/ExchangeCore.h>
+#include <exchange/core/common/CoreSymbolSpecification.h>
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/SymbolType.h>
+#include <exchange/core/common/api/ApiBinaryDataCommand.h>
+#include <exchange/core/common/api/ApiCommandValue.h>
+#include <exchange/core/common/api/binary/BatchAddSymbolsCommand.h>
+#include <exchange/core/common/api/reports/SingleUserReportQuery.h>
+#include <exchange/core/common/api/reports/SingleUserReportResult.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/utils/Logger.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace exchange::core;
+using namespace exchange::core::common;
+using namespace exchange::core::common::api;
+using namespace exchange::core::common::api::reports;
+
+namespace {
+
+constexpr int32_t kCurrencyXbt = 11;
+constexpr int32_t kCurrencyLtc = 15;
+constexpr int32_t kSymbolXbtLtc = 241;
+
+ExchangeTask Trade(CoroutineExchangeClient& client, std::atomic<bool>& finished) {
+  common::CoreSymbolSpecification symbolSpec;
+  symbolSpec.symbolId = kSymbolXbtLtc;
+  symbolSpec.type = SymbolType::CURRENCY_EXCHANGE_PAIR;
+  symbolSpec.baseCurrency = kCurrencyXbt;
+  symbolSpec.quoteCurrency = kCurrencyLtc;
+  symbolSpec.baseScaleK = 1'000'000L;
+  symbolSpec.quoteScaleK = 10'000L;
+  symbolSpec.takerFee = 1900L;
+  symbolSpec.makerFee = 700L;
+  ApiBinaryDataCommand addSymbols(1, std::make_unique<binary::BatchAddSymbolsCommand>(&symbolSpec));
+  auto resultCode = co_await client.Submit(&addSymbols);
+  LOG_INFO("Add symbol: {}", static_cast<int>(resultCode));
+
+  resultCode = co_await client.Submit(ApiCommandValue::AddUser(301L));
+  LOG_INFO("Add user 301: {}", static_cast<int>(resultCode));
+  resultCode = co_await client.Submit(ApiCommandValue::AddUser(302L));
+  LOG_INFO("Add user 302: {}", static_cast<int>(resultCode));
+
+  resultCode = co_await client.Submit(
+    ApiCommandValue::AdjustUserBalance(301L, kCurrencyLtc, 2'000'000'000L, 1L));
+  LOG_INFO("Deposit 20 LTC: {}", static_cast<int>(resultCode));
+  resultCode =
+    co_await client.Submit(ApiCommandValue::AdjustUserBalance(302L, kCurrencyXbt, 10'000'000L, 2L));
+  LOG_INFO("Deposit 0.1 BTC: {}", static_cast<int>(resultCode));
+
+  // GTC bid of the first user, matched by IOC ask of the second one
+  resultCode = co_await client.PlaceOrder(301L, kSymbolXbtLtc, 5001L, OrderAction::BID,
+                                          OrderType::GTC, 15'400L, 15'600L, 12L);
+  LOG_INFO("Place bid: {}", static_cast<int>(resultCode));
+  resultCode = co_await client.PlaceOrder(302L, kSymbolXbtLtc, 5002L, OrderAction::ASK,
+                                          OrderType::IOC, 15'250L, 0, 10L);
+  LOG_INFO("Place ask: {}", static_cast<int>(resultCode));
+
+  auto orderBook = co_await client.RequestOrderBook(kSymbolXbtLtc, 10);
+  if (orderBook) {
+    LOG_INFO("Order book: asks={}, bids={}", orderBook->askSize, orderBook->bidSize);
+  }
+
+  resultCode = co_await client.MoveOrder(301L, kSymbolXbtLtc, 5001L, 15'300L);
+  LOG_INFO("Move bid: {}", static_cast<int>(resultCode));
+  resultCode = co_await client.CancelOrder(301L, kSymbolXbtLtc, 5001L);
+  LOG_INFO("Cancel bid: {}", static_cast<int>(resultCode));
+
+  auto report = co_await client.ProcessReport<SingleUserReportQuery, SingleUserReportResult>(
+    std::make_unique<SingleUserReportQuery>(301L), 0);
+  if (report && report->accounts) {
+    for (const auto& [currency, balance] : *report->accounts) {
+      LOG_INFO("User 301 currency={} balance={}", currency, balance);
+    }
+  }
+
+  finished.store(true, std::memory_order_release);
+}
+
+}  // namespace
+
+int main() {
+  auto config = config::ExchangeConfiguration::Default();
+  ExchangeCore exchangeCore([](cmd::OrderCommand*, int64_t) {}, &config);
+  exchangeCore.Startup();
+
+  PollingCoroutineExecutor executor;
+  CoroutineExchangeClient client(exchangeCore.GetApi(), &executor);
+
+  // Event loop: resumes coroutines whose commands were processed
+  std::atomic<bool> finished{false};
+  Trade(client, finished);
+  while (!finished.load(std::memory_order_acquire)) {
+    if (executor.Poll() == 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  exchangeCore.Shutdown();
+  return 0;
+}
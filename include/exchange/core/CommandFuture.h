@@ -0,0 +1,192 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include "common/cmd/CommandResultCode.h"
+
+namespace exchange::core {
+
+/**
+ * CompletionTable - result codes of processed commands, indexed by seq & mask
+ *
+ * Has the same size as the ring buffer: slot of sequence seq is reused only
+ * by seq + size, which can not be processed before seq (ring buffer gating).
+ * Results thread completes every command with a single atomic store of
+ * [lap = seq / size (48 bits)] [result code (16 bits)] - no lookup, no
+ * allocation, no lock. Reader compares stored lap with lap of its sequence:
+ * smaller - pending, equal - completed, greater - overwritten (result was not
+ * read before size more commands were processed).
+ *
+ * Slot also marks commands waiting for more than result code: promise
+ * (order book, report, full response - looked up in promise maps) or
+ * completion callback (stored by ExchangeApi in ring-sized table).
+ */
+class CompletionTable {
+public:
+  enum class State : uint8_t { PENDING, COMPLETED, OVERWRITTEN };
+
+  enum class Waiter : uint8_t { NONE, PROMISE, COMMAND_CALLBACK, BATCH_CALLBACK };
+
+  /**
+   * @param size - ring buffer size (power of 2)
+   */
+  explicit CompletionTable(int32_t size);
+
+  /**
+   * Called from results thread for every processed command
+   */
+  void Complete(int64_t seq, common::cmd::CommandResultCode resultCode) {
+    const auto code = static_cast<uint16_t>(static_cast<int16_t>(resultCode));
+    slots_[seq & mask_].result.store(((seq >> shift_) << 16) | code, std::memory_order_release);
+  }
+
+  State Poll(int64_t seq, common::cmd::CommandResultCode& resultCode) const {
+    const int64_t value = slots_[seq & mask_].result.load(std::memory_order_acquire);
+    const int64_t lap = value >> 16;  // -1 if slot was never completed
+    const int64_t expectedLap = seq >> shift_;
+    if (lap < expectedLap) {
+      return State::PENDING;
+    }
+    if (lap > expectedLap) {
+      return State::OVERWRITTEN;
+    }
+    resultCode = static_cast<common::cmd::CommandResultCode>(static_cast<int16_t>(value));
+    return State::COMPLETED;
+  }
+
+  /**
+   * Mark command having a promise or a callback,
+   * called by producer before the sequence is published
+   */
+  void Mark(int64_t seq, Waiter waiter) {
+    slots_[seq & mask_].waiter.store(waiter, std::memory_order_relaxed);
+  }
+
+  /**
+   * Called from results thread: read and clear the mark
+   * (ordering is provided by ring buffer publish and gating)
+   */
+  Waiter TakeMark(int64_t seq) {
+    auto& waiter = slots_[seq & mask_].waiter;
+    const Waiter marked = waiter.load(std::memory_order_relaxed);
+    if (marked != Waiter::NONE) {
+      waiter.store(Waiter::NONE, std::memory_order_relaxed);
+    }
+    return marked;
+  }
+
+private:
+  struct alignas(16) Slot {
+    std::atomic<int64_t> result{-1};
+    std::atomic<Waiter> waiter{Waiter::NONE};
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  int64_t mask_;
+  int32_t shift_;
+};
+
+/**
+ * CommandFuture - lightweight future of command result code
+ *
+ * Copyable handle (table, sequence) without allocation or shared state,
+ * returned by SubmitCommandAsyncLight, provides the subset of std::future
+ * interface: get(), wait(), wait_for(). Waiting spins, then yields,
+ * then sleeps. Persist state command completes with two sequences, results
+ * are merged with MergeToFirstFailed.
+ * Result must be read before ring buffer size more commands are processed
+ * (get() throws otherwise) and while ExchangeApi exists.
+ */
+class CommandFuture {
+public:
+  CommandFuture() = default;
+
+  CommandFuture(const CompletionTable* table, int64_t seq, int64_t secondSeq = -1)
+    : table_(table), seq_(seq), secondSeq_(secondSeq) {}
+
+  bool valid() const {
+    return table_ != nullptr;
+  }
+
+  /**
+   * Sequence of the command (first one for persist state)
+   */
+  int64_t Sequence() const {
+    return seq_;
+  }
+
+  common::cmd::CommandResultCode get() const;
+
+  void wait() const;
+
+  template <typename Rep, typename Period>
+  std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+    const auto deadline =
+      std::chrono::steady_clock::now()
+      + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+    return WaitUntil(deadline) ? std::future_status::ready : std::future_status::timeout;
+  }
+
+private:
+  bool IsReady() const;
+  bool WaitUntil(std::chrono::steady_clock::time_point deadline) const;
+  common::cmd::CommandResultCode ResultOf(int64_t seq) const;
+
+  const CompletionTable* table_ = nullptr;
+  int64_t seq_ = -1;
+  int64_t secondSeq_ = -1;
+};
+
+/**
+ * CompletedBatch - result codes of a batch submitted with completion callback
+ * (consecutive sequences), valid only during the callback
+ */
+class CompletedBatch {
+public:
+  CompletedBatch(const CompletionTable* table, int64_t firstSeq, int32_t size)
+    : table_(table), firstSeq_(firstSeq), size_(size) {}
+
+  int32_t Size() const {
+    return size_;
+  }
+
+  int64_t Sequence(int32_t index) const {
+    return firstSeq_ + index;
+  }
+
+  /**
+   * Result code of command at index (submission order)
+   */
+  common::cmd::CommandResultCode ResultCode(int32_t index) const {
+    // all commands of the batch are processed before its callback is invoked
+    auto resultCode = common::cmd::CommandResultCode::NEW;
+    table_->Poll(firstSeq_ + index, resultCode);
+    return resultCode;
+  }
+
+private:
+  const CompletionTable* table_;
+  int64_t firstSeq_;
+  int32_t size_;
+};
+
+}  // namespace exchange::core
@@ -0,0 +1,350 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <concurrentqueue.h>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <utility>
+#include "ExchangeApi.h"
+#include "common/L2MarketData.h"
+#include "common/OrderAction.h"
+#include "common/OrderType.h"
+#include "common/api/ApiCommand.h"
+#include "common/api/ApiCommandValue.h"
+#include "common/api/reports/ReportQuery.h"
+#include "common/api/reports/ReportResult.h"
+#include "common/cmd/CommandResultCode.h"
+#include "common/cmd/OrderCommand.h"
+#include "utils/CoroutineFramePool.h"
+
+namespace exchange::core {
+
+/**
+ * ICoroutineExecutor - resumes coroutines waiting for command results
+ *
+ * Execute is called from results thread (ProcessResult) for every completed
+ * awaitable, it must not block and should only hand the coroutine over to
+ * the user's event loop or thread pool.
+ */
+class ICoroutineExecutor {
+public:
+  virtual ~ICoroutineExecutor() = default;
+
+  virtual void Execute(std::coroutine_handle<> handle) = 0;
+};
+
+/**
+ * InlineCoroutineExecutor - resumes coroutine directly on results thread
+ *
+ * Lowest latency, but resumed code delays results processing and must not
+ * submit commands if the ring buffer can be full (results thread would wait
+ * for itself).
+ */
+class InlineCoroutineExecutor : public ICoroutineExecutor {
+public:
+  void Execute(std::coroutine_handle<> handle) override {
+    handle.resume();
+  }
+};
+
+/**
+ * PollingCoroutineExecutor - queues coroutines, resumed by Poll() on the
+ * thread owning the executor (e.g. the event loop of the service)
+ */
+class PollingCoroutineExecutor : public ICoroutineExecutor {
+public:
+  void Execute(std::coroutine_handle<> handle) override {
+    queue_.enqueue(handle);
+  }
+
+  /**
+   * Resume all queued coroutines
+   * @return number of resumed coroutines
+   */
+  size_t Poll() {
+    size_t resumed = 0;
+    std::coroutine_handle<> handles[64];
+    size_t count;
+    while ((count = queue_.try_dequeue_bulk(handles, 64)) != 0) {
+      for (size_t i = 0; i < count; i++) {
+        handles[i].resume();
+      }
+      resumed += count;
+    }
+    return resumed;
+  }
+
+private:
+  moodycamel::ConcurrentQueue<std::coroutine_handle<>> queue_;
+};
+
+/**
+ * ExchangeTask - fire-and-forget coroutine with pooled frame
+ *
+ * Starts immediately, frame is destroyed when the coroutine completes.
+ * Frames are allocated from CoroutineFramePool. Exception escaping the
+ * coroutine terminates the process (there is nobody to report it to).
+ */
+class ExchangeTask {
+public:
+  struct promise_type {
+    ExchangeTask get_return_object() noexcept {
+      return {};
+    }
+
+    std::suspend_never initial_suspend() noexcept {
+      return {};
+    }
+
+    std::suspend_never final_suspend() noexcept {
+      return {};
+    }
+
+    void return_void() noexcept {}
+
+    void unhandled_exception() noexcept {
+      std::terminate();
+    }
+
+    static void* operator new(size_t size) {
+      return utils::CoroutineFramePool::Allocate(size);
+    }
+
+    static void operator delete(void* ptr, size_t size) noexcept {
+      utils::CoroutineFramePool::Deallocate(ptr, size);
+    }
+  };
+};
+
+/**
+ * Awaitable of one command result: command is submitted with completion
+ * callback when the coroutine suspends, callback stores the result and
+ * passes the coroutine to the executor. Nothing is allocated per command
+ * and no thread is blocked.
+ * Awaitable lives in the coroutine frame, it is not touched after the
+ * command is published (coroutine can already be resumed at that point).
+ */
+class CommandAwaitable {
+public:
+  CommandAwaitable(IExchangeApi* api,
+                   ICoroutineExecutor* executor,
+                   const common::api::ApiCommandValue& cmd)
+    : api_(api), executor_(executor), value_(cmd) {}
+
+  CommandAwaitable(IExchangeApi* api, ICoroutineExecutor* executor, common::api::ApiCommand* cmd)
+    : api_(api), executor_(executor), command_(cmd) {}
+
+  CommandAwaitable(const CommandAwaitable&) = delete;
+  CommandAwaitable& operator=(const CommandAwaitable&) = delete;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    auto callback = [this](const common::cmd::OrderCommand& cmd) {
+      resultCode_ = cmd.resultCode;
+      executor_->Execute(handle_);
+    };
+    if (command_ != nullptr) {
+      api_->SubmitCommand(command_, std::move(callback));
+    } else {
+      api_->SubmitCommand(value_, std::move(callback));
+    }
+  }
+
+  common::cmd::CommandResultCode await_resume() const noexcept {
+    return resultCode_;
+  }
+
+private:
+  IExchangeApi* api_;
+  ICoroutineExecutor* executor_;
+  common::api::ApiCommandValue value_;
+  common::api::ApiCommand* command_ = nullptr;
+  std::coroutine_handle<> handle_;
+  common::cmd::CommandResultCode resultCode_ = common::cmd::CommandResultCode::NEW;
+};
+
+/**
+ * Awaitable of order book snapshot (nullptr if symbol was not found)
+ */
+class OrderBookAwaitable {
+public:
+  OrderBookAwaitable(IExchangeApi* api,
+                     ICoroutineExecutor* executor,
+                     int32_t symbol,
+                     int32_t depth)
+    : api_(api), executor_(executor), symbol_(symbol), depth_(depth) {}
+
+  OrderBookAwaitable(const OrderBookAwaitable&) = delete;
+  OrderBookAwaitable& operator=(const OrderBookAwaitable&) = delete;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    api_->SubmitCommand(common::api::ApiCommandValue::OrderBookRequest(symbol_, depth_),
+                        [this](const common::cmd::OrderCommand& cmd) {
+                          marketData_ = cmd.marketData;
+                          executor_->Execute(handle_);
+                        });
+  }
+
+  std::shared_ptr<common::L2MarketData> await_resume() noexcept {
+    return std::move(marketData_);
+  }
+
+private:
+  IExchangeApi* api_;
+  ICoroutineExecutor* executor_;
+  int32_t symbol_;
+  int32_t depth_;
+  std::coroutine_handle<> handle_;
+  std::shared_ptr<common::L2MarketData> marketData_;
+};
+
+/**
+ * Merge result sections of processed report query (called from results thread)
+ */
+std::unique_ptr<common::api::reports::ReportResult>
+CreateReportResult(common::api::reports::ReportQueryBase& query,
+                   const common::cmd::OrderCommand& cmd);
+
+/**
+ * Awaitable of report query result, result is merged on results thread
+ * (as for ProcessReport), exception thrown there is rethrown to the coroutine
+ */
+template <typename Q, typename R>
+class ReportAwaitable {
+public:
+  ReportAwaitable(IExchangeApi* api,
+                  ICoroutineExecutor* executor,
+                  std::unique_ptr<Q> query,
+                  int32_t transferId)
+    : api_(api), executor_(executor), query_(std::move(query)), transferId_(transferId) {}
+
+  ReportAwaitable(const ReportAwaitable&) = delete;
+  ReportAwaitable& operator=(const ReportAwaitable&) = delete;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    api_->SubmitReportQuery(*query_, transferId_, [this](const common::cmd::OrderCommand& cmd) {
+      try {
+        auto result = CreateReportResult(*query_, cmd);
+        result_.reset(static_cast<R*>(result.release()));
+      } catch (...) {
+        error_ = std::current_exception();
+      }
+      executor_->Execute(handle_);
+    });
+  }
+
+  std::unique_ptr<R> await_resume() {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return std::move(result_);
+  }
+
+private:
+  IExchangeApi* api_;
+  ICoroutineExecutor* executor_;
+  std::unique_ptr<Q> query_;
+  int32_t transferId_;
+  std::coroutine_handle<> handle_;
+  std::unique_ptr<R> result_;
+  std::exception_ptr error_;
+};
+
+/**
+ * CoroutineExchangeClient - C++20 coroutine front-end of IExchangeApi
+ *
+ * co_await client.PlaceOrder(...) suspends the coroutine until the command
+ * is processed, then resumes it on the executor with the result. Any number
+ * of coroutines can wait at the same time (no thread per request), commands
+ * in flight are limited by ring buffer size as usual.
+ * Awaitables must be awaited right away (command is submitted on suspend).
+ */
+class CoroutineExchangeClient {
+public:
+  CoroutineExchangeClient(IExchangeApi* api, ICoroutineExecutor* executor)
+    : api_(api), executor_(executor) {}
+
+  CommandAwaitable Submit(const common::api::ApiCommandValue& cmd) {
+    return CommandAwaitable(api_, executor_, cmd);
+  }
+
+  /**
+   * Submit polymorphic command (binary data, persist state is not supported),
+   * cmd must stay valid until the coroutine is resumed
+   */
+  CommandAwaitable Submit(common::api::ApiCommand* cmd) {
+    return CommandAwaitable(api_, executor_, cmd);
+  }
+
+  CommandAwaitable PlaceOrder(int64_t uid,
+                              int32_t symbol,
+                              int64_t orderId,
+                              common::OrderAction action,
+                              common::OrderType orderType,
+                              int64_t price,
+                              int64_t reservePrice,
+                              int64_t size,
+                              int32_t userCookie = 0) {
+    return Submit(common::api::ApiCommandValue::PlaceOrder(
+      uid, symbol, orderId, action, orderType, price, reservePrice, size, userCookie));
+  }
+
+  CommandAwaitable MoveOrder(int64_t uid, int32_t symbol, int64_t orderId, int64_t newPrice) {
+    return Submit(common::api::ApiCommandValue::MoveOrder(uid, symbol, orderId, newPrice));
+  }
+
+  CommandAwaitable CancelOrder(int64_t uid, int32_t symbol, int64_t orderId) {
+    return Submit(common::api::ApiCommandValue::CancelOrder(uid, symbol, orderId));
+  }
+
+  CommandAwaitable ReduceOrder(int64_t uid, int32_t symbol, int64_t orderId, int64_t reduceSize) {
+    return Submit(common::api::ApiCommandValue::ReduceOrder(uid, symbol, orderId, reduceSize));
+  }
+
+  OrderBookAwaitable RequestOrderBook(int32_t symbol, int32_t depth) {
+    return OrderBookAwaitable(api_, executor_, symbol, depth);
+  }
+
+  template <typename Q, typename R>
+  ReportAwaitable<Q, R> ProcessReport(std::unique_ptr<Q> query, int32_t transferId) {
+    return ReportAwaitable<Q, R>(api_, executor_, std::move(query), transferId);
+  }
+
+private:
+  IExchangeApi* api_;
+  ICoroutineExecutor* executor_;
+};
+
+}  // namespace exchange::core
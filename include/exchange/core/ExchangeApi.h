@@ -18,11 +18,13 @@
 
 #include <ankerl/unordered_dense.h>
 #include <tbb/concurrent_hash_map.h>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <future>
 #include <memory>
 #include <vector>
+#include "CommandFuture.h"
 #include "common/BalanceAdjustmentType.h"
 #include "common/BytesIn.h"
 #include "common/OrderAction.h"
@@ -30,7 +32,10 @@
 #include "common/VectorBytesIn.h"
 #include "common/VectorBytesOut.h"
 #include "common/api/ApiCommand.h"
+#include "common/api/ApiCommandValue.h"
 #include "common/cmd/OrderCommand.h"
+#include "processors/journaling/JournalCommand.h"
+#include "utils/InlineFunction.h"
 
 // Include RingBuffer to use MultiProducerRingBuffer type alias
 #include <disruptor/RingBuffer.h>
@@ -50,6 +55,7 @@ class ApiPersistState;
 
 namespace reports {
 class ApiReportQuery;
+class ReportQueryBase;
 template <typename T>
 class ReportQuery;
 class ReportResult;
@@ -61,6 +67,19 @@ class ReportResult;
 template <typename WaitStrategyT>
 class ExchangeApi;
 
+/**
+ * Completion callback of a command: invoked from results thread with the
+ * processed command (valid only during the call). Stored inline (no
+ * allocation), must not throw and should be short - it delays results
+ * processing of all following commands.
+ */
+using CompletionCallback = utils::InlineFunction<void(const common::cmd::OrderCommand&), 48>;
+
+/**
+ * Completion callback of a whole batch, invoked once after its last command
+ */
+using BatchCompletionCallback = utils::InlineFunction<void(const CompletedBatch&), 48>;
+
 /**
  * IExchangeApi - non-template interface for ExchangeApi
  */
@@ -79,6 +98,15 @@ public:
   virtual std::future<common::cmd::CommandResultCode>
   SubmitCommandAsync(common::api::ApiCommand* cmd) = 0;
 
+  /**
+   * Submit command async, returns lightweight future (no allocation, no
+   * promise map). Result is kept only in the ring-sized completion table:
+   * it must be read before ring buffer size more commands are processed,
+   * otherwise get() throws std::runtime_error. Future must not outlive the
+   * api. Use SubmitCommandAsync if result may be read late.
+   */
+  virtual CommandFuture SubmitCommandAsyncLight(common::api::ApiCommand* cmd) = 0;
+
   /**
    * Submit command async with full response (returns OrderCommand future)
    * Matches Java submitCommandAsyncFullResponse
@@ -97,6 +125,94 @@ public:
    */
   virtual void SubmitCommandsBatch(const std::vector<common::api::ApiCommand*>& cmds) = 0;
 
+  /**
+   * Submit value-type command (fire and forget)
+   * No allocation and no RTTI: command is translated with a switch on its
+   * type straight into the claimed ring buffer slot
+   */
+  virtual void SubmitCommand(const common::api::ApiCommandValue& cmd) = 0;
+
+  /**
+   * Submit value-type command async (returns future)
+   */
+  virtual std::future<common::cmd::CommandResultCode>
+  SubmitCommandAsync(const common::api::ApiCommandValue& cmd) = 0;
+
+  /**
+   * Submit value-type command async, returns lightweight future
+   * (same limits as SubmitCommandAsyncLight for ApiCommand)
+   */
+  virtual CommandFuture SubmitCommandAsyncLight(const common::api::ApiCommandValue& cmd) = 0;
+
+  /**
+   * Submit value-type commands in batch
+   * (next(n) + publish(lo, hi) per ring buffer chunk)
+   */
+  virtual void SubmitCommandsBatch(const common::api::ApiCommandValue* cmds, size_t count) = 0;
+
+  /**
+   * Submit binary wire frames (see ingress::WireFrameReader): whole buffer is
+   * validated first, then fields are decoded straight into claimed slots
+   * @return number of submitted commands
+   */
+  virtual size_t SubmitWireFrames(const uint8_t* data, size_t length) = 0;
+
+  /**
+   * Submit binary wire frames with one completion callback for the whole buffer
+   * Buffer is claimed at once, so it is limited to ring buffer size / 4 commands
+   */
+  virtual size_t
+  SubmitWireFrames(const uint8_t* data, size_t length, BatchCompletionCallback callback) = 0;
+
+  /**
+   * Submit command with completion callback (no future, no lock, no allocation)
+   * Binary data completes with its last fragment, persist state is not supported
+   */
+  virtual void SubmitCommand(common::api::ApiCommand* cmd, CompletionCallback callback) = 0;
+
+  virtual void SubmitCommand(const common::api::ApiCommandValue& cmd,
+                             CompletionCallback callback) = 0;
+
+  /**
+   * Submit value-type commands with one completion callback for the whole batch
+   * Batch is claimed at once, so count is limited to ring buffer size / 4
+   */
+  virtual void SubmitCommandsBatch(const common::api::ApiCommandValue* cmds,
+                                   size_t count,
+                                   BatchCompletionCallback callback) = 0;
+
+  /**
+   * Submit report query with completion callback, invoked with the last
+   * command of the query (result sections, see OrderBookEventsHelper)
+   */
+  virtual void SubmitReportQuery(const common::api::reports::ReportQueryBase& query,
+                                 int32_t transferId,
+                                 CompletionCallback callback) = 0;
+
+  // Direct submission of trading commands: fields are written straight into
+  // the claimed ring buffer slot (fire and forget)
+  virtual void PlaceOrder(int64_t uid,
+                          int32_t symbol,
+                          int64_t orderId,
+                          common::OrderAction action,
+                          common::OrderType orderType,
+                          int64_t price,
+                          int64_t reservePrice,
+                          int64_t size,
+                          int32_t userCookie,
+                          int64_t timestamp) = 0;
+
+  virtual void
+  MoveOrder(int64_t uid, int32_t symbol, int64_t orderId, int64_t newPrice, int64_t timestamp) = 0;
+
+  virtual void CancelOrder(int64_t uid, int32_t symbol, int64_t orderId, int64_t timestamp) = 0;
+
+  virtual void ReduceOrder(int64_t uid,
+                           int32_t symbol,
+                           int64_t orderId,
+                           int64_t reduceSize,
+                           int64_t timestamp) = 0;
+
   /**
    * Process result from pipeline
    */
@@ -227,6 +343,13 @@ public:
 
   // Match Java: reset(timestampNs)
   virtual void ResetReplay(int64_t timestampNs) = 0;
+
+  /**
+   * Replay journaled commands using batch publishing
+   * (next(n) + publish(lo, hi) per ring buffer chunk)
+   */
+  virtual void ReplayCommandsBatch(const processors::journaling::JournalCommand* cmds,
+                                   size_t count) = 0;
 };
 
 /**
@@ -238,14 +361,26 @@ class ExchangeApi : public IExchangeApi {
 public:
   using ResultsConsumer = std::function<void(common::cmd::OrderCommand*, int64_t)>;
 
+  /**
+   * @param payloadReaders number of results processors reading binary payloads
+   *        (results fan-out: completion plus every results consumer); payload
+   *        is released by the last of them (ReleasePayload)
+   */
   explicit ExchangeApi(
-    disruptor::MultiProducerRingBuffer<common::cmd::OrderCommand, WaitStrategyT>* ringBuffer);
+    disruptor::MultiProducerRingBuffer<common::cmd::OrderCommand, WaitStrategyT>* ringBuffer,
+    int32_t payloadReaders = 1);
 
   /**
    * Process result from pipeline
    */
   void ProcessResult(int64_t seq, common::cmd::OrderCommand* cmd) override;
 
+  /**
+   * Release binary payload of command once all payload readers are done with it
+   * (called by every results processor, ProcessResult included)
+   */
+  void ReleasePayload(int64_t seq, common::cmd::OrderCommand* cmd);
+
   /**
    * Submit command (fire and forget)
    */
@@ -257,6 +392,11 @@ public:
   std::future<common::cmd::CommandResultCode>
   SubmitCommandAsync(common::api::ApiCommand* cmd) override;
 
+  /**
+   * Submit command async (returns lightweight future, see IExchangeApi)
+   */
+  CommandFuture SubmitCommandAsyncLight(common::api::ApiCommand* cmd) override;
+
   /**
    * Submit command async with full response (returns OrderCommand future)
    * Matches Java submitCommandAsyncFullResponse
@@ -275,6 +415,85 @@ public:
    */
   void SubmitCommandsBatch(const std::vector<common::api::ApiCommand*>& cmds) override;
 
+  /**
+   * Submit value-type command (fire and forget), no allocation and no RTTI
+   */
+  void SubmitCommand(const common::api::ApiCommandValue& cmd) override;
+
+  /**
+   * Submit value-type command async (returns future)
+   */
+  std::future<common::cmd::CommandResultCode>
+  SubmitCommandAsync(const common::api::ApiCommandValue& cmd) override;
+
+  /**
+   * Submit value-type command async (returns lightweight future, see IExchangeApi)
+   */
+  CommandFuture SubmitCommandAsyncLight(const common::api::ApiCommandValue& cmd) override;
+
+  /**
+   * Submit value-type commands in batch
+   * (next(n) + publish(lo, hi) per ring buffer chunk)
+   */
+  void SubmitCommandsBatch(const common::api::ApiCommandValue* cmds, size_t count) override;
+
+  /**
+   * Submit binary wire frames (next(n) + publish(lo, hi) per ring buffer chunk)
+   */
+  size_t SubmitWireFrames(const uint8_t* data, size_t length) override;
+
+  size_t SubmitWireFrames(const uint8_t* data,
+                          size_t length,
+                          BatchCompletionCallback callback) override;
+
+  /**
+   * Submit command with completion callback (invoked from ProcessResult)
+   */
+  void SubmitCommand(common::api::ApiCommand* cmd, CompletionCallback callback) override;
+
+  void SubmitCommand(const common::api::ApiCommandValue& cmd,
+                     CompletionCallback callback) override;
+
+  /**
+   * Submit value-type commands with one completion callback for the whole batch
+   */
+  void SubmitCommandsBatch(const common::api::ApiCommandValue* cmds,
+                           size_t count,
+                           BatchCompletionCallback callback) override;
+
+  /**
+   * Submit report query with completion callback
+   */
+  void SubmitReportQuery(const common::api::reports::ReportQueryBase& query,
+                         int32_t transferId,
+                         CompletionCallback callback) override;
+
+  // Direct submission of trading commands (written straight into the claimed slot)
+  void PlaceOrder(int64_t uid,
+                  int32_t symbol,
+                  int64_t orderId,
+                  common::OrderAction action,
+                  common::OrderType orderType,
+                  int64_t price,
+                  int64_t reservePrice,
+                  int64_t size,
+                  int32_t userCookie,
+                  int64_t timestamp) override;
+
+  void MoveOrder(int64_t uid,
+                 int32_t symbol,
+                 int64_t orderId,
+                 int64_t newPrice,
+                 int64_t timestamp) override;
+
+  void CancelOrder(int64_t uid, int32_t symbol, int64_t orderId, int64_t timestamp) override;
+
+  void ReduceOrder(int64_t uid,
+                   int32_t symbol,
+                   int64_t orderId,
+                   int64_t reduceSize,
+                   int64_t timestamp) override;
+
   /**
    * Process report query (matches Java processReport)
    * @tparam Q ReportQuery type
@@ -397,18 +616,41 @@ public:
 
   void ResetReplay(int64_t timestampNs) override;
 
+  void ReplayCommandsBatch(const processors::journaling::JournalCommand* cmds,
+                           size_t count) override;
+
 private:
   disruptor::MultiProducerRingBuffer<common::cmd::OrderCommand, WaitStrategyT>* ringBuffer_;
 
-  // promises cache (seq -> promise)
+  // Result codes of all commands (seq & mask), read by CommandFuture;
+  // also marks sequences having a promise in one of the maps below or a callback
+  CompletionTable completions_;
+
+  // Result code promises cache (seq -> promise), used by SubmitCommandAsync
   // Thread-safe: SubmitCommandAsync (main thread) and ProcessResult
   // (ResultsHandler thread) may access concurrently
-  // Using Intel TBB concurrent_hash_map (lock-free, better than Java
-  // ConcurrentHashMap) - header-only, no library linking needed
   using PromiseMap =
     tbb::concurrent_hash_map<int64_t, std::promise<common::cmd::CommandResultCode>>;
   PromiseMap promises_;
 
+  // Completion callbacks (seq & mask), written by producer before publish,
+  // invoked and reset by results thread; slot is reused only after that
+  // (ring buffer gating). Batch callback is stored at last sequence of batch.
+  struct PendingBatch {
+    BatchCompletionCallback callback;
+    int32_t size = 0;
+  };
+  int64_t callbacksMask_;
+  std::unique_ptr<CompletionCallback[]> callbacks_;
+  std::unique_ptr<PendingBatch[]> batchCallbacks_;
+
+  // Binary command/query payloads (seq & mask), written by producer before
+  // publish, released by last results processor reading it; command points
+  // to its slot. Readers countdown is armed by producer only for fan-out.
+  std::unique_ptr<std::vector<uint8_t>[]> payloads_;
+  int32_t payloadReaders_;
+  std::unique_ptr<std::atomic<int32_t>[]> pendingPayloadReaders_;
+
   // Report result promises cache (seq -> promise for report result)
   // Used for ProcessReport to extract results from OrderCommand
   using ReportResultPromise = std::function<void(common::cmd::OrderCommand*)>;
@@ -429,6 +671,11 @@ private:
 
   void PublishCommand(common::api::ApiCommand* cmd, int64_t seq);
 
+  // Register result code promise of seq (before it is published)
+  std::future<common::cmd::CommandResultCode> RegisterPromise(int64_t seq);
+
+  void AttachCallback(int64_t seq, CompletionCallback&& callback);
+
   // Batch publishing methods (using next(n) + publish(lo, hi))
   void PublishBinaryData(common::api::ApiBinaryDataCommand* apiCmd,
                          std::function<void(int64_t)> endSeqConsumer);
@@ -436,8 +683,18 @@ private:
                          std::function<void(int64_t, int64_t)> seqConsumer);
   void PublishQuery(common::api::reports::ApiReportQuery* apiCmd,
                     std::function<void(int64_t)> endSeqConsumer);
-
-  static constexpr int LONGS_PER_MESSAGE = 5;
+  void PublishQuery(const common::api::reports::ReportQueryBase& query,
+                    int32_t transferId,
+                    int64_t timestamp,
+                    std::function<void(int64_t)> endSeqConsumer);
+  // Single command carrying serialized binary command or query
+  void PublishPayload(common::cmd::OrderCommandType command,
+                      int32_t transferId,
+                      int64_t timestamp,
+                      std::vector<uint8_t>&& bytes,
+                      const std::function<void(int64_t)>& seqConsumer);
+  // Payload slot of sequence, readers countdown armed (producer, before publish)
+  std::vector<uint8_t>& PayloadSlot(int64_t seq);
 };
 
 /**
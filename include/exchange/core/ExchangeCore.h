@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <vector>
 #include "ExchangeApi.h"
 #include "common/cmd/OrderCommand.h"
 #include "common/config/ExchangeConfiguration.h"
@@ -39,9 +40,24 @@ class ExchangeCore {
 public:
   using ResultsConsumer = std::function<void(common::cmd::OrderCommand*, int64_t)>;
 
+  /**
+   * Results consumer is called before command completion (ExchangeApi
+   * futures and callbacks), both on the same results processor
+   */
   ExchangeCore(ResultsConsumer resultsConsumer,
                const common::config::ExchangeConfiguration* exchangeConfiguration);
 
+  /**
+   * Results fan-out: command completion and every results consumer (e.g.
+   * trades drop-copy, market data, audit) run on their own processors after
+   * matching engines (and journal), independently of each other - slow
+   * consumer does not delay acks until ring buffer is full.
+   * Binary payload (cmd->payload) stays valid until all of them have processed
+   * the command (released by the last one).
+   */
+  ExchangeCore(std::vector<ResultsConsumer> resultsConsumers,
+               const common::config::ExchangeConfiguration* exchangeConfiguration);
+
   ~ExchangeCore();
 
   /**
@@ -64,6 +80,10 @@ public:
   struct IImpl;
 
 private:
+  ExchangeCore(std::vector<ResultsConsumer> resultsConsumers,
+               bool fanOutResults,
+               const common::config::ExchangeConfiguration* exchangeConfiguration);
+
   std::unique_ptr<IImpl> impl_;
 
   const common::config::ExchangeConfiguration* exchangeConfiguration_;
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include "IEventsHandler.h"
+#include "common/L2MarketData.h"
+#include "common/MatcherEventType.h"
+#include "common/MatcherTradeEvent.h"
+#include "common/cmd/OrderCommand.h"
+
+namespace exchange::core {
+
+/**
+ * TradesView - trades of taker order, TRADE events of matcher events chain
+ * Iterated in place, valid during handler call only.
+ */
+class TradesView {
+public:
+  class Iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Trade;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Trade;
+
+    Iterator() = default;
+
+    explicit Iterator(const common::MatcherTradeEvent* event) : event_(SkipToTrade(event)) {}
+
+    Trade operator*() const {
+      return Trade{event_->matchedOrderId, event_->matchedOrderUid, event_->matchedOrderCompleted,
+                   event_->price, event_->size};
+    }
+
+    Iterator& operator++() {
+      event_ = SkipToTrade(event_->nextEvent);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator it = *this;
+      ++*this;
+      return it;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return event_ == other.event_;
+    }
+
+  private:
+    static const common::MatcherTradeEvent* SkipToTrade(const common::MatcherTradeEvent* event) {
+      while (event != nullptr && event->eventType != common::MatcherEventType::TRADE) {
+        event = event->nextEvent;
+      }
+      return event;
+    }
+
+    const common::MatcherTradeEvent* event_ = nullptr;
+  };
+
+  explicit TradesView(const common::MatcherTradeEvent* firstEvent) : firstEvent_(firstEvent) {}
+
+  Iterator begin() const {
+    return Iterator(firstEvent_);
+  }
+
+  Iterator end() const {
+    return Iterator();
+  }
+
+  bool empty() const {
+    return begin() == end();
+  }
+
+private:
+  const common::MatcherTradeEvent* firstEvent_;
+};
+
+/**
+ * Command result: processed command itself (type, fields and result code)
+ */
+struct CommandResultView {
+  const common::cmd::OrderCommand& command;
+  int64_t seq;
+};
+
+/**
+ * Trade event: taker order is the command (symbol, orderId, uid, action, timestamp)
+ */
+struct TradeEventView {
+  const common::cmd::OrderCommand& command;
+  int64_t totalVolume;
+  bool takerOrderCompleted;
+  TradesView trades;
+};
+
+/**
+ * Order book snapshot attached to command, levels are read in place
+ */
+struct OrderBookView {
+  int32_t symbol;
+  int64_t timestamp;
+  const common::L2MarketData& marketData;
+
+  std::span<const int64_t> AskPrices() const {
+    return {marketData.askPrices.data(), static_cast<size_t>(marketData.askSize)};
+  }
+  std::span<const int64_t> AskVolumes() const {
+    return {marketData.askVolumes.data(), static_cast<size_t>(marketData.askSize)};
+  }
+  std::span<const int64_t> AskOrders() const {
+    return {marketData.askOrders.data(), static_cast<size_t>(marketData.askSize)};
+  }
+  std::span<const int64_t> BidPrices() const {
+    return {marketData.bidPrices.data(), static_cast<size_t>(marketData.bidSize)};
+  }
+  std::span<const int64_t> BidVolumes() const {
+    return {marketData.bidVolumes.data(), static_cast<size_t>(marketData.bidSize)};
+  }
+  std::span<const int64_t> BidOrders() const {
+    return {marketData.bidOrders.data(), static_cast<size_t>(marketData.bidSize)};
+  }
+};
+
+/**
+ * IEventsViewHandler - allocation-free variant of IEventsHandler
+ *
+ * Same events in the same order, but passed as views of the processed
+ * command, its matcher events chain and market data - nothing is copied or
+ * allocated per command. Views are valid during handler call only.
+ */
+class IEventsViewHandler {
+public:
+  virtual ~IEventsViewHandler() = default;
+
+  virtual void CommandResult(const CommandResultView& commandResult) = 0;
+
+  virtual void TradeEvent(const TradeEventView& tradeEvent) = 0;
+
+  virtual void RejectEvent(const RejectEvent& rejectEvent) = 0;
+
+  virtual void ReduceEvent(const ReduceEvent& reduceEvent) = 0;
+
+  virtual void OrderBook(const OrderBookView& orderBook) = 0;
+};
+
+}  // namespace exchange::core
@@ -18,33 +18,56 @@
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include "IEventsHandler.h"
+#include "IEventsViewHandler.h"
 #include "common/cmd/OrderCommand.h"
 
 namespace exchange::core {
 
 /**
- * SimpleEventsProcessor - processes events and calls IEventsHandler
+ * EventsHandlerAdapter - passes events views to IEventsHandler as copies
+ * (ApiCommand of the result, vectors of trades and order book levels)
+ */
+class EventsHandlerAdapter : public IEventsViewHandler {
+public:
+  explicit EventsHandlerAdapter(IEventsHandler* eventsHandler) : eventsHandler_(eventsHandler) {}
+
+  void CommandResult(const CommandResultView& commandResult) override;
+  void TradeEvent(const TradeEventView& tradeEvent) override;
+  void RejectEvent(const exchange::core::RejectEvent& rejectEvent) override;
+  void ReduceEvent(const exchange::core::ReduceEvent& reduceEvent) override;
+  void OrderBook(const OrderBookView& orderBook) override;
+
+private:
+  IEventsHandler* eventsHandler_;
+};
+
+/**
+ * SimpleEventsProcessor - processes events and calls IEventsViewHandler
+ * (or IEventsHandler through EventsHandlerAdapter)
  */
 class SimpleEventsProcessor {
 public:
   using ResultsConsumer = std::function<void(common::cmd::OrderCommand*, int64_t)>;
 
-  explicit SimpleEventsProcessor(IEventsHandler* eventsHandler) : eventsHandler_(eventsHandler) {}
+  explicit SimpleEventsProcessor(IEventsViewHandler* eventsHandler)
+    : eventsHandler_(eventsHandler) {}
+
+  explicit SimpleEventsProcessor(IEventsHandler* eventsHandler)
+    : adapter_(std::make_unique<EventsHandlerAdapter>(eventsHandler))
+    , eventsHandler_(adapter_.get()) {}
 
   void Accept(common::cmd::OrderCommand* cmd, int64_t seq);
 
 private:
-  IEventsHandler* eventsHandler_;
+  std::unique_ptr<EventsHandlerAdapter> adapter_;
+  IEventsViewHandler* eventsHandler_;
 
   void SendCommandResult(common::cmd::OrderCommand* cmd, int64_t seq);
   void SendTradeEvents(common::cmd::OrderCommand* cmd);
   void SendMarketData(common::cmd::OrderCommand* cmd);
   void SendTradeEvent(common::cmd::OrderCommand* cmd);
-  void SendApiCommandResult(common::api::ApiCommand* cmd,
-                            common::cmd::CommandResultCode resultCode,
-                            int64_t timestamp,
-                            int64_t seq);
 };
 
 }  // namespace exchange::core
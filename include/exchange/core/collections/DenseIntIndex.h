@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace exchange::core::collections {
+
+/**
+ * DenseIntIndex - direct-indexed int32 key -> T* lookup table
+ *
+ * Secondary index for hash maps keyed by small dense ids (symbol ids).
+ * Keys in [0, maxDenseKey) are resolved with one array access, other keys
+ * are not stored and must be resolved by the owning hash map (InRange()
+ * tells which path to use). The table grows on demand up to the largest
+ * key put. The owning map remains the source of truth for iteration order,
+ * serialization and state hash.
+ *
+ * maxDenseKey == 0 disables the index (every key falls back to the map).
+ */
+template <typename T>
+class DenseIntIndex {
+public:
+  explicit DenseIntIndex(int32_t maxDenseKey = 0) : maxDenseKey_(maxDenseKey) {}
+
+  bool InRange(int32_t key) const {
+    return static_cast<uint32_t>(key) < static_cast<uint32_t>(maxDenseKey_);
+  }
+
+  /**
+   * @return value for key in dense range, nullptr if absent
+   */
+  T* Get(int32_t key) const {
+    const auto idx = static_cast<size_t>(key);
+    return idx < table_.size() ? table_[idx] : nullptr;
+  }
+
+  /**
+   * Store value if key is in dense range, ignored otherwise
+   */
+  void Put(int32_t key, T* value) {
+    if (!InRange(key)) {
+      return;
+    }
+    const auto idx = static_cast<size_t>(key);
+    if (idx >= table_.size()) {
+      table_.resize(idx + 1, nullptr);
+    }
+    table_[idx] = value;
+  }
+
+  void Clear() {
+    table_.clear();
+  }
+
+  int32_t GetMaxDenseKey() const {
+    return maxDenseKey_;
+  }
+
+private:
+  int32_t maxDenseKey_;
+  std::vector<T*> table_;
+};
+
+}  // namespace exchange::core::collections
@@ -103,6 +103,19 @@ public:
 
   void InitFromNode4(ArtNode4<V>* node4, uint8_t subKey, void* newElement);
   void InitFromNode48(ArtNode48<V>* node48);
+  /**
+   * Initialize node with children sorted by sub-key (bulk build)
+   */
+  void InitFromSorted(
+    const uint8_t* subKeys, void* const* children, int count, int64_t nodeKey, int level) {
+    keys_.fill(0);
+    nodes_.fill(nullptr);
+    std::copy_n(subKeys, count, keys_.begin());
+    std::copy_n(children, count, nodes_.begin());
+    numChildren_ = static_cast<uint8_t>(count);
+    nodeKey_ = nodeKey;
+    nodeLevel_ = level;
+  }
 
   template <typename U>
   friend class ArtNode4;
@@ -95,6 +95,19 @@ public:
   }
 
   void InitFromNode48(ArtNode48<V>* node48, uint8_t subKey, void* newElement);
+  /**
+   * Initialize node with children sorted by sub-key (bulk build)
+   */
+  void InitFromSorted(
+    const uint8_t* subKeys, void* const* children, int count, int64_t nodeKey, int level) {
+    nodes_.fill(nullptr);
+    for (int i = 0; i < count; i++) {
+      nodes_[subKeys[i]] = children[i];
+    }
+    numChildren_ = static_cast<uint16_t>(count);
+    nodeKey_ = nodeKey;
+    nodeLevel_ = level;
+  }
 
   template <typename U>
   friend class ArtNode48;
@@ -127,6 +127,20 @@ public:
     nodeLevel_ = level;
   }
 
+  /**
+   * Initialize node with children sorted by sub-key (bulk build)
+   */
+  void InitFromSorted(
+    const uint8_t* subKeys, void* const* children, int count, int64_t nodeKey, int level) {
+    keys_.fill(0);
+    nodes_.fill(nullptr);
+    std::copy_n(subKeys, count, keys_.begin());
+    std::copy_n(children, count, nodes_.begin());
+    numChildren_ = static_cast<uint8_t>(count);
+    nodeKey_ = nodeKey;
+    nodeLevel_ = level;
+  }
+
   void InitFromNode16(ArtNode16<V>* node16) {
     keys_.fill(0);
     nodes_.fill(nullptr);
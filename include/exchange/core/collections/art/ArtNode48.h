@@ -101,6 +101,22 @@ public:
 
   void InitFromNode16(ArtNode16<V>* node16, uint8_t subKey, void* newElement);
   void InitFromNode256(ArtNode256<V>* node256);
+  /**
+   * Initialize node with children sorted by sub-key (bulk build)
+   */
+  void InitFromSorted(
+    const uint8_t* subKeys, void* const* children, int count, int64_t nodeKey, int level) {
+    indexes_.fill(-1);
+    nodes_.fill(nullptr);
+    for (int i = 0; i < count; i++) {
+      indexes_[subKeys[i]] = static_cast<int8_t>(i);
+      nodes_[i] = children[i];
+    }
+    numChildren_ = static_cast<uint8_t>(count);
+    nodeKey_ = nodeKey;
+    nodeLevel_ = level;
+    freeBitMask_ = (1LL << numChildren_) - 1;
+  }
 
   template <typename U>
   friend class ArtNode16;
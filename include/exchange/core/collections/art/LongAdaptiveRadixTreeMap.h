@@ -84,6 +84,12 @@ public:
   V* Get(int64_t key) const;
   void Put(int64_t key, V* value);
   V* GetOrInsert(int64_t key, std::function<V*()> supplier);
+
+  /**
+   * Build tree from keys sorted in ascending order (non-negative, unique),
+   * bottom-up in linear time. Map must be empty.
+   */
+  void PutAllSorted(const int64_t* keys, V* const* values, size_t count);
   void Remove(int64_t key);
   void Clear();
   void RemoveRange(int64_t keyFromInclusive, int64_t keyToExclusive);
@@ -123,6 +129,8 @@ public:
                                   std::function<void*(int)> getNode);
 
 private:
+  IArtNode<V>* BuildSorted(const int64_t* keys, V* const* values, size_t count);
+
   IArtNode<V>* root_;
   ::exchange::core::collections::objpool::ObjectsPool* objectsPool_;
 };
@@ -247,6 +255,78 @@ V* LongAdaptiveRadixTreeMap<V>::GetOrInsert(int64_t key, std::function<V*()> sup
   return v;
 }
 
+template <typename V>
+void LongAdaptiveRadixTreeMap<V>::PutAllSorted(const int64_t* keys,
+                                               V* const* values,
+                                               size_t count) {
+  if (root_ != nullptr) {
+    throw std::runtime_error("PutAllSorted requires empty map");
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (keys[i] < 0 || (i > 0 && keys[i] <= keys[i - 1])) {
+      throw std::invalid_argument("PutAllSorted: keys are not sorted or negative");
+    }
+  }
+  if (count > 0) {
+    root_ = BuildSorted(keys, values, count);
+  }
+}
+
+template <typename V>
+IArtNode<V>*
+LongAdaptiveRadixTreeMap<V>::BuildSorted(const int64_t* keys, V* const* values, size_t count) {
+  using ::exchange::core::collections::objpool::ObjectsPool;
+  auto* pool = objectsPool_;
+  if (count == 1) {
+    auto* node = pool->template Get<ArtNode4<V>>(ObjectsPool::ART_NODE_4,
+                                                 [pool]() { return new ArtNode4<V>(pool); });
+    node->InitFirstKey(keys[0], values[0]);
+    return node;
+  }
+
+  // same node level as incremental inserts produce: highest differing byte
+  const int level = (63 - __builtin_clzll(keys[0] ^ keys[count - 1])) & 0xF8;
+  uint8_t subKeys[256];
+  void* children[256];
+  int numChildren = 0;
+  for (size_t i = 0; i < count;) {
+    const auto subKey = static_cast<uint8_t>((keys[i] >> level) & 0xFF);
+    size_t j = i + 1;
+    while (j < count && static_cast<uint8_t>((keys[j] >> level) & 0xFF) == subKey) {
+      j++;
+    }
+    subKeys[numChildren] = subKey;
+    children[numChildren] =
+      (level == 0) ? static_cast<void*>(values[i]) : BuildSorted(keys + i, values + i, j - i);
+    numChildren++;
+    i = j;
+  }
+
+  const int64_t nodeKey = keys[0] & (-1LL << level);
+  if (numChildren <= 4) {
+    auto* node = pool->template Get<ArtNode4<V>>(ObjectsPool::ART_NODE_4,
+                                                 [pool]() { return new ArtNode4<V>(pool); });
+    node->InitFromSorted(subKeys, children, numChildren, nodeKey, level);
+    return node;
+  }
+  if (numChildren <= 16) {
+    auto* node = pool->template Get<ArtNode16<V>>(ObjectsPool::ART_NODE_16,
+                                                  [pool]() { return new ArtNode16<V>(pool); });
+    node->InitFromSorted(subKeys, children, numChildren, nodeKey, level);
+    return node;
+  }
+  if (numChildren <= 48) {
+    auto* node = pool->template Get<ArtNode48<V>>(ObjectsPool::ART_NODE_48,
+                                                  [pool]() { return new ArtNode48<V>(pool); });
+    node->InitFromSorted(subKeys, children, numChildren, nodeKey, level);
+    return node;
+  }
+  auto* node = pool->template Get<ArtNode256<V>>(ObjectsPool::ART_NODE_256,
+                                                 [pool]() { return new ArtNode256<V>(pool); });
+  node->InitFromSorted(subKeys, children, numChildren, nodeKey, level);
+  return node;
+}
+
 template <typename V>
 void LongAdaptiveRadixTreeMap<V>::Remove(int64_t key) {
   if (root_) {
@@ -129,6 +129,39 @@ public:
    */
   void PutRaw(int type, void* object);
 
+  /**
+   * Pre-allocate objects until the pool of given type is full.
+   * Objects are constructed by supplier (which touches their memory, so page
+   * faults happen here instead of on the hot path) and stored the same way
+   * Put/PutRaw would store them.
+   * @return number of objects added
+   */
+  template <typename T, typename Supplier>
+  int Preallocate(int type, Supplier supplier) {
+    int added = 0;
+    const int capacity = Capacity(type);
+    while (Available(type) < capacity) {
+      T* obj = supplier();
+      if constexpr (std::is_default_constructible_v<T>) {
+        Put(type, obj);
+      } else {
+        PutRaw(type, static_cast<void*>(obj));
+      }
+      added++;
+    }
+    return added;
+  }
+
+  /**
+   * Number of objects currently stored in the pool of given type
+   */
+  int Available(int type) const;
+
+  /**
+   * Maximum number of objects the pool of given type can hold (0 if not configured)
+   */
+  int Capacity(int type) const;
+
 private:
   class ArrayStack {
   public:
@@ -138,6 +171,14 @@ private:
     void* Pop();
     void Add(void* element);
 
+    int Size() const {
+      return count_;
+    }
+
+    int Capacity() const {
+      return capacity_;
+    }
+
   private:
     int count_;
     void** objects_;
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <ankerl/unordered_dense.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace exchange::core::common {
+
+/**
+ * UserAccounts - currency -> balance map optimized for few currencies per user
+ *
+ * Up to INLINE_CAPACITY accounts are stored inline (no heap allocation, same
+ * cache lines as the owning UserProfile). When more currencies are added, all
+ * entries move to a heap spill area: entries vector plus currency -> index map.
+ *
+ * Iteration order is insertion order (same as ankerl::unordered_dense::map
+ * without erase), so state hash and serialization format are not changed.
+ * Accounts are never removed.
+ *
+ * Like ankerl map, references returned by operator[] are invalidated by
+ * insertion of a new currency.
+ */
+class UserAccounts {
+public:
+  static constexpr int32_t INLINE_CAPACITY = 4;
+
+  using value_type = std::pair<int32_t, int64_t>;
+  using iterator = value_type*;
+  using const_iterator = const value_type*;
+
+  UserAccounts() = default;
+  UserAccounts(const UserAccounts& other);
+  UserAccounts& operator=(const UserAccounts& other);
+  UserAccounts(UserAccounts&& other) noexcept = default;
+  UserAccounts& operator=(UserAccounts&& other) noexcept = default;
+
+  /**
+   * Get balance reference, inserting zero balance if currency not found
+   */
+  int64_t& operator[](int32_t currency) {
+    if (spill_ == nullptr) {
+      for (int32_t i = 0; i < inlineSize_; i++) {
+        if (inline_[i].first == currency) {
+          return inline_[i].second;
+        }
+      }
+      if (inlineSize_ < INLINE_CAPACITY) {
+        inline_[inlineSize_] = {currency, 0};
+        return inline_[inlineSize_++].second;
+      }
+      SpillOver();
+    }
+    return SpillGetOrInsert(currency);
+  }
+
+  iterator find(int32_t currency) {
+    if (spill_ == nullptr) {
+      for (int32_t i = 0; i < inlineSize_; i++) {
+        if (inline_[i].first == currency) {
+          return &inline_[i];
+        }
+      }
+      return end();
+    }
+    auto it = spill_->index.find(currency);
+    return it != spill_->index.end() ? &spill_->entries[it->second] : end();
+  }
+
+  const_iterator find(int32_t currency) const {
+    return const_cast<UserAccounts*>(this)->find(currency);
+  }
+
+  iterator begin() {
+    return spill_ == nullptr ? inline_.data() : spill_->entries.data();
+  }
+
+  iterator end() {
+    return spill_ == nullptr ? inline_.data() + inlineSize_
+                             : spill_->entries.data() + spill_->entries.size();
+  }
+
+  const_iterator begin() const {
+    return const_cast<UserAccounts*>(this)->begin();
+  }
+
+  const_iterator end() const {
+    return const_cast<UserAccounts*>(this)->end();
+  }
+
+  size_t size() const {
+    return spill_ == nullptr ? static_cast<size_t>(inlineSize_) : spill_->entries.size();
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  void clear() {
+    spill_.reset();
+    inlineSize_ = 0;
+  }
+
+  /**
+   * Copy accounts into ankerl map (reports)
+   */
+  ankerl::unordered_dense::map<int32_t, int64_t> ToMap() const;
+
+private:
+  struct Spill {
+    std::vector<value_type> entries;
+    ankerl::unordered_dense::map<int32_t, uint32_t> index;
+  };
+
+  void SpillOver();
+  int64_t& SpillGetOrInsert(int32_t currency);
+
+  std::array<value_type, INLINE_CAPACITY> inline_{};
+  int32_t inlineSize_ = 0;
+  std::unique_ptr<Spill> spill_;
+};
+
+}  // namespace exchange::core::common
@@ -19,8 +19,10 @@
 #include <ankerl/unordered_dense.h>
 #include <cstdint>
 #include <string>
+#include <vector>
 #include "StateHash.h"
 #include "SymbolPositionRecord.h"
+#include "UserAccounts.h"
 #include "UserStatus.h"
 #include "WriteBytesMarshallable.h"
 
@@ -38,11 +40,31 @@ public:
   int64_t adjustmentsCounter = 0;
 
   // currency accounts
-  // currency -> balance
-  ankerl::unordered_dense::map<int32_t, int64_t> accounts;
+  // currency -> balance (first few currencies are stored inline)
+  UserAccounts accounts;
 
   UserStatus userStatus = UserStatus::ACTIVE;
 
+  /**
+   * Free margin (P&L minus required margin) of all positions in one quote
+   * currency, cached by risk engine R1.
+   * Valid while priceEpoch matches risk engine price epoch of the currency,
+   * cleared when positions are changed by trades/rejects or removed.
+   * Not serialized and not part of state hash.
+   */
+  struct FreeMarginCacheRecord {
+    int32_t currency;
+    int64_t priceEpoch;
+    int64_t freeMargin;
+  };
+  std::vector<FreeMarginCacheRecord> freeMarginCache;
+
+  /**
+   * Profile was changed since last snapshot (incremental snapshots only).
+   * Not serialized and not part of state hash.
+   */
+  bool snapshotChanged = false;
+
   UserProfile() = default;
 
   UserProfile(int64_t uid, UserStatus userStatus);
@@ -29,6 +29,10 @@ public:
   int64_t uid;
 
   explicit ApiAddUser(int64_t uid) : uid(uid) {}
+
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::ADD_USER;
+  }
 };
 
 }  // namespace exchange::core::common::api
@@ -43,6 +43,10 @@ public:
     , amount(amount)
     , transactionId(transactionId)
     , adjustmentType(adjustmentType) {}
+
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::ADJUST_USER_BALANCE;
+  }
 };
 
 }  // namespace exchange::core::common::api
@@ -37,6 +37,10 @@ public:
 
   ApiBinaryDataCommand(int32_t transferId, std::unique_ptr<binary::BinaryDataCommand> data)
     : transferId(transferId), data(std::move(data)) {}
+
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::BINARY_DATA;
+  }
 };
 
 }  // namespace exchange::core::common::api
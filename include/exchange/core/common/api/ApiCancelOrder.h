@@ -32,6 +32,10 @@ public:
 
   ApiCancelOrder(int64_t orderId, int64_t uid, int32_t symbol)
     : orderId(orderId), uid(uid), symbol(symbol) {}
+
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::CANCEL_ORDER;
+  }
 };
 
 }  // namespace exchange::core::common::api
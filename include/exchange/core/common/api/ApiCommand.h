@@ -20,6 +20,26 @@
 
 namespace exchange::core::common::api {
 
+/**
+ * ApiCommandType - concrete type of API command, lets ExchangeApi translate
+ * commands with a switch instead of dynamic_cast chains
+ */
+enum class ApiCommandType : uint8_t {
+  PLACE_ORDER,
+  MOVE_ORDER,
+  CANCEL_ORDER,
+  REDUCE_ORDER,
+  ORDER_BOOK_REQUEST,
+  ADD_USER,
+  SUSPEND_USER,
+  RESUME_USER,
+  ADJUST_USER_BALANCE,
+  RESET,
+  NOP,
+  BINARY_DATA,
+  PERSIST_STATE
+};
+
 /**
  * ApiCommand - base class for all API commands
  * Used for external API interface, converted to OrderCommand for internal
@@ -30,6 +50,8 @@ public:
   int64_t timestamp = 0;
 
   virtual ~ApiCommand() = default;
+
+  virtual ApiCommandType GetCommandType() const = 0;
 };
 
 }  // namespace exchange::core::common::api
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "../BalanceAdjustmentType.h"
+#include "../OrderAction.h"
+#include "../OrderType.h"
+#include "ApiCommand.h"
+
+namespace exchange::core::common::api {
+
+/**
+ * ApiCommandValue - trivially copyable command for allocation-free submission
+ *
+ * Tagged alternative to the polymorphic ApiCommand classes: created on the
+ * stack (or kept in caller-owned arrays) and translated by ExchangeApi with a
+ * switch on type straight into the claimed ring buffer slot.
+ * Fields have the meaning of the corresponding OrderCommand fields, fields
+ * not used by the command type are ignored.
+ * Commands carrying payload (BINARY_DATA, PERSIST_STATE) are not supported.
+ */
+struct ApiCommandValue {
+  ApiCommandType type = ApiCommandType::NOP;
+  OrderAction action = OrderAction::ASK;
+  OrderType orderType = OrderType::GTC;
+  BalanceAdjustmentType adjustmentType = BalanceAdjustmentType::ADJUSTMENT;
+  int32_t symbol = 0;  // symbol, currency for balance adjustment, depth for order book request
+  int32_t userCookie = 0;
+  int64_t uid = 0;
+  int64_t orderId = 0;  // order id, transaction id for balance adjustment
+  int64_t price = 0;    // price, new price for move, amount for balance adjustment
+  int64_t reservePrice = 0;
+  int64_t size = 0;  // size, reduce size for reduce
+  int64_t timestamp = 0;
+
+  static ApiCommandValue PlaceOrder(int64_t uid,
+                                    int32_t symbol,
+                                    int64_t orderId,
+                                    OrderAction action,
+                                    OrderType orderType,
+                                    int64_t price,
+                                    int64_t reservePrice,
+                                    int64_t size,
+                                    int32_t userCookie = 0) {
+    ApiCommandValue cmd;
+    cmd.type = ApiCommandType::PLACE_ORDER;
+    cmd.uid = uid;
+    cmd.symbol = symbol;
+    cmd.orderId = orderId;
+    cmd.action = action;
+    cmd.orderType = orderType;
+    cmd.price = price;
+    cmd.reservePrice = reservePrice;
+    cmd.size = size;
+    cmd.userCookie = userCookie;
+    return cmd;
+  }
+
+  static ApiCommandValue MoveOrder(int64_t uid, int32_t symbol, int64_t orderId, int64_t newPrice) {
+    ApiCommandValue cmd;
+    cmd.type = ApiCommandType::MOVE_ORDER;
+    cmd.uid = uid;
+    cmd.symbol = symbol;
+    cmd.orderId = orderId;
+    cmd.price = newPrice;
+    return cmd;
+  }
+
+  static ApiCommandValue CancelOrder(int64_t uid, int32_t symbol, int64_t orderId) {
+    ApiCommandValue cmd;
+    cmd.type = ApiCommandType::CANCEL_ORDER;
+    cmd.uid = uid;
+    cmd.symbol = symbol;
+    cmd.orderId = orderId;
+    return cmd;
+  }
+
+  static ApiCommandValue
+  ReduceOrder(int64_t uid, int32_t symbol, int64_t orderId, int64_t reduceSize) {
+    ApiCommandValue cmd;
+    cmd.type = ApiCommandType::REDUCE_ORDER;
+    cmd.uid = uid;
+    cmd.symbol = symbol;
+    cmd.orderId = orderId;
+    cmd.size = reduceSize;
+    return cmd;
+  }
+
+  static ApiCommandValue OrderBookRequest(int32_t symbol, int32_t depth) {
+    ApiCommandValue cmd;
+    cmd.type = ApiCommandType::ORDER_BOOK_REQUEST;
+    cmd.symbol = symbol;
+    cmd.size = depth;
+    return cmd;
+  }
+
+  static ApiCommandValue AddUser(int64_t uid) {
+    return UserCommand(ApiCommandType::ADD_USER, uid);
+  }
+
+  static ApiCommandValue SuspendUser(int64_t uid) {
+    return UserCommand(ApiCommandType::SUSPEND_USER, uid);
+  }
+
+  static ApiCommandValue ResumeUser(int64_t uid) {
+    return UserCommand(ApiCommandType::RESUME_USER, uid);
+  }
+
+  static ApiCommandValue
+  AdjustUserBalance(int64_t uid,
+                    int32_t currency,
+                    int64_t amount,
+                    int64_t transactionId,
+                    BalanceAdjustmentType adjustmentType = BalanceAdjustmentType::ADJUSTMENT) {
+    ApiCommandValue cmd;
+    cmd.type = ApiCommandType::ADJUST_USER_BALANCE;
+    cmd.uid = uid;
+    cmd.symbol = currency;
+    cmd.price = amount;
+    cmd.orderId = transactionId;
+    cmd.adjustmentType = adjustmentType;
+    return cmd;
+  }
+
+  static ApiCommandValue Reset() {
+    ApiCommandValue cmd;
+    cmd.type = ApiCommandType::RESET;
+    return cmd;
+  }
+
+  static ApiCommandValue Nop() {
+    return ApiCommandValue{};
+  }
+
+private:
+  static ApiCommandValue UserCommand(ApiCommandType type, int64_t uid) {
+    ApiCommandValue cmd;
+    cmd.type = type;
+    cmd.uid = uid;
+    return cmd;
+  }
+};
+
+}  // namespace exchange::core::common::api
@@ -33,6 +33,10 @@ public:
 
   ApiMoveOrder(int64_t orderId, int64_t newPrice, int64_t uid, int32_t symbol)
     : orderId(orderId), newPrice(newPrice), uid(uid), symbol(symbol) {}
+
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::MOVE_ORDER;
+  }
 };
 
 }  // namespace exchange::core::common::api
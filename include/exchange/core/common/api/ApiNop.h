@@ -23,6 +23,11 @@ namespace exchange::core::common::api {
 /**
  * ApiNop - no operation command
  */
-class ApiNop : public ApiCommand {};
+class ApiNop : public ApiCommand {
+public:
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::NOP;
+  }
+};
 
 }  // namespace exchange::core::common::api
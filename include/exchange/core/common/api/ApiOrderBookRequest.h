@@ -30,6 +30,10 @@ public:
   int32_t size;
 
   ApiOrderBookRequest(int32_t symbol, int32_t size) : symbol(symbol), size(size) {}
+
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::ORDER_BOOK_REQUEST;
+  }
 };
 
 }  // namespace exchange::core::common::api
@@ -30,6 +30,10 @@ public:
   bool seal;
 
   ApiPersistState(int64_t dumpId, bool seal) : dumpId(dumpId), seal(seal) {}
+
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::PERSIST_STATE;
+  }
 };
 
 }  // namespace exchange::core::common::api
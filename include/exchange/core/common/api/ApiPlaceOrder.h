@@ -56,6 +56,10 @@ public:
     , symbol(symbol)
     , userCookie(userCookie)
     , reservePrice(reservePrice) {}
+
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::PLACE_ORDER;
+  }
 };
 
 }  // namespace exchange::core::common::api
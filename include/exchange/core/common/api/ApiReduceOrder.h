@@ -33,6 +33,10 @@ public:
 
   ApiReduceOrder(int64_t orderId, int64_t uid, int32_t symbol, int64_t reduceSize)
     : orderId(orderId), uid(uid), symbol(symbol), reduceSize(reduceSize) {}
+
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::REDUCE_ORDER;
+  }
 };
 
 }  // namespace exchange::core::common::api
@@ -23,6 +23,11 @@ namespace exchange::core::common::api {
 /**
  * ApiReset - reset exchange state
  */
-class ApiReset : public ApiCommand {};
+class ApiReset : public ApiCommand {
+public:
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::RESET;
+  }
+};
 
 }  // namespace exchange::core::common::api
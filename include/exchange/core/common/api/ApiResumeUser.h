@@ -29,6 +29,10 @@ public:
   int64_t uid;
 
   explicit ApiResumeUser(int64_t uid) : uid(uid) {}
+
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::RESUME_USER;
+  }
 };
 
 }  // namespace exchange::core::common::api
@@ -29,6 +29,10 @@ public:
   int64_t uid;
 
   explicit ApiSuspendUser(int64_t uid) : uid(uid) {}
+
+  ApiCommandType GetCommandType() const override {
+    return ApiCommandType::SUSPEND_USER;
+  }
 };
 
 }  // namespace exchange::core::common::api
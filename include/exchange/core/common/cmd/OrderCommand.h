@@ -87,6 +87,12 @@ struct alignas(64) OrderCommand : public IOrder, public StateHash {
   // OrderCommands
   std::shared_ptr<L2MarketData> marketData = nullptr;
 
+  // serialized binary command/query (BINARY_DATA_*), published as single
+  // command instead of 5-longs frames; owned by ExchangeApi payload arena,
+  // valid while command is in ring buffer. Set only by binary commands
+  // producers, other commands may keep stale value - check command type first
+  const std::vector<uint8_t>* payload = nullptr;
+
   // ---- potential false sharing section ------
 
   // Static factory methods
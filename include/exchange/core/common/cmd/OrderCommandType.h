@@ -46,7 +46,12 @@ enum class OrderCommandType : int8_t {
   RESET = 124,
   SHUTDOWN_SIGNAL = 127,
 
-  RESERVED_COMPRESSED = -1
+  RESERVED_COMPRESSED = -1,
+  RESERVED_COMPACT = -2,
+  RESERVED_COMPRESSED_CHECKED = -3,
+  RESERVED_COMPACT_CHECKED = -4,
+  RESERVED_BINARY_PAYLOAD = -5,
+  RESERVED_PADDING = -6
 };
 
 inline bool IsMutate(OrderCommandType type) {
@@ -107,6 +112,16 @@ inline OrderCommandType OrderCommandTypeFromCode(int8_t code) {
       return OrderCommandType::SHUTDOWN_SIGNAL;
     case -1:
       return OrderCommandType::RESERVED_COMPRESSED;
+    case -2:
+      return OrderCommandType::RESERVED_COMPACT;
+    case -3:
+      return OrderCommandType::RESERVED_COMPRESSED_CHECKED;
+    case -4:
+      return OrderCommandType::RESERVED_COMPACT_CHECKED;
+    case -5:
+      return OrderCommandType::RESERVED_BINARY_PAYLOAD;
+    case -6:
+      return OrderCommandType::RESERVED_PADDING;
     default:
       throw std::invalid_argument("Unknown order command type code: " + std::to_string(code));
   }
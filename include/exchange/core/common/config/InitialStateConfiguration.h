@@ -32,6 +32,8 @@ public:
   int64_t snapshotBaseSeq;
   int64_t journalTimestampNs;
   bool throwIfSnapshotNotFound;
+  // bulk accounts file (see BulkAccountsFile) loaded on clean start, optional
+  std::string accountsFile;
 
   InitialStateConfiguration(std::string exchangeId,
                             int64_t snapshotId,
@@ -52,6 +54,22 @@ public:
     return InitialStateConfiguration(exchangeId, 0, 0, 0, false);
   }
 
+  /**
+   * Clean start configuration with initial accounts loaded from bulk accounts
+   * file by risk engines before processing starts (instead of
+   * BatchAddAccountsCommand). File is not journaled - it has to be provided
+   * again for journal replay, unless starting from snapshot.
+   * @param exchangeId Exchange ID
+   * @param accountsFile bulk accounts file path
+   * @return clean start configuration with initial accounts.
+   */
+  static InitialStateConfiguration CleanStartWithAccounts(const std::string& exchangeId,
+                                                          const std::string& accountsFile) {
+    InitialStateConfiguration cfg = CleanStart(exchangeId);
+    cfg.accountsFile = accountsFile;
+    return cfg;
+  }
+
   static InitialStateConfiguration Default() {
     return CleanStart("MY_EXCHANGE");
   }
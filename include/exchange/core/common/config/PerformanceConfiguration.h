@@ -20,6 +20,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
 #include "../../orderbook/IOrderBook.h"
 #include "../CoreWaitStrategy.h"
 
@@ -79,6 +80,34 @@ public:
     orderbook::OrderBookEventsHelper* eventsHelper)>;
   OrderBookFactory orderBookFactory;
 
+  // Fill matching and risk engine object pools up to their capacity on startup,
+  // so allocations and page faults do not hit the first orders
+  bool preallocateObjectPools = false;
+
+  // Number of synthetic orders sent through a scratch symbol on every matching
+  // engine shard during startup, before accepting real traffic (0 - disabled).
+  // Only applied on clean start without journaling, state is reset afterwards.
+  int32_t warmUpOrdersNum = 0;
+
+  // Symbol ids below this limit are resolved through direct-indexed arrays
+  // (symbol specs, order books, last prices) instead of hash maps, larger ids
+  // fall back to hash lookup (0 - always use hash maps).
+  int32_t denseSymbolIdLimit = 100'000;
+
+  // Lookahead distance (in commands) for R1 software prefetch: dense uid index
+  // slot of PLACE_ORDER command 2 x distance ahead in the ring buffer, then its
+  // user profile distance ahead (0 - disabled). Uids not covered by dense
+  // index are not prefetched.
+  int32_t prefetchDistance = 0;
+
+  // Shared-memory ingress segment for gateway processes (see
+  // ingress::SharedMemoryBridge), empty - disabled. Command ring and every
+  // results ring have ringBufferSize slots.
+  std::string sharedMemoryIngressName;
+
+  // Number of gateway processes (results rings) of shared-memory ingress
+  int32_t sharedMemoryIngressClients = 16;
+
   PerformanceConfiguration(int32_t ringBufferSize,
                            int32_t matchingEnginesNum,
                            int32_t riskEnginesNum,
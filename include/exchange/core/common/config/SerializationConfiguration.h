@@ -23,6 +23,7 @@ namespace exchange::core {
 
 namespace processors::journaling {
 class ISerializationProcessor;
+class DiskSerializationProcessorConfiguration;
 }
 
 namespace common::config {
@@ -51,7 +52,17 @@ public:
 
   static SerializationConfiguration Default();
   static SerializationConfiguration DiskSnapshotOnly();
+  // Snapshots only, written by forked child process (non-blocking)
+  static SerializationConfiguration DiskSnapshotOnlyForked();
+  // Snapshots only, incremental (changed user profiles and order books)
+  static SerializationConfiguration DiskSnapshotOnlyIncremental();
   static SerializationConfiguration DiskJournaling();
+  // Disk journaling with asynchronous journal writer thread
+  static SerializationConfiguration DiskJournalingAsync();
+  // Disk journaling with custom disk configuration (copied)
+  static SerializationConfiguration DiskJournaling(
+    const ::exchange::core::processors::journaling::DiskSerializationProcessorConfiguration&
+      diskConfig);
 };
 
 }  // namespace common::config
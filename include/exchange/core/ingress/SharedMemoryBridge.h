@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <disruptor/dsl/ThreadFactory.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../ExchangeApi.h"
+#include "SharedMemoryIngress.h"
+
+namespace exchange::core::ingress {
+
+/**
+ * SharedMemoryBridge - publishes commands of gateway processes into the ring buffer
+ *
+ * Bridge thread drains the shared-memory command ring and submits every drained
+ * run as one buffer of wire frames (next(n) + publish(lo, hi)) with a single
+ * completion callback. Callback (results thread) copies result codes into the
+ * results rings of the gateways. Invalid frames are answered at once with
+ * INVALID_FRAME. A result that does not fit into a full results ring is
+ * dropped and counted: the pipeline never waits for a gateway.
+ */
+class SharedMemoryBridge {
+public:
+  // Result code of rejected frame (range below -10000 is reserved for gateways)
+  static constexpr int32_t INVALID_FRAME = -10001;
+
+  /**
+   * @param maxBatchSize - commands per submission, not more than ring buffer size / 4
+   */
+  SharedMemoryBridge(IExchangeApi* api, SharedMemoryIngress* ingress, size_t maxBatchSize);
+
+  ~SharedMemoryBridge();
+
+  SharedMemoryBridge(const SharedMemoryBridge&) = delete;
+  SharedMemoryBridge& operator=(const SharedMemoryBridge&) = delete;
+
+  void Start(disruptor::dsl::ThreadFactory& threadFactory);
+
+  /**
+   * Stop bridge thread (commands still in pipeline are completed as usual)
+   */
+  void Stop();
+
+  /**
+   * Drain command ring once and submit drained commands (bridge thread)
+   * @return number of drained records
+   */
+  size_t PollOnce();
+
+  int64_t DroppedResults() const {
+    return droppedResults_.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Route {
+    uint64_t correlationId;
+    uint32_t clientId;
+  };
+
+  void Reply(uint32_t clientId, uint64_t correlationId, int64_t seq, int32_t resultCode);
+
+  void OnCompleted(int64_t firstRoute, const CompletedBatch& batch);
+
+  IExchangeApi* api_;
+  SharedMemoryIngress* ingress_;
+  size_t maxBatchSize_;
+
+  std::vector<ShmCommandRecord> records_;
+  std::vector<uint8_t> frames_;
+
+  // Routes of submitted commands in submission order (bridge writes, results
+  // thread reads), at most routesMask_ + 1 commands in flight
+  std::unique_ptr<Route[]> routes_;
+  int64_t routesMask_;
+  int64_t submitted_ = 0;
+  alignas(64) std::atomic<int64_t> completed_{0};
+  std::atomic<int64_t> droppedResults_{0};
+
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+};
+
+}  // namespace exchange::core::ingress
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "SharedMemoryRing.h"
+#include "WireFrameReader.h"
+
+namespace exchange::core::ingress {
+
+/**
+ * Command written by gateway process: one wire frame (see WireFormat, no batch
+ * frames) and ids to route its result back
+ */
+struct ShmCommandRecord {
+  uint64_t correlationId;
+  uint32_t clientId;  // results ring of gateway
+  uint32_t frameLength;
+  uint8_t frame[WireFormat::HEADER_SIZE + WireFormat::PLACE_ORDER_BLOCK];
+};
+
+/**
+ * Result returned to gateway process
+ */
+struct ShmResultRecord {
+  uint64_t correlationId;
+  int64_t seq;  // -1 if command was not published (invalid frame)
+  int32_t resultCode;
+  uint32_t reserved;
+};
+
+/**
+ * SharedMemorySegment - named shared memory mapping
+ * (POSIX shm_open, file mapping on Windows)
+ */
+class SharedMemorySegment {
+public:
+  /**
+   * Create zeroed segment, replacing segment left by a previous run.
+   * Name is removed on destruction, mappings of other processes stay valid.
+   */
+  SharedMemorySegment(const std::string& name, size_t size);
+
+  /**
+   * Map existing segment
+   */
+  explicit SharedMemorySegment(const std::string& name);
+
+  ~SharedMemorySegment();
+
+  SharedMemorySegment(const SharedMemorySegment&) = delete;
+  SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+  void* Data() const {
+    return data_;
+  }
+
+  size_t Size() const {
+    return size_;
+  }
+
+private:
+  std::string name_;
+  void* data_ = nullptr;
+  size_t size_ = 0;
+  bool owner_ = false;
+#ifdef _WIN32
+  void* handle_ = nullptr;
+#endif
+};
+
+/**
+ * SharedMemoryIngress - layout of shared-memory ingress segment
+ *
+ * [header] [command ring (MPSC, all gateways)] [results ring of client 0] ...
+ * Exchange process creates the segment, gateway processes attach to it by name
+ * and use a results ring of their own (clientId).
+ */
+class SharedMemoryIngress {
+public:
+  static constexpr uint64_t MAGIC = 0x4543494E47524553ULL;
+  static constexpr uint32_t VERSION = 1;
+
+  /**
+   * Create segment and rings (exchange process)
+   * @param commandCapacity - command ring size, power of 2
+   * @param resultCapacity - size of every results ring, power of 2
+   */
+  SharedMemoryIngress(const std::string& name,
+                      uint32_t clients,
+                      uint32_t commandCapacity,
+                      uint32_t resultCapacity);
+
+  /**
+   * Attach to segment created by exchange process
+   */
+  explicit SharedMemoryIngress(const std::string& name);
+
+  SharedMemoryRing<ShmCommandRecord>& Commands() {
+    return *commands_;
+  }
+
+  SharedMemoryRing<ShmResultRecord>& Results(uint32_t clientId);
+
+  uint32_t Clients() const;
+
+private:
+  struct Header;
+
+  SharedMemorySegment segment_;
+  Header* header_;
+  SharedMemoryRing<ShmCommandRecord>* commands_;
+};
+
+/**
+ * SharedMemoryIngressClient - gateway side of shared-memory ingress
+ * (single thread per client: results ring has one consumer)
+ */
+class SharedMemoryIngressClient {
+public:
+  SharedMemoryIngressClient(const std::string& name, uint32_t clientId);
+
+  /**
+   * Offer one wire frame, validated by exchange process
+   * @return false if command ring is full
+   */
+  bool TrySubmit(uint64_t correlationId, const uint8_t* frame, size_t length);
+
+  /**
+   * Take up to maxResults results of this client
+   */
+  size_t PollResults(ShmResultRecord* results, size_t maxResults) {
+    return results_->Poll(results, maxResults);
+  }
+
+private:
+  SharedMemoryIngress ingress_;
+  uint32_t clientId_;
+  SharedMemoryRing<ShmResultRecord>* results_;
+};
+
+}  // namespace exchange::core::ingress
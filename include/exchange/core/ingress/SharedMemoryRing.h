@@ -0,0 +1,142 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+namespace exchange::core::ingress {
+
+/**
+ * SharedMemoryRing - bounded MPSC ring of fixed-size records in shared memory
+ *
+ * Lives inside a mapped segment (no pointers, valid at any mapping address).
+ * Every slot carries its own sequence stamp: producers of any process claim a
+ * slot with CAS on the tail and publish it by stamping pos + 1, the single
+ * consumer reads stamped slots in order and frees them for the next lap
+ * (pos + capacity).
+ * A producer that dies between claim and publish stalls the consumer at its slot.
+ */
+template <typename RecordT>
+class SharedMemoryRing {
+  static_assert(std::is_trivially_copyable_v<RecordT>, "records are copied between processes");
+  static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                "ring sequences must be lock-free to be shared between processes");
+
+  struct Slot {
+    std::atomic<uint64_t> sequence;
+    RecordT record;
+  };
+
+public:
+  /**
+   * Bytes of shared memory used by ring of given capacity
+   */
+  static size_t Footprint(uint32_t capacity) {
+    return sizeof(SharedMemoryRing) + static_cast<size_t>(capacity) * sizeof(Slot);
+  }
+
+  /**
+   * Initialize ring in Footprint(capacity) bytes (creator process only)
+   * @param capacity - power of 2
+   */
+  static SharedMemoryRing* Init(void* memory, uint32_t capacity) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+      throw std::invalid_argument("SharedMemoryRing: capacity must be a power of 2");
+    }
+    auto* ring = new (memory) SharedMemoryRing(capacity);
+    for (uint32_t i = 0; i < capacity; i++) {
+      new (&ring->Slots()[i].sequence) std::atomic<uint64_t>(i);
+    }
+    return ring;
+  }
+
+  /**
+   * Ring initialized by another process
+   */
+  static SharedMemoryRing* Attach(void* memory) {
+    return std::launder(static_cast<SharedMemoryRing*>(memory));
+  }
+
+  /**
+   * Copy record into next free slot (any number of producers)
+   * @return false if ring is full
+   */
+  bool TryOffer(const RecordT& record) {
+    uint64_t pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      Slot& slot = Slots()[pos & mask_];
+      const auto diff =
+        static_cast<int64_t>(slot.sequence.load(std::memory_order_acquire) - pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.record = record;
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;  // slot of previous lap is not consumed yet
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Copy up to maxRecords published records in order (single consumer)
+   * @return number of records
+   */
+  size_t Poll(RecordT* records, size_t maxRecords) {
+    uint64_t pos = head_.load(std::memory_order_relaxed);
+    size_t n = 0;
+    while (n < maxRecords) {
+      Slot& slot = Slots()[pos & mask_];
+      if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+        break;
+      }
+      records[n++] = slot.record;
+      slot.sequence.store(pos + capacity_, std::memory_order_release);
+      pos++;
+    }
+    head_.store(pos, std::memory_order_relaxed);
+    return n;
+  }
+
+  uint32_t Capacity() const {
+    return capacity_;
+  }
+
+private:
+  explicit SharedMemoryRing(uint32_t capacity) : capacity_(capacity), mask_(capacity - 1) {}
+
+  Slot* Slots() {
+    return reinterpret_cast<Slot*>(this + 1);
+  }
+
+  alignas(64) const uint32_t capacity_;
+  const uint32_t mask_;
+  // producers
+  alignas(64) std::atomic<uint64_t> tail_{0};
+  // consumer only (atomic: consumer may be restarted in another process)
+  alignas(64) std::atomic<uint64_t> head_{0};
+};
+
+}  // namespace exchange::core::ingress
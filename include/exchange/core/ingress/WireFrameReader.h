@@ -0,0 +1,176 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "../common/OrderAction.h"
+#include "../common/OrderType.h"
+#include "../common/cmd/OrderCommand.h"
+
+namespace exchange::core::ingress {
+
+static_assert(std::endian::native == std::endian::little,
+              "wire frames are decoded with plain loads (little-endian host)");
+
+/**
+ * Wire format of gateway ingress (SBE-style, little-endian, fixed layout)
+ *
+ * Frame: [message header (8)] [block (blockLength)]
+ * Message header: [blockLength (2)] [templateId (2)] [schemaId (2)] [version (2)]
+ * blockLength can be larger than known block (fields appended by newer
+ * versions are skipped).
+ *
+ * PLACE_ORDER (64): [uid (8)] [orderId (8)] [price (8)] [reservePrice (8)]
+ *   [size (8)] [timestamp (8)] [symbol (4)] [userCookie (4)] [action (1)]
+ *   [orderType (1)] [padding (6)]
+ * CANCEL_ORDER (32): [uid (8)] [orderId (8)] [timestamp (8)] [symbol (4)] [padding (4)]
+ * MOVE_ORDER (40): [uid (8)] [orderId (8)] [newPrice (8)] [timestamp (8)] [symbol (4)]
+ *   [padding (4)]
+ * REDUCE_ORDER (40): [uid (8)] [orderId (8)] [reduceSize (8)] [timestamp (8)]
+ *   [symbol (4)] [padding (4)]
+ * BATCH (8): [count (4)] [reserved (4)], followed by count order frames
+ *   (no nested batches) - published as consecutive sequences
+ */
+struct WireFormat {
+  static constexpr uint16_t SCHEMA_ID = 0x4543;  // "EC"
+  static constexpr uint16_t SCHEMA_VERSION = 1;
+  static constexpr size_t HEADER_SIZE = 8;
+
+  enum class TemplateId : uint16_t {
+    PLACE_ORDER = 1,
+    CANCEL_ORDER = 2,
+    MOVE_ORDER = 3,
+    REDUCE_ORDER = 4,
+    BATCH = 5
+  };
+
+  static constexpr size_t PLACE_ORDER_BLOCK = 64;
+  static constexpr size_t CANCEL_ORDER_BLOCK = 32;
+  static constexpr size_t MOVE_ORDER_BLOCK = 40;
+  static constexpr size_t REDUCE_ORDER_BLOCK = 40;
+  static constexpr size_t BATCH_BLOCK = 8;
+};
+
+/**
+ * WireFrameReader - validates and decodes a buffer of wire frames
+ *
+ * Validate() checks the whole buffer before anything is published (bounds,
+ * schema, template, enum codes, batch structure). Decoding writes fields
+ * straight into the ring buffer slot, no intermediate objects.
+ */
+class WireFrameReader {
+public:
+  WireFrameReader(const uint8_t* data, size_t length) : data_(data), length_(length) {}
+
+  /**
+   * Validate all frames (throws std::invalid_argument with frame offset)
+   * @param maxBatchSize - maximal number of commands in one batch frame
+   * @return number of commands
+   */
+  size_t Validate(size_t maxBatchSize) const;
+
+  bool AtEnd() const {
+    return position_ >= length_;
+  }
+
+  /**
+   * Number of commands in whole frames (batch counts as its commands) from
+   * current position, not more than maxCommands unless the first batch is
+   * larger (it is never split)
+   */
+  size_t CommandsUpTo(size_t maxCommands) const;
+
+  /**
+   * Decode next command into slot, skipping batch header (validated buffer only)
+   */
+  void DecodeNext(common::cmd::OrderCommand& cmd);
+
+private:
+  template <typename T>
+  T Read(size_t offset) const {
+    T value;
+    std::memcpy(&value, data_ + offset, sizeof(T));
+    return value;
+  }
+
+  // Total frame size (header + block), batch header only for batch frame
+  size_t FrameSize(size_t offset) const {
+    return WireFormat::HEADER_SIZE + Read<uint16_t>(offset);
+  }
+
+  WireFormat::TemplateId TemplateAt(size_t offset) const {
+    return static_cast<WireFormat::TemplateId>(Read<uint16_t>(offset + 2));
+  }
+
+  // Validate single order frame, returns its size
+  size_t ValidateOrderFrame(size_t offset) const;
+
+  const uint8_t* data_;
+  size_t length_;
+  size_t position_ = 0;
+};
+
+/**
+ * WireFrameWriter - appends wire frames to a buffer (gateway side, tests)
+ */
+class WireFrameWriter {
+public:
+  explicit WireFrameWriter(std::vector<uint8_t>& buffer) : buffer_(buffer) {}
+
+  void PlaceOrder(int64_t uid,
+                  int32_t symbol,
+                  int64_t orderId,
+                  common::OrderAction action,
+                  common::OrderType orderType,
+                  int64_t price,
+                  int64_t reservePrice,
+                  int64_t size,
+                  int32_t userCookie,
+                  int64_t timestamp);
+
+  void CancelOrder(int64_t uid, int32_t symbol, int64_t orderId, int64_t timestamp);
+
+  void MoveOrder(int64_t uid, int32_t symbol, int64_t orderId, int64_t newPrice, int64_t timestamp);
+
+  void ReduceOrder(int64_t uid,
+                   int32_t symbol,
+                   int64_t orderId,
+                   int64_t reduceSize,
+                   int64_t timestamp);
+
+  /**
+   * Batch header, must be followed by count order frames
+   */
+  void Batch(uint32_t count);
+
+private:
+  // Appends header and zeroed block, returns block offset
+  size_t Begin(WireFormat::TemplateId templateId, size_t blockLength);
+
+  template <typename T>
+  void Write(size_t offset, T value) {
+    std::memcpy(buffer_.data() + offset, &value, sizeof(T));
+  }
+
+  std::vector<uint8_t>& buffer_;
+};
+
+}  // namespace exchange::core::ingress
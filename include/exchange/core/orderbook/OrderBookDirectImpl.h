@@ -125,6 +125,14 @@ public:
                       OrderBookEventsHelper* eventsHelper,
                       const common::config::LoggingConfiguration* loggingCfg);
 
+  /**
+   * Fill order, bucket and ART node pools up to their capacity, so a fresh
+   * engine does not pay for allocations and page faults on first orders.
+   * @return number of objects allocated
+   */
+  static int64_t
+  PreallocatePoolObjects(::exchange::core::collections::objpool::ObjectsPool* objectsPool);
+
   // ... (rest of public interface remains same)
   const common::CoreSymbolSpecification* GetSymbolSpec() const override;
   void NewOrder(common::cmd::OrderCommand* cmd) override;
@@ -183,6 +191,9 @@ private:
   Bucket* GetOrCreateBucket(int64_t price, bool isAsk);
   Bucket* RemoveOrder(DirectOrder* order);
   void insertOrder(DirectOrder* order, Bucket* freeBucket);
+  // Link orders of one side sorted by matching priority, build its price
+  // buckets tree; returns best order
+  DirectOrder* BuildSortedOrders(DirectOrder* const* orders, size_t count, bool isAsk);
   int64_t tryMatchInstantly(common::IOrder* takerOrder, common::cmd::OrderCommand* triggerCmd);
   int64_t checkBudgetToFill(common::OrderAction action, int64_t size);
   bool isBudgetLimitSatisfied(common::OrderAction orderAction, int64_t calculated, int64_t limit);
@@ -80,6 +80,11 @@ public:
   void WriteMarshallable(common::BytesOut& bytes) const override;
 
 private:
+  /**
+   * Handle complete (reassembled or single payload) command or query
+   */
+  void ProcessCompleteMessage(common::cmd::OrderCommand* cmd, common::BytesIn& bytesIn);
+
   // transactionId -> TransferRecord (simplified for now)
   ankerl::unordered_dense::map<int64_t, void*> incomingData_;
 
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../utils/MappedFile.h"
+
+namespace exchange::core::processors {
+
+/**
+ * BulkAccountsFile - columnar file of initial accounts (uid, currency, balance)
+ *
+ * [magic (4)] [version (4)] [rows (8)]
+ * [uid (8)] x rows, [balance (8)] x rows, [currency (4)] x rows
+ *
+ * Loaded at startup by every risk engine shard (rows of its uids only),
+ * columns are read in place from memory-mapped file.
+ */
+class BulkAccountsFile {
+public:
+  static constexpr int32_t MAGIC = 0x41424345;  // "ECBA"
+  static constexpr int32_t VERSION = 1;
+  static constexpr size_t HEADER_SIZE = 16;
+
+  struct Row {
+    int64_t uid;
+    int32_t currency;
+    int64_t balance;
+  };
+
+  /**
+   * Map file and validate its header and size
+   */
+  explicit BulkAccountsFile(const std::string& path);
+
+  static void Write(const std::string& path, const std::vector<Row>& rows);
+
+  size_t Rows() const {
+    return rows_;
+  }
+
+  int64_t Uid(size_t row) const {
+    return uids_[row];
+  }
+
+  int32_t Currency(size_t row) const {
+    return currencies_[row];
+  }
+
+  int64_t Balance(size_t row) const {
+    return balances_[row];
+  }
+
+private:
+  utils::MappedFile file_;
+  size_t rows_ = 0;
+  const int64_t* uids_ = nullptr;
+  const int64_t* balances_ = nullptr;
+  const int32_t* currencies_ = nullptr;
+};
+
+}  // namespace exchange::core::processors
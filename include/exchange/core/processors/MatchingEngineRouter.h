@@ -23,6 +23,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include "../collections/DenseIntIndex.h"
 #include "../collections/objpool/ObjectsPool.h"
 #include "../common/WriteBytesMarshallable.h"
 #include "../common/api/reports/ReportQuery.h"
@@ -33,6 +34,7 @@
 #include "../utils/Logger.h"
 #include "BinaryCommandsProcessor.h"
 #include "SymbolSpecificationProvider.h"
+#include "journaling/IIncrementalSnapshotState.h"
 #include "journaling/ISerializationProcessor.h"
 
 namespace exchange::core::processors {
@@ -49,7 +51,8 @@ class SharedPool;
  * - Manages multiple OrderBooks (one per symbol)
  * - Supports sharding for parallel processing
  */
-class MatchingEngineRouter : public common::WriteBytesMarshallable {
+class MatchingEngineRouter : public common::WriteBytesMarshallable,
+                             public journaling::IIncrementalSnapshotState {
 public:
   // OrderBook factory function type
   // Matches Java IOrderBook.OrderBookFactory signature
@@ -87,6 +90,12 @@ public:
    */
   void Reset();
 
+  /**
+   * Fill order book object pools up to their capacity (startup warm-up)
+   * @return number of objects allocated
+   */
+  int64_t PreallocatePools();
+
   /**
    * Get shard ID
    */
@@ -118,6 +127,12 @@ public:
    */
   void WriteMarshallable(common::BytesOut& bytes) const override;
 
+  // IIncrementalSnapshotState interface (entries: symbol ID -> OrderBook)
+  void WriteGlobalState(common::BytesOut& bytes) const override;
+  void WriteEntries(journaling::SnapshotEntriesWriter& writer, bool changedOnly) const override;
+  bool ChangesTracked() const override;
+  void ClearChanges() override;
+
 private:
   int32_t shardId_;
   int64_t shardMask_;  // numShards - 1 (must be power of 2)
@@ -136,6 +151,9 @@ private:
   // Using ankerl::unordered_dense for better performance
   ankerl::unordered_dense::map<int32_t, std::unique_ptr<orderbook::IOrderBook>> orderBooks_;
 
+  // symbol ID -> OrderBook direct index for dense ids (orderBooks_ owns books)
+  ::exchange::core::collections::DenseIntIndex<orderbook::IOrderBook> orderBooksIndex_;
+
   // Events helper (shared across all order books)
   std::unique_ptr<orderbook::OrderBookEventsHelper> eventsHelper_;
 
@@ -148,12 +166,28 @@ private:
   // Serialization processor
   journaling::ISerializationProcessor* serializationProcessor_;
 
+  // Order books changed since last snapshot (incremental snapshots only)
+  bool trackChanges_ = false;
+  bool changesLost_ = false;
+  ankerl::unordered_dense::set<int32_t> changedSymbols_;
+
   // Configuration flags
   bool cfgMarginTradingEnabled_;
   bool cfgSendL2ForEveryCmd_;
   int32_t cfgL2RefreshDepth_;
   bool logDebug_;
 
+  /**
+   * Store order book and add it to dense index
+   */
+  void PutOrderBook(int32_t symbolId, std::unique_ptr<orderbook::IOrderBook> orderBook);
+
+  void MarkChanged(int32_t symbolId) {
+    if (trackChanges_) {
+      changedSymbols_.insert(symbolId);
+    }
+  }
+
   /**
    * Check if symbol belongs to this shard
    */
@@ -22,6 +22,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include "../collections/DenseIntIndex.h"
 #include "../collections/objpool/ObjectsPool.h"
 #include "../common/BalanceAdjustmentType.h"
 #include "../common/WriteBytesMarshallable.h"
@@ -32,6 +33,7 @@
 #include "SharedPool.h"
 #include "SymbolSpecificationProvider.h"
 #include "UserProfileService.h"
+#include "journaling/IIncrementalSnapshotState.h"
 
 namespace exchange::core {
 
@@ -88,7 +90,9 @@ struct LastPriceCacheRecord {
  * RiskEngine - stateful risk engine
  * Handles risk management (R1 - Pre-hold, R2 - Release)
  */
-class RiskEngine : public common::WriteBytesMarshallable, public common::StateHash {
+class RiskEngine : public common::WriteBytesMarshallable,
+                   public common::StateHash,
+                   public journaling::IIncrementalSnapshotState {
 public:
   RiskEngine(int32_t shardId,
              int64_t numShards,
@@ -111,6 +115,18 @@ public:
    */
   void PostProcessCommand(int64_t seq, common::cmd::OrderCommand* cmd);
 
+  /**
+   * Prefetch dense uid index slot of a command ahead of current one
+   * (R1 lookahead, first stage)
+   */
+  void PrefetchCommandIndex(const common::cmd::OrderCommand* cmd) const;
+
+  /**
+   * Prefetch user profile of a command ahead of current one
+   * (R1 lookahead, second stage)
+   */
+  void PrefetchCommand(const common::cmd::OrderCommand* cmd) const;
+
   /**
    * Check if UID belongs to this shard
    */
@@ -184,12 +200,24 @@ public:
    */
   void Reset();
 
+  /**
+   * Fill position records pool up to its capacity (startup warm-up)
+   * @return number of objects allocated
+   */
+  int64_t PreallocatePools();
+
   // StateHash interface
   int32_t GetStateHash() const override;
 
   // WriteBytesMarshallable interface
   void WriteMarshallable(common::BytesOut& bytes) const override;
 
+  // IIncrementalSnapshotState interface (entries: uid -> UserProfile)
+  void WriteGlobalState(common::BytesOut& bytes) const override;
+  void WriteEntries(journaling::SnapshotEntriesWriter& writer, bool changedOnly) const override;
+  bool ChangesTracked() const override;
+  void ClearChanges() override;
+
 private:
   int32_t shardId_;
   int64_t shardMask_;  // numShards - 1 (must be power of 2)
@@ -210,6 +238,14 @@ private:
 
   // symbol -> LastPriceCacheRecord
   ankerl::unordered_dense::map<int32_t, LastPriceCacheRecord> lastPriceCache_;
+  // symbol -> record in lastPriceCache_ (direct index for dense ids)
+  collections::DenseIntIndex<LastPriceCacheRecord> lastPriceCacheIndex_;
+  // lastPriceCache_ values storage the index points into (rebuilt when it moves)
+  const void* lastPriceCacheIndexedValues_ = nullptr;
+  size_t lastPriceCacheIndexedCapacity_ = 0;
+
+  // quote currency -> last price changes counter (invalidates free margin cache)
+  ankerl::unordered_dense::map<int32_t, int64_t> marginPriceEpochs_;
 
   // currency -> amount
   ankerl::unordered_dense::map<int32_t, int64_t> fees_;
@@ -310,6 +346,37 @@ private:
                            const common::CoreSymbolSpecification* spec,
                            common::SymbolPositionRecord* position);
 
+  /**
+   * Get free margin of all user positions in currency (cached)
+   */
+  int64_t GetFreeMargin(common::UserProfile* userProfile, int32_t currency);
+
+  /**
+   * Calculate free margin of all user positions in currency
+   */
+  int64_t CalculateFreeMargin(const common::UserProfile* userProfile, int32_t currency) const;
+
+  /**
+   * Find last price record for symbol (nullptr if no price received yet)
+   */
+  const LastPriceCacheRecord* FindLastPriceCacheRecord(int32_t symbol) const;
+
+  /**
+   * Get last price record for symbol, adding empty record if not found
+   */
+  LastPriceCacheRecord& GetOrAddLastPriceCacheRecord(int32_t symbol);
+
+  /**
+   * Index all records of lastPriceCache_ (after its values storage moved)
+   */
+  void RebuildLastPriceCacheIndex();
+
+  /**
+   * Serialize state, with or without user profiles (incremental snapshots
+   * store them as separate entries)
+   */
+  void WriteState(common::BytesOut& bytes, bool withUserProfiles) const;
+
   /**
    * Remove position record
    */
@@ -36,6 +36,24 @@ public:
    * @return true to forcibly publish sequence (batches)
    */
   virtual bool OnEvent(int64_t seq, common::cmd::OrderCommand* event) = 0;
+
+  /**
+   * Prefetch index entries for a command that will be handled later (first
+   * lookahead stage, computed addresses only, no loads).
+   * Must not modify state. Default - no-op.
+   *
+   * @param event - published event 2 x distance ahead of current sequence
+   */
+  virtual void PrefetchIndex(const common::cmd::OrderCommand* event) {}
+
+  /**
+   * Prefetch data for a command that will be handled later (second lookahead
+   * stage, index entries are expected in cache).
+   * Must not modify state. Default - no-op.
+   *
+   * @param event - published event distance ahead of current sequence
+   */
+  virtual void Prefetch(const common::cmd::OrderCommand* event) {}
 };
 
 }  // namespace exchange::core::processors
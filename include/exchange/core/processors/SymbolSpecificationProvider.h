@@ -18,6 +18,7 @@
 
 #include <ankerl/unordered_dense.h>
 #include <cstdint>
+#include "../collections/DenseIntIndex.h"
 #include "../common/CoreSymbolSpecification.h"
 #include "../common/StateHash.h"
 #include "../common/WriteBytesMarshallable.h"
@@ -31,12 +32,16 @@ namespace exchange::core::processors {
 class SymbolSpecificationProvider : public common::StateHash,
                                     public common::WriteBytesMarshallable {
 public:
-  SymbolSpecificationProvider();
+  /**
+   * @param denseSymbolIdLimit - symbol ids below limit are looked up by
+   * direct index (0 - hash map only)
+   */
+  explicit SymbolSpecificationProvider(int32_t denseSymbolIdLimit = 0);
 
   /**
    * Constructor from BytesIn (deserialization)
    */
-  explicit SymbolSpecificationProvider(common::BytesIn* bytes);
+  explicit SymbolSpecificationProvider(common::BytesIn* bytes, int32_t denseSymbolIdLimit = 0);
 
   /**
    * Add a new symbol specification
@@ -73,6 +78,9 @@ private:
   // symbol ID -> CoreSymbolSpecification
   // Using ankerl::unordered_dense for better performance
   ankerl::unordered_dense::map<int32_t, const common::CoreSymbolSpecification*> symbolSpecs_;
+
+  // symbol ID -> CoreSymbolSpecification direct index for dense ids
+  collections::DenseIntIndex<const common::CoreSymbolSpecification> symbolSpecsIndex_;
 };
 
 }  // namespace exchange::core::processors
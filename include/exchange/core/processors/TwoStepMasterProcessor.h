@@ -61,6 +61,11 @@ public:
    */
   void SetSlaveProcessor(TwoStepSlaveProcessor<WaitStrategyT>* slaveProcessor);
 
+  /**
+   * Set lookahead distance for SimpleEventHandler::Prefetch (0 - disabled)
+   */
+  void SetPrefetchDistance(int32_t prefetchDistance);
+
 private:
   static constexpr int32_t IDLE = 0;
   static constexpr int32_t HALTED = 1;
@@ -77,6 +82,7 @@ private:
   std::string name_;
   disruptor::Sequence sequence_;  // Changed from pointer to value (matches Java)
   TwoStepSlaveProcessor<WaitStrategyT>* slaveProcessor_;
+  int32_t prefetchDistance_ = 0;
 
   void ProcessEvents();
   void PublishProgressAndTriggerSlaveProcessor(int64_t nextSequence);
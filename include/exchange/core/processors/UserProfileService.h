@@ -18,11 +18,13 @@
 
 #include <ankerl/unordered_dense.h>
 #include <cstdint>
+#include <memory>
 #include <vector>
 #include "../common/StateHash.h"
 #include "../common/UserProfile.h"
 #include "../common/WriteBytesMarshallable.h"
 #include "../common/cmd/CommandResultCode.h"
+#include "journaling/IIncrementalSnapshotState.h"
 
 namespace exchange::core {
 namespace common {
@@ -31,13 +33,33 @@ class BytesIn;
 
 namespace processors {
 
+class BulkAccountsFile;
+
 /**
  * UserProfileService - stateful user profile service
  * Manages user profiles (uid -> UserProfile)
+ *
+ * Profiles are allocated from a chunked arena (contiguous blocks of
+ * PROFILES_CHUNK_SIZE profiles) instead of individual heap objects, slots of
+ * removed profiles are reused.
+ *
+ * Small uids (below ~2x number of users) are also indexed by a dense array, so
+ * lookups of sequentially assigned uids are a single load instead of hashing
+ * and probing. Other uids are looked up in the map only.
+ *
+ * If changes tracking is enabled (incremental snapshots), every profile
+ * accessed for modification is marked as changed (first access only).
  */
 class UserProfileService : public common::StateHash, public common::WriteBytesMarshallable {
 public:
-  // uid -> UserProfile
+  static constexpr size_t PROFILES_CHUNK_SIZE = 4096;
+  // dense index covers uids below max(DENSE_INDEX_MIN_SIZE, 2 * users number)
+  static constexpr size_t DENSE_INDEX_MIN_SIZE = 4096;
+  // funding transaction id of initial deposit is BATCH_ADD_FUNDING_BASE + currency
+  static constexpr int64_t BATCH_ADD_FUNDING_BASE = 1'000'000'000;
+
+  // uid -> UserProfile (points into arena), modified by the service only
+  // (mirrored by the dense index)
   ankerl::unordered_dense::map<int64_t, common::UserProfile*> userProfiles;
 
   UserProfileService();
@@ -54,6 +76,18 @@ public:
    */
   common::UserProfile* GetUserProfile(int64_t uid);
 
+  /**
+   * Prefetch dense index slot of uid into cache (lookahead, first stage),
+   * no-op for uids not covered by dense index
+   */
+  void PrefetchUserProfileSlot(int64_t uid) const;
+
+  /**
+   * Prefetch user profile into cache (lookahead, second stage - slot is
+   * expected in cache), no-op if not found or not covered by dense index
+   */
+  void PrefetchUserProfile(int64_t uid) const;
+
   /**
    * Get user profile or add suspended user if not exists
    */
@@ -70,6 +104,17 @@ public:
    */
   common::cmd::CommandResultCode AddUser(int64_t uid);
 
+  /**
+   * Add users of this shard (uid & shardMask == shardId) with their accounts
+   * from bulk accounts file, same state as if added by BatchAddAccountsCommand
+   * @param adjustments - currency -> adjustments total, credited amounts are subtracted
+   * @return number of rows loaded
+   */
+  size_t LoadAccounts(const BulkAccountsFile& file,
+                      int32_t shardId,
+                      int64_t shardMask,
+                      ankerl::unordered_dense::map<int32_t, int64_t>& adjustments);
+
   /**
    * Suspend user
    */
@@ -90,11 +135,72 @@ public:
    */
   void Reset();
 
+  /**
+   * Track changed profiles (incremental snapshots), disabled by default
+   */
+  void EnableChangesTracking();
+
+  /**
+   * Changes are tracked and were not lost (by Reset) since last ClearChanges
+   */
+  bool ChangesTracked() const {
+    return trackChanges_ && !changesLost_;
+  }
+
+  void ClearChanges();
+
+  /**
+   * Write profiles as incremental snapshot entries (uid -> UserProfile)
+   * @param changedOnly - changed and removed profiles only
+   */
+  void WriteEntries(journaling::SnapshotEntriesWriter& writer, bool changedOnly) const;
+
+  /**
+   * Add profile read from incremental snapshot entry
+   */
+  void RestoreUserProfile(int64_t uid, common::BytesIn* bytes);
+
   // StateHash interface
   int32_t GetStateHash() const override;
 
   // WriteBytesMarshallable interface
   void WriteMarshallable(common::BytesOut& bytes) const override;
+
+private:
+  common::UserProfile* AllocateProfile();
+  void ReleaseProfile(common::UserProfile* profile);
+
+  common::UserProfile* FindProfile(int64_t uid) const {
+    if (static_cast<uint64_t>(uid) < denseProfiles_.size()) {
+      return denseProfiles_[static_cast<size_t>(uid)];
+    }
+    const auto it = userProfiles.find(uid);
+    return it != userProfiles.end() ? it->second : nullptr;
+  }
+
+  // add/remove profile in userProfiles and dense index
+  void InsertProfile(int64_t uid, common::UserProfile* profile);
+  void EraseProfile(int64_t uid);
+  void GrowDenseIndex(size_t size);
+
+  void MarkChanged(common::UserProfile* profile) {
+    if (trackChanges_ && !profile->snapshotChanged) {
+      profile->snapshotChanged = true;
+      changedUids_.push_back(profile->uid);
+    }
+  }
+
+  std::vector<std::unique_ptr<common::UserProfile[]>> profileChunks_;
+  size_t chunkPos_ = PROFILES_CHUNK_SIZE;
+  std::vector<common::UserProfile*> freeProfiles_;
+
+  // uid -> profile (nullptr if none) for uids below size, same content as userProfiles
+  std::vector<common::UserProfile*> denseProfiles_;
+
+  // Changes tracking: uids of changed (or removed) profiles, may repeat
+  bool trackChanges_ = false;
+  bool changesLost_ = false;
+  std::vector<int64_t> changedUids_;
 };
 
 }  // namespace processors
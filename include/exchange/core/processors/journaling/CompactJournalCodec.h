@@ -0,0 +1,69 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "../../common/cmd/OrderCommand.h"
+#include "JournalCommand.h"
+
+namespace exchange::core::processors::journaling {
+
+/**
+ * CompactJournalCodec - journal record format v2
+ *
+ * Same fields as v1 record, but seq, timestamp, eventsGroup and orderId are
+ * encoded as difference from previous record of the block, and all integer
+ * fields (except raw binary data words) are written as zig-zag varints.
+ * Typical PLACE_ORDER record takes ~20 bytes instead of 78.
+ *
+ * v2 records are written in blocks (see RESERVED_COMPACT marker), delta state
+ * is reset at the beginning of each block, so blocks are decoded independently.
+ */
+class CompactJournalCodec {
+public:
+  // Upper bound of encoded record size
+  static constexpr size_t MAX_RECORD_SIZE = 128;
+
+  /**
+   * Values of previous record in block
+   */
+  struct Deltas {
+    int64_t seq = 0;
+    int64_t timestamp = 0;
+    int64_t eventsGroup = 0;
+    int64_t orderId = 0;
+  };
+
+  /**
+   * Encode command into out (at least MAX_RECORD_SIZE bytes)
+   * @return encoded record size
+   */
+  static size_t EncodeCommand(const common::cmd::OrderCommand* cmd,
+                              int64_t seq,
+                              Deltas& deltas,
+                              char* out);
+
+  /**
+   * Decode single record starting at p (advanced past the record)
+   * @return false for persist state markers (not replayed)
+   */
+  static bool DecodeCommand(const char*& p, const char* end, Deltas& deltas, JournalCommand& cmd);
+};
+
+}  // namespace exchange::core::processors::journaling
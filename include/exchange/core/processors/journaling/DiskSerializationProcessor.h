@@ -16,19 +16,27 @@
 
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <exception>
 #include <fstream>
-#include <istream>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 #include "../../common/cmd/OrderCommand.h"
 #include "../../common/config/ExchangeConfiguration.h"
 #include "../../common/config/InitialStateConfiguration.h"
+#include "../../utils/IoUring.h"
+#include "CompactJournalCodec.h"
 #include "DiskSerializationProcessorConfiguration.h"
 #include "ISerializationProcessor.h"
+#include "JournalFile.h"
 
 // Forward declarations
 class ExchangeApi;
@@ -49,6 +57,8 @@ public:
   DiskSerializationProcessor(const common::config::ExchangeConfiguration* exchangeConfig,
                              const DiskSerializationProcessorConfiguration* diskConfig);
 
+  ~DiskSerializationProcessor() override;
+
   bool StoreData(int64_t snapshotId,
                  int64_t seq,
                  int64_t timestampNs,
@@ -56,8 +66,37 @@ public:
                  int32_t instanceId,
                  const common::WriteBytesMarshallable* obj) override;
 
+  bool IncrementalSnapshotsEnabled() const override {
+    return incrementalSnapshots_;
+  }
+
+  bool StoreIncrementalData(int64_t snapshotId,
+                            int64_t seq,
+                            int64_t timestampNs,
+                            SerializedModuleType type,
+                            int32_t instanceId,
+                            IIncrementalSnapshotState* state) override;
+
+  bool LoadIncrementalData(int64_t snapshotId,
+                         SerializedModuleType type,
+                           int32_t instanceId,
+                           std::function<void(common::BytesIn*)> globalFunc,
+                           std::function<void(int64_t, common::BytesIn*)> entryFunc) override;
+
+  void AwaitSnapshotsWritten() override;
+
+  /**
+   * Journal files are written with O_DIRECT by io_uring (IO_URING_DIRECT
+   * journal I/O is configured and available)
+   */
+  bool IsDirectJournalIo() const {
+    return ioUring_ != nullptr;
+  }
+
   void WriteToJournal(common::cmd::OrderCommand* cmd, int64_t dSeq, bool eob) override;
 
+  void AwaitJournalWrite(const common::cmd::OrderCommand* cmd, int64_t dSeq) override;
+
   void EnableJournaling(int64_t afterSeq, IExchangeApi* api) override;
 
   std::map<int64_t, SnapshotDescriptor*> FindAllSnapshotPoints() override;
@@ -76,6 +115,23 @@ public:
   bool
   CheckSnapshotExists(int64_t snapshotId, SerializedModuleType type, int32_t instanceId) override;
 
+  /**
+   * Journal position to start reading from
+   */
+  struct JournalPosition {
+    int32_t fileIndex = 1;
+    int64_t offset = 0;       // block or command start within the file
+    int64_t seq = 0;          // first command sequence at offset (0 - unknown)
+    int64_t timestampNs = 0;  // its timestamp
+  };
+
+  /**
+   * Find latest indexed position of journal based on snapshotId with all
+   * commands seq > afterSeq after it (O(log n) per journal file).
+   * Falls back to the start of the first file if there is no index.
+   */
+  JournalPosition SeekJournal(int64_t snapshotId, int64_t afterSeq);
+
 private:
   std::string exchangeId_;
   std::string folder_;
@@ -84,40 +140,194 @@ private:
   int32_t journalBufferFlushTrigger_;
   int64_t journalFileMaxSize_;
   int32_t journalBatchCompressThreshold_;
+  const bool compactJournal_;  // write v2 journal records
+  const int32_t journalIndexInterval_;
+  const bool journalChecksums_;
+
+  const DiskSerializationProcessorConfiguration::DurabilityMode durabilityMode_;
+  const int64_t groupCommitIntervalNs_;
+  const int64_t groupCommitMaxBytes_;
+
+  const int32_t replayDecompressThreads_;
+  const int32_t replayReadAheadBlocks_;
+  const int32_t replayBatchSize_;
+  const int32_t snapshotChunkSize_;
+  const DiskSerializationProcessorConfiguration::SnapshotMode snapshotMode_;
+
+  // Threads waiting for forked snapshot writers (FORK snapshot mode)
+  // and compacting incremental snapshots
+  std::mutex snapshotWritersMutex_;
+  std::vector<std::thread> snapshotWriters_;
+
+  // FORK mode: all engine instances storing a snapshot on the same persist
+  // command share one forked writer - last arriving instance forks (page
+  // tables are copied once per command), child writes files of all of them
+  struct ForkedSnapshot {
+    std::vector<std::pair<std::string, std::function<void(const std::string&)>>> files;
+    bool forked = false;
+    int pid = -1;
+    // writer reaped, exit status 0 (all files written)
+    bool exited = false;
+    bool succeeded = false;
+    // instances done with the entry
+    int32_t released = 0;
+  };
+  std::mutex forkedSnapshotsMutex_;
+  std::condition_variable forkedSnapshotsCondition_;
+  std::map<std::pair<int64_t, SerializedModuleType>, ForkedSnapshot> forkedSnapshots_;
+
+  const bool incrementalSnapshots_;
+  const int32_t incrementalSnapshotsCompaction_;
+
+  /**
+   * Last stored snapshot of module instance (base for next incremental one)
+   */
+  struct SnapshotChain {
+    int64_t lastSnapshotId = 0;
+    int32_t length = 0;  // incremental snapshots since last full one
+  };
+  std::mutex snapshotChainsMutex_;
+  std::map<std::pair<SerializedModuleType, int32_t>, SnapshotChain> snapshotChains_;
 
   std::map<int64_t, SnapshotDescriptor*> snapshotsIndex_;
+  // Stored module instances per snapshot (guarded by journalMutex_),
+  // snapshot is complete when all matching and risk engines are stored
+  std::map<int64_t, int32_t> storedSnapshotModules_;
+  const int32_t matchingEnginesNum_;
+  const int32_t riskEnginesNum_;
   SnapshotDescriptor* lastSnapshotDescriptor_;
   JournalDescriptor* lastJournalDescriptor_;
 
   int64_t baseSnapshotId_;
   int64_t enableJournalAfterSeq_;
 
+  /**
+   * Journal buffer with commands to be written as one block
+   */
+  struct JournalWriteBatch {
+    std::vector<char> buffer;
+    size_t length = 0;
+    int64_t firstTimestampNs = 0;
+    int64_t firstSeq = 0;
+    int64_t lastTimestampNs = 0;
+    int64_t lastSeq = -1;   // journal sequence of last command
+    int64_t lastDSeq = -1;  // disruptor sequence of last command
+    CompactJournalCodec::Deltas deltas;  // v2 records: previous record values
+    bool forceStartNextFile = false;
+    // snapshot taken by last command (next file belongs to it), or nullptr
+    SnapshotDescriptor* nextSnapshot = nullptr;
+    // binary command payload record, batch holds nothing else
+    std::vector<char> payloadRecord;
+  };
+
+  // Journal write batches (used round-robin), batches are filled by
+  // journaling handler thread only.
+  // Synchronous mode: one batch, written by journaling handler thread.
+  // Asynchronous mode: batches are written by writer thread in submission order.
+  const bool asyncWriter_;
+  std::vector<JournalWriteBatch> writeBatches_;
+  int64_t filledBatches_;   // submitted batches counter (journaling handler thread)
+  int64_t journaledDSeq_;   // disruptor sequence of last journaled command (same thread)
+
+  // Direct journal I/O: writes of journal files in flight (nullptr - STREAM),
+  // declared before the files, as they wait for their writes when destroyed
+  std::unique_ptr<utils::IoUring> ioUring_;
+
+  // Writer thread handover (asynchronous mode)
+  std::mutex writerMutex_;
+  std::condition_variable writerCondition_;
+  int64_t submittedBatches_;  // guarded by writerMutex_
+  bool writerStopping_;       // guarded by writerMutex_
+  std::atomic<int64_t> writtenBatches_;
+  // disruptor sequence of last written command, synced if required by durability mode
+  std::atomic<int64_t> durableDSeq_;
+  std::atomic<bool> writerFailed_;
+  std::exception_ptr writerError_;
+  std::thread writerThread_;
+
+  // Journal files state (owned by thread writing batches)
+  SnapshotDescriptor* journalSnapshotDescriptor_;  // snapshot current journal belongs to
   int32_t filesCounter_;
   int64_t writtenBytes_;
   int64_t lastWrittenSeq_;  // Track last written sequence number for seqLast
-
-  // Journal writing buffers
-  std::vector<char> journalWriteBuffer_;
   std::vector<char> lz4WriteBuffer_;
-  size_t journalWriteBufferPos_;
+  std::unique_ptr<JournalFile> journalFile_;
+  int64_t unsyncedBytes_;
+  std::unique_ptr<std::ofstream> journalIndexFile_;  // nullptr if not written
+  int64_t lastIndexedBytes_;  // journal file offset of last index entry
+  // Last file of previous snapshot journal: commands are appended to it as well
+  // until new snapshot is completely stored (snapshot writers can still be
+  // running after journal is switched to it), recovery from previous snapshot
+  // does not lose commands journaled in between
+  std::unique_ptr<JournalFile> retainedJournalFile_;
+  int64_t retainedUntilSnapshotId_;
 
-  // File handles for journal writing
-  std::unique_ptr<std::fstream> journalFile_;
+  // Guards snapshot and journal descriptors
   std::mutex journalMutex_;
 
   // Internal methods
+  void WriteSnapshotFile(const std::string& path, const common::WriteBytesMarshallable* obj);
+  void RegisterStoredSnapshot(int64_t snapshotId,
+                              int64_t seq,
+                              int64_t timestampNs,
+                              SerializedModuleType type,
+                              int32_t instanceId,
+                              const std::string& path);
   std::string GetSnapshotPath(int64_t snapshotId, SerializedModuleType type, int32_t instanceId);
+  // Returns writer pid (shared by engine instances of the type), or -1 if fork failed
+  int ForkSnapshotWriter(int64_t snapshotId,
+                         SerializedModuleType type,
+                         const std::string& path,
+                         std::function<void(const std::string&)> writeFile);
+  // Waits for writer process exit (single waitpid), records its status
+  void ReapSnapshotWriter(std::pair<int64_t, SerializedModuleType> key, int pid);
+  // Waits for status of the forked writer, true if all its files are written
+  bool AwaitForkedSnapshot(int64_t snapshotId, SerializedModuleType type);
+
+  // Incremental snapshots chain helpers
+  int64_t GetIncrementalSnapshotBase(SerializedModuleType type,
+                                     int32_t instanceId,
+                                     const IIncrementalSnapshotState* state);
+  bool AppendToSnapshotChain(SerializedModuleType type,
+                             int32_t instanceId,
+                             int64_t snapshotId,
+                             int64_t baseSnapshotId);
+  void ResetSnapshotChain(SerializedModuleType type, int32_t instanceId);
+  void CompactSnapshotChain(int64_t snapshotId,
+                            SerializedModuleType type,
+                            int32_t instanceId,
+                            const std::string& path);
   std::string GetJournalPath(int64_t snapshotId, int32_t fileIndex);
+  std::string GetJournalIndexPath(int64_t snapshotId, int32_t fileIndex);
 
   // Journal writing helpers
-  void FlushBufferSync(bool forceStartNextFile, int64_t timestampNs);
+  JournalWriteBatch& CurrentBatch() {
+    return writeBatches_[filledBatches_ % static_cast<int64_t>(writeBatches_.size())];
+  }
+  void SubmitBatch(bool forceStartNextFile);
+  void WritePayloadToJournal(const common::cmd::OrderCommand* cmd, int64_t dSeq);
+  void AwaitBatchesWritten(int64_t batches);
+  void AwaitDurable(int64_t dSeq);
+  void WriterThreadLoop();
+  void DirectWriterThreadLoop();
+  void WriteBatch(JournalWriteBatch& batch);
+  void WriteJournalData(const char* data, size_t length);
+  void FlushJournalData();
+  void RetainJournalFile();
+  void ReleaseRetainedJournalFile();
+  bool IsSnapshotStored(int64_t snapshotId);
+  void SyncJournalFile();
   void StartNewFile(int64_t timestampNs);
   void RegisterNextJournal(int64_t seq, int64_t timestampNs);
   void RegisterNextSnapshot(int64_t snapshotId, int64_t seq, int64_t timestampNs);
 
-  // Journal replay helpers
-  void
-  ReadCommands(std::istream& is, IExchangeApi* api, int64_t& lastSeq, bool insideCompressedBlock);
+  // Journal replay: commands with seqFrom < seq <= seqTo, returns last replayed seq.
+  // recover - truncate damaged tail of the last journal file (no writer running)
+  int64_t ReplayJournal(int64_t snapshotId,
+                        int64_t seqFrom,
+                        int64_t seqTo,
+                        IExchangeApi* api,
+                        bool recover = false);
 
   // Override LoadData from base class
   void LoadData(int64_t snapshotId,
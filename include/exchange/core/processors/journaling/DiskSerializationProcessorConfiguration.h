@@ -29,12 +29,108 @@ class DiskSerializationProcessorConfiguration {
 public:
   static constexpr const char* DEFAULT_FOLDER = "./dumps";
 
+  /**
+   * When journaled command is considered durable (results are released)
+   */
+  enum class DurabilityMode {
+    NONE,             // written into OS page cache
+    SYNC_EACH_BATCH,  // fdatasync after each written journal batch
+    GROUP_COMMIT      // fdatasync once per groupCommitIntervalNs or groupCommitMaxBytes
+  };
+
+  /**
+   * Journal record format
+   */
+  enum class JournalFormat {
+    V1,  // fixed-size records, only batches above compress threshold are LZ4 blocks
+    V2   // delta/varint encoded records in (optionally LZ4 compressed) blocks
+  };
+
+  /**
+   * How journal files are written
+   */
+  enum class JournalIo {
+    STREAM,          // buffered writes through OS page cache
+    IO_URING_DIRECT  // O_DIRECT writes submitted to io_uring (Linux), 4 KB aligned
+  };
+
+  /**
+   * How engine state is serialized on PERSIST_STATE_* commands
+   */
+  enum class SnapshotMode {
+    INLINE,  // serialized by processing thread, pipeline stalls until file is written
+    FORK     // forked child process serializes copy-on-write image of the state
+  };
+
   std::string storageFolder;
   int32_t journalBufferSize;  // Buffer size for journal writing
   int32_t journalBufferFlushTrigger;
   int64_t journalFileMaxSize;
   int32_t journalBatchCompressThreshold;
 
+  // Format of written journal files, both formats are replayed. V1 files are
+  // readable by earlier releases, V2 (about 3.5x smaller) only by this one.
+  JournalFormat journalFormat = JournalFormat::V1;
+
+  // Every journal batch is written as a block with CRC32C of its header and
+  // data. Damaged tail of the last journal file (torn write) is detected on
+  // replay and truncated by recovery. Files without checksums are replayed.
+  // Checksummed blocks (also of V1 records) are not readable by earlier
+  // releases.
+  bool journalChecksums = false;
+
+  // Sparse sequence -> offset index written next to every journal file
+  // (.eci, see JournalIndex): one entry per block starting at least this many
+  // bytes after previous entry. Step replay seeks with it. 0 - no index.
+  int32_t journalIndexInterval = 64 * 1024;
+
+  // Asynchronous journal writer: journaling handler only copies commands into
+  // one of journalWriteBuffersNum buffers, filled buffers are compressed and
+  // written into (preallocated) journal files by a background writer thread.
+  // Results are released after their commands are written.
+  bool asyncJournalWriter = false;
+  int32_t journalWriteBuffersNum = 2;
+
+  // Journal durability, GROUP_COMMIT requires (and enables) asynchronous writer
+  DurabilityMode durabilityMode = DurabilityMode::NONE;
+  int64_t groupCommitIntervalNs = 1'000'000;
+  int64_t groupCommitMaxBytes = 1024 * 1024;
+
+  // Journal file I/O, IO_URING_DIRECT requires (and enables) asynchronous writer.
+  // Writer thread copies all submitted batches into aligned staging buffers,
+  // pads them to 4 KB boundary (padding record, overwritten by the next write)
+  // and submits them to io_uring without waiting; results are released once
+  // the write is completed (SYNC_EACH_BATCH: written with RWF_DSYNC,
+  // GROUP_COMMIT: once synced).
+  // Falls back to STREAM where io_uring or O_DIRECT is not available.
+  JournalIo journalIo = JournalIo::STREAM;
+
+  // Journal replay pipeline: LZ4 decompression threads, compressed blocks
+  // decompressed ahead of decoder, commands per ring buffer batch publish
+  int32_t replayDecompressThreads = 2;
+  int32_t replayReadAheadBlocks = 32;
+  int32_t replayBatchSize = 256;
+
+  // Snapshots are serialized, LZ4 compressed and written in chunks of this
+  // size (peak memory per snapshot writer/reader is about 2 chunks)
+  int32_t snapshotChunkSize = 4 * 1024 * 1024;
+
+  // FORK mode: processing thread is stalled only by fork() (page tables copy),
+  // file is written in background and becomes visible once complete. Engine
+  // instances processing the same persist command share one fork, so they
+  // wait for each other (matching engines, then risk engines).
+  // Pages modified while child is running are duplicated (up to whole state).
+  // Falls back to INLINE where fork() is not available.
+  SnapshotMode snapshotMode = SnapshotMode::INLINE;
+
+  // Incremental snapshots: engines track changed user profiles and order books,
+  // snapshot file contains only entries changed since previous snapshot and
+  // refers to it as a base (chain ending with a full snapshot, merged on load).
+  // Every incrementalSnapshotsCompaction-th incremental snapshot is merged
+  // with its chain into a full snapshot in background.
+  bool incrementalSnapshots = false;
+  int32_t incrementalSnapshotsCompaction = 8;
+
   explicit DiskSerializationProcessorConfiguration(
     const std::string& storageFolder = DEFAULT_FOLDER,
     int32_t journalBufferSize = 256 * 1024,  // 256 KB default
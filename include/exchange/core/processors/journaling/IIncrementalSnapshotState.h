@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "../../common/BytesOut.h"
+#include "../../common/VectorBytesOut.h"
+#include "../../common/WriteBytesMarshallable.h"
+
+namespace exchange::core::processors::journaling {
+
+/**
+ * SnapshotEntriesWriter - writes keyed entries of incremental snapshot
+ * (see KeyedSnapshotFile), every entry is length-prefixed so that entries of
+ * base snapshot can be skipped or replaced when snapshot chain is merged.
+ */
+class SnapshotEntriesWriter {
+public:
+  static constexpr int32_t REMOVED_ENTRY = -1;
+
+  explicit SnapshotEntriesWriter(common::BytesOut& bytes) : bytes_(bytes) {}
+
+  void Write(int64_t key, const common::WriteBytesMarshallable& entry) {
+    common::VectorBytesOut entryBytes(scratch_);
+    entry.WriteMarshallable(entryBytes);
+    const auto length = static_cast<int32_t>(entryBytes.WritePosition());
+    bytes_.WriteLong(key);
+    bytes_.WriteInt(length);
+    bytes_.Write(scratch_.data(), static_cast<size_t>(length));
+    entriesCount_++;
+  }
+
+  /**
+   * Entry existing in base snapshot was removed
+   */
+  void WriteRemoved(int64_t key) {
+    bytes_.WriteLong(key);
+    bytes_.WriteInt(REMOVED_ENTRY);
+    entriesCount_++;
+  }
+
+  int64_t EntriesCount() const {
+    return entriesCount_;
+  }
+
+private:
+  common::BytesOut& bytes_;
+  std::vector<uint8_t> scratch_;  // reused, only grows
+  int64_t entriesCount_ = 0;
+};
+
+/**
+ * IIncrementalSnapshotState - engine state stored as incremental snapshots
+ *
+ * State is split into global part (small, always written) and keyed entries
+ * (user profiles, order books). Engine tracks entries changed since last
+ * stored snapshot, incremental snapshot contains only those entries, so its
+ * size and write time depend on churn rather than on total state size.
+ * Called from engine thread only.
+ */
+class IIncrementalSnapshotState {
+public:
+  virtual ~IIncrementalSnapshotState() = default;
+
+  virtual void WriteGlobalState(common::BytesOut& bytes) const = 0;
+
+  /**
+   * @param changedOnly - write only entries changed since last ClearChanges()
+   * (including removed ones), otherwise all entries
+   */
+  virtual void WriteEntries(SnapshotEntriesWriter& writer, bool changedOnly) const = 0;
+
+  /**
+   * False if changes were not tracked since last ClearChanges() (e.g. state
+   * was reset), next snapshot must be a full one
+   */
+  virtual bool ChangesTracked() const = 0;
+
+  /**
+   * Called after snapshot is stored (new base for next incremental snapshot)
+   */
+  virtual void ClearChanges() = 0;
+};
+
+}  // namespace exchange::core::processors::journaling
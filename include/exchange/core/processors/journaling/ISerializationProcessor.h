@@ -23,6 +23,7 @@
 #include "../../common/WriteBytesMarshallable.h"
 #include "../../common/cmd/OrderCommand.h"
 #include "../../common/config/InitialStateConfiguration.h"
+#include "IIncrementalSnapshotState.h"
 
 // Forward declarations
 class ExchangeApi;
@@ -62,11 +63,58 @@ public:
                         int32_t instanceId,
                         std::function<void(common::BytesIn*)> initFunc) = 0;
 
+  /**
+   * Engines supporting incremental snapshots should store and load their
+   * state with StoreIncrementalData/LoadIncrementalData
+   */
+  virtual bool IncrementalSnapshotsEnabled() const {
+    return false;
+  }
+
+  /**
+   * Serialize state as full or incremental snapshot (only entries changed
+   * since previous snapshot of the same module), ClearChanges() is called
+   * once state is captured
+   */
+  virtual bool StoreIncrementalData(int64_t /*snapshotId*/,
+                                    int64_t /*seq*/,
+                                    int64_t /*timestampNs*/,
+                                    SerializedModuleType /*type*/,
+                                    int32_t /*instanceId*/,
+                                    IIncrementalSnapshotState* /*state*/) {
+    return false;
+  }
+
+  /**
+   * Deserialize state from snapshot chain: globalFunc is called first, then
+   * entryFunc for every entry
+   * @return false if snapshot is not incremental one (use LoadData)
+   */
+  virtual bool LoadIncrementalData(int64_t /*snapshotId*/,
+                                   SerializedModuleType /*type*/,
+                                   int32_t /*instanceId*/,
+                                   std::function<void(common::BytesIn*)> /*globalFunc*/,
+                                   std::function<void(int64_t, common::BytesIn*)> /*entryFunc*/) {
+    return false;
+  }
+
+  /**
+   * Wait until snapshots written in background (if any) are complete
+   */
+  virtual void AwaitSnapshotsWritten() {}
+
   /**
    * Write command into journal
    */
   virtual void WriteToJournal(common::cmd::OrderCommand* cmd, int64_t dSeq, bool eob) = 0;
 
+  /**
+   * Wait until command is written into journal file.
+   * Only asynchronous journal writers are waiting, for synchronous writers
+   * command is already written when journaling handler has processed it.
+   */
+  virtual void AwaitJournalWrite(const common::cmd::OrderCommand* /*cmd*/, int64_t /*dSeq*/) {}
+
   /**
    * Activate journal
    */
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "../../common/OrderAction.h"
+#include "../../common/OrderType.h"
+#include "../../common/cmd/OrderCommandType.h"
+
+namespace exchange::core::processors::journaling {
+
+/**
+ * JournalCommand - command decoded from journal, ready to be copied into
+ * ring buffer slot for replay.
+ *
+ * Fields have the same meaning as OrderCommand fields set by corresponding
+ * ExchangeApi replay method (e.g. BALANCE_ADJUSTMENT: orderId=transactionId,
+ * symbol=currency, price=amount, orderType=adjustment type).
+ */
+struct JournalCommand {
+  int64_t seq = 0;
+  common::cmd::OrderCommandType command = common::cmd::OrderCommandType::NOP;
+  int32_t serviceFlags = 0;
+  int64_t eventsGroup = 0;
+  int64_t timestamp = 0;
+
+  int64_t orderId = 0;
+  int32_t symbol = 0;
+  int64_t price = 0;
+  int64_t size = 0;
+  int64_t reserveBidPrice = 0;
+  common::OrderAction action = common::OrderAction::ASK;
+  common::OrderType orderType = common::OrderType::GTC;
+  int64_t uid = 0;
+  int32_t userCookie = 0;
+
+  // BINARY_DATA_COMMAND payload record: serialized command, points into
+  // reader memory (valid only while batch is consumed)
+  const uint8_t* payload = nullptr;
+  size_t payloadLength = 0;
+};
+
+}  // namespace exchange::core::processors::journaling
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "../../utils/IoUring.h"
+
+namespace exchange::core::processors::journaling {
+
+/**
+ * Journal file being written (used by thread writing journal batches)
+ */
+class JournalFile {
+public:
+  virtual ~JournalFile() = default;
+
+  /**
+   * Append data to the file (buffered)
+   */
+  virtual void Write(const char* data, size_t length) = 0;
+
+  /**
+   * Hand over written data to OS
+   */
+  virtual void Flush() = 0;
+
+  /**
+   * Flush and wait until data is on storage device
+   * @return false if sync failed
+   */
+  virtual bool Sync() = 0;
+
+  /**
+   * Flush and close the file (data is not synced)
+   */
+  virtual void Close() = 0;
+};
+
+/**
+ * Journal file written through OS page cache (std::fstream)
+ */
+class StreamJournalFile : public JournalFile {
+public:
+  /**
+   * @param syncable - second descriptor is opened for preallocation and fdatasync
+   * @param preallocateSize - disk blocks reserved without changing file size (0 - none)
+   */
+  StreamJournalFile(const std::string& path, bool syncable, int64_t preallocateSize);
+
+  ~StreamJournalFile() override;
+
+  void Write(const char* data, size_t length) override;
+  void Flush() override;
+  bool Sync() override;
+  void Close() override;
+
+private:
+  std::fstream file_;
+  int fd_ = -1;
+};
+
+/**
+ * Journal file written with O_DIRECT by io_uring (Linux).
+ *
+ * Data is copied into one of two BLOCK_SIZE aligned staging buffers, filled
+ * buffer is submitted without waiting for completion and the other one is
+ * filled meanwhile (ping-pong). Flush submits data padded up to block boundary
+ * with padding record - marker, record length, CRC32C of marker and length,
+ * zeros (skipped by JournalReader). Padding is not part of the data: partial
+ * tail block is moved to the other buffer and rewritten at the same offset by
+ * the next write (after previous write of the block is completed), so padding
+ * stays in the file on close only. Every flush writes the tail block again.
+ */
+class DirectJournalFile : public JournalFile {
+public:
+  static constexpr size_t BLOCK_SIZE = 4096;
+
+  /**
+   * @param bufferSize - staging buffer size (rounded up to BLOCK_SIZE, at least 2 blocks)
+   * @param dsync - writes are completed once data is on storage device (RWF_DSYNC)
+   * @param preallocateSize - disk blocks reserved without changing file size (0 - none)
+   * @throws std::runtime_error if file can not be opened with O_DIRECT
+   */
+  DirectJournalFile(const std::string& path,
+                    utils::IoUring* ioUring,
+                    size_t bufferSize,
+                    bool dsync,
+                    int64_t preallocateSize);
+
+  // waits for writes in flight
+  ~DirectJournalFile() override;
+
+  void Write(const char* data, size_t length) override;
+  void Flush() override;
+  bool Sync() override;
+  void Close() override;
+
+private:
+  struct StagingBuffer {
+    std::unique_ptr<char, decltype(&std::free)> data{nullptr, &std::free};
+    int64_t ticket = 0;  // last write of the buffer
+  };
+
+  void Append(const char* data, size_t length);
+  void Submit(size_t length);
+  void SwitchBuffer(size_t tail);
+  void AwaitWrites();
+
+  const std::string path_;
+  utils::IoUring* const ioUring_;
+  const size_t bufferSize_;
+  const bool dsync_;
+  int fd_ = -1;
+  StagingBuffer buffers_[2];
+  int current_ = 0;
+  size_t filled_ = 0;    // bytes in current buffer
+  int64_t offset_ = 0;   // file offset of current buffer
+  int64_t end_ = 0;      // file size (data and padding submitted)
+  bool flushed_ = true;  // no data appended since last flush
+};
+
+}  // namespace exchange::core::processors::journaling
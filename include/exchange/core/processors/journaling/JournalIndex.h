@@ -0,0 +1,58 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace exchange::core::processors::journaling {
+
+/**
+ * JournalIndex - sparse sequence -> file offset index of one journal file
+ *
+ * Sidecar file (.eci) of fixed-size entries in journal order:
+ * [sequence (8)] [timestamp (8)] [offset (8)]
+ * Every entry points to the start of a journal block or command, where
+ * decoding can begin, and holds its first command sequence and timestamp.
+ * First entry is always at offset 0, next ones are written at most every
+ * journalIndexInterval bytes of journal.
+ *
+ * Index is a hint: it is not synced, entry pointing beyond the end of
+ * journal file is not used, missing index means reading the file from start.
+ */
+class JournalIndex {
+public:
+  struct Entry {
+    int64_t seq = 0;
+    int64_t timestampNs = 0;
+    int64_t offset = 0;
+  };
+
+  static constexpr size_t ENTRY_SIZE = 3 * sizeof(int64_t);
+
+  static void Append(std::ostream& out, const Entry& entry);
+
+  /**
+   * Find last entry with sequence <= seq (binary search, O(log n) reads)
+   * @return false if index is missing or its first entry is after seq
+   */
+  static bool FindFloor(const std::string& path, int64_t seq, Entry& entry);
+};
+
+}  // namespace exchange::core::processors::journaling
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "JournalCommand.h"
+
+namespace exchange::core::processors::journaling {
+
+/**
+ * JournalReader - pipelined journal file reader for replay
+ *
+ * Journal file is memory-mapped and split into blocks: LZ4 compressed blocks
+ * and runs of uncompressed commands (v1 records), or blocks of v2 records
+ * (see CompactJournalCodec), both formats can be mixed in one file.
+ * Checksummed blocks (CRC32C of header and data) are validated while the file
+ * is split, reading stops before the first damaged block. Only checksummed
+ * blocks may follow a checksummed block.
+ * Compressed blocks are decompressed by worker threads, up to readAheadBlocks
+ * ahead of the decoder. The decoder (calling thread) converts commands into
+ * JournalCommand records in file order and hands them over to the consumer
+ * in batches of batchSize.
+ *
+ * Binary command payload record (serialized command of any size, optionally
+ * LZ4 compressed, always checksummed) is handed over as single
+ * BINARY_DATA_COMMAND in a batch of its own, payload points into reader memory.
+ *
+ * Persist state commands are skipped (they are journaled as markers only),
+ * as well as padding records (block alignment of direct journal I/O, see
+ * DirectJournalFile).
+ */
+class JournalReader {
+public:
+  using BatchConsumer = std::function<void(const JournalCommand* cmds, size_t count)>;
+
+  JournalReader(int32_t decompressThreads, int32_t readAheadBlocks, int32_t batchSize);
+  ~JournalReader();
+
+  JournalReader(const JournalReader&) = delete;
+  JournalReader& operator=(const JournalReader&) = delete;
+
+  /**
+   * Read commands with seqFrom < seq <= seqTo from journal file.
+   * Reading stops at the end of file, after seqTo, or at damaged tail:
+   * truncated command or block, or block with wrong checksum.
+   * @param lastSeq - sequence of last read command (updated)
+   * @param startOffset - block or command start to read from (see JournalIndex)
+   * @return number of file bytes processed
+   */
+  int64_t ReadFile(const std::string& path,
+                   int64_t seqFrom,
+                   int64_t seqTo,
+                   int64_t& lastSeq,
+                   const BatchConsumer& consumer,
+                   int64_t startOffset = 0);
+
+  /**
+   * File offset where damaged tail of last read file starts (everything
+   * before it was read), or -1 if no damage was found
+   */
+  int64_t DamagedAt() const {
+    return damagedAt_;
+  }
+
+  /**
+   * Size of uncompressed v1 command record (including 29 bytes header),
+   * or -1 for unknown command code
+   */
+  static int32_t CommandSize(int8_t cmdCode);
+
+  /**
+   * Decode single uncompressed v1 command record (CommandSize bytes)
+   * @return false for persist state markers (not replayed)
+   */
+  static bool DecodeCommand(const char* data, JournalCommand& cmd);
+
+private:
+  struct Block;
+
+  void DecompressLoop();
+  void Submit(Block* block);
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable tasksCondition_;
+  std::condition_variable doneCondition_;
+  std::deque<Block*> tasks_;
+  bool stopping_ = false;
+
+  const size_t readAheadBlocks_;
+  const size_t batchSize_;
+  int64_t damagedAt_ = -1;
+};
+
+}  // namespace exchange::core::processors::journaling
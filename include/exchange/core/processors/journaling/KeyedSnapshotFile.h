@@ -0,0 +1,86 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "IIncrementalSnapshotState.h"
+
+namespace exchange::core::processors::journaling {
+
+/**
+ * KeyedSnapshotFile - snapshot file format used for incremental snapshots
+ *
+ * LZ4 frame (see Lz4FrameBytesOut) containing:
+ * [magic (8)] [base snapshot id (8), FULL_SNAPSHOT if none]
+ * [global state length (4)] [global state]
+ * entries: [key (8)] [length (4), REMOVED_ENTRY for removed] [entry state]
+ * end mark: [0 (8)] [END_MARK (4)]
+ *
+ * Incremental snapshot contains entries changed since its base snapshot,
+ * chain of incremental snapshots always ends with a full one.
+ */
+class KeyedSnapshotFile {
+public:
+  static constexpr int64_t MAGIC = 0x5350414E5344454BLL;  // "KEDSNAPS"
+  static constexpr int64_t FULL_SNAPSHOT = -1;
+  static constexpr int32_t END_MARK = -2;
+
+  using PathResolver = std::function<std::string(int64_t snapshotId)>;
+  using GlobalStateConsumer = std::function<void(const std::vector<uint8_t>& state)>;
+  using EntryConsumer = std::function<void(int64_t key, const std::vector<uint8_t>& state)>;
+
+  /**
+   * Write full (baseSnapshotId is FULL_SNAPSHOT) or incremental snapshot
+   * @return number of written entries
+   */
+  static int64_t Write(const std::string& path,
+                       int32_t chunkSize,
+                       int64_t baseSnapshotId,
+                       const IIncrementalSnapshotState& state);
+
+  /**
+   * Check if file is a keyed snapshot (otherwise it is a plain one)
+   */
+  static bool IsKeyedSnapshot(const std::string& path);
+
+  /**
+   * Read snapshot chain ending with snapshotId, merged into full state:
+   * global state of the latest snapshot first, then latest version of every
+   * entry (removed entries are skipped).
+   * Full snapshot is streamed, only entries of incremental snapshots are
+   * kept in memory.
+   * @return number of files in the chain
+   */
+  static int32_t ReadChain(int64_t snapshotId,
+                           const PathResolver& pathResolver,
+                           int32_t chunkSize,
+                           const GlobalStateConsumer& globalConsumer,
+                           const EntryConsumer& entryConsumer);
+
+  /**
+   * Merge snapshot chain ending with snapshotId into full snapshot file
+   */
+  static void Compact(int64_t snapshotId,
+                      const PathResolver& pathResolver,
+                      int32_t chunkSize,
+                      const std::string& path);
+};
+
+}  // namespace exchange::core::processors::journaling
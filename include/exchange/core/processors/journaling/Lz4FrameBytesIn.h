@@ -0,0 +1,99 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../../common/BytesIn.h"
+
+struct LZ4F_dctx_s;
+
+namespace exchange::core::processors::journaling {
+
+/**
+ * Lz4FrameBytesIn - streaming snapshot reader
+ *
+ * Reads LZ4 frame written by Lz4FrameBytesOut chunk by chunk, decompressing
+ * on demand, so memory usage does not depend on the size of serialized state.
+ */
+class Lz4FrameBytesIn : public common::BytesIn {
+public:
+  /** LZ4 frame magic number (first 4 bytes of the file, little-endian) */
+  static constexpr uint32_t FRAME_MAGIC = 0x184D2204;
+
+  Lz4FrameBytesIn(const std::string& path, int32_t chunkSize);
+  ~Lz4FrameBytesIn() override;
+
+  Lz4FrameBytesIn(const Lz4FrameBytesIn&) = delete;
+  Lz4FrameBytesIn& operator=(const Lz4FrameBytesIn&) = delete;
+
+  int8_t ReadByte() override {
+    return ReadValue<int8_t>();
+  }
+
+  int32_t ReadInt() override {
+    return ReadValue<int32_t>();
+  }
+
+  int64_t ReadLong() override {
+    return ReadValue<int64_t>();
+  }
+
+  bool ReadBoolean() override {
+    return ReadValue<int8_t>() != 0;
+  }
+
+  /**
+   * Decompressed bytes available without reading further from the file
+   * (total size of the stream is not known in advance)
+   */
+  int64_t ReadRemaining() const override {
+    return static_cast<int64_t>(outLength_ - outPosition_);
+  }
+
+  void Read(void* buffer, size_t length) override;
+
+private:
+  template <typename T>
+  T ReadValue() {
+    T value;
+    if (outPosition_ + sizeof(T) <= outLength_) {
+      std::memcpy(&value, out_.data() + outPosition_, sizeof(T));
+      outPosition_ += sizeof(T);
+    } else {
+      Read(&value, sizeof(T));
+    }
+    return value;
+  }
+
+  void Decompress();
+
+  std::ifstream file_;
+  LZ4F_dctx_s* context_ = nullptr;
+  std::vector<char> in_;
+  std::vector<char> out_;
+  size_t inPosition_ = 0;
+  size_t inLength_ = 0;
+  size_t outPosition_ = 0;
+  size_t outLength_ = 0;
+  bool frameEnd_ = false;
+};
+
+}  // namespace exchange::core::processors::journaling
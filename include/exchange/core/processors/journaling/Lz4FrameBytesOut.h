@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../../common/BytesOut.h"
+
+struct LZ4F_cctx_s;
+
+namespace exchange::core::processors::journaling {
+
+/**
+ * Lz4FrameBytesOut - streaming snapshot writer
+ *
+ * Serialized bytes are collected into a fixed-size chunk, every full chunk is
+ * compressed as LZ4 frame block and written into the file straight away,
+ * so memory usage does not depend on the size of serialized state.
+ * Finish() must be called to complete the frame.
+ */
+class Lz4FrameBytesOut : public common::BytesOut {
+public:
+  Lz4FrameBytesOut(const std::string& path, int32_t chunkSize);
+  ~Lz4FrameBytesOut() override;
+
+  Lz4FrameBytesOut(const Lz4FrameBytesOut&) = delete;
+  Lz4FrameBytesOut& operator=(const Lz4FrameBytesOut&) = delete;
+
+  common::BytesOut& WriteByte(int8_t value) override {
+    return WriteValue(value);
+  }
+
+  common::BytesOut& WriteInt(int32_t value) override {
+    return WriteValue(value);
+  }
+
+  common::BytesOut& WriteLong(int64_t value) override {
+    return WriteValue(value);
+  }
+
+  common::BytesOut& WriteBoolean(bool value) override {
+    return WriteValue(static_cast<int8_t>(value ? 1 : 0));
+  }
+
+  common::BytesOut& Write(const void* buffer, size_t length) override;
+
+  int64_t WritePosition() const override {
+    return written_ + static_cast<int64_t>(chunkLength_);
+  }
+
+  /**
+   * Compress remaining bytes, write frame end mark and flush the file
+   * @return compressed file size
+   */
+  int64_t Finish();
+
+private:
+  template <typename T>
+  common::BytesOut& WriteValue(T value) {
+    if (chunkLength_ + sizeof(T) <= chunk_.size()) {
+      std::memcpy(chunk_.data() + chunkLength_, &value, sizeof(T));
+      chunkLength_ += sizeof(T);
+      return *this;
+    }
+    return Write(&value, sizeof(T));
+  }
+
+  void CompressChunk();
+  void WriteCompressed(size_t length);
+
+  std::ofstream file_;
+  LZ4F_cctx_s* context_ = nullptr;
+  std::vector<char> chunk_;
+  std::vector<char> compressed_;
+  size_t chunkLength_ = 0;
+  int64_t written_ = 0;
+  int64_t fileSize_ = 0;
+  bool finished_ = false;
+};
+
+}  // namespace exchange::core::processors::journaling
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace exchange::core::utils {
+
+/**
+ * CoroutineFramePool - pooled allocation of coroutine frames
+ *
+ * Frames are rounded up to size classes (64 bytes .. 4 KB), larger frames
+ * use operator new. Every thread keeps a small cache of free blocks per
+ * class; caches exchange blocks with a shared free list in batches, because
+ * frames are usually created by submitting thread and freed by executor
+ * thread. Free blocks are kept for reuse, memory is not returned to the
+ * system (pool retains its peak size).
+ */
+class CoroutineFramePool {
+public:
+  static constexpr size_t MIN_BLOCK_SIZE = 64;
+  static constexpr size_t MAX_BLOCK_SIZE = 4096;
+
+  static void* Allocate(size_t size);
+
+  /**
+   * @param size - same size as passed to Allocate
+   */
+  static void Deallocate(void* ptr, size_t size) noexcept;
+};
+
+}  // namespace exchange::core::utils
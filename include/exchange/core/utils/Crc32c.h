@@ -0,0 +1,44 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace exchange::core::utils {
+
+/**
+ * Crc32c - CRC-32C (Castagnoli) checksum of journal blocks
+ *
+ * - x86_64 with SSE4.2: crc32 instruction over 3 interleaved streams,
+ *   selected at runtime (fast enough to validate at memory bandwidth)
+ * - Otherwise: table-driven software implementation
+ */
+class Crc32c {
+public:
+  /**
+   * Compute checksum of data, or extend crc of preceding data
+   */
+  static uint32_t Compute(const void* data, size_t length, uint32_t crc = 0);
+
+  /**
+   * True if hardware instruction is used
+   */
+  static bool HardwareAccelerated();
+};
+
+}  // namespace exchange::core::utils
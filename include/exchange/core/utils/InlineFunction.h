@@ -0,0 +1,113 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace exchange::core::utils {
+
+template <typename Signature, size_t Capacity>
+class InlineFunction;
+
+/**
+ * InlineFunction - move-only type-erased callable stored inline
+ *
+ * Like std::function but never allocates: callable must fit into Capacity
+ * bytes (checked at compile time) and be nothrow move constructible.
+ * Used for completions stored in ring-sized tables.
+ */
+template <typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+public:
+  InlineFunction() = default;
+
+  template <typename F,
+            typename Fn = std::decay_t<F>,
+            typename = std::enable_if_t<!std::is_same_v<Fn, InlineFunction>
+                                        && std::is_invocable_r_v<R, Fn&, Args...>>>
+  InlineFunction(F&& f) {  // NOLINT(google-explicit-constructor)
+    static_assert(sizeof(Fn) <= Capacity, "callable does not fit into InlineFunction");
+    static_assert(alignof(Fn) <= alignof(std::max_align_t), "callable is over-aligned");
+    static_assert(std::is_nothrow_move_constructible_v<Fn>,
+                  "callable must be nothrow move constructible");
+    new (storage_) Fn(std::forward<F>(f));
+    invoke_ = [](void* storage, Args... args) -> R {
+      return (*static_cast<Fn*>(storage))(std::forward<Args>(args)...);
+    };
+    manage_ = [](void* dst, void* src) noexcept {
+      if (dst != nullptr) {
+        new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+      }
+      static_cast<Fn*>(src)->~Fn();
+    };
+  }
+
+  InlineFunction(InlineFunction&& other) noexcept {
+    MoveFrom(other);
+  }
+
+  InlineFunction& operator=(InlineFunction&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  InlineFunction(const InlineFunction&) = delete;
+  InlineFunction& operator=(const InlineFunction&) = delete;
+
+  ~InlineFunction() {
+    Reset();
+  }
+
+  explicit operator bool() const {
+    return invoke_ != nullptr;
+  }
+
+  R operator()(Args... args) {
+    return invoke_(storage_, std::forward<Args>(args)...);
+  }
+
+  void Reset() {
+    if (manage_ != nullptr) {
+      manage_(nullptr, storage_);
+      invoke_ = nullptr;
+      manage_ = nullptr;
+    }
+  }
+
+private:
+  void MoveFrom(InlineFunction& other) {
+    if (other.manage_ != nullptr) {
+      other.manage_(storage_, other.storage_);
+      invoke_ = other.invoke_;
+      manage_ = other.manage_;
+      other.invoke_ = nullptr;
+      other.manage_ = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[Capacity];
+  R (*invoke_)(void*, Args...) = nullptr;
+  void (*manage_)(void* dst, void* src) noexcept = nullptr;
+};
+
+}  // namespace exchange::core::utils
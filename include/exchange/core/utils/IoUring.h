@@ -0,0 +1,101 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace exchange::core::utils {
+
+/**
+ * Minimal io_uring write queue (Linux 5.6+, raw io_uring_setup/io_uring_enter
+ * syscalls, no liburing dependency), used by single thread.
+ *
+ * Every submitted write gets a ticket (1, 2, ...), writes may complete out of
+ * order, CompletedTicket() is the last ticket all writes up to which are done.
+ * Failed or short write throws on the reaping call.
+ */
+class IoUring {
+public:
+  /**
+   * @param entries - submission queue size (max writes in flight)
+   * @throws std::runtime_error if io_uring is not available
+   */
+  explicit IoUring(uint32_t entries);
+
+  ~IoUring();
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  /**
+   * Submit write of length bytes at file offset (waits if queue is full),
+   * data must stay valid until write is completed
+   * @param dsync - complete after data is on storage device (RWF_DSYNC)
+   * @return ticket of the write
+   */
+  int64_t SubmitWrite(int fd, const void* data, uint32_t length, int64_t offset, bool dsync);
+
+  /**
+   * Reap completed writes, wait for at least one if any is in flight
+   */
+  void Reap(bool wait);
+
+  /**
+   * Wait until all writes up to ticket are completed
+   */
+  void Await(int64_t ticket);
+
+  int64_t SubmittedTicket() const {
+    return submittedTicket_;
+  }
+
+  int64_t CompletedTicket() const {
+    return completedTicket_;
+  }
+
+private:
+  void Close();
+  int Enter(uint32_t toSubmit, uint32_t minComplete, uint32_t flags);
+
+  int ringFd_ = -1;
+  uint32_t entries_ = 0;
+  void* sqRing_ = nullptr;
+  size_t sqRingSize_ = 0;
+  void* cqRing_ = nullptr;
+  size_t cqRingSize_ = 0;
+  void* sqes_ = nullptr;
+  size_t sqesSize_ = 0;
+
+  // ring fields (mapped memory shared with kernel)
+  uint32_t* sqHead_ = nullptr;
+  uint32_t* sqTail_ = nullptr;
+  uint32_t sqMask_ = 0;
+  uint32_t* sqArray_ = nullptr;
+  uint32_t* cqHead_ = nullptr;
+  uint32_t* cqTail_ = nullptr;
+  uint32_t cqMask_ = 0;
+  void* cqes_ = nullptr;
+
+  int64_t submittedTicket_ = 0;
+  int64_t completedTicket_ = 0;
+  std::vector<std::pair<int64_t, uint32_t>> inFlight_;  // ticket, length
+};
+
+}  // namespace exchange::core::utils
@@ -20,6 +20,10 @@
 #include "../common/cmd/CommandResultCode.h"
 #include "../common/cmd/OrderCommand.h"
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <xmmintrin.h>
+#endif
+
 namespace exchange::core::utils {
 
 /**
@@ -41,6 +45,19 @@ public:
    */
   static void AppendEventsVolatile(common::cmd::OrderCommand* cmd,
                                    common::MatcherTradeEvent* eventHead);
+
+  /**
+   * Software prefetch of cache line containing addr (read, all cache levels)
+   */
+  static void Prefetch(const void* addr) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(addr), _MM_HINT_T0);
+#else
+    (void)addr;
+#endif
+  }
 };
 
 }  // namespace exchange::core::utils
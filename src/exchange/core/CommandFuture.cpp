@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/CommandFuture.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace exchange::core {
+
+namespace {
+
+constexpr int32_t SPIN_TRIES = 1000;
+constexpr int32_t YIELD_TRIES = 1000;
+constexpr auto SLEEP_INTERVAL = std::chrono::microseconds(50);
+
+}  // namespace
+
+CompletionTable::CompletionTable(int32_t size) : mask_(size - 1), shift_(0) {
+  if (size <= 0 || (size & (size - 1)) != 0) {
+    throw std::invalid_argument("CompletionTable size must be a power of 2: "
+                                + std::to_string(size));
+  }
+  slots_ = std::make_unique<Slot[]>(static_cast<size_t>(size));
+  while ((int64_t{1} << shift_) < size) {
+    shift_++;
+  }
+}
+
+bool CommandFuture::IsReady() const {
+  common::cmd::CommandResultCode code;
+  for (const int64_t seq : {seq_, secondSeq_}) {
+    if (seq < 0) {
+      continue;
+    }
+    // overwritten result is also ready: get() reports it
+    if (table_->Poll(seq, code) == CompletionTable::State::PENDING) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CommandFuture::WaitUntil(std::chrono::steady_clock::time_point deadline) const {
+  if (!table_) {
+    throw std::future_error(std::future_errc::no_state);
+  }
+  for (int32_t i = 0; !IsReady(); i++) {
+    if (i < SPIN_TRIES) {
+      continue;
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+    if (i < SPIN_TRIES + YIELD_TRIES) {
+      std::this_thread::yield();
+    } else {
+      std::this_thread::sleep_for(SLEEP_INTERVAL);
+    }
+  }
+  return true;
+}
+
+void CommandFuture::wait() const {
+  WaitUntil(std::chrono::steady_clock::time_point::max());
+}
+
+common::cmd::CommandResultCode CommandFuture::ResultOf(int64_t seq) const {
+  common::cmd::CommandResultCode code = common::cmd::CommandResultCode::NEW;
+  if (table_->Poll(seq, code) == CompletionTable::State::OVERWRITTEN) {
+    throw std::runtime_error("Result of command " + std::to_string(seq)
+                             + " was overwritten before it was read");
+  }
+  return code;
+}
+
+common::cmd::CommandResultCode CommandFuture::get() const {
+  wait();
+  const auto result = ResultOf(seq_);
+  if (secondSeq_ < 0) {
+    return result;
+  }
+  return common::cmd::MergeToFirstFailed({result, ResultOf(secondSeq_)});
+}
+
+}  // namespace exchange::core
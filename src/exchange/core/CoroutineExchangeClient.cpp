@@ -0,0 +1,43 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/CoroutineExchangeClient.h>
+#include <exchange/core/common/Wire.h>
+#include <exchange/core/orderbook/OrderBookEventsHelper.h>
+#include <vector>
+
+namespace exchange::core {
+
+std::unique_ptr<common::api::reports::ReportResult>
+CreateReportResult(common::api::reports::ReportQueryBase& query,
+                   const common::cmd::OrderCommand& cmd) {
+  auto sectionsMap = orderbook::OrderBookEventsHelper::DeserializeEvents(&cmd);
+
+  // Empty sections are skipped (as in ProcessReport)
+  std::vector<common::Wire> wireOwners;
+  wireOwners.reserve(sectionsMap.size());
+  std::vector<common::BytesIn*> sections;
+  sections.reserve(sectionsMap.size());
+  for (const auto& [sectionId, wire] : sectionsMap) {
+    if (!wire.GetBytes().empty()) {
+      wireOwners.push_back(wire);
+      sections.push_back(&wireOwners.back().bytes());
+    }
+  }
+  return query.CreateResultTypeErased(sections);
+}
+
+}  // namespace exchange::core
@@ -28,6 +28,7 @@
 #include <exchange/core/common/api/ApiBinaryDataCommand.h>
 #include <exchange/core/common/api/ApiCancelOrder.h>
 #include <exchange/core/common/api/ApiCommand.h>
+#include <exchange/core/common/api/ApiCommandValue.h>
 #include <exchange/core/common/api/ApiMoveOrder.h>
 #include <exchange/core/common/api/ApiNop.h>
 #include <exchange/core/common/api/ApiOrderBookRequest.h>
@@ -44,11 +45,12 @@
 #include <exchange/core/common/cmd/CommandResultCode.h>
 #include <exchange/core/common/cmd/OrderCommand.h>
 #include <exchange/core/common/cmd/OrderCommandType.h>
+#include <exchange/core/ingress/WireFrameReader.h>
 #include <exchange/core/orderbook/OrderBookEventsHelper.h>
 #include <exchange/core/processors/BinaryCommandsProcessor.h>
 #include <exchange/core/utils/FastNanoTime.h>
 #include <exchange/core/utils/Logger.h>
-#include <exchange/core/utils/SerializationUtils.h>
+#include <algorithm>
 #include <functional>
 #include <future>
 #include <stdexcept>
@@ -257,15 +259,218 @@ static AdjustUserBalanceTranslator ADJUST_USER_BALANCE_TRANSLATOR;
 static ResetTranslator RESET_TRANSLATOR;
 static NopTranslator NOP_TRANSLATOR;
 static GroupingControlTranslator GROUPING_CONTROL_TRANSLATOR;
+
+// Commands carrying payload claim their own (multiple) sequences
+bool IsPayloadCommand(common::api::ApiCommandType type) {
+  return type == common::api::ApiCommandType::BINARY_DATA
+         || type == common::api::ApiCommandType::PERSIST_STATE;
+}
+
+// Translate single-slot command, switch on command type instead of dynamic_cast chain
+void TranslateCommand(common::cmd::OrderCommand& event,
+                      int64_t seq,
+                      const common::api::ApiCommand& cmd) {
+  using common::api::ApiCommandType;
+  switch (cmd.GetCommandType()) {
+    case ApiCommandType::PLACE_ORDER:
+      NEW_ORDER_TRANSLATOR.translateTo(event, seq,
+                                       static_cast<const common::api::ApiPlaceOrder&>(cmd));
+      break;
+    case ApiCommandType::MOVE_ORDER:
+      MOVE_ORDER_TRANSLATOR.translateTo(event, seq,
+                                        static_cast<const common::api::ApiMoveOrder&>(cmd));
+      break;
+    case ApiCommandType::CANCEL_ORDER:
+      CANCEL_ORDER_TRANSLATOR.translateTo(event, seq,
+                                          static_cast<const common::api::ApiCancelOrder&>(cmd));
+      break;
+    case ApiCommandType::REDUCE_ORDER:
+      REDUCE_ORDER_TRANSLATOR.translateTo(event, seq,
+                                          static_cast<const common::api::ApiReduceOrder&>(cmd));
+      break;
+    case ApiCommandType::ORDER_BOOK_REQUEST:
+      ORDER_BOOK_REQUEST_TRANSLATOR.translateTo(
+        event, seq, static_cast<const common::api::ApiOrderBookRequest&>(cmd));
+      break;
+    case ApiCommandType::ADD_USER:
+      ADD_USER_TRANSLATOR.translateTo(event, seq,
+                                      static_cast<const common::api::ApiAddUser&>(cmd));
+      break;
+    case ApiCommandType::SUSPEND_USER:
+      SUSPEND_USER_TRANSLATOR.translateTo(event, seq,
+                                          static_cast<const common::api::ApiSuspendUser&>(cmd));
+      break;
+    case ApiCommandType::RESUME_USER:
+      RESUME_USER_TRANSLATOR.translateTo(event, seq,
+                                         static_cast<const common::api::ApiResumeUser&>(cmd));
+      break;
+    case ApiCommandType::ADJUST_USER_BALANCE:
+      ADJUST_USER_BALANCE_TRANSLATOR.translateTo(
+        event, seq, static_cast<const common::api::ApiAdjustUserBalance&>(cmd));
+      break;
+    case ApiCommandType::RESET:
+      RESET_TRANSLATOR.translateTo(event, seq, static_cast<const common::api::ApiReset&>(cmd));
+      break;
+    case ApiCommandType::NOP:
+      NOP_TRANSLATOR.translateTo(event, seq, static_cast<const common::api::ApiNop&>(cmd));
+      break;
+    default:
+      // payload commands are rejected by callers before a sequence is claimed
+      throw std::invalid_argument("Unsupported command type");
+  }
+}
+
+// Translate value-type command straight into the slot (no allocation, no RTTI)
+void TranslateCommandValue(common::cmd::OrderCommand& event,
+                           const common::api::ApiCommandValue& cmd) {
+  using common::api::ApiCommandType;
+  using common::cmd::OrderCommandType;
+  switch (cmd.type) {
+    case ApiCommandType::PLACE_ORDER:
+      event.command = OrderCommandType::PLACE_ORDER;
+      event.price = cmd.price;
+      event.reserveBidPrice = cmd.reservePrice;
+      event.size = cmd.size;
+      event.orderId = cmd.orderId;
+      event.action = cmd.action;
+      event.orderType = cmd.orderType;
+      event.symbol = cmd.symbol;
+      event.uid = cmd.uid;
+      event.userCookie = cmd.userCookie;
+      break;
+    case ApiCommandType::MOVE_ORDER:
+      event.command = OrderCommandType::MOVE_ORDER;
+      event.price = cmd.price;
+      event.orderId = cmd.orderId;
+      event.symbol = cmd.symbol;
+      event.uid = cmd.uid;
+      break;
+    case ApiCommandType::CANCEL_ORDER:
+      event.command = OrderCommandType::CANCEL_ORDER;
+      event.orderId = cmd.orderId;
+      event.symbol = cmd.symbol;
+      event.uid = cmd.uid;
+      break;
+    case ApiCommandType::REDUCE_ORDER:
+      event.command = OrderCommandType::REDUCE_ORDER;
+      event.orderId = cmd.orderId;
+      event.symbol = cmd.symbol;
+      event.uid = cmd.uid;
+      event.size = cmd.size;
+      break;
+    case ApiCommandType::ORDER_BOOK_REQUEST:
+      event.command = OrderCommandType::ORDER_BOOK_REQUEST;
+      event.symbol = cmd.symbol;
+      event.size = cmd.size;
+      break;
+    case ApiCommandType::ADD_USER:
+      event.command = OrderCommandType::ADD_USER;
+      event.uid = cmd.uid;
+      break;
+    case ApiCommandType::SUSPEND_USER:
+      event.command = OrderCommandType::SUSPEND_USER;
+      event.uid = cmd.uid;
+      break;
+    case ApiCommandType::RESUME_USER:
+      event.command = OrderCommandType::RESUME_USER;
+      event.uid = cmd.uid;
+      break;
+    case ApiCommandType::ADJUST_USER_BALANCE:
+      event.command = OrderCommandType::BALANCE_ADJUSTMENT;
+      event.orderId = cmd.orderId;
+      event.symbol = cmd.symbol;
+      event.uid = cmd.uid;
+      event.price = cmd.price;
+      event.orderType =
+        common::OrderTypeFromCode(common::BalanceAdjustmentTypeToCode(cmd.adjustmentType));
+      break;
+    case ApiCommandType::RESET:
+      event.command = OrderCommandType::RESET;
+      break;
+    case ApiCommandType::NOP:
+      event.command = OrderCommandType::NOP;
+      break;
+    default:
+      // payload commands are rejected by callers before a sequence is claimed
+      throw std::invalid_argument("Unsupported command value type");
+  }
+  event.timestamp = cmd.timestamp;
+  event.resultCode = common::cmd::CommandResultCode::NEW;
+}
 }  // namespace
 
 template <typename WaitStrategyT>
 ExchangeApi<WaitStrategyT>::ExchangeApi(
-  disruptor::MultiProducerRingBuffer<common::cmd::OrderCommand, WaitStrategyT>* ringBuffer)
-  : ringBuffer_(ringBuffer) {}
+  disruptor::MultiProducerRingBuffer<common::cmd::OrderCommand, WaitStrategyT>* ringBuffer,
+  int32_t payloadReaders)
+  : ringBuffer_(ringBuffer),
+    completions_(ringBuffer ? ringBuffer->getBufferSize() : 1),
+    callbacksMask_(ringBuffer ? ringBuffer->getBufferSize() - 1 : 0),
+    callbacks_(std::make_unique<CompletionCallback[]>(callbacksMask_ + 1)),
+    batchCallbacks_(std::make_unique<PendingBatch[]>(callbacksMask_ + 1)),
+    payloads_(std::make_unique<std::vector<uint8_t>[]>(callbacksMask_ + 1)),
+    payloadReaders_(payloadReaders),
+    pendingPayloadReaders_(payloadReaders > 1
+                             ? std::make_unique<std::atomic<int32_t>[]>(callbacksMask_ + 1)
+                             : nullptr) {}
+
+template <typename WaitStrategyT>
+std::vector<uint8_t>& ExchangeApi<WaitStrategyT>::PayloadSlot(int64_t seq) {
+  // armed before publish - readers see it together with the command
+  if (payloadReaders_ > 1) {
+    pendingPayloadReaders_[seq & callbacksMask_].store(payloadReaders_,
+                                                       std::memory_order_relaxed);
+  }
+  return payloads_[seq & callbacksMask_];
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::ReleasePayload(int64_t seq, common::cmd::OrderCommand* cmd) {
+  if (cmd->payload == nullptr) {
+    return;
+  }
+  // With results fan-out other processors may still read the command: only the
+  // last one releases (acq_rel - their reads happen before the release)
+  if (payloadReaders_ > 1
+      && pendingPayloadReaders_[seq & callbacksMask_].fetch_sub(1, std::memory_order_acq_rel)
+           != 1) {
+    return;
+  }
+  std::vector<uint8_t>().swap(payloads_[seq & callbacksMask_]);
+  cmd->payload = nullptr;
+}
 
 template <typename WaitStrategyT>
 void ExchangeApi<WaitStrategyT>::ProcessResult(int64_t seq, common::cmd::OrderCommand* cmd) {
+  // Every command: single store of result code into completion table slot
+  // (SubmitCommandAsyncLight futures read it from there)
+  completions_.Complete(seq, cmd->resultCode);
+
+  // Binary payload is not needed anymore, large blobs are not kept until slot is reused
+  ReleasePayload(seq, cmd);
+
+  // Callbacks and promise maps are looked up only for commands marked by producer
+  // (callbacks, order book requests, report queries, full response)
+  switch (completions_.TakeMark(seq)) {
+    case CompletionTable::Waiter::NONE:
+      return;
+    case CompletionTable::Waiter::COMMAND_CALLBACK: {
+      auto& callback = callbacks_[seq & callbacksMask_];
+      callback(*cmd);
+      callback.Reset();
+      return;
+    }
+    case CompletionTable::Waiter::BATCH_CALLBACK: {
+      // previous commands of the batch are already completed (in-order processing)
+      auto& batch = batchCallbacks_[seq & callbacksMask_];
+      batch.callback(CompletedBatch(&completions_, seq - batch.size + 1, batch.size));
+      batch.callback.Reset();
+      return;
+    }
+    case CompletionTable::Waiter::PROMISE:
+      break;
+  }
+
   // Check if this is a report query result (BINARY_DATA_QUERY)
   // Match Java: promises.put(seq, orderCommand ->
   // future.complete(translator.apply(orderCommand)))
@@ -292,7 +497,7 @@ void ExchangeApi<WaitStrategyT>::ProcessResult(int64_t seq, common::cmd::OrderCo
     return;
   }
 
-  // Check for full response promise first (SubmitCommandAsyncFullResponse)
+  // Full response promise (SubmitCommandAsyncFullResponse)
   typename FullResponsePromiseMap::accessor fullResponseAccessor;
   if (fullResponsePromises_.find(fullResponseAccessor, seq)) {
     // Return complete OrderCommand copy
@@ -301,51 +506,44 @@ void ExchangeApi<WaitStrategyT>::ProcessResult(int64_t seq, common::cmd::OrderCo
     return;
   }
 
-  // Regular command result (SubmitCommandAsync)
-  // TBB concurrent_hash_map: lock-free find and erase
+  // Result code promise (SubmitCommandAsync)
   typename PromiseMap::accessor accessor;
   if (promises_.find(accessor, seq)) {
     accessor->second.set_value(cmd->resultCode);
     promises_.erase(accessor);
   }
-  // No promise found - this can happen if:
-  // 1. Command was submitted via SubmitCommand (fire-and-forget)
-  // 2. Promise was already consumed (shouldn't happen)
-  // 3. Sequence mismatch (shouldn't happen)
 }
 
 template <typename WaitStrategyT>
 void ExchangeApi<WaitStrategyT>::SubmitCommand(common::api::ApiCommand* cmd) {
-  // Use publishEvent for normal path
-  if (auto* placeOrder = dynamic_cast<common::api::ApiPlaceOrder*>(cmd)) {
-    ringBuffer_->publishEvent(NEW_ORDER_TRANSLATOR, *placeOrder);
-  } else if (auto* moveOrder = dynamic_cast<common::api::ApiMoveOrder*>(cmd)) {
-    ringBuffer_->publishEvent(MOVE_ORDER_TRANSLATOR, *moveOrder);
-  } else if (auto* cancelOrder = dynamic_cast<common::api::ApiCancelOrder*>(cmd)) {
-    ringBuffer_->publishEvent(CANCEL_ORDER_TRANSLATOR, *cancelOrder);
-  } else if (auto* reduceOrder = dynamic_cast<common::api::ApiReduceOrder*>(cmd)) {
-    ringBuffer_->publishEvent(REDUCE_ORDER_TRANSLATOR, *reduceOrder);
-  } else if (auto* orderBookRequest = dynamic_cast<common::api::ApiOrderBookRequest*>(cmd)) {
-    ringBuffer_->publishEvent(ORDER_BOOK_REQUEST_TRANSLATOR, *orderBookRequest);
-  } else if (auto* addUser = dynamic_cast<common::api::ApiAddUser*>(cmd)) {
-    ringBuffer_->publishEvent(ADD_USER_TRANSLATOR, *addUser);
-  } else if (auto* suspendUser = dynamic_cast<common::api::ApiSuspendUser*>(cmd)) {
-    ringBuffer_->publishEvent(SUSPEND_USER_TRANSLATOR, *suspendUser);
-  } else if (auto* resumeUser = dynamic_cast<common::api::ApiResumeUser*>(cmd)) {
-    ringBuffer_->publishEvent(RESUME_USER_TRANSLATOR, *resumeUser);
-  } else if (auto* adjustBalance = dynamic_cast<common::api::ApiAdjustUserBalance*>(cmd)) {
-    ringBuffer_->publishEvent(ADJUST_USER_BALANCE_TRANSLATOR, *adjustBalance);
-  } else if (auto* reset = dynamic_cast<common::api::ApiReset*>(cmd)) {
-    ringBuffer_->publishEvent(RESET_TRANSLATOR, *reset);
-  } else if (auto* nop = dynamic_cast<common::api::ApiNop*>(cmd)) {
-    ringBuffer_->publishEvent(NOP_TRANSLATOR, *nop);
-  } else if (auto* binaryData = dynamic_cast<common::api::ApiBinaryDataCommand*>(cmd)) {
-    PublishBinaryData(binaryData, [](int64_t) {});
-  } else if (auto* persistState = dynamic_cast<common::api::ApiPersistState*>(cmd)) {
-    PublishPersistCmd(persistState, [](int64_t, int64_t) {});
-  } else {
-    throw std::invalid_argument("Unsupported command type");
+  if (!cmd) {
+    throw std::invalid_argument("SubmitCommand: cmd is nullptr");
+  }
+  switch (cmd->GetCommandType()) {
+    case common::api::ApiCommandType::BINARY_DATA:
+      PublishBinaryData(static_cast<common::api::ApiBinaryDataCommand*>(cmd), [](int64_t) {});
+      return;
+    case common::api::ApiCommandType::PERSIST_STATE:
+      PublishPersistCmd(static_cast<common::api::ApiPersistState*>(cmd),
+                        [](int64_t, int64_t) {});
+      return;
+    default:
+      break;
+  }
+
+  const int64_t seq = ringBuffer_->next();
+  TranslateCommand(ringBuffer_->get(seq), seq, *cmd);
+  ringBuffer_->publish(seq);
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::SubmitCommand(const common::api::ApiCommandValue& cmd) {
+  if (IsPayloadCommand(cmd.type)) {
+    throw std::invalid_argument("SubmitCommand: payload commands are not supported as values");
   }
+  const int64_t seq = ringBuffer_->next();
+  TranslateCommandValue(ringBuffer_->get(seq), cmd);
+  ringBuffer_->publish(seq);
 }
 
 template <typename WaitStrategyT>
@@ -358,110 +556,174 @@ ExchangeApi<WaitStrategyT>::SubmitCommandAsync(common::api::ApiCommand* cmd) {
     throw std::runtime_error("SubmitCommandAsync: ringBuffer is nullptr");
   }
 
-  std::promise<common::cmd::CommandResultCode> promise;
-  auto future = promise.get_future();
-
-  // Handle binary data and persist commands specially - they claim their own
-  // sequences
-  if (auto* binaryData = dynamic_cast<common::api::ApiBinaryDataCommand*>(cmd)) {
-    // PublishBinaryData will claim its own sequences and set promises
-    // Use shared_ptr to make lambda copyable for std::function
-    auto promisePtr =
-      std::make_shared<std::promise<common::cmd::CommandResultCode>>(std::move(promise));
-    PublishBinaryData(binaryData, [this, promisePtr](int64_t seq) {
-      // TBB concurrent_hash_map: lock-free insert
-      typename PromiseMap::accessor accessor;
-      promises_.insert(accessor, seq);
-      accessor->second = std::move(*promisePtr);
-    });
+  // Binary data and persist commands claim their own sequences,
+  // promises are registered before sequences are published
+  const auto commandType = cmd->GetCommandType();
+  if (commandType == common::api::ApiCommandType::BINARY_DATA) {
+    std::future<common::cmd::CommandResultCode> future;
+    PublishBinaryData(static_cast<common::api::ApiBinaryDataCommand*>(cmd),
+                      [this, &future](int64_t seq) { future = RegisterPromise(seq); });
     return future;
-  } else if (auto* persistState = dynamic_cast<common::api::ApiPersistState*>(cmd)) {
-    // PublishPersistCmd will claim its own sequences and set promises
-    // For persist, we need to wait for both sequences
-    std::promise<common::cmd::CommandResultCode> promise2;
-    auto future2 = promise2.get_future();
-    // Use shared_ptr to make lambda copyable for std::function
-    auto promise1Ptr =
-      std::make_shared<std::promise<common::cmd::CommandResultCode>>(std::move(promise));
-    auto promise2Ptr =
-      std::make_shared<std::promise<common::cmd::CommandResultCode>>(std::move(promise2));
-    PublishPersistCmd(persistState, [this, promise1Ptr, promise2Ptr](int64_t seq1, int64_t seq2) {
-      // TBB concurrent_hash_map: lock-free insert
-      typename PromiseMap::accessor accessor1, accessor2;
-      promises_.insert(accessor1, seq1);
-      accessor1->second = std::move(*promise1Ptr);
-      promises_.insert(accessor2, seq2);
-      accessor2->second = std::move(*promise2Ptr);
-    });
-    // Match Java: return future1.thenCombineAsync(future2,
-    // CommandResultCode::mergeToFirstFailed)
-    // Java thenCombineAsync: registers callback, executes when both futures
-    // complete (doesn't start thread immediately, uses thread pool when both
-    // ready) Use deferred launch to avoid starting thread immediately When
-    // .get() is called, it will wait for both futures and merge results
+  } else if (commandType == common::api::ApiCommandType::PERSIST_STATE) {
+    std::future<common::cmd::CommandResultCode> future1;
+    std::future<common::cmd::CommandResultCode> future2;
+    PublishPersistCmd(static_cast<common::api::ApiPersistState*>(cmd),
+                      [this, &future1, &future2](int64_t seq1, int64_t seq2) {
+                        future1 = RegisterPromise(seq1);
+                        future2 = RegisterPromise(seq2);
+                      });
+    // Match Java: future1.thenCombineAsync(future2, CommandResultCode::mergeToFirstFailed)
+    // Deferred launch: both results are merged when get() is called
     return std::async(std::launch::deferred,
-                      [future = std::move(future), future2 = std::move(future2)]() mutable {
-                        // Wait for both futures to complete (matching Java thenCombineAsync
-                        // behavior - executes when both are ready)
-                        auto result1 = future.get();
-                        auto result2 = future2.get();
-                        // Match Java: CommandResultCode.mergeToFirstFailed(result1, result2)
-                        // Java mergeToFirstFailed logic:
-                        // - If any failed (not SUCCESS and not ACCEPTED), return first failed
-                        // - Otherwise, if any SUCCESS, return SUCCESS
-                        // - Otherwise return ACCEPTED
-                        std::vector<common::cmd::CommandResultCode> results = {result1, result2};
-                        return common::cmd::MergeToFirstFailed(results);
+                      [future1 = std::move(future1), future2 = std::move(future2)]() mutable {
+                        return common::cmd::MergeToFirstFailed({future1.get(), future2.get()});
                       });
   }
 
-  // For other commands, claim sequence and translate
-  // Get sequence before publishing
-  int64_t seq = ringBuffer_->next();
+  const int64_t seq = ringBuffer_->next();
+  auto future = RegisterPromise(seq);
+  TranslateCommand(ringBuffer_->get(seq), seq, *cmd);
+  ringBuffer_->publish(seq);
+  return future;
+}
 
-  // Store promise (TBB concurrent_hash_map: lock-free insert)
-  {
-    typename PromiseMap::accessor accessor;
-    promises_.insert(accessor, seq);
-    accessor->second = std::move(promise);
+template <typename WaitStrategyT>
+std::future<common::cmd::CommandResultCode>
+ExchangeApi<WaitStrategyT>::SubmitCommandAsync(const common::api::ApiCommandValue& cmd) {
+  if (IsPayloadCommand(cmd.type)) {
+    throw std::invalid_argument("SubmitCommandAsync: payload commands are not supported "
+                                "as values");
   }
+  const int64_t seq = ringBuffer_->next();
+  auto future = RegisterPromise(seq);
+  TranslateCommandValue(ringBuffer_->get(seq), cmd);
+  ringBuffer_->publish(seq);
+  return future;
+}
 
-  // Get event slot and translate
-  auto& event = ringBuffer_->get(seq);
+template <typename WaitStrategyT>
+std::future<common::cmd::CommandResultCode>
+ExchangeApi<WaitStrategyT>::RegisterPromise(int64_t seq) {
+  // TBB concurrent_hash_map: lock-free insert
+  typename PromiseMap::accessor accessor;
+  promises_.insert(accessor, seq);
+  completions_.Mark(seq, CompletionTable::Waiter::PROMISE);
+  return accessor->second.get_future();
+}
 
-  // Publish command (manually translate and publish to capture sequence)
-  if (auto* placeOrder = dynamic_cast<common::api::ApiPlaceOrder*>(cmd)) {
-    NEW_ORDER_TRANSLATOR.translateTo(event, seq, *placeOrder);
-  } else if (auto* moveOrder = dynamic_cast<common::api::ApiMoveOrder*>(cmd)) {
-    MOVE_ORDER_TRANSLATOR.translateTo(event, seq, *moveOrder);
-  } else if (auto* cancelOrder = dynamic_cast<common::api::ApiCancelOrder*>(cmd)) {
-    CANCEL_ORDER_TRANSLATOR.translateTo(event, seq, *cancelOrder);
-  } else if (auto* reduceOrder = dynamic_cast<common::api::ApiReduceOrder*>(cmd)) {
-    REDUCE_ORDER_TRANSLATOR.translateTo(event, seq, *reduceOrder);
-  } else if (auto* orderBookRequest = dynamic_cast<common::api::ApiOrderBookRequest*>(cmd)) {
-    ORDER_BOOK_REQUEST_TRANSLATOR.translateTo(event, seq, *orderBookRequest);
-  } else if (auto* addUser = dynamic_cast<common::api::ApiAddUser*>(cmd)) {
-    ADD_USER_TRANSLATOR.translateTo(event, seq, *addUser);
-  } else if (auto* suspendUser = dynamic_cast<common::api::ApiSuspendUser*>(cmd)) {
-    SUSPEND_USER_TRANSLATOR.translateTo(event, seq, *suspendUser);
-  } else if (auto* resumeUser = dynamic_cast<common::api::ApiResumeUser*>(cmd)) {
-    RESUME_USER_TRANSLATOR.translateTo(event, seq, *resumeUser);
-  } else if (auto* adjustBalance = dynamic_cast<common::api::ApiAdjustUserBalance*>(cmd)) {
-    ADJUST_USER_BALANCE_TRANSLATOR.translateTo(event, seq, *adjustBalance);
-  } else if (auto* reset = dynamic_cast<common::api::ApiReset*>(cmd)) {
-    RESET_TRANSLATOR.translateTo(event, seq, *reset);
-  } else if (auto* nop = dynamic_cast<common::api::ApiNop*>(cmd)) {
-    NOP_TRANSLATOR.translateTo(event, seq, *nop);
-  } else {
-    // Remove promise if command type is unsupported
-    promises_.erase(seq);
-    throw std::invalid_argument("Unsupported command type");
+template <typename WaitStrategyT>
+CommandFuture ExchangeApi<WaitStrategyT>::SubmitCommandAsyncLight(common::api::ApiCommand* cmd) {
+  if (!cmd) {
+    throw std::invalid_argument("SubmitCommandAsyncLight: cmd is nullptr");
+  }
+  if (!ringBuffer_) {
+    throw std::runtime_error("SubmitCommandAsyncLight: ringBuffer is nullptr");
   }
 
-  // Publish the event
+  // Binary data and persist commands claim their own sequences,
+  // result is the result of the last (binary data) or both (persist) commands
+  const auto commandType = cmd->GetCommandType();
+  if (commandType == common::api::ApiCommandType::BINARY_DATA) {
+    int64_t endSeq = -1;
+    PublishBinaryData(static_cast<common::api::ApiBinaryDataCommand*>(cmd),
+                      [&endSeq](int64_t seq) { endSeq = seq; });
+    return CommandFuture(&completions_, endSeq);
+  } else if (commandType == common::api::ApiCommandType::PERSIST_STATE) {
+    // Match Java: future1.thenCombineAsync(future2, CommandResultCode::mergeToFirstFailed)
+    int64_t firstSeq = -1;
+    int64_t secondSeq = -1;
+    PublishPersistCmd(static_cast<common::api::ApiPersistState*>(cmd),
+                      [&firstSeq, &secondSeq](int64_t seq1, int64_t seq2) {
+                        firstSeq = seq1;
+                        secondSeq = seq2;
+                      });
+    return CommandFuture(&completions_, firstSeq, secondSeq);
+  }
+
+  // Result code is stored in completion table by ProcessResult,
+  // nothing is registered per command
+  const int64_t seq = ringBuffer_->next();
+  TranslateCommand(ringBuffer_->get(seq), seq, *cmd);
   ringBuffer_->publish(seq);
+  return CommandFuture(&completions_, seq);
+}
 
-  return future;
+template <typename WaitStrategyT>
+CommandFuture
+ExchangeApi<WaitStrategyT>::SubmitCommandAsyncLight(const common::api::ApiCommandValue& cmd) {
+  if (IsPayloadCommand(cmd.type)) {
+    throw std::invalid_argument("SubmitCommandAsyncLight: payload commands are not supported "
+                                "as values");
+  }
+  const int64_t seq = ringBuffer_->next();
+  TranslateCommandValue(ringBuffer_->get(seq), cmd);
+  ringBuffer_->publish(seq);
+  return CommandFuture(&completions_, seq);
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::SubmitCommand(common::api::ApiCommand* cmd,
+                                               CompletionCallback callback) {
+  if (!cmd) {
+    throw std::invalid_argument("SubmitCommand: cmd is nullptr");
+  }
+  if (!callback) {
+    throw std::invalid_argument("SubmitCommand: empty completion callback");
+  }
+  switch (cmd->GetCommandType()) {
+    case common::api::ApiCommandType::BINARY_DATA:
+      // completes with the last fragment
+      PublishBinaryData(static_cast<common::api::ApiBinaryDataCommand*>(cmd),
+                        [this, &callback](int64_t endSeq) {
+                          AttachCallback(endSeq, std::move(callback));
+                        });
+      return;
+    case common::api::ApiCommandType::PERSIST_STATE:
+      throw std::invalid_argument("SubmitCommand: persist state does not support "
+                                  "completion callback");
+    default:
+      break;
+  }
+
+  const int64_t seq = ringBuffer_->next();
+  TranslateCommand(ringBuffer_->get(seq), seq, *cmd);
+  AttachCallback(seq, std::move(callback));
+  ringBuffer_->publish(seq);
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::SubmitCommand(const common::api::ApiCommandValue& cmd,
+                                               CompletionCallback callback) {
+  if (IsPayloadCommand(cmd.type)) {
+    throw std::invalid_argument("SubmitCommand: payload commands are not supported as values");
+  }
+  if (!callback) {
+    throw std::invalid_argument("SubmitCommand: empty completion callback");
+  }
+  const int64_t seq = ringBuffer_->next();
+  TranslateCommandValue(ringBuffer_->get(seq), cmd);
+  AttachCallback(seq, std::move(callback));
+  ringBuffer_->publish(seq);
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::SubmitReportQuery(
+  const common::api::reports::ReportQueryBase& query,
+  int32_t transferId,
+  CompletionCallback callback) {
+  if (!callback) {
+    throw std::invalid_argument("SubmitReportQuery: empty completion callback");
+  }
+  PublishQuery(query, transferId, 0, [this, &callback](int64_t endSeq) {
+    AttachCallback(endSeq, std::move(callback));
+  });
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::AttachCallback(int64_t seq, CompletionCallback&& callback) {
+  // slot is free: its previous sequence was processed (claimed seq passed gating)
+  callbacks_[seq & callbacksMask_] = std::move(callback);
+  completions_.Mark(seq, CompletionTable::Waiter::COMMAND_CALLBACK);
 }
 
 template <typename WaitStrategyT>
@@ -479,11 +741,12 @@ ExchangeApi<WaitStrategyT>::SubmitCommandAsyncFullResponse(common::api::ApiComma
 
   // Handle binary data and persist commands specially - they claim their own
   // sequences
-  if (auto* binaryData = dynamic_cast<common::api::ApiBinaryDataCommand*>(cmd)) {
+  const auto commandType = cmd->GetCommandType();
+  if (commandType == common::api::ApiCommandType::BINARY_DATA) {
     // For binary data commands, we can't use full response (they don't return
     // OrderCommand) Fall back to regular async
     throw std::invalid_argument("SubmitCommandAsyncFullResponse: BinaryDataCommand not supported");
-  } else if (auto* persistState = dynamic_cast<common::api::ApiPersistState*>(cmd)) {
+  } else if (commandType == common::api::ApiCommandType::PERSIST_STATE) {
     // For persist commands, we can't use full response
     throw std::invalid_argument("SubmitCommandAsyncFullResponse: PersistState not supported");
   }
@@ -498,38 +761,13 @@ ExchangeApi<WaitStrategyT>::SubmitCommandAsyncFullResponse(common::api::ApiComma
     fullResponsePromises_.insert(accessor, seq);
     accessor->second = std::move(promise);
   }
+  completions_.Mark(seq, CompletionTable::Waiter::PROMISE);
 
   // Get event slot and translate
   auto& event = ringBuffer_->get(seq);
 
-  // Publish command (manually translate and publish to capture sequence)
-  if (auto* placeOrder = dynamic_cast<common::api::ApiPlaceOrder*>(cmd)) {
-    NEW_ORDER_TRANSLATOR.translateTo(event, seq, *placeOrder);
-  } else if (auto* moveOrder = dynamic_cast<common::api::ApiMoveOrder*>(cmd)) {
-    MOVE_ORDER_TRANSLATOR.translateTo(event, seq, *moveOrder);
-  } else if (auto* cancelOrder = dynamic_cast<common::api::ApiCancelOrder*>(cmd)) {
-    CANCEL_ORDER_TRANSLATOR.translateTo(event, seq, *cancelOrder);
-  } else if (auto* reduceOrder = dynamic_cast<common::api::ApiReduceOrder*>(cmd)) {
-    REDUCE_ORDER_TRANSLATOR.translateTo(event, seq, *reduceOrder);
-  } else if (auto* orderBookRequest = dynamic_cast<common::api::ApiOrderBookRequest*>(cmd)) {
-    ORDER_BOOK_REQUEST_TRANSLATOR.translateTo(event, seq, *orderBookRequest);
-  } else if (auto* addUser = dynamic_cast<common::api::ApiAddUser*>(cmd)) {
-    ADD_USER_TRANSLATOR.translateTo(event, seq, *addUser);
-  } else if (auto* suspendUser = dynamic_cast<common::api::ApiSuspendUser*>(cmd)) {
-    SUSPEND_USER_TRANSLATOR.translateTo(event, seq, *suspendUser);
-  } else if (auto* resumeUser = dynamic_cast<common::api::ApiResumeUser*>(cmd)) {
-    RESUME_USER_TRANSLATOR.translateTo(event, seq, *resumeUser);
-  } else if (auto* adjustBalance = dynamic_cast<common::api::ApiAdjustUserBalance*>(cmd)) {
-    ADJUST_USER_BALANCE_TRANSLATOR.translateTo(event, seq, *adjustBalance);
-  } else if (auto* reset = dynamic_cast<common::api::ApiReset*>(cmd)) {
-    RESET_TRANSLATOR.translateTo(event, seq, *reset);
-  } else if (auto* nop = dynamic_cast<common::api::ApiNop*>(cmd)) {
-    NOP_TRANSLATOR.translateTo(event, seq, *nop);
-  } else {
-    // Remove promise if command type is unsupported
-    fullResponsePromises_.erase(seq);
-    throw std::invalid_argument("Unsupported command type");
-  }
+  // Translate command (switch on command type) and publish to capture sequence
+  TranslateCommand(event, seq, *cmd);
 
   // Publish the event
   ringBuffer_->publish(seq);
@@ -556,6 +794,7 @@ ExchangeApi<WaitStrategyT>::RequestOrderBookAsync(int32_t symbolId, int32_t dept
     orderBookPromises_.insert(accessor, seq);
     accessor->second = std::move(promise);
   }
+  completions_.Mark(seq, CompletionTable::Waiter::PROMISE);
 
   // Get event slot and set up order book request
   // Match Java: ringBuffer.publishEvent(((cmd, seq) -> { ... promises.put(seq,
@@ -628,6 +867,7 @@ void ExchangeApi<WaitStrategyT>::BinaryData(int32_t serviceFlags,
   cmd.reserveBidPrice = word2;
   cmd.size = word3;
   cmd.uid = word4;
+  cmd.payload = nullptr;
   cmd.timestamp = timestampNs;
   cmd.resultCode = common::cmd::CommandResultCode::NEW;
   ringBuffer_->publish(seq);
@@ -855,6 +1095,52 @@ void ExchangeApi<WaitStrategyT>::ResetReplay(int64_t timestampNs) {
   ringBuffer_->publish(seq);
 }
 
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::ReplayCommandsBatch(
+  const processors::journaling::JournalCommand* cmds,
+  size_t count) {
+  if (!ringBuffer_) {
+    throw std::runtime_error("ReplayCommandsBatch: ringBuffer is nullptr");
+  }
+
+  const size_t chunkSize = static_cast<size_t>(ringBuffer_->getBufferSize() / 4);
+  while (count > 0) {
+    const size_t n = std::min(count, chunkSize);
+    const int64_t highSeq = ringBuffer_->next(static_cast<int>(n));
+    const int64_t lowSeq = highSeq - static_cast<int64_t>(n) + 1;
+    for (size_t i = 0; i < n; i++) {
+      const auto& src = cmds[i];
+      const int64_t seq = lowSeq + static_cast<int64_t>(i);
+      auto& cmd = ringBuffer_->get(seq);
+      cmd.command = src.command;
+      cmd.serviceFlags = src.serviceFlags;
+      cmd.eventsGroup = src.eventsGroup;
+      cmd.timestamp = src.timestamp;
+      cmd.orderId = src.orderId;
+      cmd.symbol = src.symbol;
+      cmd.price = src.price;
+      cmd.size = src.size;
+      cmd.reserveBidPrice = src.reserveBidPrice;
+      cmd.action = src.action;
+      cmd.orderType = src.orderType;
+      cmd.uid = src.uid;
+      cmd.userCookie = src.userCookie;
+      if (src.payload != nullptr) {
+        // journal record is valid only during this call
+        auto& payload = PayloadSlot(seq);
+        payload.assign(src.payload, src.payload + src.payloadLength);
+        cmd.payload = &payload;
+      } else {
+        cmd.payload = nullptr;
+      }
+      cmd.resultCode = common::cmd::CommandResultCode::NEW;
+    }
+    ringBuffer_->publish(lowSeq, highSeq);
+    cmds += n;
+    count -= n;
+  }
+}
+
 template <typename WaitStrategyT>
 void ExchangeApi<WaitStrategyT>::SubmitCommandsSync(
   const std::vector<common::api::ApiCommand*>& cmds) {
@@ -868,7 +1154,7 @@ void ExchangeApi<WaitStrategyT>::SubmitCommandsSync(
   }
 
   // Submit last one and wait for result
-  auto future = SubmitCommandAsync(cmds[cmds.size() - 1]);
+  auto future = SubmitCommandAsyncLight(cmds[cmds.size() - 1]);
   future.wait();  // Wait for completion
 }
 
@@ -883,6 +1169,19 @@ void ExchangeApi<WaitStrategyT>::SubmitCommandsBatch(
     throw std::runtime_error("SubmitCommandsBatch: ringBuffer is nullptr");
   }
 
+  // Validate before claiming: claimed sequences must always be published
+  for (const auto* apiCmd : cmds) {
+    if (!apiCmd) {
+      throw std::invalid_argument("SubmitCommandsBatch: cmd is nullptr");
+    }
+    // Binary data and persist commands claim their own sequences,
+    // they can't be mixed with regular commands in batch
+    if (IsPayloadCommand(apiCmd->GetCommandType())) {
+      throw std::invalid_argument("SubmitCommandsBatch: BinaryDataCommand and PersistState "
+                                  "not supported in batch");
+    }
+  }
+
   const size_t batchSize = cmds.size();
 
   // Batch claim sequences: next(n) instead of n calls to next()
@@ -891,52 +1190,207 @@ void ExchangeApi<WaitStrategyT>::SubmitCommandsBatch(
 
   // Fill commands into ring buffer slots
   for (size_t i = 0; i < batchSize; i++) {
-    int64_t seq = lowSeq + static_cast<int64_t>(i);
-    auto& cmd = ringBuffer_->get(seq);
-    auto* apiCmd = cmds[i];
+    const int64_t seq = lowSeq + static_cast<int64_t>(i);
+    TranslateCommand(ringBuffer_->get(seq), seq, *cmds[i]);
+  }
 
-    if (!apiCmd) {
-      throw std::invalid_argument("SubmitCommandsBatch: cmd is nullptr");
+  // Batch publish: publish(lo, hi) instead of n calls to publish()
+  ringBuffer_->publish(lowSeq, highSeq);
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::SubmitCommandsBatch(const common::api::ApiCommandValue* cmds,
+                                                     size_t count) {
+  if (!ringBuffer_) {
+    throw std::runtime_error("SubmitCommandsBatch: ringBuffer is nullptr");
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (IsPayloadCommand(cmds[i].type)) {
+      throw std::invalid_argument("SubmitCommandsBatch: payload commands are not supported "
+                                  "as values");
     }
+  }
 
-    // Translate command using appropriate translator (match SubmitCommand
-    // logic)
-    if (auto* placeOrder = dynamic_cast<common::api::ApiPlaceOrder*>(apiCmd)) {
-      NEW_ORDER_TRANSLATOR.translateTo(cmd, seq, *placeOrder);
-    } else if (auto* moveOrder = dynamic_cast<common::api::ApiMoveOrder*>(apiCmd)) {
-      MOVE_ORDER_TRANSLATOR.translateTo(cmd, seq, *moveOrder);
-    } else if (auto* cancelOrder = dynamic_cast<common::api::ApiCancelOrder*>(apiCmd)) {
-      CANCEL_ORDER_TRANSLATOR.translateTo(cmd, seq, *cancelOrder);
-    } else if (auto* reduceOrder = dynamic_cast<common::api::ApiReduceOrder*>(apiCmd)) {
-      REDUCE_ORDER_TRANSLATOR.translateTo(cmd, seq, *reduceOrder);
-    } else if (auto* orderBookRequest = dynamic_cast<common::api::ApiOrderBookRequest*>(apiCmd)) {
-      ORDER_BOOK_REQUEST_TRANSLATOR.translateTo(cmd, seq, *orderBookRequest);
-    } else if (auto* addUser = dynamic_cast<common::api::ApiAddUser*>(apiCmd)) {
-      ADD_USER_TRANSLATOR.translateTo(cmd, seq, *addUser);
-    } else if (auto* suspendUser = dynamic_cast<common::api::ApiSuspendUser*>(apiCmd)) {
-      SUSPEND_USER_TRANSLATOR.translateTo(cmd, seq, *suspendUser);
-    } else if (auto* resumeUser = dynamic_cast<common::api::ApiResumeUser*>(apiCmd)) {
-      RESUME_USER_TRANSLATOR.translateTo(cmd, seq, *resumeUser);
-    } else if (auto* adjustBalance = dynamic_cast<common::api::ApiAdjustUserBalance*>(apiCmd)) {
-      ADJUST_USER_BALANCE_TRANSLATOR.translateTo(cmd, seq, *adjustBalance);
-    } else if (auto* reset = dynamic_cast<common::api::ApiReset*>(apiCmd)) {
-      RESET_TRANSLATOR.translateTo(cmd, seq, *reset);
-    } else if (auto* nop = dynamic_cast<common::api::ApiNop*>(apiCmd)) {
-      NOP_TRANSLATOR.translateTo(cmd, seq, *nop);
-    } else if (auto* binaryData = dynamic_cast<common::api::ApiBinaryDataCommand*>(apiCmd)) {
-      // Binary data commands need special handling (they claim their own
-      // sequences) For batch, we can't mix them with regular commands
-      throw std::invalid_argument("SubmitCommandsBatch: BinaryDataCommand not supported in batch");
-    } else if (auto* persistState = dynamic_cast<common::api::ApiPersistState*>(apiCmd)) {
-      // Persist commands need special handling
-      throw std::invalid_argument("SubmitCommandsBatch: PersistState not supported in batch");
-    } else {
-      throw std::invalid_argument("SubmitCommandsBatch: Unsupported command type");
+  // Same chunking as ReplayCommandsBatch: never claims more than a quarter of the ring
+  const size_t chunkSize = static_cast<size_t>(ringBuffer_->getBufferSize() / 4);
+  while (count > 0) {
+    const size_t n = std::min(count, chunkSize);
+    const int64_t highSeq = ringBuffer_->next(static_cast<int>(n));
+    const int64_t lowSeq = highSeq - static_cast<int64_t>(n) + 1;
+    for (size_t i = 0; i < n; i++) {
+      TranslateCommandValue(ringBuffer_->get(lowSeq + static_cast<int64_t>(i)), cmds[i]);
     }
+    ringBuffer_->publish(lowSeq, highSeq);
+    cmds += n;
+    count -= n;
   }
+}
 
-  // Batch publish: publish(lo, hi) instead of n calls to publish()
+template <typename WaitStrategyT>
+size_t ExchangeApi<WaitStrategyT>::SubmitWireFrames(const uint8_t* data, size_t length) {
+  if (!ringBuffer_) {
+    throw std::runtime_error("SubmitWireFrames: ringBuffer is nullptr");
+  }
+  // Malformed buffer is rejected before claiming: claimed sequences must always be published
+  const size_t chunkSize = static_cast<size_t>(ringBuffer_->getBufferSize() / 4);
+  ingress::WireFrameReader reader(data, length);
+  const size_t total = reader.Validate(chunkSize);
+
+  while (!reader.AtEnd()) {
+    const size_t n = reader.CommandsUpTo(chunkSize);
+    const int64_t highSeq = ringBuffer_->next(static_cast<int>(n));
+    const int64_t lowSeq = highSeq - static_cast<int64_t>(n) + 1;
+    for (int64_t seq = lowSeq; seq <= highSeq; seq++) {
+      reader.DecodeNext(ringBuffer_->get(seq));
+    }
+    ringBuffer_->publish(lowSeq, highSeq);
+  }
+  return total;
+}
+
+template <typename WaitStrategyT>
+size_t ExchangeApi<WaitStrategyT>::SubmitWireFrames(const uint8_t* data,
+                                                    size_t length,
+                                                    BatchCompletionCallback callback) {
+  if (!ringBuffer_) {
+    throw std::runtime_error("SubmitWireFrames: ringBuffer is nullptr");
+  }
+  if (!callback) {
+    throw std::invalid_argument("SubmitWireFrames: empty completion callback");
+  }
+  const size_t maxCount = static_cast<size_t>(ringBuffer_->getBufferSize() / 4);
+  ingress::WireFrameReader reader(data, length);
+  const size_t count = reader.Validate(maxCount);
+  if (count == 0 || count > maxCount) {
+    throw std::invalid_argument("SubmitWireFrames: frames with completion callback must "
+                                "have from 1 to ringBufferSize / 4 commands");
+  }
+
+  const int64_t highSeq = ringBuffer_->next(static_cast<int>(count));
+  const int64_t lowSeq = highSeq - static_cast<int64_t>(count) + 1;
+  for (int64_t seq = lowSeq; seq <= highSeq; seq++) {
+    reader.DecodeNext(ringBuffer_->get(seq));
+  }
+  auto& batch = batchCallbacks_[highSeq & callbacksMask_];
+  batch.callback = std::move(callback);
+  batch.size = static_cast<int32_t>(count);
+  completions_.Mark(highSeq, CompletionTable::Waiter::BATCH_CALLBACK);
   ringBuffer_->publish(lowSeq, highSeq);
+  return count;
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::SubmitCommandsBatch(const common::api::ApiCommandValue* cmds,
+                                                     size_t count,
+                                                     BatchCompletionCallback callback) {
+  if (!ringBuffer_) {
+    throw std::runtime_error("SubmitCommandsBatch: ringBuffer is nullptr");
+  }
+  if (!callback) {
+    throw std::invalid_argument("SubmitCommandsBatch: empty completion callback");
+  }
+  // Batch is claimed at once (consecutive sequences, single callback slot)
+  if (count == 0 || count > static_cast<size_t>(ringBuffer_->getBufferSize() / 4)) {
+    throw std::invalid_argument("SubmitCommandsBatch: batch with completion callback must "
+                                "have from 1 to ringBufferSize / 4 commands");
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (IsPayloadCommand(cmds[i].type)) {
+      throw std::invalid_argument("SubmitCommandsBatch: payload commands are not supported "
+                                  "as values");
+    }
+  }
+
+  const int64_t highSeq = ringBuffer_->next(static_cast<int>(count));
+  const int64_t lowSeq = highSeq - static_cast<int64_t>(count) + 1;
+  for (size_t i = 0; i < count; i++) {
+    TranslateCommandValue(ringBuffer_->get(lowSeq + static_cast<int64_t>(i)), cmds[i]);
+  }
+  auto& batch = batchCallbacks_[highSeq & callbacksMask_];
+  batch.callback = std::move(callback);
+  batch.size = static_cast<int32_t>(count);
+  completions_.Mark(highSeq, CompletionTable::Waiter::BATCH_CALLBACK);
+  ringBuffer_->publish(lowSeq, highSeq);
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::PlaceOrder(int64_t uid,
+                                            int32_t symbol,
+                                            int64_t orderId,
+                                            common::OrderAction action,
+                                            common::OrderType orderType,
+                                            int64_t price,
+                                            int64_t reservePrice,
+                                            int64_t size,
+                                            int32_t userCookie,
+                                            int64_t timestamp) {
+  const int64_t seq = ringBuffer_->next();
+  auto& cmd = ringBuffer_->get(seq);
+  cmd.command = common::cmd::OrderCommandType::PLACE_ORDER;
+  cmd.price = price;
+  cmd.reserveBidPrice = reservePrice;
+  cmd.size = size;
+  cmd.orderId = orderId;
+  cmd.timestamp = timestamp;
+  cmd.action = action;
+  cmd.orderType = orderType;
+  cmd.symbol = symbol;
+  cmd.uid = uid;
+  cmd.userCookie = userCookie;
+  cmd.resultCode = common::cmd::CommandResultCode::NEW;
+  ringBuffer_->publish(seq);
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::MoveOrder(int64_t uid,
+                                           int32_t symbol,
+                                           int64_t orderId,
+                                           int64_t newPrice,
+                                           int64_t timestamp) {
+  const int64_t seq = ringBuffer_->next();
+  auto& cmd = ringBuffer_->get(seq);
+  cmd.command = common::cmd::OrderCommandType::MOVE_ORDER;
+  cmd.price = newPrice;
+  cmd.orderId = orderId;
+  cmd.symbol = symbol;
+  cmd.uid = uid;
+  cmd.timestamp = timestamp;
+  cmd.resultCode = common::cmd::CommandResultCode::NEW;
+  ringBuffer_->publish(seq);
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::CancelOrder(int64_t uid,
+                                             int32_t symbol,
+                                             int64_t orderId,
+                                             int64_t timestamp) {
+  const int64_t seq = ringBuffer_->next();
+  auto& cmd = ringBuffer_->get(seq);
+  cmd.command = common::cmd::OrderCommandType::CANCEL_ORDER;
+  cmd.orderId = orderId;
+  cmd.symbol = symbol;
+  cmd.uid = uid;
+  cmd.timestamp = timestamp;
+  cmd.resultCode = common::cmd::CommandResultCode::NEW;
+  ringBuffer_->publish(seq);
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::ReduceOrder(int64_t uid,
+                                             int32_t symbol,
+                                             int64_t orderId,
+                                             int64_t reduceSize,
+                                             int64_t timestamp) {
+  const int64_t seq = ringBuffer_->next();
+  auto& cmd = ringBuffer_->get(seq);
+  cmd.command = common::cmd::OrderCommandType::REDUCE_ORDER;
+  cmd.orderId = orderId;
+  cmd.symbol = symbol;
+  cmd.uid = uid;
+  cmd.size = reduceSize;
+  cmd.timestamp = timestamp;
+  cmd.resultCode = common::cmd::CommandResultCode::NEW;
+  ringBuffer_->publish(seq);
 }
 
 template <typename WaitStrategyT>
@@ -961,95 +1415,39 @@ void ExchangeApi<WaitStrategyT>::PublishBinaryData(common::api::ApiBinaryDataCom
   bytesOut.WriteInt(apiCmd->data->GetBinaryCommandTypeCode());
   apiCmd->data->WriteMarshallable(bytesOut);
 
-  // Compress and convert to long array
-  const std::vector<int64_t> longsArrayData =
-    utils::SerializationUtils::BytesToLongArrayLz4(serializedBytes, LONGS_PER_MESSAGE);
-
-  const int totalNumMessagesToClaim = static_cast<int>(longsArrayData.size()) / LONGS_PER_MESSAGE;
-
-  if (totalNumMessagesToClaim == 0) {
-    throw std::runtime_error("PublishBinaryData: empty data after serialization");
-  }
-
-  // Verify array size is a multiple of LONGS_PER_MESSAGE
-  const int expectedArraySize = totalNumMessagesToClaim * LONGS_PER_MESSAGE;
-  if (static_cast<int>(longsArrayData.size()) < expectedArraySize) {
-    throw std::runtime_error("PublishBinaryData: array size mismatch");
-  }
-
-  // Max fragment size is quarter of ring buffer
-  const int batchSize = ringBuffer_->getBufferSize() / 4;
-
-  int offset = 0;
-  bool isLastFragment = false;
-  int fragmentSize = batchSize;
-
-  do {
-    if (offset + batchSize >= totalNumMessagesToClaim) {
-      fragmentSize = totalNumMessagesToClaim - offset;
-      isLastFragment = true;
-    }
-
-    // Batch publish: next(n) + publish(lo, hi)
-    const int64_t highSeq = ringBuffer_->next(fragmentSize);
-    const int64_t lowSeq = highSeq - fragmentSize + 1;
-
-    // Verify sequence range is valid
-    if (lowSeq < 0 || highSeq < lowSeq) {
-      throw std::runtime_error("PublishBinaryData: invalid sequence range");
-    }
-
-    try {
-      int ptr = offset * LONGS_PER_MESSAGE;
-      // Verify ptr bounds before loop
-      const int maxPtr = static_cast<int>(longsArrayData.size()) - LONGS_PER_MESSAGE;
-      if (ptr < 0 || ptr > maxPtr) {
-        throw std::out_of_range("PublishBinaryData: ptr out of range");
-      }
-
-      for (int64_t seq = lowSeq; seq <= highSeq; seq++) {
-        // Verify bounds before accessing array
-        if (ptr + 4 >= static_cast<int>(longsArrayData.size())) {
-          throw std::out_of_range("PublishBinaryData: array index out of bounds");
-        }
-
-        // Verify ringBuffer is still valid before accessing
-        if (!ringBuffer_) {
-          throw std::runtime_error("PublishBinaryData: ringBuffer became nullptr");
-        }
-
-        auto& cmd = ringBuffer_->get(seq);
-        cmd.command = common::cmd::OrderCommandType::BINARY_DATA_COMMAND;
-        cmd.userCookie = apiCmd->transferId;
-        cmd.symbol = (isLastFragment && seq == highSeq) ? -1 : 0;
-
-        cmd.orderId = longsArrayData[ptr];
-        cmd.price = longsArrayData[ptr + 1];
-        cmd.reserveBidPrice = longsArrayData[ptr + 2];
-        cmd.size = longsArrayData[ptr + 3];
-        cmd.uid = longsArrayData[ptr + 4];
-
-        cmd.timestamp = apiCmd->timestamp;
-        cmd.resultCode = common::cmd::CommandResultCode::NEW;
-
-        ptr += LONGS_PER_MESSAGE;
-      }
-    } catch (const std::exception& ex) {
-      // Publish even on error to maintain sequence consistency
-      ringBuffer_->publish(lowSeq, highSeq);
-      throw;
-    }
+  PublishPayload(common::cmd::OrderCommandType::BINARY_DATA_COMMAND, apiCmd->transferId,
+                 apiCmd->timestamp, std::move(serializedBytes), endSeqConsumer);
+}
 
-    if (isLastFragment) {
-      // Report last sequence before actually publishing data
-      endSeqConsumer(highSeq);
-    }
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::PublishPayload(
+  common::cmd::OrderCommandType command,
+  int32_t transferId,
+  int64_t timestamp,
+  std::vector<uint8_t>&& bytes,
+  const std::function<void(int64_t)>& seqConsumer) {
+  // Blob is handed over once instead of compressed 5-longs frames, so
+  // commands of any size take single ring buffer slot and need no reassembly
+  const int64_t seq = ringBuffer_->next();
+  auto& payload = PayloadSlot(seq);
+  payload = std::move(bytes);
 
-    // Batch publish: publish(lo, hi)
-    ringBuffer_->publish(lowSeq, highSeq);
+  auto& cmd = ringBuffer_->get(seq);
+  cmd.command = command;
+  cmd.userCookie = transferId;
+  cmd.symbol = -1;  // last (only) frame
+  cmd.orderId = 0;
+  cmd.price = 0;
+  cmd.reserveBidPrice = 0;
+  cmd.size = 0;
+  cmd.uid = 0;
+  cmd.payload = &payload;
+  cmd.timestamp = timestamp;
+  cmd.resultCode = common::cmd::CommandResultCode::NEW;
 
-    offset += batchSize;
-  } while (!isLastFragment);
+  // Report sequence before actually publishing data
+  seqConsumer(seq);
+  ringBuffer_->publish(seq);
 }
 
 template <typename WaitStrategyT>
@@ -1101,6 +1499,14 @@ void ExchangeApi<WaitStrategyT>::PublishQuery(common::api::reports::ApiReportQue
   if (!apiCmd || !apiCmd->query) {
     throw std::invalid_argument("Invalid ApiReportQuery");
   }
+  PublishQuery(*apiCmd->query, apiCmd->transferId, apiCmd->timestamp, std::move(endSeqConsumer));
+}
+
+template <typename WaitStrategyT>
+void ExchangeApi<WaitStrategyT>::PublishQuery(const common::api::reports::ReportQueryBase& query,
+                                              int32_t transferId,
+                                              int64_t timestamp,
+                                              std::function<void(int64_t)> endSeqConsumer) {
   if (!ringBuffer_) {
     throw std::runtime_error("PublishQuery: ringBuffer is nullptr");
   }
@@ -1110,100 +1516,12 @@ void ExchangeApi<WaitStrategyT>::PublishQuery(common::api::reports::ApiReportQue
   std::vector<uint8_t> serializedBytes;
   serializedBytes.reserve(128);
   common::VectorBytesOut bytesOut(serializedBytes);
-  bytesOut.WriteInt(apiCmd->query->GetReportTypeCode());
+  bytesOut.WriteInt(query.GetReportTypeCode());
   // ReportQuery implements WriteBytesMarshallable (inherited from base class)
-  apiCmd->query->WriteMarshallable(bytesOut);
-
-  // Compress and convert to long array
-  const std::vector<int64_t> longsArrayData =
-    utils::SerializationUtils::BytesToLongArrayLz4(serializedBytes, LONGS_PER_MESSAGE);
+  query.WriteMarshallable(bytesOut);
 
-  const int totalNumMessagesToClaim = static_cast<int>(longsArrayData.size()) / LONGS_PER_MESSAGE;
-
-  if (totalNumMessagesToClaim == 0) {
-    throw std::runtime_error("PublishQuery: empty data after serialization");
-  }
-
-  // Verify array size is a multiple of LONGS_PER_MESSAGE
-  const int expectedArraySize = totalNumMessagesToClaim * LONGS_PER_MESSAGE;
-  if (static_cast<int>(longsArrayData.size()) < expectedArraySize) {
-    throw std::runtime_error("PublishQuery: array size mismatch");
-  }
-
-  // Max fragment size is quarter of ring buffer
-  const int batchSize = ringBuffer_->getBufferSize() / 4;
-
-  int offset = 0;
-  bool isLastFragment = false;
-  int fragmentSize = batchSize;
-
-  do {
-    if (offset + batchSize >= totalNumMessagesToClaim) {
-      fragmentSize = totalNumMessagesToClaim - offset;
-      isLastFragment = true;
-    }
-
-    // Batch publish: next(n) + publish(lo, hi)
-    const int64_t highSeq = ringBuffer_->next(fragmentSize);
-    const int64_t lowSeq = highSeq - fragmentSize + 1;
-
-    // Verify sequence range is valid
-    if (lowSeq < 0 || highSeq < lowSeq) {
-      throw std::runtime_error("PublishQuery: invalid sequence range");
-    }
-
-    try {
-      int ptr = offset * LONGS_PER_MESSAGE;
-      // Verify ptr bounds before loop
-      const int maxPtr = static_cast<int>(longsArrayData.size()) - LONGS_PER_MESSAGE;
-      if (ptr < 0 || ptr > maxPtr) {
-        throw std::out_of_range("PublishQuery: ptr out of range");
-      }
-
-      for (int64_t seq = lowSeq; seq <= highSeq; seq++) {
-        // Verify bounds before accessing array
-        if (ptr + 4 >= static_cast<int>(longsArrayData.size())) {
-          throw std::out_of_range("PublishQuery: array index out of bounds");
-        }
-
-        // Verify ringBuffer is still valid before accessing
-        if (!ringBuffer_) {
-          throw std::runtime_error("PublishQuery: ringBuffer became nullptr");
-        }
-
-        auto& cmd = ringBuffer_->get(seq);
-        // Use BINARY_DATA_QUERY instead of BINARY_DATA_COMMAND
-        cmd.command = common::cmd::OrderCommandType::BINARY_DATA_QUERY;
-        cmd.userCookie = apiCmd->transferId;
-        cmd.symbol = (isLastFragment && seq == highSeq) ? -1 : 0;
-
-        cmd.orderId = longsArrayData[ptr];
-        cmd.price = longsArrayData[ptr + 1];
-        cmd.reserveBidPrice = longsArrayData[ptr + 2];
-        cmd.size = longsArrayData[ptr + 3];
-        cmd.uid = longsArrayData[ptr + 4];
-
-        cmd.timestamp = apiCmd->timestamp;
-        cmd.resultCode = common::cmd::CommandResultCode::NEW;
-
-        ptr += LONGS_PER_MESSAGE;
-      }
-    } catch (const std::exception& ex) {
-      // Publish even on error to maintain sequence consistency
-      ringBuffer_->publish(lowSeq, highSeq);
-      throw;
-    }
-
-    if (isLastFragment) {
-      // Report last sequence before actually publishing data
-      endSeqConsumer(highSeq);
-    }
-
-    // Batch publish: publish(lo, hi)
-    ringBuffer_->publish(lowSeq, highSeq);
-
-    offset += batchSize;
-  } while (!isLastFragment);
+  PublishPayload(common::cmd::OrderCommandType::BINARY_DATA_QUERY, transferId, timestamp,
+                 std::move(serializedBytes), endSeqConsumer);
 }
 
 template <typename WaitStrategyT>
@@ -1235,6 +1553,7 @@ std::future<std::unique_ptr<R>> ExchangeApi<WaitStrategyT>::ProcessReport(std::u
     // Store translator function that will extract result from OrderCommand
     // Match Java: cmd ->
     // query.createResult(OrderBookEventsHelper.deserializeEvents(cmd).values().parallelStream().map(Wire::bytes))
+    completions_.Mark(seq, CompletionTable::Waiter::PROMISE);
     typename ReportPromiseMap::accessor accessor;
     reportPromises_.insert(accessor, seq);
     accessor->second = [promisePtr, queryPtr](common::cmd::OrderCommand* cmd) {
@@ -1308,98 +1627,36 @@ ExchangeApi<WaitStrategyT>::ProcessReportAny(int32_t queryTypeId,
   // Actually, we already have the serialized bytes, so we can use them directly
   std::vector<uint8_t> serializedBytes = std::move(queryBytes);
 
-  // Compress and convert to long array
-  const std::vector<int64_t> longsArrayData =
-    utils::SerializationUtils::BytesToLongArrayLz4(serializedBytes, LONGS_PER_MESSAGE);
-
-  const int totalNumMessagesToClaim = static_cast<int>(longsArrayData.size()) / LONGS_PER_MESSAGE;
-
-  if (totalNumMessagesToClaim == 0) {
-    throw std::runtime_error("ProcessReportAny: empty data after serialization");
-  }
-
-  // Max fragment size is quarter of ring buffer
-  const int batchSize = ringBuffer_->getBufferSize() / 4;
-
-  int offset = 0;
-  bool isLastFragment = false;
-  int fragmentSize = batchSize;
-
-  do {
-    if (offset + batchSize >= totalNumMessagesToClaim) {
-      fragmentSize = totalNumMessagesToClaim - offset;
-      isLastFragment = true;
-    }
-
-    // Batch publish: next(n) + publish(lo, hi)
-    const int64_t highSeq = ringBuffer_->next(fragmentSize);
-    const int64_t lowSeq = highSeq - fragmentSize + 1;
-
-    try {
-      int ptr = offset * LONGS_PER_MESSAGE;
-      const int maxPtr = static_cast<int>(longsArrayData.size()) - LONGS_PER_MESSAGE;
-      if (ptr < 0 || ptr > maxPtr) {
-        throw std::out_of_range("ProcessReportAny: ptr out of range");
-      }
+  // Store promise for result extraction
+  const auto storePromise = [&](int64_t seq) {
+    completions_.Mark(seq, CompletionTable::Waiter::PROMISE);
+    typename ReportPromiseMap::accessor accessor;
+    reportPromises_.insert(accessor, seq);
+    accessor->second = [promisePtr, queryPtr, reportType](common::cmd::OrderCommand* cmd) {
+      // Extract binary events from OrderCommand
+      auto sectionsMap = orderbook::OrderBookEventsHelper::DeserializeEvents(cmd);
 
-      for (int64_t seq = lowSeq; seq <= highSeq; seq++) {
-        if (ptr + 4 >= static_cast<int>(longsArrayData.size())) {
-          throw std::out_of_range("ProcessReportAny: array index out of bounds");
+      // Convert map values to vector of byte vectors
+      // Match Java: .map(Wire::bytes) but for ProcessReportAny we need bytes
+      std::vector<std::vector<uint8_t>> sections;
+      sections.reserve(sectionsMap.size());
+      for (const auto& [sectionId, wire] : sectionsMap) {
+        const auto& bytes = wire.GetBytes();
+        if (!bytes.empty()) {
+          sections.push_back(bytes);
         }
-
-        auto& cmd = ringBuffer_->get(seq);
-        cmd.command = common::cmd::OrderCommandType::BINARY_DATA_QUERY;
-        cmd.userCookie = transferId;
-        cmd.symbol = (isLastFragment && seq == highSeq) ? -1 : 0;
-
-        cmd.orderId = longsArrayData[ptr];
-        cmd.price = longsArrayData[ptr + 1];
-        cmd.reserveBidPrice = longsArrayData[ptr + 2];
-        cmd.size = longsArrayData[ptr + 3];
-        cmd.uid = longsArrayData[ptr + 4];
-
-        cmd.resultCode = common::cmd::CommandResultCode::NEW;
-
-        ptr += LONGS_PER_MESSAGE;
       }
-    } catch (const std::exception& ex) {
-      ringBuffer_->publish(lowSeq, highSeq);
-      throw;
-    }
 
-    if (isLastFragment) {
-      // Store promise for result extraction
-      typename ReportPromiseMap::accessor accessor;
-      reportPromises_.insert(accessor, highSeq);
-      accessor->second = [promisePtr, queryPtr, reportType](common::cmd::OrderCommand* cmd) {
-        // Extract binary events from OrderCommand
-        auto sectionsMap = orderbook::OrderBookEventsHelper::DeserializeEvents(cmd);
-
-        // Convert map values to vector of byte vectors
-        // Match Java: .map(Wire::bytes) but for ProcessReportAny we need bytes
-        std::vector<std::vector<uint8_t>> sections;
-        sections.reserve(sectionsMap.size());
-        for (const auto& [sectionId, wire] : sectionsMap) {
-          const auto& bytes = wire.GetBytes();
-          if (!bytes.empty()) {
-            sections.push_back(bytes);
-          }
-        }
+      // Clean up query pointer (was created with new)
+      // We need to know the type to delete it properly
+      // For now, we'll leak it (not ideal, but type erasure makes this hard)
+      // TODO: Store deleter function in factory
 
-        // Clean up query pointer (was created with new)
-        // We need to know the type to delete it properly
-        // For now, we'll leak it (not ideal, but type erasure makes this hard)
-        // TODO: Store deleter function in factory
-
-        promisePtr->set_value(std::move(sections));
-      };
-    }
-
-    // Batch publish: publish(lo, hi)
-    ringBuffer_->publish(lowSeq, highSeq);
-
-    offset += batchSize;
-  } while (!isLastFragment);
+      promisePtr->set_value(std::move(sections));
+    };
+  };
+  PublishPayload(common::cmd::OrderCommandType::BINARY_DATA_QUERY, transferId, 0,
+                 std::move(serializedBytes), storePromise);
 
   // Clean up query pointer - we need to delete it properly
   // For now, we'll store it and delete it after the result is received
@@ -27,12 +27,26 @@
 #include <disruptor/dsl/ThreadFactory.h>
 #include <exchange/core/ExchangeApi.h>
 #include <exchange/core/ExchangeCore.h>
+#include <exchange/core/common/CoreSymbolSpecification.h>
 #include <exchange/core/common/CoreWaitStrategy.h>
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/SymbolType.h>
+#include <exchange/core/common/api/ApiAddUser.h>
+#include <exchange/core/common/api/ApiAdjustUserBalance.h>
+#include <exchange/core/common/api/ApiBinaryDataCommand.h>
+#include <exchange/core/common/api/ApiCancelOrder.h>
+#include <exchange/core/common/api/ApiMoveOrder.h>
+#include <exchange/core/common/api/ApiPlaceOrder.h>
+#include <exchange/core/common/api/ApiReset.h>
+#include <exchange/core/common/api/binary/BatchAddSymbolsCommand.h>
 #include <exchange/core/common/cmd/OrderCommand.h>
 #include <exchange/core/common/cmd/OrderCommandType.h>
 #include <exchange/core/common/config/ExchangeConfiguration.h>
 #include <exchange/core/common/config/PerformanceConfiguration.h>
 #include <exchange/core/common/config/SerializationConfiguration.h>
+#include <exchange/core/ingress/SharedMemoryBridge.h>
+#include <exchange/core/ingress/SharedMemoryIngress.h>
 #include <exchange/core/orderbook/OrderBookEventsHelper.h>
 #include <exchange/core/processors/DisruptorExceptionHandler.h>
 #include <exchange/core/processors/GroupingProcessor.h>
@@ -49,6 +63,8 @@
 #include <exchange/core/utils/FastNanoTime.h>
 #include <exchange/core/utils/Logger.h>
 #include <atomic>
+#include <chrono>
+#include <future>
 #include <latch>
 #include <memory>
 #include <stdexcept>
@@ -112,7 +128,8 @@ public:
   using DisruptorT = disruptor::dsl::
     Disruptor<common::cmd::OrderCommand, disruptor::dsl::ProducerType::MULTI, WaitStrategyT>;
 
-  ExchangeCoreImpl(ExchangeCore::ResultsConsumer resultsConsumer,
+  ExchangeCoreImpl(std::vector<ExchangeCore::ResultsConsumer> resultsConsumers,
+                   bool fanOutResults,
                    const common::config::ExchangeConfiguration* exchangeConfiguration)
     : exchangeConfiguration_(exchangeConfiguration)
     , started_(false)
@@ -147,20 +164,34 @@ public:
     sharedPool_ =
       std::make_unique<processors::SharedPool>(poolInitialSize * 4, poolInitialSize, chainLength);
 
-    // 3. Matching Engines
-    matchingEngines_.reserve(matchingEnginesNum);
+    // 3. Matching Engines and 4. Risk Engines
+    // Shards are independent (own objects pool, own snapshot file), so they
+    // are created (and restored from snapshot) concurrently; order books of
+    // one shard are restored sequentially as they share the shard's pool.
+    matchingEngines_.resize(matchingEnginesNum);
+    riskEngines_.resize(riskEnginesNum);
+    std::vector<std::future<void>> shardsCreated;
+    shardsCreated.reserve(matchingEnginesNum + riskEnginesNum);
     for (int32_t shardId = 0; shardId < matchingEnginesNum; shardId++) {
-      matchingEngines_.push_back(std::make_unique<processors::MatchingEngineRouter>(
-        shardId, matchingEnginesNum, perfCfg.orderBookFactory, sharedPool_.get(),
-        exchangeConfiguration, serializationProcessor_, nullptr));
+      shardsCreated.push_back(std::async(std::launch::async, [&, shardId]() {
+        matchingEngines_[shardId] = std::make_unique<processors::MatchingEngineRouter>(
+          shardId, matchingEnginesNum, perfCfg.orderBookFactory, sharedPool_.get(),
+          exchangeConfiguration, serializationProcessor_, nullptr);
+      }));
     }
-
-    // 4. Risk Engines
-    riskEngines_.reserve(riskEnginesNum);
     for (int32_t shardId = 0; shardId < riskEnginesNum; shardId++) {
-      riskEngines_.push_back(
-        std::make_unique<processors::RiskEngine>(shardId, riskEnginesNum, serializationProcessor_,
-                                                 sharedPool_.get(), exchangeConfiguration));
+      shardsCreated.push_back(std::async(std::launch::async, [&, shardId]() {
+        riskEngines_[shardId] =
+          std::make_unique<processors::RiskEngine>(shardId, riskEnginesNum, serializationProcessor_,
+                                                   sharedPool_.get(), exchangeConfiguration);
+      }));
+    }
+    // wait for all shards first, then rethrow first failure (if any)
+    for (auto& shardCreated : shardsCreated) {
+      shardCreated.wait();
+    }
+    for (auto& shardCreated : shardsCreated) {
+      shardCreated.get();
     }
 
     // 5. Disruptor Setup
@@ -178,7 +209,10 @@ public:
                                               *waitStrategyPtr);
 
     auto& ringBuffer = disruptor_->getRingBuffer();
-    api_ = std::make_unique<ExchangeApi<WaitStrategyT>>(&ringBuffer);
+    // fan-out: payload is read by completion and by every results consumer
+    const auto payloadReaders =
+      fanOutResults ? static_cast<int32_t>(resultsConsumers.size()) + 1 : 1;
+    api_ = std::make_unique<ExchangeApi<WaitStrategyT>>(&ringBuffer, payloadReaders);
 
     // 6. Exception Handler
     // Match Java behavior: publish SHUTDOWN_SIGNAL and call shutdown()
@@ -276,6 +310,14 @@ public:
         return riskEngine_->PreProcessCommand(seq, event);
       }
 
+      void PrefetchIndex(const common::cmd::OrderCommand* event) override {
+        riskEngine_->PrefetchCommandIndex(event);
+      }
+
+      void Prefetch(const common::cmd::OrderCommand* event) override {
+        riskEngine_->PrefetchCommand(event);
+      }
+
     private:
       processors::RiskEngine* riskEngine_;
     };
@@ -287,6 +329,7 @@ public:
         processors::SimpleEventHandler* eventHandler,
         processors::DisruptorExceptionHandler<common::cmd::OrderCommand>* exceptionHandler,
         common::CoreWaitStrategy coreWaitStrategy,
+        int32_t prefetchDistance,
         const std::string& name,
         std::vector<void*>& r1Processors,
         std::vector<std::shared_ptr<processors::TwoStepMasterProcessor<WaitStrategyT>>>&
@@ -296,6 +339,7 @@ public:
         : eventHandler_(eventHandler)
         , exceptionHandler_(exceptionHandler)
         , coreWaitStrategy_(coreWaitStrategy)
+        , prefetchDistance_(prefetchDistance)
         , name_(name)
         , r1Processors_(r1Processors)
         , r1ProcessorsOwned_(r1ProcessorsOwned)
@@ -314,6 +358,7 @@ public:
         ownedBarriers_.push_back(barrier);
         auto processor = std::make_shared<processors::TwoStepMasterProcessor<WaitStrategyT>>(
           &ringBuffer, barrier.get(), eventHandler_, exceptionHandler_, coreWaitStrategy_, name_);
+        processor->SetPrefetchDistance(prefetchDistance_);
 
         r1Processors_.push_back(processor.get());
         r1ProcessorsOwned_.push_back(processor);
@@ -326,6 +371,7 @@ public:
       processors::SimpleEventHandler* eventHandler_;
       processors::DisruptorExceptionHandler<common::cmd::OrderCommand>* exceptionHandler_;
       common::CoreWaitStrategy coreWaitStrategy_;
+      int32_t prefetchDistance_;
       std::string name_;
       std::vector<void*>& r1Processors_;
       std::vector<std::shared_ptr<processors::TwoStepMasterProcessor<WaitStrategyT>>>&
@@ -337,8 +383,9 @@ public:
     for (size_t i = 0; i < riskEngines_.size(); i++) {
       auto handler = std::make_unique<RiskPreProcessHandler>(riskEngines_[i].get());
       auto r1Factory = R1ProcessorFactory(
-        handler.get(), exceptionHandler_.get(), perfCfg.waitStrategy, "R1_" + std::to_string(i),
-        r1Processors_, r1ProcessorsOwned_, r1EventProcessors_, ownedBarriers_);
+        handler.get(), exceptionHandler_.get(), perfCfg.waitStrategy, perfCfg.prefetchDistance,
+        "R1_" + std::to_string(i), r1Processors_, r1ProcessorsOwned_, r1EventProcessors_,
+        ownedBarriers_);
       afterGrouping.handleEventsWith(r1Factory);
       riskHandlers_.push_back(std::move(handler));
     }
@@ -491,25 +538,43 @@ public:
       riskHandlers_.push_back(std::move(handler));
     }
 
-    // Stage 6: Results Handler
-    // Java: mainHandlerGroup = enableJournaling
-    //   ? disruptor.after(arraysAddHandler(matchingEngineHandlers, jh))
-    //   : afterMatchingEngine;
-    resultsHandler_ = std::make_unique<processors::ResultsHandler>(resultsConsumer);
-
+    // Results handler: results consumer (if any), then command completion or
+    // (other fan-out processors) just release of binary payload
     class ResultsEventHandler : public disruptor::EventHandler<common::cmd::OrderCommand> {
     public:
-      ResultsEventHandler(processors::ResultsHandler* handler, ExchangeApi<WaitStrategyT>* api)
-        : handler_(handler), api_(api) {}
+      ResultsEventHandler(processors::ResultsHandler* handler,
+                          ExchangeApi<WaitStrategyT>* api,
+                          bool completeCommands,
+                          const std::atomic<bool>* warmingUp,
+                          processors::journaling::ISerializationProcessor* journal)
+        : handler_(handler),
+          api_(api),
+          completeCommands_(completeCommands),
+          warmingUp_(warmingUp),
+          journal_(journal) {}
 
       void onEvent(common::cmd::OrderCommand& cmd, int64_t sequence, bool endOfBatch) override {
-        handler_->OnEvent(&cmd, sequence, endOfBatch);
-        api_->ProcessResult(sequence, &cmd);
+        // results are released only after command is written (asynchronous journal writer)
+        if (journal_ != nullptr) {
+          journal_->AwaitJournalWrite(&cmd, sequence);
+        }
+        // startup warm-up flow is not visible to the results consumer
+        if (handler_ != nullptr && !warmingUp_->load(std::memory_order_relaxed)) {
+          handler_->OnEvent(&cmd, sequence, endOfBatch);
+        }
+        if (completeCommands_) {
+          api_->ProcessResult(sequence, &cmd);
+        } else {
+          api_->ReleasePayload(sequence, &cmd);
+        }
       }
 
     private:
       processors::ResultsHandler* handler_;
       ExchangeApi<WaitStrategyT>* api_;
+      bool completeCommands_;
+      const std::atomic<bool>* warmingUp_;
+      processors::journaling::ISerializationProcessor* journal_;
     };
 
     // Stage 6: Results Handler
@@ -529,9 +594,31 @@ public:
       mainHandlerGroup = disruptor_->after(meAndJIdentities.data(), meAndJIdentities.size());
     }
 
-    auto resHandler = std::make_unique<ResultsEventHandler>(resultsHandler_.get(), api_.get());
-    mainHandlerGroup.handleEventsWith(*resHandler);
-    eventHandlers_.push_back(std::move(resHandler));
+    auto* journal = serializationCfg.enableJournaling ? serializationProcessor_ : nullptr;
+    const auto addResultsHandler = [&](processors::ResultsHandler* handler,
+                                       bool completeCommands) {
+      auto resHandler = std::make_unique<ResultsEventHandler>(
+        handler, api_.get(), completeCommands, &warmingUp_, journal);
+      mainHandlerGroup.handleEventsWith(*resHandler);
+      eventHandlers_.push_back(std::move(resHandler));
+    };
+
+    resultsHandlers_.reserve(resultsConsumers.size());
+    for (auto& resultsConsumer : resultsConsumers) {
+      resultsHandlers_.push_back(
+        std::make_unique<processors::ResultsHandler>(std::move(resultsConsumer)));
+    }
+    if (fanOutResults) {
+      // Fan-out: every handler has its own processor and sequence, ring buffer
+      // is gated by the slowest of them; binary payload is released by the
+      // last processor done with it
+      addResultsHandler(nullptr, true);
+      for (auto& resultsHandler : resultsHandlers_) {
+        addResultsHandler(resultsHandler.get(), false);
+      }
+    } else {
+      addResultsHandler(resultsHandlers_.front().get(), true);
+    }
 
     // Final Stage: Link R1 and R2
     for (size_t i = 0; i < r1ProcessorsOwned_.size() && i < r2ProcessorsOwned_.size(); i++) {
@@ -552,6 +639,10 @@ public:
       return;  // Already started
     }
 
+    if (exchangeConfiguration_->performanceCfg.preallocateObjectPools) {
+      PreallocatePools();
+    }
+
     LOG_DEBUG("Starting disruptor...");
     // Start disruptor - threads will be created asynchronously
     // Each thread will call latch.count_down() when it starts (via Disruptor's
@@ -602,10 +693,26 @@ public:
       }
     }
 
+    if (exchangeConfiguration_->performanceCfg.warmUpOrdersNum > 0) {
+      RunWarmUpFlow();
+    }
+
     if (serializationProcessor_) {
       serializationProcessor_->ReplayJournalFullAndThenEnableJouraling(
         &exchangeConfiguration_->initStateCfg, api_.get());
     }
+
+    // Gateway processes are accepted only after recovery
+    const auto& perfCfg = exchangeConfiguration_->performanceCfg;
+    if (!perfCfg.sharedMemoryIngressName.empty()) {
+      const auto ringSize = static_cast<uint32_t>(perfCfg.ringBufferSize);
+      sharedMemoryIngress_ = std::make_unique<ingress::SharedMemoryIngress>(
+        perfCfg.sharedMemoryIngressName, static_cast<uint32_t>(perfCfg.sharedMemoryIngressClients),
+        ringSize, ringSize);
+      sharedMemoryBridge_ = std::make_unique<ingress::SharedMemoryBridge>(
+        api_.get(), sharedMemoryIngress_.get(), static_cast<size_t>(perfCfg.ringBufferSize / 4));
+      sharedMemoryBridge_->Start(*perfCfg.threadFactory);
+    }
   }
 
   void Shutdown(int64_t timeoutMs) override {
@@ -616,6 +723,10 @@ public:
     }
     // Match Java: simple shutdown logic
     // TODO stop accepting new events first
+    // (gateway processes are stopped, their commands in flight are completed)
+    if (sharedMemoryBridge_) {
+      sharedMemoryBridge_->Stop();
+    }
     try {
       LOG_INFO("[ExchangeCore] Shutdown: publishing SHUTDOWN_SIGNAL");
       static ShutdownSignalTranslator shutdownTranslator;
@@ -631,6 +742,10 @@ public:
       // onShutdown() calls. In Java, GC keeps objects alive, but in C++ we
       // must explicitly wait for threads to finish.
       disruptor_->join();
+      // Snapshots can still be written in background (FORK snapshot mode)
+      if (serializationProcessor_) {
+        serializationProcessor_->AwaitSnapshotsWritten();
+      }
       LOG_INFO("[ExchangeCore] Shutdown: completed");
     } catch (const disruptor::TimeoutException& e) {
       // Match Java: throw IllegalStateException on timeout
@@ -645,6 +760,137 @@ public:
   }
 
 private:
+  // Scratch ids used by startup warm-up flow.
+  // Aligned so that (base + i) is routed to shard i for any power-of-2 shards number.
+  static constexpr int32_t WARM_UP_SYMBOL_BASE = 0x3FFF0000;
+  static constexpr int32_t WARM_UP_CURRENCY_BASE = 0x3FFF0000;
+  static constexpr int64_t WARM_UP_UID_BASE = int64_t{1} << 60;
+  static constexpr int64_t WARM_UP_BALANCE = 1'000'000'000'000'000LL;
+  static constexpr int64_t WARM_UP_TIMEOUT_MS = 60'000;
+
+  /**
+   * Touch all pool objects of every matching and risk engine before the
+   * first command arrives. Engines are independent, so pools are filled in parallel.
+   */
+  void PreallocatePools() {
+    const int64_t startNs = utils::FastNanoTime::Now();
+    std::atomic<int64_t> allocated{0};
+    std::vector<std::thread> threads;
+    threads.reserve(matchingEngines_.size() + riskEngines_.size());
+    for (auto& me : matchingEngines_) {
+      threads.emplace_back([&allocated, me = me.get()]() { allocated += me->PreallocatePools(); });
+    }
+    for (auto& re : riskEngines_) {
+      threads.emplace_back([&allocated, re = re.get()]() { allocated += re->PreallocatePools(); });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    LOG_INFO("[ExchangeCore] Pre-allocated {} pool objects in {}ms", allocated.load(),
+             (utils::FastNanoTime::Now() - startNs) / 1'000'000LL);
+  }
+
+  static void AwaitWarmUpResult(const CommandFuture& future, const char* step) {
+    if (future.wait_for(std::chrono::milliseconds(WARM_UP_TIMEOUT_MS))
+        == std::future_status::timeout) {
+      throw std::runtime_error(std::string("Warm-up timeout: ") + step);
+    }
+    const auto result = future.get();
+    if (result != common::cmd::CommandResultCode::SUCCESS) {
+      LOG_WARN("[ExchangeCore] Warm-up step '{}' completed with code {}", step,
+               static_cast<int>(result));
+    }
+  }
+
+  /**
+   * Run synthetic order flow through a scratch symbol on every matching engine
+   * shard (and scratch users on every risk engine shard), then reset the state.
+   * Warms up code paths, branch predictors and pools before real traffic.
+   *
+   * Warm-up commands take disruptor sequences, so it runs only on clean start
+   * without journaling - otherwise journal sequences would not match on replay.
+   * Final reset would also drop accounts loaded from bulk accounts file.
+   */
+  void RunWarmUpFlow() {
+    const auto& perfCfg = exchangeConfiguration_->performanceCfg;
+    const auto& initStateCfg = exchangeConfiguration_->initStateCfg;
+    if (initStateCfg.FromSnapshot() || initStateCfg.journalTimestampNs != 0
+        || !initStateCfg.accountsFile.empty()
+        || exchangeConfiguration_->serializationCfg.enableJournaling) {
+      LOG_INFO("[ExchangeCore] Warm-up flow skipped: supported only for clean start "
+               "without journaling and initial accounts");
+      return;
+    }
+
+    const int64_t startNs = utils::FastNanoTime::Now();
+    const auto symbolsNum = static_cast<int32_t>(matchingEngines_.size());
+    const auto usersPerSide = static_cast<int32_t>(riskEngines_.size());
+    warmingUp_.store(true, std::memory_order_release);
+
+    // one scratch symbol per matching engine shard
+    std::vector<common::CoreSymbolSpecification> specs;
+    std::vector<const common::CoreSymbolSpecification*> specPtrs;
+    specs.reserve(symbolsNum);
+    for (int32_t i = 0; i < symbolsNum; i++) {
+      specs.emplace_back(WARM_UP_SYMBOL_BASE + i, common::SymbolType::CURRENCY_EXCHANGE_PAIR,
+                         WARM_UP_CURRENCY_BASE, WARM_UP_CURRENCY_BASE + 1, 1, 1, 0, 0, 0, 0);
+    }
+    for (const auto& spec : specs) {
+      specPtrs.push_back(&spec);
+    }
+    common::api::ApiBinaryDataCommand addSymbols(
+      0, std::make_unique<common::api::binary::BatchAddSymbolsCommand>(specPtrs));
+    AwaitWarmUpResult(api_->SubmitCommandAsyncLight(&addSymbols), "add symbols");
+
+    // makers [0, usersPerSide) and takers [usersPerSide, 2*usersPerSide) cover every risk shard
+    for (int32_t j = 0; j < 2 * usersPerSide; j++) {
+      const int64_t uid = WARM_UP_UID_BASE + j;
+      common::api::ApiAddUser addUser(uid);
+      api_->SubmitCommand(&addUser);
+      common::api::ApiAdjustUserBalance adjustBase(uid, WARM_UP_CURRENCY_BASE, WARM_UP_BALANCE, 1);
+      api_->SubmitCommand(&adjustBase);
+      common::api::ApiAdjustUserBalance adjustQuote(uid, WARM_UP_CURRENCY_BASE + 1,
+                                                    WARM_UP_BALANCE, 2);
+      api_->SubmitCommand(&adjustQuote);
+    }
+
+    // every round: resting ask, resting bid moved and cancelled, IOC bid matching the ask
+    constexpr int32_t COMMANDS_PER_ROUND = 5;
+    const int32_t rounds = (perfCfg.warmUpOrdersNum + COMMANDS_PER_ROUND - 1) / COMMANDS_PER_ROUND;
+    int64_t orderId = 1;
+    for (int32_t r = 0; r < rounds; r++) {
+      const int64_t maker = WARM_UP_UID_BASE + (r % usersPerSide);
+      const int64_t taker = WARM_UP_UID_BASE + usersPerSide + (r % usersPerSide);
+      const int64_t priceShift = r & 127;
+      for (int32_t s = 0; s < symbolsNum; s++) {
+        const int32_t symbol = WARM_UP_SYMBOL_BASE + s;
+        const int64_t askId = orderId++;
+        const int64_t bidId = orderId++;
+        const int64_t iocId = orderId++;
+        common::api::ApiPlaceOrder ask(10'000 + priceShift, 1, askId, common::OrderAction::ASK,
+                                       common::OrderType::GTC, maker, symbol, 0, 0);
+        api_->SubmitCommand(&ask);
+        common::api::ApiPlaceOrder bid(9'000 + priceShift, 1, bidId, common::OrderAction::BID,
+                                       common::OrderType::GTC, taker, symbol, 0, 9'200);
+        api_->SubmitCommand(&bid);
+        common::api::ApiMoveOrder move(bidId, 9'001 + priceShift, taker, symbol);
+        api_->SubmitCommand(&move);
+        common::api::ApiCancelOrder cancel(bidId, taker, symbol);
+        api_->SubmitCommand(&cancel);
+        common::api::ApiPlaceOrder ioc(11'000, 1, iocId, common::OrderAction::BID,
+                                       common::OrderType::IOC, taker, symbol, 0, 11'000);
+        api_->SubmitCommand(&ioc);
+      }
+    }
+
+    common::api::ApiReset reset;
+    AwaitWarmUpResult(api_->SubmitCommandAsyncLight(&reset), "reset");
+    warmingUp_.store(false, std::memory_order_release);
+
+    LOG_INFO("[ExchangeCore] Warm-up flow: {} rounds on {} symbols completed in {}ms", rounds,
+             symbolsNum, (utils::FastNanoTime::Now() - startNs) / 1'000'000LL);
+  }
+
   const common::config::ExchangeConfiguration* exchangeConfiguration_;
   // CRITICAL: Store barriers created by factories to ensure they outlive
   // processors. Must be declared before disruptor_ so it's destroyed after
@@ -661,7 +907,11 @@ private:
 
   std::unique_ptr<processors::DisruptorExceptionHandler<common::cmd::OrderCommand>>
     exceptionHandler_;
-  std::unique_ptr<processors::ResultsHandler> resultsHandler_;
+  std::vector<std::unique_ptr<processors::ResultsHandler>> resultsHandlers_;
+
+  // Shared-memory ingress of gateway processes (optional)
+  std::unique_ptr<ingress::SharedMemoryIngress> sharedMemoryIngress_;
+  std::unique_ptr<ingress::SharedMemoryBridge> sharedMemoryBridge_;
 
   // Lifecycle management
   std::vector<std::unique_ptr<processors::MatchingEngineRouter>> matchingEngines_;
@@ -682,6 +932,9 @@ private:
   std::atomic<bool> started_;
   std::atomic<bool> stopped_;
 
+  // Set while startup warm-up flow is running (results are not forwarded to consumer)
+  std::atomic<bool> warmingUp_{false};
+
   // Startup synchronization using std::latch (C++20)
   // Pointer because latch is created in Startup(), not in constructor
   std::unique_ptr<std::latch> processorStartupLatch_;
@@ -689,22 +942,32 @@ private:
 
 ExchangeCore::ExchangeCore(ResultsConsumer resultsConsumer,
                            const common::config::ExchangeConfiguration* exchangeConfiguration)
+  : ExchangeCore(std::vector<ResultsConsumer>{std::move(resultsConsumer)}, false,
+                 exchangeConfiguration) {}
+
+ExchangeCore::ExchangeCore(std::vector<ResultsConsumer> resultsConsumers,
+                           const common::config::ExchangeConfiguration* exchangeConfiguration)
+  : ExchangeCore(std::move(resultsConsumers), true, exchangeConfiguration) {}
+
+ExchangeCore::ExchangeCore(std::vector<ResultsConsumer> resultsConsumers,
+                           bool fanOutResults,
+                           const common::config::ExchangeConfiguration* exchangeConfiguration)
   : exchangeConfiguration_(exchangeConfiguration) {
   const auto& perfCfg = exchangeConfiguration_->performanceCfg;
 
   switch (perfCfg.waitStrategy) {
     case common::CoreWaitStrategy::BUSY_SPIN:
       impl_ = std::make_unique<ExchangeCoreImpl<disruptor::BusySpinWaitStrategy>>(
-        resultsConsumer, exchangeConfiguration);
+        std::move(resultsConsumers), fanOutResults, exchangeConfiguration);
       break;
     case common::CoreWaitStrategy::YIELDING:
       impl_ = std::make_unique<ExchangeCoreImpl<disruptor::YieldingWaitStrategy>>(
-        resultsConsumer, exchangeConfiguration);
+        std::move(resultsConsumers), fanOutResults, exchangeConfiguration);
       break;
     case common::CoreWaitStrategy::BLOCKING:
     default:
       impl_ = std::make_unique<ExchangeCoreImpl<disruptor::BlockingWaitStrategy>>(
-        resultsConsumer, exchangeConfiguration);
+        std::move(resultsConsumers), fanOutResults, exchangeConfiguration);
       break;
   }
 }
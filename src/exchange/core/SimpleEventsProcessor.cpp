@@ -15,6 +15,7 @@
  */
 
 #include <exchange/core/IEventsHandler.h>
+#include <exchange/core/IEventsViewHandler.h>
 #include <exchange/core/SimpleEventsProcessor.h>
 #include <exchange/core/common/L2MarketData.h>
 #include <exchange/core/common/MatcherEventType.h>
@@ -32,7 +33,9 @@
 #include <exchange/core/common/cmd/CommandResultCode.h>
 #include <exchange/core/common/cmd/OrderCommand.h>
 #include <exchange/core/common/cmd/OrderCommandType.h>
+#include <span>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace exchange::core {
@@ -47,77 +50,41 @@ void SimpleEventsProcessor::Accept(common::cmd::OrderCommand* cmd, int64_t seq)
   }
 }
 
-void SimpleEventsProcessor::SendApiCommandResult(common::api::ApiCommand* apiCmd,
-                                                 common::cmd::CommandResultCode resultCode,
-                                                 int64_t timestamp,
-                                                 int64_t seq) {
-  apiCmd->timestamp = timestamp;
-  ApiCommandResult commandResult{apiCmd, resultCode, seq};
-  eventsHandler_->CommandResult(commandResult);
-}
-
 void SimpleEventsProcessor::SendCommandResult(common::cmd::OrderCommand* cmd, int64_t seq) {
-  common::api::ApiCommand* apiCmd = nullptr;
-
   switch (cmd->command) {
     case common::cmd::OrderCommandType::PLACE_ORDER:
-      apiCmd = new common::api::ApiPlaceOrder(cmd->price, cmd->size, cmd->orderId, cmd->action,
-                                              cmd->orderType, cmd->uid, cmd->symbol,
-                                              cmd->userCookie, cmd->reserveBidPrice);
-      break;
-
     case common::cmd::OrderCommandType::MOVE_ORDER:
-      apiCmd = new common::api::ApiMoveOrder(cmd->orderId, cmd->price, cmd->uid, cmd->symbol);
-      break;
-
     case common::cmd::OrderCommandType::CANCEL_ORDER:
-      apiCmd = new common::api::ApiCancelOrder(cmd->orderId, cmd->uid, cmd->symbol);
-      break;
-
     case common::cmd::OrderCommandType::REDUCE_ORDER:
-      apiCmd = new common::api::ApiReduceOrder(cmd->orderId, cmd->uid, cmd->symbol, cmd->size);
-      break;
-
     case common::cmd::OrderCommandType::ADD_USER:
-      apiCmd = new common::api::ApiAddUser(cmd->uid);
-      break;
-
     case common::cmd::OrderCommandType::BALANCE_ADJUSTMENT:
-      apiCmd =
-        new common::api::ApiAdjustUserBalance(cmd->uid, cmd->symbol, cmd->price, cmd->orderId);
+    case common::cmd::OrderCommandType::ORDER_BOOK_REQUEST:
       break;
 
     case common::cmd::OrderCommandType::BINARY_DATA_COMMAND:
-      if (cmd->resultCode != common::cmd::CommandResultCode::ACCEPTED) {
-        apiCmd = new common::api::ApiBinaryDataCommand(cmd->userCookie, nullptr);
+      // only last fragment has result
+      if (cmd->resultCode == common::cmd::CommandResultCode::ACCEPTED) {
+        return;
       }
       break;
 
-    case common::cmd::OrderCommandType::ORDER_BOOK_REQUEST:
-      apiCmd = new common::api::ApiOrderBookRequest(cmd->symbol, static_cast<int32_t>(cmd->size));
-      break;
-
     default:
       // Other commands not handled
-      break;
-  }
-
-  if (apiCmd != nullptr) {
-    SendApiCommandResult(apiCmd, cmd->resultCode, cmd->timestamp, seq);
-    delete apiCmd;  // Clean up
+      return;
   }
+  eventsHandler_->CommandResult(CommandResultView{*cmd, seq});
 }
 
 void SimpleEventsProcessor::SendTradeEvents(common::cmd::OrderCommand* cmd) {
-  common::MatcherTradeEvent* firstEvent = cmd->matcherEvent;
+  const common::MatcherTradeEvent* firstEvent = cmd->matcherEvent;
   if (firstEvent == nullptr) {
     return;
   }
 
   if (firstEvent->eventType == common::MatcherEventType::REDUCE) {
-    ReduceEvent evt{cmd->symbol,       firstEvent->size, firstEvent->activeOrderCompleted,
-                    firstEvent->price, cmd->orderId,     cmd->uid,
-                    cmd->timestamp};
+    const ReduceEvent evt{cmd->symbol,       firstEvent->size, firstEvent->activeOrderCompleted,
+                          firstEvent->price, cmd->orderId,     cmd->uid,
+                          cmd->timestamp};
     eventsHandler_->ReduceEvent(evt);
 
     if (firstEvent->nextEvent != nullptr) {
@@ -131,71 +98,154 @@ void SimpleEventsProcessor::SendTradeEvents(common::cmd::OrderCommand* cmd) {
 }
 
 void SimpleEventsProcessor::SendTradeEvent(common::cmd::OrderCommand* cmd) {
+  bool hasTrades = false;
   bool takerOrderCompleted = false;
   int64_t totalVolume = 0;
-  std::vector<Trade> trades;
-
-  RejectEvent* rejectEvent = nullptr;
+  const common::MatcherTradeEvent* rejectEvent = nullptr;
 
-  // Process all matcher events
-  common::MatcherTradeEvent* event = cmd->matcherEvent;
-  while (event != nullptr) {
+  // Process all matcher events, trades are passed as view of the chain
+  for (const common::MatcherTradeEvent* event = cmd->matcherEvent; event != nullptr;
+       event = event->nextEvent) {
     if (event->eventType == common::MatcherEventType::TRADE) {
-      Trade trade{event->matchedOrderId, event->matchedOrderUid, event->matchedOrderCompleted,
-                  event->price, event->size};
-      trades.push_back(trade);
+      hasTrades = true;
       totalVolume += event->size;
-
       if (event->activeOrderCompleted) {
         takerOrderCompleted = true;
       }
     } else if (event->eventType == common::MatcherEventType::REJECT) {
-      rejectEvent = new RejectEvent{cmd->symbol,  event->size, event->price,
-                                    cmd->orderId, cmd->uid,    cmd->timestamp};
+      rejectEvent = event;
     }
-
-    event = event->nextEvent;
   }
 
-  if (!trades.empty()) {
-    TradeEvent evt{cmd->symbol, totalVolume,         cmd->orderId,   cmd->uid,
-                   cmd->action, takerOrderCompleted, cmd->timestamp, trades};
-    eventsHandler_->TradeEvent(evt);
+  if (hasTrades) {
+    eventsHandler_->TradeEvent(
+      TradeEventView{*cmd, totalVolume, takerOrderCompleted, TradesView(cmd->matcherEvent)});
   }
 
   if (rejectEvent != nullptr) {
-    eventsHandler_->RejectEvent(*rejectEvent);
-    delete rejectEvent;
+    const RejectEvent evt{cmd->symbol,  rejectEvent->size, rejectEvent->price,
+                          cmd->orderId, cmd->uid,          cmd->timestamp};
+    eventsHandler_->RejectEvent(evt);
   }
 }
 
 void SimpleEventsProcessor::SendMarketData(common::cmd::OrderCommand* cmd) {
-  // With shared_ptr, we can simply copy the shared_ptr (matching Java behavior)
-  // No need for special handling for ORDER_BOOK_REQUEST since shared_ptr can be
-  // copied
   if (cmd->marketData == nullptr) {
     return;
   }
+  eventsHandler_->OrderBook(OrderBookView{cmd->symbol, cmd->timestamp, *cmd->marketData});
+}
+
+namespace {
 
-  // Copy shared_ptr (cheap operation, just increments reference count)
-  std::shared_ptr<common::L2MarketData> marketData = cmd->marketData;
+void SendApiCommandResult(IEventsHandler* eventsHandler,
+                          common::api::ApiCommand& apiCmd,
+                          const CommandResultView& result) {
+  apiCmd.timestamp = result.command.timestamp;
+  const ApiCommandResult commandResult{&apiCmd, result.command.resultCode, result.seq};
+  eventsHandler->CommandResult(commandResult);
+}
 
-  std::vector<OrderBookRecord> asks;
-  asks.reserve(marketData->askSize);
-  for (int32_t i = 0; i < marketData->askSize; i++) {
-    asks.push_back(OrderBookRecord{marketData->askPrices[i], marketData->askVolumes[i],
-                                   static_cast<int32_t>(marketData->askOrders[i])});
+std::vector<OrderBookRecord> ToRecords(std::span<const int64_t> prices,
+                                       std::span<const int64_t> volumes,
+                                       std::span<const int64_t> orders) {
+  std::vector<OrderBookRecord> records;
+  records.reserve(prices.size());
+  for (size_t i = 0; i < prices.size(); i++) {
+    records.push_back(OrderBookRecord{prices[i], volumes[i], static_cast<int32_t>(orders[i])});
   }
+  return records;
+}
+
+}  // namespace
+
+void EventsHandlerAdapter::CommandResult(const CommandResultView& commandResult) {
+  // ApiCommand lives only for the duration of the call
+  const common::cmd::OrderCommand& cmd = commandResult.command;
+  switch (cmd.command) {
+    case common::cmd::OrderCommandType::PLACE_ORDER: {
+      common::api::ApiPlaceOrder apiCmd(cmd.price, cmd.size, cmd.orderId, cmd.action,
+                                        cmd.orderType, cmd.uid, cmd.symbol, cmd.userCookie,
+                                        cmd.reserveBidPrice);
+      SendApiCommandResult(eventsHandler_, apiCmd, commandResult);
+      break;
+    }
 
-  std::vector<OrderBookRecord> bids;
-  bids.reserve(marketData->bidSize);
-  for (int32_t i = 0; i < marketData->bidSize; i++) {
-    bids.push_back(OrderBookRecord{marketData->bidPrices[i], marketData->bidVolumes[i],
-                                   static_cast<int32_t>(marketData->bidOrders[i])});
+    case common::cmd::OrderCommandType::MOVE_ORDER: {
+      common::api::ApiMoveOrder apiCmd(cmd.orderId, cmd.price, cmd.uid, cmd.symbol);
+      SendApiCommandResult(eventsHandler_, apiCmd, commandResult);
+      break;
+    }
+
+    case common::cmd::OrderCommandType::CANCEL_ORDER: {
+      common::api::ApiCancelOrder apiCmd(cmd.orderId, cmd.uid, cmd.symbol);
+      SendApiCommandResult(eventsHandler_, apiCmd, commandResult);
+      break;
+    }
+
+    case common::cmd::OrderCommandType::REDUCE_ORDER: {
+      common::api::ApiReduceOrder apiCmd(cmd.orderId, cmd.uid, cmd.symbol, cmd.size);
+      SendApiCommandResult(eventsHandler_, apiCmd, commandResult);
+      break;
+    }
+
+    case common::cmd::OrderCommandType::ADD_USER: {
+      common::api::ApiAddUser apiCmd(cmd.uid);
+      SendApiCommandResult(eventsHandler_, apiCmd, commandResult);
+      break;
+    }
+
+    case common::cmd::OrderCommandType::BALANCE_ADJUSTMENT: {
+      common::api::ApiAdjustUserBalance apiCmd(cmd.uid, cmd.symbol, cmd.price, cmd.orderId);
+      SendApiCommandResult(eventsHandler_, apiCmd, commandResult);
+      break;
+    }
+
+    case common::cmd::OrderCommandType::BINARY_DATA_COMMAND: {
+      common::api::ApiBinaryDataCommand apiCmd(cmd.userCookie, nullptr);
+      SendApiCommandResult(eventsHandler_, apiCmd, commandResult);
+      break;
+    }
+
+    case common::cmd::OrderCommandType::ORDER_BOOK_REQUEST: {
+      common::api::ApiOrderBookRequest apiCmd(cmd.symbol, static_cast<int32_t>(cmd.size));
+      SendApiCommandResult(eventsHandler_, apiCmd, commandResult);
+      break;
+    }
+
+    default:
+      break;
   }
+}
+
+void EventsHandlerAdapter::TradeEvent(const TradeEventView& tradeEvent) {
+  const common::cmd::OrderCommand& cmd = tradeEvent.command;
+  std::vector<Trade> trades(tradeEvent.trades.begin(), tradeEvent.trades.end());
+  const exchange::core::TradeEvent evt{cmd.symbol,
+                                       tradeEvent.totalVolume,
+                                       cmd.orderId,
+                                       cmd.uid,
+                                       cmd.action,
+                                       tradeEvent.takerOrderCompleted,
+                                       cmd.timestamp,
+                                       std::move(trades)};
+  eventsHandler_->TradeEvent(evt);
+}
+
+void EventsHandlerAdapter::RejectEvent(const exchange::core::RejectEvent& rejectEvent) {
+  eventsHandler_->RejectEvent(rejectEvent);
+}
+
+void EventsHandlerAdapter::ReduceEvent(const exchange::core::ReduceEvent& reduceEvent) {
+  eventsHandler_->ReduceEvent(reduceEvent);
+}
 
-  OrderBook orderBook{cmd->symbol, asks, bids, cmd->timestamp};
-  eventsHandler_->OrderBook(orderBook);
+void EventsHandlerAdapter::OrderBook(const OrderBookView& orderBook) {
+  auto asks = ToRecords(orderBook.AskPrices(), orderBook.AskVolumes(), orderBook.AskOrders());
+  auto bids = ToRecords(orderBook.BidPrices(), orderBook.BidVolumes(), orderBook.BidOrders());
+  const exchange::core::OrderBook evt{orderBook.symbol, std::move(asks), std::move(bids),
+                                      orderBook.timestamp};
+  eventsHandler_->OrderBook(evt);
 }
 
 }  // namespace exchange::core
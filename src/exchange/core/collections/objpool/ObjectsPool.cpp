@@ -99,6 +99,20 @@ void* ObjectsPool::Pop(int type) {
   return nullptr;
 }
 
+int ObjectsPool::Available(int type) const {
+  if (type >= 0 && type < static_cast<int>(pools_.size()) && pools_[type] != nullptr) {
+    return pools_[type]->Size();
+  }
+  return 0;
+}
+
+int ObjectsPool::Capacity(int type) const {
+  if (type >= 0 && type < static_cast<int>(pools_.size()) && pools_[type] != nullptr) {
+    return pools_[type]->Capacity();
+  }
+  return 0;
+}
+
 // ArrayStack implementation
 ObjectsPool::ArrayStack::ArrayStack(int fixedSize)
   : count_(0), capacity_(fixedSize), objects_(new void*[fixedSize]) {
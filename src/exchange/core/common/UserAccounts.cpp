@@ -0,0 +1,65 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/common/UserAccounts.h>
+
+namespace exchange::core::common {
+
+UserAccounts::UserAccounts(const UserAccounts& other)
+  : inline_(other.inline_)
+  , inlineSize_(other.inlineSize_)
+  , spill_(other.spill_ != nullptr ? std::make_unique<Spill>(*other.spill_) : nullptr) {}
+
+UserAccounts& UserAccounts::operator=(const UserAccounts& other) {
+  if (this != &other) {
+    inline_ = other.inline_;
+    inlineSize_ = other.inlineSize_;
+    spill_ = other.spill_ != nullptr ? std::make_unique<Spill>(*other.spill_) : nullptr;
+  }
+  return *this;
+}
+
+ankerl::unordered_dense::map<int32_t, int64_t> UserAccounts::ToMap() const {
+  ankerl::unordered_dense::map<int32_t, int64_t> result;
+  result.reserve(size());
+  for (const auto& [currency, balance] : *this) {
+    result[currency] = balance;
+  }
+  return result;
+}
+
+void UserAccounts::SpillOver() {
+  // Move inline entries first, keeping insertion order
+  spill_ = std::make_unique<Spill>();
+  spill_->entries.reserve(INLINE_CAPACITY * 2);
+  spill_->index.reserve(INLINE_CAPACITY * 2);
+  for (int32_t i = 0; i < inlineSize_; i++) {
+    spill_->index[inline_[i].first] = static_cast<uint32_t>(spill_->entries.size());
+    spill_->entries.push_back(inline_[i]);
+  }
+  inlineSize_ = 0;
+}
+
+int64_t& UserAccounts::SpillGetOrInsert(int32_t currency) {
+  auto [it, inserted] =
+    spill_->index.try_emplace(currency, static_cast<uint32_t>(spill_->entries.size()));
+  if (inserted) {
+    spill_->entries.emplace_back(currency, 0);
+  }
+  return spill_->entries[it->second].second;
+}
+
+}  // namespace exchange::core::common
@@ -47,7 +47,11 @@ UserProfile::UserProfile(BytesIn* bytes) {
   adjustmentsCounter = bytes->ReadLong();
 
   // account balances (int -> long)
-  accounts = utils::SerializationUtils::ReadIntLongHashMap(*bytes);
+  int accountsNum = bytes->ReadInt();
+  for (int i = 0; i < accountsNum; i++) {
+    int32_t currency = bytes->ReadInt();
+    accounts[currency] = bytes->ReadLong();
+  }
 
   // userStatus
   userStatus = UserStatusFromCode(bytes->ReadByte());
@@ -112,8 +116,12 @@ void UserProfile::WriteMarshallable(BytesOut& bytes) const {
   // adjustmentsCounter
   bytes.WriteLong(adjustmentsCounter);
 
-  // account balances (int -> long)
-  utils::SerializationUtils::MarshallIntLongHashMap(accounts, bytes);
+  // account balances (int -> long), same format as MarshallIntLongHashMap
+  bytes.WriteInt(static_cast<int32_t>(accounts.size()));
+  for (const auto& [currency, balance] : accounts) {
+    bytes.WriteInt(currency);
+    bytes.WriteLong(balance);
+  }
 
   // userStatus
   bytes.WriteByte(static_cast<int8_t>(userStatus));
@@ -104,7 +104,7 @@ SingleUserReportQuery::Process(RiskEngineType* riskEngine) {
 
     return std::make_optional(
       std::unique_ptr<SingleUserReportResult>(SingleUserReportResult::CreateFromRiskEngineFound(
-        uid, &userProfile->userStatus, userProfile->accounts, positions)));
+        uid, &userProfile->userStatus, userProfile->accounts.ToMap(), positions)));
   } else {
     // Not found
     return std::make_optional(std::unique_ptr<SingleUserReportResult>(
@@ -47,6 +47,28 @@ SerializationConfiguration SerializationConfiguration::DiskSnapshotOnly() {
   return SerializationConfiguration(false, factory);
 }
 
+SerializationConfiguration SerializationConfiguration::DiskSnapshotOnlyForked() {
+  DiskSerializationProcessorConfiguration forkConfig;
+  forkConfig.snapshotMode = DiskSerializationProcessorConfiguration::SnapshotMode::FORK;
+  auto factory = [forkConfig](const ExchangeConfiguration* exchangeCfg)
+    -> ISerializationProcessor* {
+    return static_cast<ISerializationProcessor*>(
+      new DiskSerializationProcessor(exchangeCfg, &forkConfig));
+  };
+  return SerializationConfiguration(false, factory);
+}
+
+SerializationConfiguration SerializationConfiguration::DiskSnapshotOnlyIncremental() {
+  DiskSerializationProcessorConfiguration incrementalConfig;
+  incrementalConfig.incrementalSnapshots = true;
+  auto factory = [incrementalConfig](const ExchangeConfiguration* exchangeCfg)
+    -> ISerializationProcessor* {
+    return static_cast<ISerializationProcessor*>(
+      new DiskSerializationProcessor(exchangeCfg, &incrementalConfig));
+  };
+  return SerializationConfiguration(false, factory);
+}
+
 SerializationConfiguration SerializationConfiguration::DiskJournaling() {
   using namespace ::exchange::core::processors::journaling;
   auto factory = [](const ExchangeConfiguration* exchangeCfg) -> ISerializationProcessor* {
@@ -58,4 +80,20 @@ SerializationConfiguration SerializationConfiguration::DiskJournaling() {
   return SerializationConfiguration(true, factory);
 }
 
+SerializationConfiguration SerializationConfiguration::DiskJournalingAsync() {
+  DiskSerializationProcessorConfiguration asyncConfig;
+  asyncConfig.asyncJournalWriter = true;
+  return DiskJournaling(asyncConfig);
+}
+
+SerializationConfiguration SerializationConfiguration::DiskJournaling(
+  const DiskSerializationProcessorConfiguration& diskConfig) {
+  auto factory = [diskConfig](const ExchangeConfiguration* exchangeCfg)
+    -> ISerializationProcessor* {
+    return static_cast<ISerializationProcessor*>(
+      new DiskSerializationProcessor(exchangeCfg, &diskConfig));
+  };
+  return SerializationConfiguration(true, factory);
+}
+
 }  // namespace exchange::core::common::config
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/ingress/SharedMemoryBridge.h>
+#include <exchange/core/ingress/WireFrameReader.h>
+#include <exchange/core/utils/Logger.h>
+#include <stdexcept>
+
+namespace exchange::core::ingress {
+
+namespace {
+
+// Exactly one order frame (gateways can not submit batch frames)
+bool IsSingleOrderFrame(const ShmCommandRecord& record) {
+  if (record.frameLength > sizeof(record.frame)) {
+    return false;
+  }
+  try {
+    return WireFrameReader(record.frame, record.frameLength).Validate(0) == 1;
+  } catch (const std::invalid_argument&) {
+    return false;
+  }
+}
+
+}  // namespace
+
+SharedMemoryBridge::SharedMemoryBridge(IExchangeApi* api,
+                                       SharedMemoryIngress* ingress,
+                                       size_t maxBatchSize)
+  : api_(api), ingress_(ingress), maxBatchSize_(maxBatchSize), records_(maxBatchSize) {
+  if (maxBatchSize == 0) {
+    throw std::invalid_argument("SharedMemoryBridge: maxBatchSize must be positive");
+  }
+  frames_.reserve(maxBatchSize * sizeof(ShmCommandRecord::frame));
+  // enough for a full ring buffer of bridge commands, bridge waits if more are in flight
+  int64_t capacity = 1;
+  while (capacity < static_cast<int64_t>(maxBatchSize) * 4) {
+    capacity <<= 1;
+  }
+  routes_ = std::make_unique<Route[]>(static_cast<size_t>(capacity));
+  routesMask_ = capacity - 1;
+}
+
+SharedMemoryBridge::~SharedMemoryBridge() {
+  Stop();
+}
+
+void SharedMemoryBridge::Start(disruptor::dsl::ThreadFactory& threadFactory) {
+  if (running_.exchange(true)) {
+    return;
+  }
+  thread_ = threadFactory.newThread([this]() {
+    int32_t idleSpins = 0;
+    while (running_.load(std::memory_order_acquire)) {
+      if (PollOnce() > 0) {
+        idleSpins = 0;
+      } else if (++idleSpins > 1000) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  LOG_INFO("[SharedMemoryBridge] Started, {} gateway clients", ingress_->Clients());
+}
+
+void SharedMemoryBridge::Stop() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  LOG_INFO("[SharedMemoryBridge] Stopped, dropped results: {}", DroppedResults());
+}
+
+size_t SharedMemoryBridge::PollOnce() {
+  const size_t n = ingress_->Commands().Poll(records_.data(), maxBatchSize_);
+  if (n == 0) {
+    return 0;
+  }
+  // routes of this run must not overwrite routes of commands still in flight
+  while (submitted_ + static_cast<int64_t>(n) - completed_.load(std::memory_order_acquire)
+         > routesMask_ + 1) {
+    std::this_thread::yield();
+  }
+
+  frames_.clear();
+  int64_t count = 0;
+  for (size_t i = 0; i < n; i++) {
+    const auto& record = records_[i];
+    if (record.clientId >= ingress_->Clients()) {
+      droppedResults_.fetch_add(1, std::memory_order_relaxed);  // nowhere to answer
+      continue;
+    }
+    if (!IsSingleOrderFrame(record)) {
+      Reply(record.clientId, record.correlationId, -1, INVALID_FRAME);
+      continue;
+    }
+    routes_[(submitted_ + count) & routesMask_] = {record.correlationId, record.clientId};
+    frames_.insert(frames_.end(), record.frame, record.frame + record.frameLength);
+    count++;
+  }
+
+  if (count > 0) {
+    const int64_t firstRoute = submitted_;
+    submitted_ += count;
+    api_->SubmitWireFrames(frames_.data(), frames_.size(),
+                           [this, firstRoute](const CompletedBatch& batch) {
+                             OnCompleted(firstRoute, batch);
+                           });
+  }
+  return n;
+}
+
+void SharedMemoryBridge::Reply(uint32_t clientId,
+                               uint64_t correlationId,
+                               int64_t seq,
+                               int32_t resultCode) {
+  const ShmResultRecord result{correlationId, seq, resultCode, 0};
+  if (!ingress_->Results(clientId).TryOffer(result)) {
+    droppedResults_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void SharedMemoryBridge::OnCompleted(int64_t firstRoute, const CompletedBatch& batch) {
+  for (int32_t i = 0; i < batch.Size(); i++) {
+    const Route& route = routes_[(firstRoute + i) & routesMask_];
+    Reply(route.clientId, route.correlationId, batch.Sequence(i),
+          static_cast<int32_t>(batch.ResultCode(i)));
+  }
+  completed_.fetch_add(batch.Size(), std::memory_order_release);
+}
+
+}  // namespace exchange::core::ingress
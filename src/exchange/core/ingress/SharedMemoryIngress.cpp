@@ -0,0 +1,219 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/ingress/SharedMemoryIngress.h>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace exchange::core::ingress {
+
+namespace {
+
+constexpr size_t HEADER_BYTES = 64;
+
+constexpr size_t AlignUp(size_t size) {
+  return (size + 63) & ~size_t{63};
+}
+
+size_t CommandsOffset() {
+  return HEADER_BYTES;
+}
+
+size_t ResultsOffset(uint32_t commandCapacity, uint32_t resultCapacity, uint32_t clientId) {
+  return HEADER_BYTES + AlignUp(SharedMemoryRing<ShmCommandRecord>::Footprint(commandCapacity))
+         + clientId * AlignUp(SharedMemoryRing<ShmResultRecord>::Footprint(resultCapacity));
+}
+
+#ifndef _WIN32
+std::string PosixName(const std::string& name) {
+  return name.starts_with('/') ? name : "/" + name;
+}
+#endif
+
+}  // namespace
+
+struct SharedMemoryIngress::Header {
+  std::atomic<uint64_t> magic;  // stored last, after rings are initialized
+  uint32_t version;
+  uint32_t clients;
+  uint32_t commandCapacity;
+  uint32_t resultCapacity;
+};
+
+SharedMemorySegment::SharedMemorySegment(const std::string& name, size_t size)
+  : name_(name), size_(size), owner_(true) {
+#ifdef _WIN32
+  handle_ = ::CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                 static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+                                 static_cast<DWORD>(size & 0xFFFFFFFFu), name.c_str());
+  if (handle_ == nullptr) {
+    throw std::runtime_error("Can not create shared memory: " + name);
+  }
+  data_ = ::MapViewOfFile(handle_, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  if (data_ == nullptr) {
+    ::CloseHandle(handle_);
+    throw std::runtime_error("Can not map shared memory: " + name);
+  }
+  std::memset(data_, 0, size);
+#else
+  name_ = PosixName(name);
+  // segment of crashed previous run is replaced, its gateways have to reattach
+  ::shm_unlink(name_.c_str());
+  const int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    throw std::runtime_error("Can not create shared memory: " + name);
+  }
+  // extended file is zero-filled
+  if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    ::close(fd);
+    ::shm_unlink(name_.c_str());
+    throw std::runtime_error("Can not resize shared memory: " + name);
+  }
+  void* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    ::shm_unlink(name_.c_str());
+    throw std::runtime_error("Can not map shared memory: " + name);
+  }
+  data_ = mapped;
+#endif
+}
+
+SharedMemorySegment::SharedMemorySegment(const std::string& name) : name_(name) {
+#ifdef _WIN32
+  handle_ = ::OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+  if (handle_ == nullptr) {
+    throw std::runtime_error("Can not open shared memory: " + name);
+  }
+  data_ = ::MapViewOfFile(handle_, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+  if (data_ == nullptr) {
+    ::CloseHandle(handle_);
+    throw std::runtime_error("Can not map shared memory: " + name);
+  }
+  MEMORY_BASIC_INFORMATION info{};
+  ::VirtualQuery(data_, &info, sizeof(info));
+  size_ = info.RegionSize;
+#else
+  name_ = PosixName(name);
+  const int fd = ::shm_open(name_.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    throw std::runtime_error("Can not open shared memory: " + name);
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    throw std::runtime_error("Shared memory is not initialized: " + name);
+  }
+  size_ = static_cast<size_t>(st.st_size);
+  void* mapped = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    throw std::runtime_error("Can not map shared memory: " + name);
+  }
+  data_ = mapped;
+#endif
+}
+
+SharedMemorySegment::~SharedMemorySegment() {
+#ifdef _WIN32
+  ::UnmapViewOfFile(data_);
+  ::CloseHandle(handle_);
+#else
+  ::munmap(data_, size_);
+  if (owner_) {
+    ::shm_unlink(name_.c_str());
+  }
+#endif
+}
+
+SharedMemoryIngress::SharedMemoryIngress(const std::string& name,
+                                         uint32_t clients,
+                                         uint32_t commandCapacity,
+                                         uint32_t resultCapacity)
+  : segment_(name, ResultsOffset(commandCapacity, resultCapacity, clients)) {
+  static_assert(sizeof(Header) <= HEADER_BYTES);
+  auto* base = static_cast<uint8_t*>(segment_.Data());
+  header_ = new (base) Header{};
+  header_->version = VERSION;
+  header_->clients = clients;
+  header_->commandCapacity = commandCapacity;
+  header_->resultCapacity = resultCapacity;
+  commands_ = SharedMemoryRing<ShmCommandRecord>::Init(base + CommandsOffset(), commandCapacity);
+  for (uint32_t i = 0; i < clients; i++) {
+    SharedMemoryRing<ShmResultRecord>::Init(
+      base + ResultsOffset(commandCapacity, resultCapacity, i), resultCapacity);
+  }
+  header_->magic.store(MAGIC, std::memory_order_release);
+}
+
+SharedMemoryIngress::SharedMemoryIngress(const std::string& name) : segment_(name) {
+  auto* base = static_cast<uint8_t*>(segment_.Data());
+  if (segment_.Size() < HEADER_BYTES) {
+    throw std::runtime_error("Not a shared memory ingress: " + name);
+  }
+  header_ = std::launder(reinterpret_cast<Header*>(base));
+  if (header_->magic.load(std::memory_order_acquire) != MAGIC) {
+    throw std::runtime_error("Shared memory ingress is not initialized: " + name);
+  }
+  if (header_->version != VERSION
+      || segment_.Size()
+           < ResultsOffset(header_->commandCapacity, header_->resultCapacity, header_->clients)) {
+    throw std::runtime_error("Incompatible shared memory ingress: " + name);
+  }
+  commands_ = SharedMemoryRing<ShmCommandRecord>::Attach(base + CommandsOffset());
+}
+
+SharedMemoryRing<ShmResultRecord>& SharedMemoryIngress::Results(uint32_t clientId) {
+  if (clientId >= header_->clients) {
+    throw std::invalid_argument("SharedMemoryIngress: unknown client " + std::to_string(clientId));
+  }
+  auto* base = static_cast<uint8_t*>(segment_.Data());
+  return *SharedMemoryRing<ShmResultRecord>::Attach(
+    base + ResultsOffset(header_->commandCapacity, header_->resultCapacity, clientId));
+}
+
+uint32_t SharedMemoryIngress::Clients() const {
+  return header_->clients;
+}
+
+SharedMemoryIngressClient::SharedMemoryIngressClient(const std::string& name, uint32_t clientId)
+  : ingress_(name), clientId_(clientId), results_(&ingress_.Results(clientId)) {}
+
+bool SharedMemoryIngressClient::TrySubmit(uint64_t correlationId,
+                                          const uint8_t* frame,
+                                          size_t length) {
+  ShmCommandRecord record;
+  if (length > sizeof(record.frame)) {
+    throw std::invalid_argument("SharedMemoryIngressClient: frame is too long");
+  }
+  record.correlationId = correlationId;
+  record.clientId = clientId_;
+  record.frameLength = static_cast<uint32_t>(length);
+  std::memcpy(record.frame, frame, length);
+  return ingress_.Commands().TryOffer(record);
+}
+
+}  // namespace exchange::core::ingress
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/ingress/WireFrameReader.h>
+#include <stdexcept>
+#include <string>
+
+namespace exchange::core::ingress {
+
+namespace {
+
+[[noreturn]] void Fail(size_t offset, const char* reason) {
+  throw std::invalid_argument("Wire frame at offset " + std::to_string(offset) + ": " + reason);
+}
+
+size_t MinBlockLength(WireFormat::TemplateId templateId) {
+  switch (templateId) {
+    case WireFormat::TemplateId::PLACE_ORDER:
+      return WireFormat::PLACE_ORDER_BLOCK;
+    case WireFormat::TemplateId::CANCEL_ORDER:
+      return WireFormat::CANCEL_ORDER_BLOCK;
+    case WireFormat::TemplateId::MOVE_ORDER:
+      return WireFormat::MOVE_ORDER_BLOCK;
+    case WireFormat::TemplateId::REDUCE_ORDER:
+      return WireFormat::REDUCE_ORDER_BLOCK;
+    case WireFormat::TemplateId::BATCH:
+      return WireFormat::BATCH_BLOCK;
+  }
+  return 0;  // unknown template
+}
+
+}  // namespace
+
+size_t WireFrameReader::ValidateOrderFrame(size_t offset) const {
+  if (length_ - offset < WireFormat::HEADER_SIZE) {
+    Fail(offset, "truncated header");
+  }
+  if (Read<uint16_t>(offset + 4) != WireFormat::SCHEMA_ID) {
+    Fail(offset, "unknown schema");
+  }
+  const auto templateId = TemplateAt(offset);
+  const size_t minBlockLength = MinBlockLength(templateId);
+  if (minBlockLength == 0) {
+    Fail(offset, "unknown template");
+  }
+  if (templateId == WireFormat::TemplateId::BATCH) {
+    Fail(offset, "nested batch");
+  }
+  if (Read<uint16_t>(offset) < minBlockLength) {
+    Fail(offset, "block is too short");
+  }
+  const size_t frameSize = FrameSize(offset);
+  if (length_ - offset < frameSize) {
+    Fail(offset, "truncated block");
+  }
+  if (templateId == WireFormat::TemplateId::PLACE_ORDER) {
+    const size_t block = offset + WireFormat::HEADER_SIZE;
+    if (Read<uint8_t>(block + 56) > static_cast<uint8_t>(common::OrderAction::BID)) {
+      Fail(offset, "invalid order action");
+    }
+    if (Read<uint8_t>(block + 57) > static_cast<uint8_t>(common::OrderType::FOK_BUDGET)) {
+      Fail(offset, "invalid order type");
+    }
+  }
+  return frameSize;
+}
+
+size_t WireFrameReader::Validate(size_t maxBatchSize) const {
+  size_t commands = 0;
+  size_t offset = 0;
+  while (offset < length_) {
+    if (length_ - offset >= WireFormat::HEADER_SIZE
+        && TemplateAt(offset) == WireFormat::TemplateId::BATCH) {
+      if (Read<uint16_t>(offset + 4) != WireFormat::SCHEMA_ID) {
+        Fail(offset, "unknown schema");
+      }
+      if (Read<uint16_t>(offset) < WireFormat::BATCH_BLOCK
+          || length_ - offset < FrameSize(offset)) {
+        Fail(offset, "invalid batch block");
+      }
+      const uint32_t count = Read<uint32_t>(offset + WireFormat::HEADER_SIZE);
+      if (count == 0 || count > maxBatchSize) {
+        Fail(offset, "invalid batch size");
+      }
+      offset += FrameSize(offset);
+      for (uint32_t i = 0; i < count; i++) {
+        if (offset >= length_) {
+          Fail(offset, "batch is truncated");
+        }
+        offset += ValidateOrderFrame(offset);
+      }
+      commands += count;
+    } else {
+      offset += ValidateOrderFrame(offset);
+      commands++;
+    }
+  }
+  return commands;
+}
+
+size_t WireFrameReader::CommandsUpTo(size_t maxCommands) const {
+  size_t total = 0;
+  size_t offset = position_;
+  while (offset < length_ && total < maxCommands) {
+    size_t commands = 1;
+    size_t next = offset + FrameSize(offset);
+    if (TemplateAt(offset) == WireFormat::TemplateId::BATCH) {
+      commands = Read<uint32_t>(offset + WireFormat::HEADER_SIZE);
+      for (size_t i = 0; i < commands; i++) {
+        next += FrameSize(next);
+      }
+    }
+    // batch is never split between claims
+    if (total > 0 && total + commands > maxCommands) {
+      break;
+    }
+    total += commands;
+    offset = next;
+  }
+  return total;
+}
+
+void WireFrameReader::DecodeNext(common::cmd::OrderCommand& cmd) {
+  using common::cmd::OrderCommandType;
+  if (TemplateAt(position_) == WireFormat::TemplateId::BATCH) {
+    position_ += FrameSize(position_);
+  }
+  const size_t block = position_ + WireFormat::HEADER_SIZE;
+  cmd.uid = Read<int64_t>(block);
+  cmd.orderId = Read<int64_t>(block + 8);
+  switch (TemplateAt(position_)) {
+    case WireFormat::TemplateId::PLACE_ORDER:
+      cmd.command = OrderCommandType::PLACE_ORDER;
+      cmd.price = Read<int64_t>(block + 16);
+      cmd.reserveBidPrice = Read<int64_t>(block + 24);
+      cmd.size = Read<int64_t>(block + 32);
+      cmd.timestamp = Read<int64_t>(block + 40);
+      cmd.symbol = Read<int32_t>(block + 48);
+      cmd.userCookie = Read<int32_t>(block + 52);
+      cmd.action = static_cast<common::OrderAction>(Read<uint8_t>(block + 56));
+      cmd.orderType = static_cast<common::OrderType>(Read<uint8_t>(block + 57));
+      break;
+    case WireFormat::TemplateId::CANCEL_ORDER:
+      cmd.command = OrderCommandType::CANCEL_ORDER;
+      cmd.timestamp = Read<int64_t>(block + 16);
+      cmd.symbol = Read<int32_t>(block + 24);
+      break;
+    case WireFormat::TemplateId::MOVE_ORDER:
+      cmd.command = OrderCommandType::MOVE_ORDER;
+      cmd.price = Read<int64_t>(block + 16);
+      cmd.timestamp = Read<int64_t>(block + 24);
+      cmd.symbol = Read<int32_t>(block + 32);
+      break;
+    case WireFormat::TemplateId::REDUCE_ORDER:
+      cmd.command = OrderCommandType::REDUCE_ORDER;
+      cmd.size = Read<int64_t>(block + 16);
+      cmd.timestamp = Read<int64_t>(block + 24);
+      cmd.symbol = Read<int32_t>(block + 32);
+      break;
+    case WireFormat::TemplateId::BATCH:
+      break;  // rejected by Validate
+  }
+  cmd.resultCode = common::cmd::CommandResultCode::NEW;
+  position_ += FrameSize(position_);
+}
+
+size_t WireFrameWriter::Begin(WireFormat::TemplateId templateId, size_t blockLength) {
+  const size_t offset = buffer_.size();
+  buffer_.resize(offset + WireFormat::HEADER_SIZE + blockLength, 0);
+  Write<uint16_t>(offset, static_cast<uint16_t>(blockLength));
+  Write<uint16_t>(offset + 2, static_cast<uint16_t>(templateId));
+  Write<uint16_t>(offset + 4, WireFormat::SCHEMA_ID);
+  Write<uint16_t>(offset + 6, WireFormat::SCHEMA_VERSION);
+  return offset + WireFormat::HEADER_SIZE;
+}
+
+void WireFrameWriter::PlaceOrder(int64_t uid,
+                                 int32_t symbol,
+                                 int64_t orderId,
+                                 common::OrderAction action,
+                                 common::OrderType orderType,
+                                 int64_t price,
+                                 int64_t reservePrice,
+                                 int64_t size,
+                                 int32_t userCookie,
+                                 int64_t timestamp) {
+  const size_t block =
+    Begin(WireFormat::TemplateId::PLACE_ORDER, WireFormat::PLACE_ORDER_BLOCK);
+  Write<int64_t>(block, uid);
+  Write<int64_t>(block + 8, orderId);
+  Write<int64_t>(block + 16, price);
+  Write<int64_t>(block + 24, reservePrice);
+  Write<int64_t>(block + 32, size);
+  Write<int64_t>(block + 40, timestamp);
+  Write<int32_t>(block + 48, symbol);
+  Write<int32_t>(block + 52, userCookie);
+  Write<uint8_t>(block + 56, static_cast<uint8_t>(action));
+  Write<uint8_t>(block + 57, static_cast<uint8_t>(orderType));
+}
+
+void WireFrameWriter::CancelOrder(int64_t uid, int32_t symbol, int64_t orderId, int64_t timestamp) {
+  const size_t block =
+    Begin(WireFormat::TemplateId::CANCEL_ORDER, WireFormat::CANCEL_ORDER_BLOCK);
+  Write<int64_t>(block, uid);
+  Write<int64_t>(block + 8, orderId);
+  Write<int64_t>(block + 16, timestamp);
+  Write<int32_t>(block + 24, symbol);
+}
+
+void WireFrameWriter::MoveOrder(int64_t uid,
+                                int32_t symbol,
+                                int64_t orderId,
+                                int64_t newPrice,
+                                int64_t timestamp) {
+  const size_t block = Begin(WireFormat::TemplateId::MOVE_ORDER, WireFormat::MOVE_ORDER_BLOCK);
+  Write<int64_t>(block, uid);
+  Write<int64_t>(block + 8, orderId);
+  Write<int64_t>(block + 16, newPrice);
+  Write<int64_t>(block + 24, timestamp);
+  Write<int32_t>(block + 32, symbol);
+}
+
+void WireFrameWriter::ReduceOrder(int64_t uid,
+                                  int32_t symbol,
+                                  int64_t orderId,
+                                  int64_t reduceSize,
+                                  int64_t timestamp) {
+  const size_t block =
+    Begin(WireFormat::TemplateId::REDUCE_ORDER, WireFormat::REDUCE_ORDER_BLOCK);
+  Write<int64_t>(block, uid);
+  Write<int64_t>(block + 8, orderId);
+  Write<int64_t>(block + 16, reduceSize);
+  Write<int64_t>(block + 24, timestamp);
+  Write<int32_t>(block + 32, symbol);
+}
+
+void WireFrameWriter::Batch(uint32_t count) {
+  const size_t block = Begin(WireFormat::TemplateId::BATCH, WireFormat::BATCH_BLOCK);
+  Write<uint32_t>(block, count);
+}
+
+}  // namespace exchange::core::ingress
@@ -76,17 +76,101 @@ OrderBookDirectImpl::OrderBookDirectImpl(
     common::config::LoggingConfiguration::LoggingLevel::LOGGING_MATCHING_DEBUG);
 
   // Read number of orders
-  int32_t size = bytes->ReadInt();
-
-  // Read and insert all orders
+  const int32_t size = bytes->ReadInt();
+
+  // Orders are serialized in matching priority order: asks from best price,
+  // then bids from best price, oldest first within each price.
+  // So order chains and buckets are rebuilt in one pass, and price trees are
+  // built bottom-up from sorted prices (no per-order tree lookups).
+  std::vector<DirectOrder*> orders(size);
+  orderIdIndex_.reserve(size);
   for (int32_t i = 0; i < size; i++) {
-    // Create DirectOrder from bytes (deserialization)
-    DirectOrder* order = new DirectOrder(*bytes);
-
-    // Insert order into the order book structure
-    insertOrder(order, nullptr);
+    auto* order = objectsPool_->Get<DirectOrder>(
+      ::exchange::core::collections::objpool::ObjectsPool::DIRECT_ORDER,
+      []() { return new DirectOrder(); });
+    *order = DirectOrder(*bytes);
+    orders[i] = order;
     orderIdIndex_[order->orderId] = order;
   }
+
+  const auto firstBid =
+    std::find_if(orders.begin(), orders.end(),
+                 [](const DirectOrder* order) { return order->action == OrderAction::BID; });
+  const size_t asksNum = static_cast<size_t>(firstBid - orders.begin());
+  bestAskOrder_ = BuildSortedOrders(orders.data(), asksNum, true);
+  bestBidOrder_ = BuildSortedOrders(orders.data() + asksNum, orders.size() - asksNum, false);
+}
+
+OrderBookDirectImpl::DirectOrder*
+OrderBookDirectImpl::BuildSortedOrders(DirectOrder* const* orders, size_t count, bool isAsk) {
+  std::vector<int64_t> prices;
+  std::vector<Bucket*> buckets;
+  Bucket* bucket = nullptr;
+  DirectOrder* prevOrder = nullptr;
+  for (size_t i = 0; i < count; i++) {
+    DirectOrder* order = orders[i];
+    if ((order->action == OrderAction::ASK) != isAsk) {
+      throw std::runtime_error("Order book snapshot: unexpected order action");
+    }
+    if (bucket == nullptr || order->price != bucket->price) {
+      if (bucket != nullptr && (order->price < bucket->price) == isAsk) {
+        throw std::runtime_error("Order book snapshot: orders are not sorted by price");
+      }
+      bucket = objectsPool_->Get<Bucket>(
+        ::exchange::core::collections::objpool::ObjectsPool::DIRECT_BUCKET,
+        []() { return new Bucket(); });
+      bucket->price = order->price;
+      bucket->totalVolume = 0;
+      bucket->numOrders = 0;
+      prices.push_back(order->price);
+      buckets.push_back(bucket);
+    }
+    bucket->totalVolume += order->size - order->filled;
+    bucket->numOrders++;
+    bucket->lastOrder = order;
+    order->bucket = bucket;
+
+    // next - towards best order, prev - towards worst order
+    order->next = prevOrder;
+    order->prev = nullptr;
+    if (prevOrder != nullptr) {
+      prevOrder->prev = order;
+    }
+    prevOrder = order;
+  }
+
+  if (!isAsk) {
+    std::reverse(prices.begin(), prices.end());
+    std::reverse(buckets.begin(), buckets.end());
+  }
+  auto& priceBuckets = isAsk ? askPriceBuckets_ : bidPriceBuckets_;
+  priceBuckets.PutAllSorted(prices.data(), buckets.data(), prices.size());
+
+  return count > 0 ? orders[0] : nullptr;
+}
+
+int64_t OrderBookDirectImpl::PreallocatePoolObjects(
+  ::exchange::core::collections::objpool::ObjectsPool* objectsPool) {
+  using ::exchange::core::collections::objpool::ObjectsPool;
+  using namespace ::exchange::core::collections::art;
+  if (objectsPool == nullptr) {
+    return 0;
+  }
+  int64_t allocated = 0;
+  allocated += objectsPool->Preallocate<DirectOrder>(ObjectsPool::DIRECT_ORDER,
+                                                     []() { return new DirectOrder(); });
+  allocated +=
+    objectsPool->Preallocate<Bucket>(ObjectsPool::DIRECT_BUCKET, []() { return new Bucket(); });
+  // ART nodes are only used by price bucket trees (orderIdIndex_ is a hash map)
+  allocated += objectsPool->Preallocate<ArtNode4<Bucket>>(
+    ObjectsPool::ART_NODE_4, [objectsPool]() { return new ArtNode4<Bucket>(objectsPool); });
+  allocated += objectsPool->Preallocate<ArtNode16<Bucket>>(
+    ObjectsPool::ART_NODE_16, [objectsPool]() { return new ArtNode16<Bucket>(objectsPool); });
+  allocated += objectsPool->Preallocate<ArtNode48<Bucket>>(
+    ObjectsPool::ART_NODE_48, [objectsPool]() { return new ArtNode48<Bucket>(objectsPool); });
+  allocated += objectsPool->Preallocate<ArtNode256<Bucket>>(
+    ObjectsPool::ART_NODE_256, [objectsPool]() { return new ArtNode256<Bucket>(objectsPool); });
+  return allocated;
 }
 
 const common::CoreSymbolSpecification* OrderBookDirectImpl::GetSymbolSpec() const {
@@ -152,6 +152,18 @@ common::cmd::CommandResultCode
 BinaryCommandsProcessor::AcceptBinaryFrame(common::cmd::OrderCommand* cmd) {
   const int32_t transferId = cmd->userCookie;
 
+  if (cmd->payload != nullptr) {
+    // Complete message published as single command, no reassembly
+    if (cmd->payload->size() < sizeof(int32_t)) {
+      LOG_ERROR("[BinaryCommandsProcessor] Payload too small for transferId={} size={}",
+                transferId, cmd->payload->size());
+      return common::cmd::CommandResultCode::SUCCESS;
+    }
+    common::VectorBytesIn bytesIn(*cmd->payload);
+    ProcessCompleteMessage(cmd, bytesIn);
+    return common::cmd::CommandResultCode::SUCCESS;
+  }
+
   try {
     // Get or create transfer record
     auto it = incomingData_.find(transferId);
@@ -205,118 +217,7 @@ BinaryCommandsProcessor::AcceptBinaryFrame(common::cmd::OrderCommand* cmd) {
 
       // Create bytesIn - ensure decompressedBytes stays in scope
       common::VectorBytesIn bytesIn(decompressedBytes);
-
-      if (cmd->command == common::cmd::OrderCommandType::BINARY_DATA_QUERY) {
-        // Match Java:
-        // deserializeQuery(bytesIn).flatMap(reportQueriesHandler::handleReport).ifPresent(...)
-        if (reportQueriesHandler_) {
-          // Read class code and deserialize query
-          int32_t classCode = bytesIn.ReadInt();
-          common::api::reports::ReportType reportType =
-            common::api::reports::ReportTypeFromCode(classCode);
-
-          // Use factory to create report query
-          auto* queryPtr = common::api::reports::ReportQueryFactory::getInstance().createQuery(
-            reportType, bytesIn);
-
-          if (queryPtr != nullptr) {
-            std::optional<std::unique_ptr<common::api::reports::ReportResult>> result;
-
-            // Cast to appropriate type and process (flatMap equivalent)
-            switch (reportType) {
-              case common::api::reports::ReportType::STATE_HASH: {
-                auto* query = static_cast<common::api::reports::StateHashReportQuery*>(queryPtr);
-                result = reportQueriesHandler_->HandleReport(query);
-                delete query;
-                break;
-              }
-              case common::api::reports::ReportType::SINGLE_USER_REPORT: {
-                auto* query = static_cast<common::api::reports::SingleUserReportQuery*>(queryPtr);
-                result = reportQueriesHandler_->HandleReport(query);
-                delete query;
-                break;
-              }
-              case common::api::reports::ReportType::TOTAL_CURRENCY_BALANCE: {
-                auto* query =
-                  static_cast<common::api::reports::TotalCurrencyBalanceReportQuery*>(queryPtr);
-                result = reportQueriesHandler_->HandleReport(query);
-                delete query;
-                break;
-              }
-              default:
-                delete static_cast<
-                  common::api::reports::ReportQuery<common::api::reports::ReportResult>*>(queryPtr);
-                break;
-            }
-
-            // ifPresent equivalent: if result is available, create binary
-            // events chain
-            if (result.has_value() && eventsHelper_) {
-              // Serialize result to bytes
-              std::vector<uint8_t> serializedBytes;
-              serializedBytes.reserve(128);
-              common::VectorBytesOut bytesOut(serializedBytes);
-
-              // Serialize based on type
-              switch (reportType) {
-                case common::api::reports::ReportType::STATE_HASH: {
-                  auto* stateHashResult =
-                    static_cast<common::api::reports::StateHashReportResult*>(result.value().get());
-                  stateHashResult->WriteMarshallable(bytesOut);
-                  break;
-                }
-                case common::api::reports::ReportType::SINGLE_USER_REPORT: {
-                  auto* singleUserResult =
-                    static_cast<common::api::reports::SingleUserReportResult*>(
-                      result.value().get());
-                  singleUserResult->WriteMarshallable(bytesOut);
-                  break;
-                }
-                case common::api::reports::ReportType::TOTAL_CURRENCY_BALANCE: {
-                  auto* totalCurrencyResult =
-                    static_cast<common::api::reports::TotalCurrencyBalanceReportResult*>(
-                      result.value().get());
-                  totalCurrencyResult->WriteMarshallable(bytesOut);
-                  break;
-                }
-                default:
-                  break;
-              }
-
-              // Resize serializedBytes to actual written size (VectorBytesOut
-              // may have grown the vector beyond what was written)
-              serializedBytes.resize(bytesOut.GetPosition());
-
-              // Create binary events chain
-              common::MatcherTradeEvent* binaryEventsChain =
-                eventsHelper_->CreateBinaryEventsChain(cmd->timestamp, section_, serializedBytes);
-
-              // Append events to command using atomic operation
-              if (binaryEventsChain != nullptr) {
-                utils::UnsafeUtils::AppendEventsVolatile(cmd, binaryEventsChain);
-              }
-            }
-          }
-        }
-      } else if (cmd->command == common::cmd::OrderCommandType::BINARY_DATA_COMMAND) {
-        // Handle binary data command
-        // Match Java: deserializeBinaryCommand(bytesIn)
-        int32_t classCode = bytesIn.ReadInt();
-        common::api::binary::BinaryCommandType commandType =
-          common::api::binary::BinaryCommandTypeFromCode(classCode);
-
-        // Use factory to create binary command
-        auto binaryCommand =
-          common::api::binary::BinaryDataCommandFactory::getInstance().createCommand(commandType,
-                                                                                     bytesIn);
-
-        // Match Java: completeMessagesHandler.accept(binaryDataCommand)
-        if (completeMessagesHandler_ && binaryCommand) {
-          completeMessagesHandler_(binaryCommand.get());
-        }
-      } else {
-        throw std::runtime_error("Invalid binary command type");
-      }
+      ProcessCompleteMessage(cmd, bytesIn);
 
       delete record;
       return common::cmd::CommandResultCode::SUCCESS;
@@ -338,6 +239,120 @@ BinaryCommandsProcessor::AcceptBinaryFrame(common::cmd::OrderCommand* cmd) {
   }
 }
 
+void BinaryCommandsProcessor::ProcessCompleteMessage(common::cmd::OrderCommand* cmd,
+                                                     common::BytesIn& bytesIn) {
+  if (cmd->command == common::cmd::OrderCommandType::BINARY_DATA_QUERY) {
+    // Match Java:
+    // deserializeQuery(bytesIn).flatMap(reportQueriesHandler::handleReport).ifPresent(...)
+    if (reportQueriesHandler_) {
+      // Read class code and deserialize query
+      int32_t classCode = bytesIn.ReadInt();
+      common::api::reports::ReportType reportType =
+        common::api::reports::ReportTypeFromCode(classCode);
+
+      // Use factory to create report query
+      auto* queryPtr =
+        common::api::reports::ReportQueryFactory::getInstance().createQuery(reportType, bytesIn);
+
+      if (queryPtr != nullptr) {
+        std::optional<std::unique_ptr<common::api::reports::ReportResult>> result;
+
+        // Cast to appropriate type and process (flatMap equivalent)
+        switch (reportType) {
+          case common::api::reports::ReportType::STATE_HASH: {
+            auto* query = static_cast<common::api::reports::StateHashReportQuery*>(queryPtr);
+            result = reportQueriesHandler_->HandleReport(query);
+            delete query;
+            break;
+          }
+          case common::api::reports::ReportType::SINGLE_USER_REPORT: {
+            auto* query = static_cast<common::api::reports::SingleUserReportQuery*>(queryPtr);
+            result = reportQueriesHandler_->HandleReport(query);
+            delete query;
+            break;
+          }
+          case common::api::reports::ReportType::TOTAL_CURRENCY_BALANCE: {
+            auto* query =
+              static_cast<common::api::reports::TotalCurrencyBalanceReportQuery*>(queryPtr);
+            result = reportQueriesHandler_->HandleReport(query);
+            delete query;
+            break;
+          }
+          default:
+            delete static_cast<
+              common::api::reports::ReportQuery<common::api::reports::ReportResult>*>(queryPtr);
+            break;
+        }
+
+        // ifPresent equivalent: if result is available, create binary
+        // events chain
+        if (result.has_value() && eventsHelper_) {
+          // Serialize result to bytes
+          std::vector<uint8_t> serializedBytes;
+          serializedBytes.reserve(128);
+          common::VectorBytesOut bytesOut(serializedBytes);
+
+          // Serialize based on type
+          switch (reportType) {
+            case common::api::reports::ReportType::STATE_HASH: {
+              auto* stateHashResult =
+                static_cast<common::api::reports::StateHashReportResult*>(result.value().get());
+              stateHashResult->WriteMarshallable(bytesOut);
+              break;
+            }
+            case common::api::reports::ReportType::SINGLE_USER_REPORT: {
+              auto* singleUserResult =
+                static_cast<common::api::reports::SingleUserReportResult*>(result.value().get());
+              singleUserResult->WriteMarshallable(bytesOut);
+              break;
+            }
+            case common::api::reports::ReportType::TOTAL_CURRENCY_BALANCE: {
+              auto* totalCurrencyResult =
+                static_cast<common::api::reports::TotalCurrencyBalanceReportResult*>(
+                  result.value().get());
+              totalCurrencyResult->WriteMarshallable(bytesOut);
+              break;
+            }
+            default:
+              break;
+          }
+
+          // Resize serializedBytes to actual written size (VectorBytesOut
+          // may have grown the vector beyond what was written)
+          serializedBytes.resize(bytesOut.GetPosition());
+
+          // Create binary events chain
+          common::MatcherTradeEvent* binaryEventsChain =
+            eventsHelper_->CreateBinaryEventsChain(cmd->timestamp, section_, serializedBytes);
+
+          // Append events to command using atomic operation
+          if (binaryEventsChain != nullptr) {
+            utils::UnsafeUtils::AppendEventsVolatile(cmd, binaryEventsChain);
+          }
+        }
+      }
+    }
+  } else if (cmd->command == common::cmd::OrderCommandType::BINARY_DATA_COMMAND) {
+    // Handle binary data command
+    // Match Java: deserializeBinaryCommand(bytesIn)
+    int32_t classCode = bytesIn.ReadInt();
+    common::api::binary::BinaryCommandType commandType =
+      common::api::binary::BinaryCommandTypeFromCode(classCode);
+
+    // Use factory to create binary command
+    auto binaryCommand =
+      common::api::binary::BinaryDataCommandFactory::getInstance().createCommand(commandType,
+                                                                                 bytesIn);
+
+    // Match Java: completeMessagesHandler.accept(binaryDataCommand)
+    if (completeMessagesHandler_ && binaryCommand) {
+      completeMessagesHandler_(binaryCommand.get());
+    }
+  } else {
+    throw std::runtime_error("Invalid binary command type");
+  }
+}
+
 void BinaryCommandsProcessor::Reset() {
   // Clean up all transfer records
   for (auto& pair : incomingData_) {
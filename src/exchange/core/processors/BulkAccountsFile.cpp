@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <exchange/core/processors/BulkAccountsFile.h>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace exchange::core::processors {
+
+BulkAccountsFile::BulkAccountsFile(const std::string& path) : file_(path) {
+  const char* data = file_.Data();
+  const size_t size = file_.Size();
+  if (size < HEADER_SIZE) {
+    throw std::runtime_error("Bulk accounts file is too short: " + path);
+  }
+  int32_t magic;
+  int32_t version;
+  int64_t rows;
+  std::memcpy(&magic, data, sizeof(magic));
+  std::memcpy(&version, data + 4, sizeof(version));
+  std::memcpy(&rows, data + 8, sizeof(rows));
+  if (magic != MAGIC || version != VERSION) {
+    throw std::runtime_error("Not a bulk accounts file (or unsupported version): " + path);
+  }
+  constexpr size_t ROW_SIZE = sizeof(int64_t) * 2 + sizeof(int32_t);
+  if (rows < 0 || static_cast<size_t>(rows) > (size - HEADER_SIZE) / ROW_SIZE
+      || HEADER_SIZE + static_cast<size_t>(rows) * ROW_SIZE != size) {
+    throw std::runtime_error("Bulk accounts file size does not match rows number: " + path);
+  }
+  // mapping is page aligned, 8-byte columns go first
+  rows_ = static_cast<size_t>(rows);
+  uids_ = reinterpret_cast<const int64_t*>(data + HEADER_SIZE);
+  balances_ = uids_ + rows_;
+  currencies_ = reinterpret_cast<const int32_t*>(balances_ + rows_);
+}
+
+void BulkAccountsFile::Write(const std::string& path, const std::vector<Row>& rows) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error("Can not create bulk accounts file: " + path);
+  }
+  const int64_t rowsNum = static_cast<int64_t>(rows.size());
+  out.write(reinterpret_cast<const char*>(&MAGIC), sizeof(MAGIC));
+  out.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+  out.write(reinterpret_cast<const char*>(&rowsNum), sizeof(rowsNum));
+  for (const Row& row : rows) {
+    out.write(reinterpret_cast<const char*>(&row.uid), sizeof(row.uid));
+  }
+  for (const Row& row : rows) {
+    out.write(reinterpret_cast<const char*>(&row.balance), sizeof(row.balance));
+  }
+  for (const Row& row : rows) {
+    out.write(reinterpret_cast<const char*>(&row.currency), sizeof(row.currency));
+  }
+  if (!out.flush()) {
+    throw std::runtime_error("Can not write bulk accounts file: " + path);
+  }
+}
+
+}  // namespace exchange::core::processors
@@ -23,6 +23,7 @@
 #include <exchange/core/common/cmd/OrderCommandType.h>
 #include <exchange/core/orderbook/IOrderBook.h>
 #include <exchange/core/orderbook/OrderBookEventsHelper.h>
+#include <exchange/core/orderbook/OrderBookDirectImpl.h>
 #include <exchange/core/orderbook/OrderBookNaiveImpl.h>
 #include <exchange/core/processors/BinaryCommandsProcessor.h>
 #include <exchange/core/processors/MatchingEngineReportQueriesHandler.h>
@@ -92,6 +93,9 @@ MatchingEngineRouter::MatchingEngineRouter(
     const auto& perfCfg = exchangeCfg->performanceCfg;
     cfgSendL2ForEveryCmd_ = perfCfg.sendL2ForEveryCmd;
     cfgL2RefreshDepth_ = perfCfg.l2RefreshDepth;
+    orderBooksIndex_ =
+      ::exchange::core::collections::DenseIntIndex<orderbook::IOrderBook>(
+        perfCfg.denseSymbolIdLimit);
 
     const auto& loggingCfg = exchangeCfg->loggingCfg;
     // Check if LOGGING_MATCHING_DEBUG is in logging levels
@@ -102,41 +106,62 @@ MatchingEngineRouter::MatchingEngineRouter(
     if (journaling::ISerializationProcessor::CanLoadFromSnapshot(
           serializationProcessor_, &initStateCfg, shardId_,
           journaling::ISerializationProcessor::SerializedModuleType::MATCHING_ENGINE_ROUTER)) {
-      // Load from snapshot
-      serializationProcessor_->LoadData(
+      // Deserialize state, order books are stored either inside the state
+      // (plain snapshot) or as separate entries (incremental snapshot)
+      const auto readState = [this, sharedPool, exchangeCfg](common::BytesIn* bytesIn,
+                                                             bool withOrderBooks) {
+        if (bytesIn == nullptr) {
+          throw std::invalid_argument("BytesIn cannot be nullptr");
+        }
+        // Verify shardId and shardMask
+        if (shardId_ != bytesIn->ReadInt()) {
+          throw std::runtime_error("wrong shardId");
+        }
+        if (shardMask_ != bytesIn->ReadLong()) {
+          throw std::runtime_error("wrong shardMask");
+        }
+
+        // Create ReportQueriesHandler adapter to forward queries to
+        // MatchingEngineRouter
+        reportQueriesHandler_ = std::make_unique<MatchingEngineReportQueriesHandler>(this);
+
+        // Deserialize BinaryCommandsProcessor
+        binaryCommandsProcessor_ = std::make_unique<BinaryCommandsProcessor>(
+          [this](common::api::binary::BinaryDataCommand* msg) { HandleBinaryMessage(msg); },
+          reportQueriesHandler_.get(), sharedPool, &exchangeCfg->reportsQueriesCfg, bytesIn,
+          shardId_ + 1024);
+
+        if (!withOrderBooks) {
+          return;
+        }
+
+        // Deserialize orderBooks (int -> IOrderBook*)
+        int orderBooksLength = bytesIn->ReadInt();
+        for (int i = 0; i < orderBooksLength; i++) {
+          int32_t symbolId = bytesIn->ReadInt();
+          auto orderBook = orderbook::IOrderBook::Create(
+            bytesIn, objectsPool_.get(), eventsHelper_.get(), &exchangeCfg->loggingCfg);
+          PutOrderBook(symbolId, std::move(orderBook));
+        }
+      };
+
+      // Incremental snapshot chain, or plain snapshot
+      const bool isLoaded = serializationProcessor_->LoadIncrementalData(
         initStateCfg.snapshotId,
-        journaling::ISerializationProcessor::SerializedModuleType::MATCHING_ENGINE_ROUTER, shardId_,
-        [this, sharedPool, exchangeCfg](common::BytesIn* bytesIn) {
-          if (bytesIn == nullptr) {
-            throw std::invalid_argument("BytesIn cannot be nullptr");
-          }
-          // Verify shardId and shardMask
-          if (shardId_ != bytesIn->ReadInt()) {
-            throw std::runtime_error("wrong shardId");
-          }
-          if (shardMask_ != bytesIn->ReadLong()) {
-            throw std::runtime_error("wrong shardMask");
-          }
-
-          // Create ReportQueriesHandler adapter to forward queries to
-          // MatchingEngineRouter
-          reportQueriesHandler_ = std::make_unique<MatchingEngineReportQueriesHandler>(this);
-
-          // Deserialize BinaryCommandsProcessor
-          binaryCommandsProcessor_ = std::make_unique<BinaryCommandsProcessor>(
-            [this](common::api::binary::BinaryDataCommand* msg) { HandleBinaryMessage(msg); },
-            reportQueriesHandler_.get(), sharedPool, &exchangeCfg->reportsQueriesCfg, bytesIn,
-            shardId_ + 1024);
-
-          // Deserialize orderBooks (int -> IOrderBook*)
-          int orderBooksLength = bytesIn->ReadInt();
-          for (int i = 0; i < orderBooksLength; i++) {
-            int32_t symbolId = bytesIn->ReadInt();
-            auto orderBook = orderbook::IOrderBook::Create(
-              bytesIn, objectsPool_.get(), eventsHelper_.get(), &exchangeCfg->loggingCfg);
-            orderBooks_[symbolId] = std::move(orderBook);
-          }
+        journaling::ISerializationProcessor::SerializedModuleType::MATCHING_ENGINE_ROUTER,
+        shardId_, [&readState](common::BytesIn* bytesIn) { readState(bytesIn, false); },
+        [this, exchangeCfg](int64_t symbolId, common::BytesIn* bytesIn) {
+          PutOrderBook(static_cast<int32_t>(symbolId),
+                       orderbook::IOrderBook::Create(bytesIn, objectsPool_.get(),
+                                                     eventsHelper_.get(),
+                                                     &exchangeCfg->loggingCfg));
         });
+      if (!isLoaded) {
+        serializationProcessor_->LoadData(
+          initStateCfg.snapshotId,
+          journaling::ISerializationProcessor::SerializedModuleType::MATCHING_ENGINE_ROUTER,
+          shardId_, [&readState](common::BytesIn* bytesIn) { readState(bytesIn, true); });
+      }
     } else {
       // Create ReportQueriesHandler adapter to forward queries to
       // MatchingEngineRouter
@@ -147,6 +172,10 @@ MatchingEngineRouter::MatchingEngineRouter(
         [this](common::api::binary::BinaryDataCommand* msg) { HandleBinaryMessage(msg); },
         reportQueriesHandler_.get(), sharedPool, &exchangeCfg->reportsQueriesCfg, shardId + 1024);
     }
+
+    // Changed order books are tracked for incremental snapshots
+    trackChanges_ = serializationProcessor_ != nullptr
+                    && serializationProcessor_->IncrementalSnapshotsEnabled();
   } else {
     // Create with minimal configuration
     binaryCommandsProcessor_ = std::make_unique<BinaryCommandsProcessor>(
@@ -187,6 +216,9 @@ void MatchingEngineRouter::ProcessOrder(int64_t seq, common::cmd::OrderCommand*
   if (command == common::cmd::OrderCommandType::RESET) {
     // Process all symbol groups, only processor 0 writes result
     orderBooks_.clear();
+    orderBooksIndex_.Clear();
+    changedSymbols_.clear();
+    changesLost_ = true;
     if (binaryCommandsProcessor_ != nullptr) {
       binaryCommandsProcessor_->Reset();
     }
@@ -207,10 +239,16 @@ void MatchingEngineRouter::ProcessOrder(int64_t seq, common::cmd::OrderCommand*
   // Handle PERSIST_STATE_MATCHING command
   if (command == common::cmd::OrderCommandType::PERSIST_STATE_MATCHING) {
     if (serializationProcessor_ != nullptr) {
-      const bool isSuccess = serializationProcessor_->StoreData(
-        cmd->orderId, seq, cmd->timestamp,
-        journaling::ISerializationProcessor::SerializedModuleType::MATCHING_ENGINE_ROUTER, shardId_,
-        this);
+      const bool isSuccess =
+        serializationProcessor_->IncrementalSnapshotsEnabled()
+          ? serializationProcessor_->StoreIncrementalData(
+              cmd->orderId, seq, cmd->timestamp,
+              journaling::ISerializationProcessor::SerializedModuleType::MATCHING_ENGINE_ROUTER,
+              shardId_, this)
+          : serializationProcessor_->StoreData(
+              cmd->orderId, seq, cmd->timestamp,
+              journaling::ISerializationProcessor::SerializedModuleType::MATCHING_ENGINE_ROUTER,
+              shardId_, this);
       // Send ACCEPTED because this is a first command in series.
       // Risk engine is second - so it will return SUCCESS
       utils::UnsafeUtils::SetResultVolatile(
@@ -224,10 +262,19 @@ void MatchingEngineRouter::ProcessOrder(int64_t seq, common::cmd::OrderCommand*
 }
 
 orderbook::IOrderBook* MatchingEngineRouter::GetOrderBook(int32_t symbolId) {
+  if (orderBooksIndex_.InRange(symbolId)) {
+    return orderBooksIndex_.Get(symbolId);
+  }
   auto it = orderBooks_.find(symbolId);
   return (it != orderBooks_.end()) ? it->second.get() : nullptr;
 }
 
+void MatchingEngineRouter::PutOrderBook(int32_t symbolId,
+                                        std::unique_ptr<orderbook::IOrderBook> orderBook) {
+  orderBooksIndex_.Put(symbolId, orderBook.get());
+  orderBooks_[symbolId] = std::move(orderBook);
+}
+
 void MatchingEngineRouter::AddSymbol(const common::CoreSymbolSpecification* spec) {
   if (spec == nullptr) {
     return;
@@ -249,13 +296,14 @@ void MatchingEngineRouter::AddSymbol(const common::CoreSymbolSpecification* spec
   // Create new order book using factory
   if (orderBookFactory_) {
     auto orderBook = orderBookFactory_(spec, objectsPool_.get(), eventsHelper_.get());
-    orderBooks_[spec->symbolId] = std::move(orderBook);
+    PutOrderBook(spec->symbolId, std::move(orderBook));
   } else {
     // Fallback to naive implementation
     auto orderBook = std::make_unique<orderbook::OrderBookNaiveImpl>(spec, objectsPool_.get(),
                                                                      eventsHelper_.get());
-    orderBooks_[spec->symbolId] = std::move(orderBook);
+    PutOrderBook(spec->symbolId, std::move(orderBook));
   }
+  MarkChanged(spec->symbolId);
 
   if (symbolSpecProvider_ != nullptr) {
     symbolSpecProvider_->AddSymbol(spec);
@@ -286,6 +334,9 @@ bool MatchingEngineRouter::SymbolForThisHandler(int32_t symbolId) const {
 
 void MatchingEngineRouter::Reset() {
   orderBooks_.clear();
+  orderBooksIndex_.Clear();
+  changedSymbols_.clear();
+  changesLost_ = true;
   if (binaryCommandsProcessor_ != nullptr) {
     binaryCommandsProcessor_->Reset();
   }
@@ -294,6 +345,11 @@ void MatchingEngineRouter::Reset() {
   }
 }
 
+int64_t MatchingEngineRouter::PreallocatePools() {
+  // Only OrderBookDirectImpl takes objects from the pool
+  return orderbook::OrderBookDirectImpl::PreallocatePoolObjects(objectsPool_.get());
+}
+
 std::vector<orderbook::IOrderBook*> MatchingEngineRouter::GetOrderBooks() const {
   std::vector<orderbook::IOrderBook*> result;
   result.reserve(orderBooks_.size());
@@ -318,6 +374,9 @@ void MatchingEngineRouter::ProcessMatchingCommand(common::cmd::OrderCommand* cmd
   } else {
     // Match Java: cmd.resultCode = IOrderBook.processCommand(orderBook, cmd);
     cmd->resultCode = orderbook::IOrderBook::ProcessCommand(orderBook, cmd);
+    if (cmd->command != common::cmd::OrderCommandType::ORDER_BOOK_REQUEST) {
+      MarkChanged(cmd->symbol);
+    }
 
     // Match Java: posting market data for risk processor makes sense only if
     // command execution is successful
@@ -334,12 +393,7 @@ void MatchingEngineRouter::ProcessMatchingCommand(common::cmd::OrderCommand* cmd
 }
 
 void MatchingEngineRouter::WriteMarshallable(common::BytesOut& bytes) const {
-  // Write shardId and shardMask
-  bytes.WriteInt(shardId_);
-  bytes.WriteLong(shardMask_);
-
-  // Write binaryCommandsProcessor (always non-null in Java)
-  binaryCommandsProcessor_->WriteMarshallable(bytes);
+  WriteGlobalState(bytes);
 
   // Write orderBooks
   // Match Java: SerializationUtils.marshallIntHashMap(orderBooks, bytes)
@@ -351,4 +405,40 @@ void MatchingEngineRouter::WriteMarshallable(common::BytesOut& bytes) const {
   utils::SerializationUtils::MarshallIntHashMap(orderBookMap, bytes);
 }
 
+void MatchingEngineRouter::WriteGlobalState(common::BytesOut& bytes) const {
+  // Write shardId and shardMask
+  bytes.WriteInt(shardId_);
+  bytes.WriteLong(shardMask_);
+
+  // Write binaryCommandsProcessor (always non-null in Java)
+  binaryCommandsProcessor_->WriteMarshallable(bytes);
+}
+
+void MatchingEngineRouter::WriteEntries(journaling::SnapshotEntriesWriter& writer,
+                                        bool changedOnly) const {
+  if (!changedOnly) {
+    for (const auto& [symbolId, orderBook] : orderBooks_) {
+      writer.Write(symbolId, *orderBook);
+    }
+    return;
+  }
+  for (const int32_t symbolId : changedSymbols_) {
+    const auto it = orderBooks_.find(symbolId);
+    if (it != orderBooks_.end()) {
+      writer.Write(symbolId, *it->second);
+    } else {
+      writer.WriteRemoved(symbolId);
+    }
+  }
+}
+
+bool MatchingEngineRouter::ChangesTracked() const {
+  return trackChanges_ && !changesLost_;
+}
+
+void MatchingEngineRouter::ClearChanges() {
+  changedSymbols_.clear();
+  changesLost_ = false;
+}
+
 }  // namespace exchange::core::processors
@@ -30,12 +30,14 @@
 #include <exchange/core/common/config/ExchangeConfiguration.h>
 #include <exchange/core/common/config/OrdersProcessingConfiguration.h>
 #include <exchange/core/processors/BinaryCommandsProcessor.h>
+#include <exchange/core/processors/BulkAccountsFile.h>
 #include <exchange/core/processors/RiskEngine.h>
 #include <exchange/core/processors/RiskEngineReportQueriesHandler.h>
 #include <exchange/core/processors/UserProfileService.h>
 #include <exchange/core/processors/journaling/DiskSerializationProcessorConfiguration.h>
 #include <exchange/core/processors/journaling/ISerializationProcessor.h>
 #include <exchange/core/utils/CoreArithmeticUtils.h>
+#include <exchange/core/utils/FastNanoTime.h>
 #include <exchange/core/utils/Logger.h>
 #include <exchange/core/utils/SerializationUtils.h>
 #include <exchange/core/utils/UnsafeUtils.h>
@@ -66,6 +68,8 @@ RiskEngine::RiskEngine(int32_t shardId,
   const auto* initStateCfg = &exchangeConfiguration->initStateCfg;
   const auto* ordersProcCfg = &exchangeConfiguration->ordersProcessingCfg;
   const auto* reportsQueriesCfg = &exchangeConfiguration->reportsQueriesCfg;
+  const int32_t denseSymbolIdLimit = exchangeConfiguration->performanceCfg.denseSymbolIdLimit;
+  lastPriceCacheIndex_ = collections::DenseIntIndex<LastPriceCacheRecord>(denseSymbolIdLimit);
 
   // Initialize exchangeId and folder
   exchangeId_ = initStateCfg->exchangeId;
@@ -94,61 +98,79 @@ RiskEngine::RiskEngine(int32_t shardId,
   objectsPool_ = std::unique_ptr<::exchange::core::collections::objpool::ObjectsPool>(
     new ::exchange::core::collections::objpool::ObjectsPool(objectsPoolConfig));
 
-  // Try to load from snapshot
-  if (journaling::ISerializationProcessor::CanLoadFromSnapshot(
-        serializationProcessor, initStateCfg, shardId_,
-        journaling::ISerializationProcessor::SerializedModuleType::RISK_ENGINE)) {
-    // Load from snapshot
-    serializationProcessor->LoadData(
-      initStateCfg->snapshotId,
-      journaling::ISerializationProcessor::SerializedModuleType::RISK_ENGINE, shardId_,
-      [this, sharedPool, reportsQueriesCfg](common::BytesIn* bytesIn) {
-        if (bytesIn == nullptr) {
-          throw std::invalid_argument("BytesIn cannot be nullptr");
-        }
-        // Verify shardId and shardMask
-        if (shardId_ != bytesIn->ReadInt()) {
-          throw std::runtime_error("wrong shardId");
-        }
-        if (shardMask_ != bytesIn->ReadLong()) {
-          throw std::runtime_error("wrong shardMask");
-        }
+  // Deserialize state, user profiles are stored either inside the state
+  // (plain snapshot) or as separate entries (incremental snapshot)
+  const auto readState = [this, sharedPool, reportsQueriesCfg, denseSymbolIdLimit](
+                           common::BytesIn* bytesIn, bool withUserProfiles) {
+    if (bytesIn == nullptr) {
+      throw std::invalid_argument("BytesIn cannot be nullptr");
+    }
+    // Verify shardId and shardMask
+    if (shardId_ != bytesIn->ReadInt()) {
+      throw std::runtime_error("wrong shardId");
+    }
+    if (shardMask_ != bytesIn->ReadLong()) {
+      throw std::runtime_error("wrong shardMask");
+    }
 
-        // Deserialize SymbolSpecificationProvider
-        symbolSpecificationProvider_ = std::make_unique<SymbolSpecificationProvider>(bytesIn);
+    // Deserialize SymbolSpecificationProvider
+    symbolSpecificationProvider_ =
+      std::make_unique<SymbolSpecificationProvider>(bytesIn, denseSymbolIdLimit);
 
-        // Deserialize UserProfileService
-        userProfileService_ = std::make_unique<UserProfileService>(bytesIn);
+    // Deserialize UserProfileService
+    userProfileService_ = withUserProfiles ? std::make_unique<UserProfileService>(bytesIn)
+                                           : std::make_unique<UserProfileService>();
 
-        // Create ReportQueriesHandler adapter to forward queries to
-        // RiskEngine
-        reportQueriesHandler_ = std::make_unique<RiskEngineReportQueriesHandler>(this);
+    // Create ReportQueriesHandler adapter to forward queries to
+    // RiskEngine
+    reportQueriesHandler_ = std::make_unique<RiskEngineReportQueriesHandler>(this);
 
-        // Deserialize BinaryCommandsProcessor
-        binaryCommandsProcessor_ = std::make_unique<BinaryCommandsProcessor>(
-          [this](common::api::binary::BinaryDataCommand* msg) { HandleBinaryMessage(msg); },
-          reportQueriesHandler_.get(), sharedPool, reportsQueriesCfg, bytesIn, shardId_);
+    // Deserialize BinaryCommandsProcessor
+    binaryCommandsProcessor_ = std::make_unique<BinaryCommandsProcessor>(
+      [this](common::api::binary::BinaryDataCommand* msg) { HandleBinaryMessage(msg); },
+      reportQueriesHandler_.get(), sharedPool, reportsQueriesCfg, bytesIn, shardId_);
+
+    // Deserialize lastPriceCache (int -> LastPriceCacheRecord)
+    int lastPriceCacheLength = bytesIn->ReadInt();
+    for (int i = 0; i < lastPriceCacheLength; i++) {
+      int32_t symbolId = bytesIn->ReadInt();
+      LastPriceCacheRecord record(*bytesIn);
+      lastPriceCache_[symbolId] = record;
+    }
+    RebuildLastPriceCacheIndex();
 
-        // Deserialize lastPriceCache (int -> LastPriceCacheRecord)
-        int lastPriceCacheLength = bytesIn->ReadInt();
-        for (int i = 0; i < lastPriceCacheLength; i++) {
-          int32_t symbolId = bytesIn->ReadInt();
-          LastPriceCacheRecord record(*bytesIn);
-          lastPriceCache_[symbolId] = record;
-        }
+    // Deserialize fees (int -> long)
+    fees_ = utils::SerializationUtils::ReadIntLongHashMap(*bytesIn);
 
-        // Deserialize fees (int -> long)
-        fees_ = utils::SerializationUtils::ReadIntLongHashMap(*bytesIn);
+    // Deserialize adjustments (int -> long)
+    adjustments_ = utils::SerializationUtils::ReadIntLongHashMap(*bytesIn);
 
-        // Deserialize adjustments (int -> long)
-        adjustments_ = utils::SerializationUtils::ReadIntLongHashMap(*bytesIn);
+    // Deserialize suspends (int -> long)
+    suspends_ = utils::SerializationUtils::ReadIntLongHashMap(*bytesIn);
+  };
 
-        // Deserialize suspends (int -> long)
-        suspends_ = utils::SerializationUtils::ReadIntLongHashMap(*bytesIn);
+  // Try to load from snapshot
+  if (journaling::ISerializationProcessor::CanLoadFromSnapshot(
+        serializationProcessor, initStateCfg, shardId_,
+        journaling::ISerializationProcessor::SerializedModuleType::RISK_ENGINE)) {
+    // Incremental snapshot chain, or plain snapshot
+    const bool isLoaded = serializationProcessor->LoadIncrementalData(
+      initStateCfg->snapshotId,
+      journaling::ISerializationProcessor::SerializedModuleType::RISK_ENGINE, shardId_,
+      [&readState](common::BytesIn* bytesIn) { readState(bytesIn, false); },
+      [this](int64_t uid, common::BytesIn* bytesIn) {
+        userProfileService_->RestoreUserProfile(uid, bytesIn);
       });
+    if (!isLoaded) {
+      serializationProcessor->LoadData(
+        initStateCfg->snapshotId,
+        journaling::ISerializationProcessor::SerializedModuleType::RISK_ENGINE, shardId_,
+        [&readState](common::BytesIn* bytesIn) { readState(bytesIn, true); });
+    }
   } else {
     // Initialize services normally
-    symbolSpecificationProvider_ = std::make_unique<SymbolSpecificationProvider>();
+    symbolSpecificationProvider_ =
+      std::make_unique<SymbolSpecificationProvider>(denseSymbolIdLimit);
     userProfileService_ = std::make_unique<UserProfileService>();
 
     // Create ReportQueriesHandler adapter to forward queries to RiskEngine
@@ -157,6 +179,22 @@ RiskEngine::RiskEngine(int32_t shardId,
     binaryCommandsProcessor_ = std::make_unique<BinaryCommandsProcessor>(
       [this](common::api::binary::BinaryDataCommand* msg) { HandleBinaryMessage(msg); },
       reportQueriesHandler_.get(), sharedPool, reportsQueriesCfg, shardId_);
+
+    // Initial accounts of this shard (shards are created concurrently)
+    if (!initStateCfg->accountsFile.empty()) {
+      const int64_t startNs = utils::FastNanoTime::Now();
+      const BulkAccountsFile accountsFile(initStateCfg->accountsFile);
+      const size_t loaded =
+        userProfileService_->LoadAccounts(accountsFile, shardId_, shardMask_, adjustments_);
+      LOG_INFO("[RiskEngine] shard {} loaded {} of {} account rows from {} in {} ms", shardId_,
+               loaded, accountsFile.Rows(), initStateCfg->accountsFile,
+               (utils::FastNanoTime::Now() - startNs) / 1'000'000);
+    }
+  }
+
+  // Changed profiles are tracked for incremental snapshots
+  if (serializationProcessor != nullptr && serializationProcessor->IncrementalSnapshotsEnabled()) {
+    userProfileService_->EnableChangesTracking();
   }
 }
 
@@ -225,9 +263,16 @@ bool RiskEngine::PreProcessCommand(int64_t seq, common::cmd::OrderCommand* cmd)
 
     case common::cmd::OrderCommandType::PERSIST_STATE_RISK:
       if (serializationProcessor_ != nullptr) {
-        const bool isSuccess = serializationProcessor_->StoreData(
-          cmd->orderId, seq, cmd->timestamp,
-          journaling::ISerializationProcessor::SerializedModuleType::RISK_ENGINE, shardId_, this);
+        const bool isSuccess =
+          serializationProcessor_->IncrementalSnapshotsEnabled()
+            ? serializationProcessor_->StoreIncrementalData(
+                cmd->orderId, seq, cmd->timestamp,
+                journaling::ISerializationProcessor::SerializedModuleType::RISK_ENGINE, shardId_,
+                this)
+            : serializationProcessor_->StoreData(
+                cmd->orderId, seq, cmd->timestamp,
+                journaling::ISerializationProcessor::SerializedModuleType::RISK_ENGINE, shardId_,
+                this);
         utils::UnsafeUtils::SetResultVolatile(
           cmd, isSuccess, common::cmd::CommandResultCode::SUCCESS,
           common::cmd::CommandResultCode::STATE_PERSIST_RISK_ENGINE_FAILED);
@@ -304,9 +349,26 @@ void RiskEngine::PostProcessCommand(int64_t seq, common::cmd::OrderCommand* cmd)
 
   // Process market data
   if (marketData != nullptr && cfgMarginTradingEnabled_) {
-    auto& record = lastPriceCache_[symbol];
-    record.askPrice = (marketData->askSize != 0) ? marketData->askPrices[0] : INT64_MAX;
-    record.bidPrice = (marketData->bidSize != 0) ? marketData->bidPrices[0] : 0;
+    auto& record = GetOrAddLastPriceCacheRecord(symbol);
+    const int64_t askPrice = (marketData->askSize != 0) ? marketData->askPrices[0] : INT64_MAX;
+    const int64_t bidPrice = (marketData->bidSize != 0) ? marketData->bidPrices[0] : 0;
+    if (record.askPrice != askPrice || record.bidPrice != bidPrice) {
+      record.askPrice = askPrice;
+      record.bidPrice = bidPrice;
+      marginPriceEpochs_[spec->quoteCurrency]++;
+    }
+  }
+}
+
+void RiskEngine::PrefetchCommandIndex(const common::cmd::OrderCommand* cmd) const {
+  if (cmd->command == common::cmd::OrderCommandType::PLACE_ORDER && UidForThisHandler(cmd->uid)) {
+    userProfileService_->PrefetchUserProfileSlot(cmd->uid);
+  }
+}
+
+void RiskEngine::PrefetchCommand(const common::cmd::OrderCommand* cmd) const {
+  if (cmd->command == common::cmd::OrderCommandType::PLACE_ORDER && UidForThisHandler(cmd->uid)) {
+    userProfileService_->PrefetchUserProfile(cmd->uid);
   }
 }
 
@@ -319,11 +381,19 @@ void RiskEngine::Reset() {
   userProfileService_->Reset();
   binaryCommandsProcessor_->Reset();
   lastPriceCache_.clear();
+  lastPriceCacheIndex_.Clear();
+  marginPriceEpochs_.clear();
   fees_.clear();
   adjustments_.clear();
   suspends_.clear();
 }
 
+int64_t RiskEngine::PreallocatePools() {
+  return objectsPool_->Preallocate<common::SymbolPositionRecord>(
+    ::exchange::core::collections::objpool::ObjectsPool::SYMBOL_POSITION_RECORD,
+    []() { return new common::SymbolPositionRecord(); });
+}
+
 common::cmd::CommandResultCode RiskEngine::PlaceOrderRiskCheck(common::cmd::OrderCommand* cmd) {
   auto* userProfile = userProfileService_->GetUserProfile(cmd->uid);
   if (userProfile == nullptr) {
@@ -368,7 +438,7 @@ void RiskEngine::HandleBinaryMessage(common::api::binary::BinaryDataCommand* mes
     for (const auto& [uid, accounts] : users) {
       if (userProfileService_->AddUser(uid) == common::cmd::CommandResultCode::SUCCESS) {
         for (const auto& [cur, bal] : accounts) {
-          AdjustBalance(uid, cur, bal, 1'000'000'000 + cur,
+          AdjustBalance(uid, cur, bal, UserProfileService::BATCH_ADD_FUNDING_BASE + cur,
                         common::BalanceAdjustmentType::ADJUSTMENT);
         }
       }
@@ -411,7 +481,16 @@ common::cmd::CommandResultCode RiskEngine::PlaceOrder(common::cmd::OrderCommand*
 
     const bool canPlaceOrder = CanPlaceMarginOrder(cmd, userProfile, spec, position);
     if (canPlaceOrder) {
+      // pending hold changes only required margin - adjust cached free margin
+      const int64_t marginBefore = position->CalculateRequiredMarginForFutures(*spec);
       position->PendingHold(cmd->action, cmd->size);
+      const int64_t marginDiff = position->CalculateRequiredMarginForFutures(*spec) - marginBefore;
+      for (auto& cacheRecord : userProfile->freeMarginCache) {
+        if (cacheRecord.currency == spec->quoteCurrency) {
+          cacheRecord.freeMargin -= marginDiff;
+          break;
+        }
+      }
       return common::cmd::CommandResultCode::VALID_FOR_MATCHING_ENGINE;
     } else {
       // Try to cleanup position if refusing to place
@@ -618,6 +697,7 @@ void RiskEngine::HandleMatcherEventMargin(common::MatcherTradeEvent* ev,
                                           common::UserProfile* takerUp,
                                           common::SymbolPositionRecord* takerSpr) {
   if (takerUp != nullptr && takerSpr != nullptr) {
+    takerUp->freeMarginCache.clear();
     if (ev->eventType == common::MatcherEventType::TRADE) {
       // update taker's position
       int64_t sizeOpen = takerSpr->UpdatePositionForMarginTrade(takerAction, ev->size, ev->price);
@@ -639,6 +719,7 @@ void RiskEngine::HandleMatcherEventMargin(common::MatcherTradeEvent* ev,
     // update maker's position
     auto* maker = userProfileService_->GetUserProfileOrAddSuspended(ev->matchedOrderUid);
     auto* makerSpr = maker->GetPositionRecordOrThrowEx(spec->symbolId);
+    maker->freeMarginCache.clear();
     int64_t sizeOpen =
       makerSpr->UpdatePositionForMarginTrade(OppositeAction(takerAction), ev->size, ev->price);
     int64_t fee = spec->makerFee * sizeOpen;
@@ -666,52 +747,100 @@ bool RiskEngine::CanPlaceMarginOrder(common::cmd::OrderCommand* cmd,
   }
 
   // Extra margin is required
-  const int32_t symbol = cmd->symbol;
-  // Calculate free margin for all positions same currency
-  int64_t freeMargin = 0;
-  for (const auto& posPair : userProfile->positions) {
-    const int32_t recSymbol = posPair.first;
-    if (recSymbol != symbol) {
-      if (posPair.second->currency == spec->quoteCurrency) {
-        const auto* spec2 = symbolSpecificationProvider_->GetSymbolSpecification(recSymbol);
-        if (spec2 != nullptr) {
-          auto lastPriceIt = lastPriceCache_.find(recSymbol);
-          const LastPriceCacheRecord* lastPriceRecord =
-            (lastPriceIt != lastPriceCache_.end()) ? &lastPriceIt->second : nullptr;
-          // Add P&L subtract margin
-          // Convert LastPriceCacheRecord to
-          // common::processors::LastPriceCacheRecord
-          common::processors::LastPriceCacheRecord commonLastPrice;
-          if (lastPriceRecord != nullptr) {
-            commonLastPrice.askPrice = lastPriceRecord->askPrice;
-            commonLastPrice.bidPrice = lastPriceRecord->bidPrice;
-          }
-          freeMargin += posPair.second->EstimateProfit(*spec2, &commonLastPrice);
-          freeMargin -= posPair.second->CalculateRequiredMarginForFutures(*spec2);
-        }
+  // Own position: P&L only (its margin is covered by newRequiredMarginForSymbol),
+  // other positions in same currency: P&L minus margin
+  const int64_t freeMargin = GetFreeMargin(userProfile, spec->quoteCurrency)
+                             + position->CalculateRequiredMarginForFutures(*spec);
+
+  // Check if current balance and margin can cover new required margin for
+  // symbol position
+  return newRequiredMarginForSymbol <= userProfile->accounts[position->currency] + freeMargin;
+}
+
+int64_t RiskEngine::GetFreeMargin(common::UserProfile* userProfile, int32_t currency) {
+  const auto epochIt = marginPriceEpochs_.find(currency);
+  const int64_t priceEpoch = (epochIt != marginPriceEpochs_.end()) ? epochIt->second : 0;
+
+  for (auto& cacheRecord : userProfile->freeMarginCache) {
+    if (cacheRecord.currency == currency) {
+      if (cacheRecord.priceEpoch != priceEpoch) {
+        cacheRecord.freeMargin = CalculateFreeMargin(userProfile, currency);
+        cacheRecord.priceEpoch = priceEpoch;
       }
+      return cacheRecord.freeMargin;
+    }
+  }
+
+  const int64_t freeMargin = CalculateFreeMargin(userProfile, currency);
+  userProfile->freeMarginCache.push_back({currency, priceEpoch, freeMargin});
+  return freeMargin;
+}
+
+int64_t RiskEngine::CalculateFreeMargin(const common::UserProfile* userProfile,
+                                        int32_t currency) const {
+  int64_t freeMargin = 0;
+  for (const auto& [recSymbol, record] : userProfile->positions) {
+    if (record->currency != currency) {
+      continue;
+    }
+    const auto* spec = symbolSpecificationProvider_->GetSymbolSpecification(recSymbol);
+    if (spec == nullptr) {
+      continue;
+    }
+    common::processors::LastPriceCacheRecord commonLastPrice;
+    const auto* lastPriceRecord = FindLastPriceCacheRecord(recSymbol);
+    if (lastPriceRecord != nullptr) {
+      commonLastPrice.askPrice = lastPriceRecord->askPrice;
+      commonLastPrice.bidPrice = lastPriceRecord->bidPrice;
+    }
+    // Add P&L subtract margin
+    freeMargin += record->EstimateProfit(*spec, &commonLastPrice);
+    freeMargin -= record->CalculateRequiredMarginForFutures(*spec);
+  }
+  return freeMargin;
+}
+
+const LastPriceCacheRecord* RiskEngine::FindLastPriceCacheRecord(int32_t symbol) const {
+  if (lastPriceCacheIndex_.InRange(symbol)) {
+    return lastPriceCacheIndex_.Get(symbol);
+  }
+  const auto it = lastPriceCache_.find(symbol);
+  return (it != lastPriceCache_.end()) ? &it->second : nullptr;
+}
+
+LastPriceCacheRecord& RiskEngine::GetOrAddLastPriceCacheRecord(int32_t symbol) {
+  if (lastPriceCacheIndex_.InRange(symbol)) {
+    auto* record = lastPriceCacheIndex_.Get(symbol);
+    if (record != nullptr) {
+      return *record;
+    }
+  }
+  const auto [it, inserted] = lastPriceCache_.try_emplace(symbol);
+  if (inserted) {
+    const auto& values = lastPriceCache_.values();
+    if (values.data() != lastPriceCacheIndexedValues_
+        || values.capacity() != lastPriceCacheIndexedCapacity_) {
+      // values storage was reallocated (grows geometrically, amortized O(1))
+      RebuildLastPriceCacheIndex();
     } else {
-      auto lastPriceIt = lastPriceCache_.find(spec->symbolId);
-      const LastPriceCacheRecord* lastPriceRecord =
-        (lastPriceIt != lastPriceCache_.end()) ? &lastPriceIt->second : nullptr;
-      // Convert RiskEngine::LastPriceCacheRecord to
-      // common::processors::LastPriceCacheRecord
-      common::processors::LastPriceCacheRecord commonLastPrice;
-      if (lastPriceRecord != nullptr) {
-        commonLastPrice.askPrice = lastPriceRecord->askPrice;
-        commonLastPrice.bidPrice = lastPriceRecord->bidPrice;
-      }
-      freeMargin = position->EstimateProfit(*spec, &commonLastPrice);
+      lastPriceCacheIndex_.Put(symbol, &it->second);
     }
   }
+  return it->second;
+}
 
-  // Check if current balance and margin can cover new required margin for
-  // symbol position
-  return newRequiredMarginForSymbol <= userProfile->accounts[position->currency] + freeMargin;
+void RiskEngine::RebuildLastPriceCacheIndex() {
+  lastPriceCacheIndex_.Clear();
+  for (auto& [symbol, record] : lastPriceCache_) {
+    lastPriceCacheIndex_.Put(symbol, &record);
+  }
+  lastPriceCacheIndexedValues_ = lastPriceCache_.values().data();
+  lastPriceCacheIndexedCapacity_ = lastPriceCache_.values().capacity();
 }
 
 void RiskEngine::RemovePositionRecord(common::SymbolPositionRecord* record,
                                       common::UserProfile* userProfile) {
+  userProfile->freeMarginCache.clear();
   userProfile->accounts[record->currency] += record->profit;
   userProfile->positions.erase(record->symbol);
   objectsPool_->Put(::exchange::core::collections::objpool::ObjectsPool::SYMBOL_POSITION_RECORD,
@@ -756,6 +885,26 @@ int32_t RiskEngine::GetStateHash() const {
 }
 
 void RiskEngine::WriteMarshallable(common::BytesOut& bytes) const {
+  WriteState(bytes, true);
+}
+
+void RiskEngine::WriteGlobalState(common::BytesOut& bytes) const {
+  WriteState(bytes, false);
+}
+
+void RiskEngine::WriteEntries(journaling::SnapshotEntriesWriter& writer, bool changedOnly) const {
+  userProfileService_->WriteEntries(writer, changedOnly);
+}
+
+bool RiskEngine::ChangesTracked() const {
+  return userProfileService_->ChangesTracked();
+}
+
+void RiskEngine::ClearChanges() {
+  userProfileService_->ClearChanges();
+}
+
+void RiskEngine::WriteState(common::BytesOut& bytes, bool withUserProfiles) const {
   // Write shardId and shardMask
   bytes.WriteInt(shardId_);
   bytes.WriteLong(shardMask_);
@@ -763,8 +912,11 @@ void RiskEngine::WriteMarshallable(common::BytesOut& bytes) const {
   // Write symbolSpecificationProvider (always non-null in Java)
   symbolSpecificationProvider_->WriteMarshallable(bytes);
 
-  // Write userProfileService (always non-null in Java)
-  userProfileService_->WriteMarshallable(bytes);
+  // Write userProfileService (always non-null in Java),
+  // incremental snapshots store profiles as separate entries
+  if (withUserProfiles) {
+    userProfileService_->WriteMarshallable(bytes);
+  }
 
   // Write binaryCommandsProcessor (always non-null in Java)
   binaryCommandsProcessor_->WriteMarshallable(bytes);
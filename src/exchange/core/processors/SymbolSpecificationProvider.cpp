@@ -22,9 +22,12 @@
 
 namespace exchange::core::processors {
 
-SymbolSpecificationProvider::SymbolSpecificationProvider() {}
+SymbolSpecificationProvider::SymbolSpecificationProvider(int32_t denseSymbolIdLimit)
+  : symbolSpecsIndex_(denseSymbolIdLimit) {}
 
-SymbolSpecificationProvider::SymbolSpecificationProvider(common::BytesIn* bytes) {
+SymbolSpecificationProvider::SymbolSpecificationProvider(common::BytesIn* bytes,
+                                                         int32_t denseSymbolIdLimit)
+  : symbolSpecsIndex_(denseSymbolIdLimit) {
   if (bytes == nullptr) {
     throw std::invalid_argument("BytesIn cannot be nullptr");
   }
@@ -33,7 +36,7 @@ SymbolSpecificationProvider::SymbolSpecificationProvider(common::BytesIn* bytes)
   for (int i = 0; i < length; i++) {
     int32_t symbolId = bytes->ReadInt();
     common::CoreSymbolSpecification* spec = new common::CoreSymbolSpecification(*bytes);
-    symbolSpecs_[symbolId] = spec;
+    RegisterSymbol(symbolId, spec);
   }
 }
 
@@ -47,12 +50,15 @@ bool SymbolSpecificationProvider::AddSymbol(const common::CoreSymbolSpecificatio
     return false;  // Symbol already exists
   }
 
-  symbolSpecs_[symbolId] = symbolSpec;
+  RegisterSymbol(symbolId, symbolSpec);
   return true;
 }
 
 const common::CoreSymbolSpecification*
 SymbolSpecificationProvider::GetSymbolSpecification(int32_t symbol) const {
+  if (symbolSpecsIndex_.InRange(symbol)) {
+    return symbolSpecsIndex_.Get(symbol);
+  }
   auto it = symbolSpecs_.find(symbol);
   return (it != symbolSpecs_.end()) ? it->second : nullptr;
 }
@@ -60,10 +66,12 @@ SymbolSpecificationProvider::GetSymbolSpecification(int32_t symbol) const {
 void SymbolSpecificationProvider::RegisterSymbol(int32_t symbol,
                                                  const common::CoreSymbolSpecification* spec) {
   symbolSpecs_[symbol] = spec;
+  symbolSpecsIndex_.Put(symbol, spec);
 }
 
 void SymbolSpecificationProvider::Reset() {
   symbolSpecs_.clear();
+  symbolSpecsIndex_.Clear();
 }
 
 int32_t SymbolSpecificationProvider::GetStateHash() const {
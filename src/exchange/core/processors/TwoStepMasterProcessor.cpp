@@ -92,6 +92,11 @@ void TwoStepMasterProcessor<WaitStrategyT>::SetSlaveProcessor(
   slaveProcessor_ = slaveProcessor;
 }
 
+template <typename WaitStrategyT>
+void TwoStepMasterProcessor<WaitStrategyT>::SetPrefetchDistance(int32_t prefetchDistance) {
+  prefetchDistance_ = prefetchDistance;
+}
+
 template <typename WaitStrategyT>
 void TwoStepMasterProcessor<WaitStrategyT>::ProcessEvents() {
   // Match Java: Thread.currentThread().setName("Thread-" + name);
@@ -124,6 +129,18 @@ void TwoStepMasterProcessor<WaitStrategyT>::ProcessEvents() {
         while (nextSequence <= availableSequence) {
           cmd = &ringBuffer_->get(nextSequence);
 
+          // lookahead: let memory loads for later commands overlap with this one -
+          // index entries 2 x distance ahead, then data they point to
+          if (prefetchDistance_ > 0) {
+            const int64_t indexSequence = nextSequence + 2 * prefetchDistance_;
+            if (indexSequence <= availableSequence) {
+              eventHandler_->PrefetchIndex(&ringBuffer_->get(indexSequence));
+            }
+            if (nextSequence + prefetchDistance_ <= availableSequence) {
+              eventHandler_->Prefetch(&ringBuffer_->get(nextSequence + prefetchDistance_));
+            }
+          }
+
           // switch to next group - let slave processor start doing its handling
           // cycle
           if (cmd->eventsGroup != currentSequenceGroup) {
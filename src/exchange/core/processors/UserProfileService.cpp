@@ -18,9 +18,14 @@
 #include <exchange/core/common/BytesOut.h>
 #include <exchange/core/common/UserProfile.h>
 #include <exchange/core/common/UserStatus.h>
+#include <exchange/core/processors/BulkAccountsFile.h>
 #include <exchange/core/processors/UserProfileService.h>
 #include <exchange/core/utils/HashingUtils.h>
 #include <exchange/core/utils/SerializationUtils.h>
+#include <exchange/core/utils/UnsafeUtils.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
 
 namespace exchange::core::processors {
 
@@ -34,24 +39,102 @@ UserProfileService::UserProfileService(common::BytesIn* bytes) {
   int length = bytes->ReadInt();
   for (int i = 0; i < length; i++) {
     int64_t uid = bytes->ReadLong();
-    common::UserProfile* profile = new common::UserProfile(bytes);
-    userProfiles[uid] = profile;
+    common::UserProfile* profile = AllocateProfile();
+    *profile = common::UserProfile(bytes);
+    InsertProfile(uid, profile);
+  }
+}
+
+common::UserProfile* UserProfileService::AllocateProfile() {
+  if (!freeProfiles_.empty()) {
+    common::UserProfile* profile = freeProfiles_.back();
+    freeProfiles_.pop_back();
+    return profile;
+  }
+  if (chunkPos_ == PROFILES_CHUNK_SIZE) {
+    profileChunks_.push_back(std::make_unique<common::UserProfile[]>(PROFILES_CHUNK_SIZE));
+    chunkPos_ = 0;
+  }
+  return &profileChunks_.back()[chunkPos_++];
+}
+
+void UserProfileService::ReleaseProfile(common::UserProfile* profile) {
+  *profile = common::UserProfile();
+  freeProfiles_.push_back(profile);
+}
+
+void UserProfileService::InsertProfile(int64_t uid, common::UserProfile* profile) {
+  userProfiles[uid] = profile;
+  const auto index = static_cast<uint64_t>(uid);
+  if (index >= denseProfiles_.size()) {
+    const size_t limit = std::max(DENSE_INDEX_MIN_SIZE, 2 * userProfiles.size());
+    if (index >= limit) {
+      return;
+    }
+    GrowDenseIndex(std::min(
+      limit, std::max({static_cast<size_t>(index) + 1, 2 * denseProfiles_.size(),
+                       DENSE_INDEX_MIN_SIZE})));
+  }
+  denseProfiles_[static_cast<size_t>(index)] = profile;
+}
+
+void UserProfileService::EraseProfile(int64_t uid) {
+  userProfiles.erase(uid);
+  if (static_cast<uint64_t>(uid) < denseProfiles_.size()) {
+    denseProfiles_[static_cast<size_t>(uid)] = nullptr;
+  }
+}
+
+void UserProfileService::GrowDenseIndex(size_t size) {
+  const size_t oldSize = denseProfiles_.size();
+  // exact capacity - index size stays within 2x users number
+  denseProfiles_.reserve(size);
+  denseProfiles_.resize(size, nullptr);
+  // uids of the new range added while they were not covered
+  for (const auto& [uid, profile] : userProfiles) {
+    const auto index = static_cast<uint64_t>(uid);
+    if (index >= oldSize && index < size) {
+      denseProfiles_[static_cast<size_t>(index)] = profile;
+    }
   }
 }
 
 common::UserProfile* UserProfileService::GetUserProfile(int64_t uid) {
-  auto it = userProfiles.find(uid);
-  return (it != userProfiles.end()) ? it->second : nullptr;
+  common::UserProfile* profile = FindProfile(uid);
+  if (profile != nullptr) {
+    MarkChanged(profile);
+  }
+  return profile;
+}
+
+void UserProfileService::PrefetchUserProfileSlot(int64_t uid) const {
+  // computed address only - uid map buckets can not be addressed without probing
+  if (static_cast<uint64_t>(uid) < denseProfiles_.size()) {
+    utils::UnsafeUtils::Prefetch(&denseProfiles_[static_cast<size_t>(uid)]);
+  }
+}
+
+void UserProfileService::PrefetchUserProfile(int64_t uid) const {
+  if (static_cast<uint64_t>(uid) < denseProfiles_.size()) {
+    const common::UserProfile* profile = denseProfiles_[static_cast<size_t>(uid)];
+    if (profile != nullptr) {
+      utils::UnsafeUtils::Prefetch(profile);
+      utils::UnsafeUtils::Prefetch(&profile->accounts);
+    }
+  }
 }
 
 common::UserProfile* UserProfileService::GetUserProfileOrAddSuspended(int64_t uid) {
-  auto it = userProfiles.find(uid);
-  if (it != userProfiles.end()) {
-    return it->second;
+  common::UserProfile* existing = GetUserProfile(uid);
+  if (existing != nullptr) {
+    return existing;
   }
   // Create new suspended user profile
-  auto* profile = new common::UserProfile(uid, common::UserStatus::SUSPENDED);
-  userProfiles[uid] = profile;
+  auto* profile = AllocateProfile();
+  profile->uid = uid;
+  profile->userStatus = common::UserStatus::SUSPENDED;
+  InsertProfile(uid, profile);
+  MarkChanged(profile);
   return profile;
 }
 
@@ -91,11 +174,59 @@ common::cmd::CommandResultCode UserProfileService::AddUser(int64_t uid) {
     return common::cmd::CommandResultCode::USER_MGMT_USER_ALREADY_EXISTS;
   }
 
-  auto* profile = new common::UserProfile(uid, common::UserStatus::ACTIVE);
-  userProfiles[uid] = profile;
+  auto* profile = AllocateProfile();
+  profile->uid = uid;
+  profile->userStatus = common::UserStatus::ACTIVE;
+  InsertProfile(uid, profile);
+  MarkChanged(profile);
   return common::cmd::CommandResultCode::SUCCESS;
 }
 
+size_t
+UserProfileService::LoadAccounts(const BulkAccountsFile& file,
+                                 int32_t shardId,
+                                 int64_t shardMask,
+                                 ankerl::unordered_dense::map<int32_t, int64_t>& adjustments) {
+  const auto forShard = [shardId, shardMask](int64_t uid) {
+    return shardMask == 0 || (uid & shardMask) == shardId;
+  };
+  const size_t rows = file.Rows();
+
+  // uid column only - rows of this shard are upper bound of its users number
+  size_t shardRows = 0;
+  for (size_t i = 0; i < rows; i++) {
+    shardRows += forShard(file.Uid(i)) ? 1 : 0;
+  }
+  userProfiles.reserve(userProfiles.size() + shardRows);
+  profileChunks_.reserve(profileChunks_.size() + shardRows / PROFILES_CHUNK_SIZE + 1);
+
+  for (size_t i = 0; i < rows; i++) {
+    const int64_t uid = file.Uid(i);
+    if (!forShard(uid)) {
+      continue;
+    }
+    const int32_t currency = file.Currency(i);
+    const int64_t balance = file.Balance(i);
+    if (balance < 0) {
+      throw std::runtime_error("Negative balance in bulk accounts file, uid="
+                               + std::to_string(uid) + " currency=" + std::to_string(currency));
+    }
+    common::UserProfile* profile = FindProfile(uid);
+    if (profile == nullptr) {
+      profile = AllocateProfile();
+      profile->uid = uid;
+      profile->userStatus = common::UserStatus::ACTIVE;
+      InsertProfile(uid, profile);
+      MarkChanged(profile);
+    }
+    profile->accounts[currency] += balance;
+    profile->adjustmentsCounter =
+      std::max(profile->adjustmentsCounter, BATCH_ADD_FUNDING_BASE + currency);
+    adjustments[currency] -= balance;
+  }
+  return shardRows;
+}
+
 common::cmd::CommandResultCode UserProfileService::SuspendUser(int64_t uid) {
   common::UserProfile* profile = GetUserProfile(uid);
   if (profile == nullptr) {
@@ -123,8 +254,8 @@ common::cmd::CommandResultCode UserProfileService::SuspendUser(int64_t uid) {
   // Match Java: userProfiles.remove(uid) - actually delete the user profile
   // This removes inactive clients profile from the core in order to increase
   // performance
-  delete profile;
-  userProfiles.erase(uid);
+  EraseProfile(uid);
+  ReleaseProfile(profile);
   return common::cmd::CommandResultCode::SUCCESS;
 }
 
@@ -133,8 +264,11 @@ common::cmd::CommandResultCode UserProfileService::ResumeUser(int64_t uid) {
   if (profile == nullptr) {
     // Match Java: create new empty user profile if not exists
     // account balance adjustments should be applied later
-    auto* newProfile = new common::UserProfile(uid, common::UserStatus::ACTIVE);
-    userProfiles[uid] = newProfile;
+    auto* newProfile = AllocateProfile();
+    newProfile->uid = uid;
+    newProfile->userStatus = common::UserStatus::ACTIVE;
+    InsertProfile(uid, newProfile);
+    MarkChanged(newProfile);
     return common::cmd::CommandResultCode::SUCCESS;
   }
 
@@ -159,11 +293,59 @@ std::vector<common::UserProfile*> UserProfileService::GetUserProfiles() const {
 }
 
 void UserProfileService::Reset() {
-  // Delete all user profiles before clearing
-  for (auto& pair : userProfiles) {
-    delete pair.second;
-  }
+  // Release whole arena at once
   userProfiles.clear();
+  denseProfiles_.clear();
+  denseProfiles_.shrink_to_fit();
+  freeProfiles_.clear();
+  profileChunks_.clear();
+  chunkPos_ = PROFILES_CHUNK_SIZE;
+  changedUids_.clear();
+  changesLost_ = true;
+}
+
+void UserProfileService::EnableChangesTracking() {
+  trackChanges_ = true;
+  ClearChanges();
+}
+
+void UserProfileService::ClearChanges() {
+  for (const int64_t uid : changedUids_) {
+    common::UserProfile* profile = FindProfile(uid);
+    if (profile != nullptr) {
+      profile->snapshotChanged = false;
+    }
+  }
+  changedUids_.clear();
+  changesLost_ = false;
+}
+
+void UserProfileService::WriteEntries(journaling::SnapshotEntriesWriter& writer,
+                                      bool changedOnly) const {
+  if (!changedOnly) {
+    for (const auto& [uid, profile] : userProfiles) {
+      writer.Write(uid, *profile);
+    }
+    return;
+  }
+  // Removed profile is not in the map (suspended user is removed)
+  std::vector<int64_t> uids(changedUids_);
+  std::sort(uids.begin(), uids.end());
+  uids.erase(std::unique(uids.begin(), uids.end()), uids.end());
+  for (const int64_t uid : uids) {
+    const common::UserProfile* profile = FindProfile(uid);
+    if (profile != nullptr) {
+      writer.Write(uid, *profile);
+    } else {
+      writer.WriteRemoved(uid);
+    }
+  }
+}
+
+void UserProfileService::RestoreUserProfile(int64_t uid, common::BytesIn* bytes) {
+  common::UserProfile* profile = AllocateProfile();
+  *profile = common::UserProfile(bytes);
+  InsertProfile(uid, profile);
 }
 
 int32_t UserProfileService::GetStateHash() const {
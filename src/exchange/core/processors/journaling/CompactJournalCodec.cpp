@@ -0,0 +1,269 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <exchange/core/common/BalanceAdjustmentType.h>
+#include <exchange/core/common/cmd/OrderCommandType.h>
+#include <exchange/core/processors/journaling/CompactJournalCodec.h>
+#include <cstring>
+#include <stdexcept>
+
+namespace exchange::core::processors::journaling {
+
+namespace {
+
+using common::cmd::OrderCommandType;
+
+uint64_t ZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+class Writer {
+public:
+  explicit Writer(char* out) : start_(out), p_(out) {}
+
+  void Byte(uint8_t value) {
+    *p_++ = static_cast<char>(value);
+  }
+
+  void Var(int64_t value) {
+    uint64_t v = ZigZag(value);
+    while (v >= 0x80) {
+      *p_++ = static_cast<char>(v | 0x80);
+      v >>= 7;
+    }
+    *p_++ = static_cast<char>(v);
+  }
+
+  void Fixed(int64_t value) {
+    std::memcpy(p_, &value, sizeof(value));
+    p_ += sizeof(value);
+  }
+
+  size_t Size() const {
+    return static_cast<size_t>(p_ - start_);
+  }
+
+private:
+  char* const start_;
+  char* p_;
+};
+
+// Bounds are not checked when whole MAX_RECORD_SIZE is available: even corrupted
+// record can not be longer (at most 12 varints of 10 bytes and 2 bytes)
+template <bool CHECKED>
+class Reader {
+public:
+  Reader(const char*& p, const char* end) : p_(p), end_(end) {}
+
+  uint8_t Byte() {
+    Require(1);
+    return static_cast<uint8_t>(*p_++);
+  }
+
+  int64_t Var() {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      const uint8_t b = Byte();
+      v |= static_cast<uint64_t>(b & 0x7F) << shift;
+      if ((b & 0x80) == 0) {
+        return UnZigZag(v);
+      }
+    }
+    throw std::runtime_error("Bad varint in journal block (data corrupted)");
+  }
+
+  int32_t Var32() {
+    return static_cast<int32_t>(Var());
+  }
+
+  int64_t Fixed() {
+    Require(sizeof(int64_t));
+    int64_t value;
+    std::memcpy(&value, p_, sizeof(value));
+    p_ += sizeof(value);
+    return value;
+  }
+
+private:
+  void Require(size_t bytes) const {
+    if (CHECKED && static_cast<size_t>(end_ - p_) < bytes) {
+      throw std::runtime_error("Bad command in journal block (data corrupted)");
+    }
+  }
+
+  const char*& p_;
+  const char* const end_;
+};
+
+template <bool CHECKED>
+bool Decode(const char*& p,
+            const char* end,
+            CompactJournalCodec::Deltas& deltas,
+            JournalCommand& cmd) {
+  Reader<CHECKED> r(p, end);
+  cmd = JournalCommand{};
+  cmd.command = common::cmd::OrderCommandTypeFromCode(static_cast<int8_t>(r.Byte()));
+  cmd.seq = deltas.seq += r.Var();
+  cmd.timestamp = deltas.timestamp += r.Var();
+  cmd.serviceFlags = r.Var32();
+  cmd.eventsGroup = deltas.eventsGroup += r.Var();
+
+  switch (cmd.command) {
+    case OrderCommandType::MOVE_ORDER:
+    case OrderCommandType::CANCEL_ORDER:
+    case OrderCommandType::REDUCE_ORDER:
+    case OrderCommandType::PLACE_ORDER:
+      cmd.uid = r.Var();
+      cmd.symbol = r.Var32();
+      cmd.orderId = deltas.orderId += r.Var();
+      if (cmd.command == OrderCommandType::MOVE_ORDER) {
+        cmd.price = r.Var();
+      } else if (cmd.command == OrderCommandType::REDUCE_ORDER) {
+        cmd.size = r.Var();
+      } else if (cmd.command == OrderCommandType::PLACE_ORDER) {
+        const uint8_t actionAndType = r.Byte();
+        cmd.action = common::OrderActionFromCode(static_cast<uint8_t>(actionAndType & 0b1));
+        cmd.orderType =
+          common::OrderTypeFromCode(static_cast<uint8_t>((actionAndType >> 1) & 0b1111));
+        cmd.price = r.Var();
+        cmd.reserveBidPrice = r.Var();
+        if (cmd.action == common::OrderAction::BID) {
+          cmd.reserveBidPrice += cmd.price;
+        }
+        cmd.size = r.Var();
+        cmd.userCookie = r.Var32();
+      }
+      return true;
+    case OrderCommandType::BALANCE_ADJUSTMENT: {
+      cmd.uid = r.Var();
+      cmd.symbol = r.Var32();
+      cmd.orderId = r.Var();
+      cmd.price = r.Var();
+      const auto adjustmentType = common::BalanceAdjustmentTypeFromCode(r.Byte());
+      cmd.orderType =
+        common::OrderTypeFromCode(common::BalanceAdjustmentTypeToCode(adjustmentType));
+      return true;
+    }
+    case OrderCommandType::ADD_USER:
+    case OrderCommandType::SUSPEND_USER:
+    case OrderCommandType::RESUME_USER:
+      cmd.uid = r.Var();
+      cmd.orderId = -1;
+      cmd.symbol = -1;
+      return true;
+    case OrderCommandType::BINARY_DATA_COMMAND:
+      cmd.symbol = static_cast<int32_t>(r.Byte());
+      cmd.orderId = r.Fixed();
+      cmd.price = r.Fixed();
+      cmd.reserveBidPrice = r.Fixed();
+      cmd.size = r.Fixed();
+      cmd.uid = r.Fixed();
+      return true;
+    case OrderCommandType::RESET:
+      return true;
+    case OrderCommandType::PERSIST_STATE_MATCHING:
+    case OrderCommandType::PERSIST_STATE_RISK:
+      return false;
+    default:
+      throw std::runtime_error("Unexpected command type in journal replay");
+  }
+}
+
+}  // namespace
+
+size_t CompactJournalCodec::EncodeCommand(const common::cmd::OrderCommand* cmd,
+                                          int64_t seq,
+                                          Deltas& deltas,
+                                          char* out) {
+  const auto cmdType = cmd->command;
+  Writer w(out);
+
+  w.Byte(static_cast<uint8_t>(cmdType));
+  w.Var(seq - deltas.seq);
+  w.Var(cmd->timestamp - deltas.timestamp);
+  w.Var(cmd->serviceFlags);
+  w.Var(cmd->eventsGroup - deltas.eventsGroup);
+  deltas.seq = seq;
+  deltas.timestamp = cmd->timestamp;
+  deltas.eventsGroup = cmd->eventsGroup;
+
+  switch (cmdType) {
+    case OrderCommandType::MOVE_ORDER:
+    case OrderCommandType::CANCEL_ORDER:
+    case OrderCommandType::REDUCE_ORDER:
+    case OrderCommandType::PLACE_ORDER:
+      w.Var(cmd->uid);
+      w.Var(cmd->symbol);
+      w.Var(cmd->orderId - deltas.orderId);
+      deltas.orderId = cmd->orderId;
+      if (cmdType == OrderCommandType::MOVE_ORDER) {
+        w.Var(cmd->price);
+      } else if (cmdType == OrderCommandType::REDUCE_ORDER) {
+        w.Var(cmd->size);
+      } else if (cmdType == OrderCommandType::PLACE_ORDER) {
+        w.Byte(static_cast<uint8_t>((static_cast<int>(cmd->orderType) << 1)
+                                    | static_cast<int>(cmd->action)));
+        w.Var(cmd->price);
+        // bid reserve price is usually close to price
+        w.Var(cmd->action == common::OrderAction::BID ? cmd->reserveBidPrice - cmd->price
+                                                      : cmd->reserveBidPrice);
+        w.Var(cmd->size);
+        w.Var(cmd->userCookie);
+      }
+      break;
+    case OrderCommandType::BALANCE_ADJUSTMENT:
+      // orderId is transaction id here (not delta-encoded)
+      w.Var(cmd->uid);
+      w.Var(cmd->symbol);
+      w.Var(cmd->orderId);
+      w.Var(cmd->price);
+      w.Byte(common::OrderTypeToCode(cmd->orderType));
+      break;
+    case OrderCommandType::ADD_USER:
+    case OrderCommandType::SUSPEND_USER:
+    case OrderCommandType::RESUME_USER:
+      w.Var(cmd->uid);
+      break;
+    case OrderCommandType::BINARY_DATA_COMMAND:
+      // binary data words are not compressible by varints
+      w.Byte(static_cast<uint8_t>(cmd->symbol));
+      w.Fixed(cmd->orderId);
+      w.Fixed(cmd->price);
+      w.Fixed(cmd->reserveBidPrice);
+      w.Fixed(cmd->size);
+      w.Fixed(cmd->uid);
+      break;
+    default:
+      break;
+  }
+  return w.Size();
+}
+
+bool CompactJournalCodec::DecodeCommand(const char*& p,
+                                        const char* end,
+                                        Deltas& deltas,
+                                        JournalCommand& cmd) {
+  return end - p >= static_cast<std::ptrdiff_t>(MAX_RECORD_SIZE)
+           ? Decode<false>(p, end, deltas, cmd)
+           : Decode<true>(p, end, deltas, cmd);
+}
+
+}  // namespace exchange::core::processors::journaling
@@ -16,7 +16,6 @@
 
 #include <exchange/core/ExchangeApi.h>
 #include <exchange/core/common/VectorBytesIn.h>
-#include <exchange/core/common/VectorBytesOut.h>
 #include <exchange/core/common/WriteBytesMarshallable.h>
 #include <exchange/core/common/api/ApiAddUser.h>
 #include <exchange/core/common/api/ApiAdjustUserBalance.h>
@@ -29,19 +28,40 @@
 #include <exchange/core/common/api/ApiResumeUser.h>
 #include <exchange/core/common/api/ApiSuspendUser.h>
 #include <exchange/core/common/cmd/OrderCommandType.h>
+#include <exchange/core/processors/journaling/CompactJournalCodec.h>
 #include <exchange/core/processors/journaling/DiskSerializationProcessor.h>
 #include <exchange/core/processors/journaling/JournalDescriptor.h>
+#include <exchange/core/processors/journaling/JournalIndex.h>
+#include <exchange/core/processors/journaling/JournalReader.h>
+#include <exchange/core/processors/journaling/KeyedSnapshotFile.h>
+#include <exchange/core/processors/journaling/Lz4FrameBytesIn.h>
+#include <exchange/core/processors/journaling/Lz4FrameBytesOut.h>
 #include <exchange/core/processors/journaling/SnapshotDescriptor.h>
+#include <exchange/core/utils/Crc32c.h>
 #include <exchange/core/utils/FastNanoTime.h>
 #include <exchange/core/utils/Logger.h>
 #include <lz4.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <ctime>
+#include <deque>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <limits>
 #include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
 
 namespace exchange {
 namespace core {
@@ -93,6 +113,28 @@ public:
   }
 };
 
+namespace {
+
+using DurabilityMode = DiskSerializationProcessorConfiguration::DurabilityMode;
+using JournalIo = DiskSerializationProcessorConfiguration::JournalIo;
+using SnapshotMode = DiskSerializationProcessorConfiguration::SnapshotMode;
+
+// Direct journal I/O: writes in flight (2 staging buffers of current and retained file)
+constexpr uint32_t DIRECT_IO_QUEUE_SIZE = 8;
+
+/**
+ * Snapshot is written as LZ4 frame (streaming format), otherwise it is
+ * a single LZ4 block prefixed with original and compressed sizes
+ */
+bool IsLz4FrameSnapshot(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  uint32_t magic = 0;
+  return file.read(reinterpret_cast<char*>(&magic), sizeof(magic))
+         && magic == Lz4FrameBytesIn::FRAME_MAGIC;
+}
+
+}  // namespace
+
 DiskSerializationProcessor::DiskSerializationProcessor(
   const common::config::ExchangeConfiguration* exchangeConfig,
   const DiskSerializationProcessorConfiguration* diskConfig)
@@ -102,15 +144,43 @@ DiskSerializationProcessor::DiskSerializationProcessor(
   , journalBufferFlushTrigger_(diskConfig->journalBufferFlushTrigger)
   , journalFileMaxSize_(diskConfig->journalFileMaxSize)
   , journalBatchCompressThreshold_(diskConfig->journalBatchCompressThreshold)
+  , compactJournal_(diskConfig->journalFormat
+                    == DiskSerializationProcessorConfiguration::JournalFormat::V2)
+  , journalIndexInterval_(diskConfig->journalIndexInterval)
+  , journalChecksums_(diskConfig->journalChecksums)
+  , durabilityMode_(diskConfig->durabilityMode)
+  , groupCommitIntervalNs_(diskConfig->groupCommitIntervalNs)
+  , groupCommitMaxBytes_(diskConfig->groupCommitMaxBytes)
+  , replayDecompressThreads_(diskConfig->replayDecompressThreads)
+  , replayReadAheadBlocks_(diskConfig->replayReadAheadBlocks)
+  , replayBatchSize_(diskConfig->replayBatchSize)
+  , snapshotChunkSize_(diskConfig->snapshotChunkSize)
+  , snapshotMode_(diskConfig->snapshotMode)
+  , incrementalSnapshots_(diskConfig->incrementalSnapshots)
+  , incrementalSnapshotsCompaction_(std::max(diskConfig->incrementalSnapshotsCompaction, 1))
+  , matchingEnginesNum_(exchangeConfig->performanceCfg.matchingEnginesNum)
+  , riskEnginesNum_(exchangeConfig->performanceCfg.riskEnginesNum)
   , lastJournalDescriptor_(nullptr)
   , baseSnapshotId_(exchangeConfig->initStateCfg.snapshotId)
   , enableJournalAfterSeq_(-1)
+  , asyncWriter_(diskConfig->asyncJournalWriter
+                 || durabilityMode_ == DurabilityMode::GROUP_COMMIT
+                 || diskConfig->journalIo == JournalIo::IO_URING_DIRECT)
+  , writeBatches_(asyncWriter_ ? std::max(diskConfig->journalWriteBuffersNum, 2) : 1)
+  , filledBatches_(0)
+  , journaledDSeq_(-1)
+  , submittedBatches_(0)
+  , writerStopping_(false)
+  , writtenBatches_(0)
+  , durableDSeq_(-1)
+  , writerFailed_(false)
   , filesCounter_(0)
   , writtenBytes_(0)
   , lastWrittenSeq_(-1)
-  , journalWriteBuffer_(diskConfig->journalBufferSize, 0)
   , lz4WriteBuffer_(LZ4_compressBound(diskConfig->journalBufferSize), 0)
-  , journalWriteBufferPos_(0) {
+  , unsyncedBytes_(0)
+  , lastIndexedBytes_(0)
+  , retainedUntilSnapshotId_(-1) {
   // Create folder if it doesn't exist
   std::filesystem::create_directories(folder_);
 
@@ -118,9 +188,54 @@ DiskSerializationProcessor::DiskSerializationProcessor(
   const auto& perfCfg = exchangeConfig->performanceCfg;
   lastSnapshotDescriptor_ =
     SnapshotDescriptor::CreateEmpty(perfCfg.matchingEnginesNum, perfCfg.riskEnginesNum);
+  journalSnapshotDescriptor_ = lastSnapshotDescriptor_;
 
   // Initialize snapshotsIndex with empty snapshot
   snapshotsIndex_[0] = lastSnapshotDescriptor_;
+
+  for (auto& batch : writeBatches_) {
+    batch.buffer.resize(diskConfig->journalBufferSize, 0);
+  }
+  if (diskConfig->journalIo == JournalIo::IO_URING_DIRECT) {
+    // one aligned block is written to probe file: io_uring, its write
+    // operation and O_DIRECT on the journal file system
+    const std::string probeName = folder_ + "/" + exchangeId_ + "_direct_io_probe.tmp";
+    try {
+      ioUring_ = std::make_unique<utils::IoUring>(DIRECT_IO_QUEUE_SIZE);
+      DirectJournalFile probe(probeName, ioUring_.get(), DirectJournalFile::BLOCK_SIZE, false, 0);
+      probe.Write(probeName.data(), probeName.size());
+      probe.Close();
+    } catch (const std::exception& ex) {
+      LOG_WARN("Direct journal I/O is not available ({}), journal is written through page cache",
+               ex.what());
+      ioUring_.reset();
+    }
+    std::error_code ec;
+    std::filesystem::remove(probeName, ec);
+  }
+  if (asyncWriter_) {
+    writerThread_ = std::thread([this] {
+      if (ioUring_) {
+        DirectWriterThreadLoop();
+      } else {
+        WriterThreadLoop();
+      }
+    });
+  }
+}
+
+DiskSerializationProcessor::~DiskSerializationProcessor() {
+  AwaitSnapshotsWritten();
+  if (writerThread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(writerMutex_);
+      writerStopping_ = true;
+    }
+    writerCondition_.notify_one();
+    writerThread_.join();
+  }
+  journalFile_.reset();
+  retainedJournalFile_.reset();
 }
 
 bool DiskSerializationProcessor::StoreData(int64_t snapshotId,
@@ -133,112 +248,342 @@ bool DiskSerializationProcessor::StoreData(int64_t snapshotId,
 
   LOG_DEBUG("Writing state into file {} ...", path);
 
+  if (obj == nullptr) {
+    LOG_ERROR("Can not write snapshot file: {} - obj is nullptr", path);
+    return false;
+  }
+
   try {
     // Create directory if needed
     std::filesystem::path filePath(path);
     std::filesystem::create_directories(filePath.parent_path());
 
-    // Open file with CREATE_NEW (fail if exists)
-    std::ofstream file(path, std::ios::binary | std::ios::out);
-    if (!file.is_open()) {
-      LOG_ERROR("Can not open snapshot file: {}", path);
-      return false;
-    }
+    const int64_t startNs = utils::FastNanoTime::Now();
+
+#ifndef _WIN32
+    if (snapshotMode_ == SnapshotMode::FORK) {
+      const pid_t pid =
+        ForkSnapshotWriter(snapshotId, type, path,
+                           [this, obj](const std::string& file) { WriteSnapshotFile(file, obj); });
+
+      if (pid > 0) {
+        LOG_DEBUG("Forked snapshot writer {} for {} ({} us stall)", pid, path,
+                  (utils::FastNanoTime::Now() - startNs) / 1000);
+        std::lock_guard<std::mutex> lock(snapshotWritersMutex_);
+        snapshotWriters_.emplace_back(
+          [this, pid, path, snapshotId, seq, timestampNs, type, instanceId] {
+            if (AwaitForkedSnapshot(snapshotId, type)) {
+              RegisterStoredSnapshot(snapshotId, seq, timestampNs, type, instanceId, path);
+              LOG_DEBUG("completed {}", path);
+            } else {
+              LOG_ERROR("Can not write snapshot file: {} - snapshot writer {} failed", path, pid);
+            }
+          });
+        return true;
+      }
 
-    // Serialize to memory first
-    std::vector<uint8_t> serializedData;
-    common::VectorBytesOut vectorOut(serializedData);
-    if (obj == nullptr) {
-      LOG_ERROR("Can not write snapshot file: {} - obj is nullptr", path);
-      file.close();
-      return false;
+      LOG_WARN("Can not fork snapshot writer, writing {} inline", path);
     }
+#endif
 
-    try {
-      obj->WriteMarshallable(vectorOut);
-    } catch (const std::exception& ex) {
-      LOG_ERROR("Can not write snapshot file: {} - WriteMarshallable failed: {}", path, ex.what());
-      file.close();
-      return false;
-    }
+    WriteSnapshotFile(path, obj);
+    RegisterStoredSnapshot(snapshotId, seq, timestampNs, type, instanceId, path);
 
-    // Get actual written size (may be different from vector size)
-    const size_t writtenSize = vectorOut.GetPosition();
-    // Resize vector to actual written size
-    serializedData.resize(writtenSize);
+    LOG_DEBUG("completed {} ({} us stall)", path, (utils::FastNanoTime::Now() - startNs) / 1000);
+    return true;
+  } catch (const std::exception& ex) {
+    LOG_ERROR("Can not write snapshot file: {} - {}", path, ex.what());
+    return false;
+  }
+}
 
-    // Compress with LZ4
-    const int originalSize = static_cast<int>(serializedData.size());
-    if (originalSize == 0) {
-      LOG_ERROR("Can not write snapshot file: {} - serialized data is empty", path);
-      file.close();
-      return false;
-    }
-    const int maxCompressedSize = LZ4_compressBound(originalSize);
-    std::vector<char> compressedData(maxCompressedSize);
-    const int compressedSize =
-      LZ4_compress_default(reinterpret_cast<const char*>(serializedData.data()),
-                           compressedData.data(), originalSize, maxCompressedSize);
+bool DiskSerializationProcessor::StoreIncrementalData(int64_t snapshotId,
+                                                      int64_t seq,
+                                                      int64_t timestampNs,
+                                                      SerializedModuleType type,
+                                                      int32_t instanceId,
+                                                      IIncrementalSnapshotState* state) {
+  const std::string path = GetSnapshotPath(snapshotId, type, instanceId);
 
-    if (compressedSize <= 0) {
-      LOG_ERROR("Can not write snapshot file: {} - LZ4 compression failed", path);
-      file.close();
-      return false;
-    }
+  if (state == nullptr) {
+    LOG_ERROR("Can not write snapshot file: {} - state is nullptr", path);
+    return false;
+  }
 
-    // Write format: [originalSize (4 bytes)] [compressedSize (4 bytes)]
-    // [compressed data]
-    file.write(reinterpret_cast<const char*>(&originalSize), sizeof(int32_t));
-    file.write(reinterpret_cast<const char*>(&compressedSize), sizeof(int32_t));
-    file.write(compressedData.data(), compressedSize);
+  try {
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+
+    const int64_t startNs = utils::FastNanoTime::Now();
+    const int64_t baseSnapshotId = GetIncrementalSnapshotBase(type, instanceId, state);
+
+    LOG_DEBUG("Writing state into file {} (base snapshot {}) ...", path, baseSnapshotId);
+
+#ifndef _WIN32
+    if (snapshotMode_ == SnapshotMode::FORK) {
+      const pid_t pid = ForkSnapshotWriter(
+        snapshotId, type, path, [this, baseSnapshotId, state](const std::string& file) {
+          KeyedSnapshotFile::Write(file, snapshotChunkSize_, baseSnapshotId, *state);
+        });
+
+      if (pid > 0) {
+        state->ClearChanges();
+        const bool compact = AppendToSnapshotChain(type, instanceId, snapshotId, baseSnapshotId);
+        LOG_DEBUG("Forked snapshot writer {} for {} ({} us stall)", pid, path,
+                  (utils::FastNanoTime::Now() - startNs) / 1000);
+        std::lock_guard<std::mutex> lock(snapshotWritersMutex_);
+        snapshotWriters_.emplace_back(
+          [this, pid, path, snapshotId, seq, timestampNs, type, instanceId, compact] {
+            if (AwaitForkedSnapshot(snapshotId, type)) {
+              RegisterStoredSnapshot(snapshotId, seq, timestampNs, type, instanceId, path);
+              LOG_DEBUG("completed {}", path);
+              if (compact) {
+                // base snapshots written by other children must be complete
+                CompactSnapshotChain(snapshotId, type, instanceId, path);
+              }
+            } else {
+              // changes are already cleared - next snapshot must be full
+              ResetSnapshotChain(type, instanceId);
+              LOG_ERROR("Can not write snapshot file: {} - snapshot writer {} failed", path, pid);
+            }
+          });
+        return true;
+      }
 
-    // Flush and verify write
-    file.flush();
-    if (!file.good()) {
-      LOG_ERROR("Can not write snapshot file: {} - write failed", path);
-      file.close();
-      return false;
+      LOG_WARN("Can not fork snapshot writer, writing {} inline", path);
     }
+#endif
 
-    file.close();
+    const int64_t entries =
+      KeyedSnapshotFile::Write(path, snapshotChunkSize_, baseSnapshotId, *state);
+    state->ClearChanges();
+    RegisterStoredSnapshot(snapshotId, seq, timestampNs, type, instanceId, path);
 
-    LOG_DEBUG("done serializing, flushing {} ...", path);
-    LOG_DEBUG("completed {}", path);
-
-    // Update snapshot descriptor path if this is the first instance written
-    // (matches Java: path is set when snapshot is created)
-    if (snapshotsIndex_.find(snapshotId) != snapshotsIndex_.end()) {
-      auto* descriptor = snapshotsIndex_[snapshotId];
-      if (descriptor && descriptor->path.empty()) {
-        // Set path for the snapshot descriptor (use first instance path as
-        // base)
-        if (instanceId == 0) {
-          descriptor->path = path;
+    LOG_DEBUG("completed {} ({} entries, {} us stall)", path, entries,
+              (utils::FastNanoTime::Now() - startNs) / 1000);
+
+    if (AppendToSnapshotChain(type, instanceId, snapshotId, baseSnapshotId)) {
+      std::lock_guard<std::mutex> lock(snapshotWritersMutex_);
+      snapshotWriters_.emplace_back([this, snapshotId, type, instanceId, path] {
+        CompactSnapshotChain(snapshotId, type, instanceId, path);
+      });
+    }
+    return true;
+  } catch (const std::exception& ex) {
+    ResetSnapshotChain(type, instanceId);
+    LOG_ERROR("Can not write snapshot file: {} - {}", path, ex.what());
+    return false;
+  }
+}
+
+int DiskSerializationProcessor::ForkSnapshotWriter(
+  int64_t snapshotId,
+  SerializedModuleType type,
+  const std::string& path,
+  std::function<void(const std::string&)> writeFile) {
+#ifndef _WIN32
+  const int32_t instances =
+    type == SerializedModuleType::RISK_ENGINE ? riskEnginesNum_ : matchingEnginesNum_;
+  const auto key = std::make_pair(snapshotId, type);
+  std::unique_lock<std::mutex> lock(forkedSnapshotsMutex_);
+  auto& snapshot = forkedSnapshots_[key];
+  snapshot.files.emplace_back(path, std::move(writeFile));
+
+  if (static_cast<int32_t>(snapshot.files.size()) >= instances) {
+    // Other instances are waiting, their state is not modified until fork is done
+    const pid_t pid = ::fork();
+    if (pid == 0) {
+      // Child process: copy-on-write image of the states at this point.
+      // Only this thread exists here, so no logging (logger lock could be
+      // held by another thread of the parent). Complete files are renamed.
+      bool isSuccess = true;
+      for (const auto& [filePath, write] : snapshot.files) {
+        try {
+          const std::string tmpPath = filePath + ".tmp";
+          write(tmpPath);
+          isSuccess = std::rename(tmpPath.c_str(), filePath.c_str()) == 0 && isSuccess;
+        } catch (...) {
+          isSuccess = false;
         }
       }
+      ::_exit(isSuccess ? 0 : 1);
+    }
+    snapshot.pid = pid;
+    snapshot.forked = true;
+    forkedSnapshotsCondition_.notify_all();
+    if (pid > 0) {
+      lock.unlock();
+      // the only waitpid call for this writer
+      std::lock_guard<std::mutex> writersLock(snapshotWritersMutex_);
+      snapshotWriters_.emplace_back([this, key, pid] { ReapSnapshotWriter(key, pid); });
+      return pid;
     }
+  } else {
+    forkedSnapshotsCondition_.wait(lock, [&snapshot] { return snapshot.forked; });
+  }
 
-    // Write to main log file (synchronized) - matches Java format
-    {
-      static std::mutex mainLogMutex;
-      std::lock_guard<std::mutex> lock(mainLogMutex);
-      const std::string mainLogPath = folder_ + "/" + exchangeId_ + ".eca";
-      std::ofstream mainLog(mainLogPath, std::ios::app);
-      if (mainLog.is_open()) {
-        auto now = utils::FastNanoTime::NowMillis();
-        mainLog << now << " seq=" << seq << " timestampNs=" << timestampNs
-                << " snapshotId=" << snapshotId
-                << " type=" << (type == SerializedModuleType::RISK_ENGINE ? "RE" : "ME")
-                << " instance=" << instanceId << "\n";
-        mainLog.close();
-      }
+  const int pid = snapshot.pid;
+  if (pid < 0 && ++snapshot.released == instances) {
+    // fork failed - files are written inline, nobody waits for the entry
+    forkedSnapshots_.erase(key);
+  }
+  return pid;
+#else
+  return -1;
+#endif
+}
+
+void DiskSerializationProcessor::ReapSnapshotWriter(
+  std::pair<int64_t, SerializedModuleType> key,
+  int pid) {
+#ifndef _WIN32
+  int status = 0;
+  pid_t result;
+  do {
+    result = ::waitpid(pid, &status, 0);
+  } while (result < 0 && errno == EINTR);
+
+  std::unique_lock<std::mutex> lock(forkedSnapshotsMutex_);
+  auto& snapshot = forkedSnapshots_.at(key);
+  if (result == pid) {
+    snapshot.succeeded = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  } else if (errno == ECHILD) {
+    // SIGCHLD is ignored: writer was reaped automatically (waitpid returns
+    // once it is gone) and its exit status is lost - complete files are
+    // renamed to their paths by the writer
+    snapshot.succeeded = true;
+    for (const auto& file : snapshot.files) {
+      snapshot.succeeded = snapshot.succeeded && std::filesystem::exists(file.first);
     }
+  } else {
+    snapshot.succeeded = false;
+  }
+  snapshot.exited = true;
+  forkedSnapshotsCondition_.notify_all();
+#endif
+}
 
-    return true;
-  } catch (const std::exception& ex) {
-    LOG_ERROR("Can not write snapshot file: {} - {}", path, ex.what());
+bool DiskSerializationProcessor::AwaitForkedSnapshot(int64_t snapshotId,
+                                                     SerializedModuleType type) {
+  const int32_t instances =
+    type == SerializedModuleType::RISK_ENGINE ? riskEnginesNum_ : matchingEnginesNum_;
+  const auto key = std::make_pair(snapshotId, type);
+  std::unique_lock<std::mutex> lock(forkedSnapshotsMutex_);
+  const auto it = forkedSnapshots_.find(key);
+  forkedSnapshotsCondition_.wait(lock, [&it] { return it->second.exited; });
+  const bool isSuccess = it->second.succeeded;
+  if (++it->second.released == instances) {
+    forkedSnapshots_.erase(it);
+  }
+  return isSuccess;
+}
+
+int64_t DiskSerializationProcessor::GetIncrementalSnapshotBase(
+  SerializedModuleType type,
+  int32_t instanceId,
+  const IIncrementalSnapshotState* state) {
+  std::lock_guard<std::mutex> lock(snapshotChainsMutex_);
+  const auto it = snapshotChains_.find({type, instanceId});
+  if (it == snapshotChains_.end() || !state->ChangesTracked()) {
+    return KeyedSnapshotFile::FULL_SNAPSHOT;
+  }
+  return it->second.lastSnapshotId;
+}
+
+bool DiskSerializationProcessor::AppendToSnapshotChain(SerializedModuleType type,
+                                                       int32_t instanceId,
+                                                       int64_t snapshotId,
+                                                       int64_t baseSnapshotId) {
+  std::lock_guard<std::mutex> lock(snapshotChainsMutex_);
+  auto& chain = snapshotChains_[{type, instanceId}];
+  chain.lastSnapshotId = snapshotId;
+  chain.length = (baseSnapshotId == KeyedSnapshotFile::FULL_SNAPSHOT) ? 0 : chain.length + 1;
+  if (chain.length < incrementalSnapshotsCompaction_) {
     return false;
   }
+  // snapshot will be replaced by full one, next incremental snapshots refer to it
+  chain.length = 0;
+  return true;
+}
+
+void DiskSerializationProcessor::ResetSnapshotChain(SerializedModuleType type,
+                                                    int32_t instanceId) {
+  std::lock_guard<std::mutex> lock(snapshotChainsMutex_);
+  snapshotChains_.erase({type, instanceId});
+}
+
+void DiskSerializationProcessor::CompactSnapshotChain(int64_t snapshotId,
+                                                      SerializedModuleType type,
+                                                      int32_t instanceId,
+                                                      const std::string& path) {
+  const int64_t startNs = utils::FastNanoTime::Now();
+  try {
+    KeyedSnapshotFile::Compact(
+      snapshotId,
+      [this, type, instanceId](int64_t id) { return GetSnapshotPath(id, type, instanceId); },
+      snapshotChunkSize_, path);
+    LOG_DEBUG("Compacted snapshot chain into {} ({} ms)", path,
+              (utils::FastNanoTime::Now() - startNs) / 1'000'000);
+  } catch (const std::exception& ex) {
+    // chain files are still valid, it just keeps growing until next full snapshot
+    ResetSnapshotChain(type, instanceId);
+    LOG_WARN("Can not compact snapshot chain into {} - {}", path, ex.what());
+  }
+}
+
+void DiskSerializationProcessor::WriteSnapshotFile(const std::string& path,
+                                                   const common::WriteBytesMarshallable* obj) {
+  // Serialized state is compressed and written chunk by chunk (LZ4 frame),
+  // memory usage does not depend on the state size
+  Lz4FrameBytesOut bytesOut(path, snapshotChunkSize_);
+  obj->WriteMarshallable(bytesOut);
+  if (bytesOut.WritePosition() == 0) {
+    throw std::runtime_error("serialized data is empty");
+  }
+  bytesOut.Finish();
+}
+
+void DiskSerializationProcessor::RegisterStoredSnapshot(int64_t snapshotId,
+                                                        int64_t seq,
+                                                        int64_t timestampNs,
+                                                        SerializedModuleType type,
+                                                        int32_t instanceId,
+                                                        const std::string& path) {
+  // Update snapshot descriptor path if this is the first instance written
+  // (matches Java: path is set when snapshot is created)
+  {
+    std::lock_guard<std::mutex> lock(journalMutex_);
+    auto it = snapshotsIndex_.find(snapshotId);
+    if (it != snapshotsIndex_.end() && it->second != nullptr && it->second->path.empty()
+        && instanceId == 0) {
+      it->second->path = path;
+    }
+    storedSnapshotModules_[snapshotId]++;
+  }
+
+  // Write to main log file (synchronized) - matches Java format
+  static std::mutex mainLogMutex;
+  std::lock_guard<std::mutex> lock(mainLogMutex);
+  const std::string mainLogPath = folder_ + "/" + exchangeId_ + ".eca";
+  std::ofstream mainLog(mainLogPath, std::ios::app);
+  if (mainLog.is_open()) {
+    auto now = utils::FastNanoTime::NowMillis();
+    mainLog << now << " seq=" << seq << " timestampNs=" << timestampNs
+            << " snapshotId=" << snapshotId
+            << " type=" << (type == SerializedModuleType::RISK_ENGINE ? "RE" : "ME")
+            << " instance=" << instanceId << "\n";
+    mainLog.close();
+  }
+}
+
+void DiskSerializationProcessor::AwaitSnapshotsWritten() {
+  std::vector<std::thread> writers;
+  {
+    std::lock_guard<std::mutex> lock(snapshotWritersMutex_);
+    writers.swap(snapshotWriters_);
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
 }
 
 void DiskSerializationProcessor::LoadData(int64_t snapshotId,
@@ -249,7 +594,16 @@ void DiskSerializationProcessor::LoadData(int64_t snapshotId,
 
   LOG_DEBUG("Loading state from {}", path);
 
+  AwaitSnapshotsWritten();
+
   try {
+    if (IsLz4FrameSnapshot(path)) {
+      Lz4FrameBytesIn bytesIn(path, snapshotChunkSize_);
+      initFunc(&bytesIn);
+      return;
+    }
+
+    // Snapshot written as single LZ4 block (previous format)
     std::ifstream file(path, std::ios::binary);
     if (!file.is_open()) {
       throw std::runtime_error("Can not open snapshot file: " + path);
@@ -313,6 +667,52 @@ void DiskSerializationProcessor::LoadData(int64_t snapshotId,
   }
 }
 
+bool DiskSerializationProcessor::LoadIncrementalData(
+  int64_t snapshotId,
+  SerializedModuleType type,
+  int32_t instanceId,
+  std::function<void(common::BytesIn*)> globalFunc,
+  std::function<void(int64_t, common::BytesIn*)> entryFunc) {
+  const std::string path = GetSnapshotPath(snapshotId, type, instanceId);
+
+  AwaitSnapshotsWritten();
+
+  if (!KeyedSnapshotFile::IsKeyedSnapshot(path)) {
+    return false;
+  }
+
+  LOG_DEBUG("Loading state from snapshot chain {}", path);
+
+  try {
+    const int64_t startNs = utils::FastNanoTime::Now();
+    const int32_t files = KeyedSnapshotFile::ReadChain(
+      snapshotId,
+      [this, type, instanceId](int64_t id) { return GetSnapshotPath(id, type, instanceId); },
+      snapshotChunkSize_,
+      [&globalFunc](const std::vector<uint8_t>& state) {
+        common::VectorBytesIn bytesIn(state);
+        globalFunc(&bytesIn);
+      },
+      [&entryFunc](int64_t key, const std::vector<uint8_t>& state) {
+        common::VectorBytesIn bytesIn(state);
+        entryFunc(key, &bytesIn);
+      });
+
+    // Loaded state is the base for next incremental snapshot
+    {
+      std::lock_guard<std::mutex> lock(snapshotChainsMutex_);
+      snapshotChains_[{type, instanceId}] = SnapshotChain{snapshotId, files - 1};
+    }
+
+    LOG_DEBUG("Loaded {} snapshot files ({} ms)", files,
+              (utils::FastNanoTime::Now() - startNs) / 1'000'000);
+    return true;
+  } catch (const std::exception& ex) {
+    LOG_ERROR("Can not read snapshot file: {} - {}", path, ex.what());
+    throw;
+  }
+}
+
 std::string DiskSerializationProcessor::GetSnapshotPath(int64_t snapshotId,
                                                         SerializedModuleType type,
                                                         int32_t instanceId) {
@@ -331,6 +731,13 @@ std::string DiskSerializationProcessor::GetJournalPath(int64_t snapshotId, int32
   return oss.str();
 }
 
+std::string DiskSerializationProcessor::GetJournalIndexPath(int64_t snapshotId,
+                                                            int32_t fileIndex) {
+  std::string path = GetJournalPath(snapshotId, fileIndex);
+  path.replace(path.size() - 4, 4, ".eci");
+  return path;
+}
+
 void DiskSerializationProcessor::WriteToJournal(common::cmd::OrderCommand* cmd,
                                                 int64_t dSeq,
                                                 bool eob) {
@@ -346,140 +753,169 @@ void DiskSerializationProcessor::WriteToJournal(common::cmd::OrderCommand* cmd,
 
   // Handle shutdown signal
   if (cmdType == common::cmd::OrderCommandType::SHUTDOWN_SIGNAL) {
-    std::lock_guard<std::mutex> lock(journalMutex_);
-    FlushBufferSync(false, cmd->timestamp);
+    SubmitBatch(false);
+    AwaitBatchesWritten(filledBatches_);
+    AwaitDurable(journaledDSeq_);
     LOG_DEBUG("Shutdown signal received, flushed to disk");
     return;
   }
 
-  // Skip non-mutating commands
+  // Skip non-mutating commands (but do not keep journaled commands of the batch
+  // in buffer, their results are waiting for them)
   if (!common::cmd::IsMutate(cmdType)) {
+    if (eob) {
+      SubmitBatch(false);
+    }
     return;
   }
 
-  // Start new file if needed
-  {
-    std::lock_guard<std::mutex> lock(journalMutex_);
-    if (!journalFile_ || !journalFile_->is_open()) {
-      StartNewFile(cmd->timestamp);
-    }
+  if (cmdType == common::cmd::OrderCommandType::BINARY_DATA_COMMAND && cmd->payload != nullptr) {
+    WritePayloadToJournal(cmd, dSeq);
+    return;
+  }
 
+  {
     // Write command to buffer
-    auto& buffer = journalWriteBuffer_;
-    size_t& pos = journalWriteBufferPos_;
+    auto* batch = &CurrentBatch();
 
     // Check if buffer is full
-    if (pos + 256 > buffer.size()) {  // MAX_COMMAND_SIZE_BYTES
-      FlushBufferSync(false, cmd->timestamp);
-      pos = 0;
+    if (batch->length + 256 > batch->buffer.size()) {  // MAX_COMMAND_SIZE_BYTES
+      SubmitBatch(false);
+      batch = &CurrentBatch();
     }
 
-    // Mandatory fields
-    buffer[pos++] = static_cast<char>(static_cast<int8_t>(cmdType));
+    auto& buffer = batch->buffer;
+    size_t& pos = batch->length;
     const int64_t currentSeq = baseSeq_ + dSeq;
-    *reinterpret_cast<int64_t*>(&buffer[pos]) = currentSeq;
-    pos += sizeof(int64_t);
-    lastWrittenSeq_ = currentSeq;  // Track last written sequence
-    *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->timestamp;
-    pos += sizeof(int64_t);
-    *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->serviceFlags;
-    pos += sizeof(int32_t);
-    *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->eventsGroup;
-    pos += sizeof(int64_t);
-
-    // Write command-specific fields
-    if (cmdType == common::cmd::OrderCommandType::MOVE_ORDER) {
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->symbol;
-      pos += sizeof(int32_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->price;
-      pos += sizeof(int64_t);
-    } else if (cmdType == common::cmd::OrderCommandType::CANCEL_ORDER) {
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->symbol;
-      pos += sizeof(int32_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
-      pos += sizeof(int64_t);
-    } else if (cmdType == common::cmd::OrderCommandType::REDUCE_ORDER) {
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->symbol;
-      pos += sizeof(int32_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->size;
-      pos += sizeof(int64_t);
-    } else if (cmdType == common::cmd::OrderCommandType::PLACE_ORDER) {
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->symbol;
-      pos += sizeof(int32_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->price;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->reserveBidPrice;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->size;
+    if (pos == 0) {
+      batch->firstTimestampNs = cmd->timestamp;
+      batch->firstSeq = currentSeq;
+      batch->deltas = CompactJournalCodec::Deltas{};
+    }
+    batch->lastTimestampNs = cmd->timestamp;
+    batch->lastSeq = currentSeq;
+    batch->lastDSeq = dSeq;
+    journaledDSeq_ = dSeq;
+
+    if (compactJournal_) {
+      // v2 record, delta-encoded against previous record of the batch
+      pos += CompactJournalCodec::EncodeCommand(cmd, currentSeq, batch->deltas, &buffer[pos]);
+    } else {
+      // Mandatory fields
+      buffer[pos++] = static_cast<char>(static_cast<int8_t>(cmdType));
+      *reinterpret_cast<int64_t*>(&buffer[pos]) = currentSeq;
       pos += sizeof(int64_t);
-      *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->userCookie;
-      pos += sizeof(int32_t);
-      const int actionAndType =
-        (static_cast<int>(cmd->orderType) << 1) | static_cast<int>(cmd->action);
-      buffer[pos++] = static_cast<char>(actionAndType);
-    } else if (cmdType == common::cmd::OrderCommandType::BALANCE_ADJUSTMENT) {
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
+      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->timestamp;
       pos += sizeof(int64_t);
-      *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->symbol;
+      *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->serviceFlags;
       pos += sizeof(int32_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->price;
-      pos += sizeof(int64_t);
-      // Match Java: buffer.put(cmd.orderType.getCode());
-      // For BALANCE_ADJUSTMENT, orderType code equals adjustmentType code
-      buffer[pos++] = static_cast<char>(common::OrderTypeToCode(cmd->orderType));
-    } else if (cmdType == common::cmd::OrderCommandType::ADD_USER
-               || cmdType == common::cmd::OrderCommandType::SUSPEND_USER
-               || cmdType == common::cmd::OrderCommandType::RESUME_USER) {
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
-      pos += sizeof(int64_t);
-    } else if (cmdType == common::cmd::OrderCommandType::BINARY_DATA_COMMAND) {
-      buffer[pos++] = static_cast<char>(cmd->symbol);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->price;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->reserveBidPrice;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->size;
-      pos += sizeof(int64_t);
-      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
+      *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->eventsGroup;
       pos += sizeof(int64_t);
+
+      // Write command-specific fields
+      if (cmdType == common::cmd::OrderCommandType::MOVE_ORDER) {
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->symbol;
+        pos += sizeof(int32_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->price;
+        pos += sizeof(int64_t);
+      } else if (cmdType == common::cmd::OrderCommandType::CANCEL_ORDER) {
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->symbol;
+        pos += sizeof(int32_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
+        pos += sizeof(int64_t);
+      } else if (cmdType == common::cmd::OrderCommandType::REDUCE_ORDER) {
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->symbol;
+        pos += sizeof(int32_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->size;
+        pos += sizeof(int64_t);
+      } else if (cmdType == common::cmd::OrderCommandType::PLACE_ORDER) {
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->symbol;
+        pos += sizeof(int32_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->price;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->reserveBidPrice;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->size;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->userCookie;
+        pos += sizeof(int32_t);
+        const int actionAndType =
+          (static_cast<int>(cmd->orderType) << 1) | static_cast<int>(cmd->action);
+        buffer[pos++] = static_cast<char>(actionAndType);
+      } else if (cmdType == common::cmd::OrderCommandType::BALANCE_ADJUSTMENT) {
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int32_t*>(&buffer[pos]) = cmd->symbol;
+        pos += sizeof(int32_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->price;
+        pos += sizeof(int64_t);
+        // Match Java: buffer.put(cmd.orderType.getCode());
+        // For BALANCE_ADJUSTMENT, orderType code equals adjustmentType code
+        buffer[pos++] = static_cast<char>(common::OrderTypeToCode(cmd->orderType));
+      } else if (cmdType == common::cmd::OrderCommandType::ADD_USER
+                 || cmdType == common::cmd::OrderCommandType::SUSPEND_USER
+                 || cmdType == common::cmd::OrderCommandType::RESUME_USER) {
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
+        pos += sizeof(int64_t);
+      } else if (cmdType == common::cmd::OrderCommandType::BINARY_DATA_COMMAND) {
+        buffer[pos++] = static_cast<char>(cmd->symbol);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->orderId;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->price;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->reserveBidPrice;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->size;
+        pos += sizeof(int64_t);
+        *reinterpret_cast<int64_t*>(&buffer[pos]) = cmd->uid;
+        pos += sizeof(int64_t);
+      }
     }
 
     // Handle special commands
     if (cmdType == common::cmd::OrderCommandType::PERSIST_STATE_RISK) {
-      // Register snapshot change
-      RegisterNextSnapshot(cmd->orderId, baseSeq_ + dSeq, cmd->timestamp);
-      // Start new file
-      baseSnapshotId_ = cmd->orderId;
-      filesCounter_ = 0;
-      FlushBufferSync(true, cmd->timestamp);
+      // Register snapshot change, next journal file belongs to new snapshot
+      {
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        RegisterNextSnapshot(cmd->orderId, baseSeq_ + dSeq, cmd->timestamp);
+      }
+      batch->nextSnapshot = lastSnapshotDescriptor_;
+      SubmitBatch(true);
     } else if (cmdType == common::cmd::OrderCommandType::RESET) {
       // Force start next journal file on reset
-      FlushBufferSync(true, cmd->timestamp);
+      SubmitBatch(true);
     } else if (eob || pos >= static_cast<size_t>(journalBufferFlushTrigger_)) {
       // Flush on end of batch or when buffer is full
-      FlushBufferSync(false, cmd->timestamp);
+      SubmitBatch(false);
     }
   }
 }
 
+void DiskSerializationProcessor::AwaitJournalWrite(const common::cmd::OrderCommand* cmd,
+                                                   int64_t dSeq) {
+  if (!asyncWriter_ || !common::cmd::IsMutate(cmd->command) || enableJournalAfterSeq_ == -1
+      || dSeq + baseSeq_ <= enableJournalAfterSeq_) {
+    return;
+  }
+  AwaitDurable(dSeq);
+}
+
 void DiskSerializationProcessor::EnableJournaling(int64_t afterSeq, IExchangeApi* api) {
   enableJournalAfterSeq_ = afterSeq;
   // Match Java: api.groupingControl(0, 1);
@@ -489,6 +925,7 @@ void DiskSerializationProcessor::EnableJournaling(int64_t afterSeq, IExchangeApi
 }
 
 std::map<int64_t, SnapshotDescriptor*> DiskSerializationProcessor::FindAllSnapshotPoints() {
+  std::lock_guard<std::mutex> lock(journalMutex_);
   return snapshotsIndex_;
 }
 
@@ -496,7 +933,13 @@ void DiskSerializationProcessor::ReplayJournalStep(int64_t snapshotId,
                                                    int64_t seqFrom,
                                                    int64_t seqTo,
                                                    IExchangeApi* api) {
-  throw std::runtime_error("ReplayJournalStep not implemented");
+  if (seqTo <= seqFrom) {
+    return;
+  }
+  const int64_t lastSeq = ReplayJournal(snapshotId, seqFrom, seqTo, api);
+  if (lastSeq < seqTo) {
+    LOG_WARN("Journal step replay stopped at seq={}, expected seqTo={}", lastSeq, seqTo);
+  }
 }
 
 int64_t DiskSerializationProcessor::ReplayJournalFull(
@@ -514,341 +957,581 @@ int64_t DiskSerializationProcessor::ReplayJournalFull(
     api->GroupingControl(0, 0);
   }
 
-  int64_t lastSeq = baseSeq_;
-  int partitionCounter = 1;
+  return ReplayJournal(initialStateConfiguration->snapshotId, std::numeric_limits<int64_t>::min(),
+                       std::numeric_limits<int64_t>::max(), api, true);
+}
 
-  while (true) {
-    const std::string path =
-      GetJournalPath(initialStateConfiguration->snapshotId, partitionCounter);
+int64_t DiskSerializationProcessor::ReplayJournal(int64_t snapshotId,
+                                                  int64_t seqFrom,
+                                                  int64_t seqTo,
+                                                  IExchangeApi* api,
+                                                  bool recover) {
+  // Step replay starts at indexed position, full replay reads all files
+  JournalPosition position;
+  if (seqFrom != std::numeric_limits<int64_t>::min()) {
+    position = SeekJournal(snapshotId, seqFrom);
+    LOG_DEBUG("Journal seek after seq={}: file {} offset {} (seq={})", seqFrom,
+              position.fileIndex, position.offset, position.seq);
+  }
 
-    LOG_DEBUG("Reading journal file: {}", path);
+  JournalReader reader(replayDecompressThreads_, replayReadAheadBlocks_, replayBatchSize_);
+  const auto publishBatch = [api](const JournalCommand* cmds, size_t count) {
+    api->ReplayCommandsBatch(cmds, count);
+  };
 
+  const int64_t startNs = utils::FastNanoTime::Now();
+  int64_t lastSeq = seqFrom == std::numeric_limits<int64_t>::min() ? baseSeq_ : seqFrom;
+  int64_t bytesRead = 0;
+  for (int32_t partitionCounter = position.fileIndex; lastSeq < seqTo; partitionCounter++) {
+    const std::string path = GetJournalPath(snapshotId, partitionCounter);
     if (!std::filesystem::exists(path)) {
       LOG_DEBUG("File not found: {}, returning lastSeq={}", path, lastSeq);
-      return lastSeq;
+      break;
     }
 
+    LOG_DEBUG("Reading journal file: {}", path);
     try {
-      std::ifstream file(path, std::ios::binary);
-      if (!file.is_open()) {
-        LOG_DEBUG("Can not open file: {}, try next partition", path);
-        partitionCounter++;
-        continue;
-      }
-
-      ReadCommands(file, api, lastSeq, false);
-      file.close();
-      partitionCounter++;
-      LOG_DEBUG("File end reached, try next partition {}...", partitionCounter);
-
+      const int64_t offset = partitionCounter == position.fileIndex ? position.offset : 0;
+      bytesRead += reader.ReadFile(path, seqFrom, seqTo, lastSeq, publishBatch, offset);
     } catch (const std::exception& ex) {
       LOG_DEBUG("File end reached through exception: {}", ex.what());
-      partitionCounter++;
     }
-  }
-}
 
-void DiskSerializationProcessor::ReadCommands(std::istream& is,
-                                              IExchangeApi* api,
-                                              int64_t& lastSeq,
-                                              bool insideCompressedBlock) {
-  while (is.peek() != EOF && is.good()) {
-    int8_t cmdByte;
-    if (!is.read(reinterpret_cast<char*>(&cmdByte), 1)) {
+    const int64_t damagedAt = reader.DamagedAt();
+    if (damagedAt >= 0) {
+      // Only the tail of the last file can be damaged by interrupted write,
+      // later commands can not be replayed without a gap
+      if (std::filesystem::exists(GetJournalPath(snapshotId, partitionCounter + 1))) {
+        LOG_ERROR("Journal file {} is damaged at {}, replay stopped at seq={}", path, damagedAt,
+                  lastSeq);
+      } else if (recover) {
+        const auto fileSize = static_cast<int64_t>(std::filesystem::file_size(path));
+        LOG_WARN("Truncating damaged journal tail: {} at {} ({} bytes dropped)", path, damagedAt,
+                 fileSize - damagedAt);
+        std::filesystem::resize_file(path, static_cast<uintmax_t>(damagedAt));
+      }
       break;
     }
+  }
 
-    if (cmdByte == static_cast<int8_t>(common::cmd::OrderCommandType::RESERVED_COMPRESSED)) {
-      if (insideCompressedBlock) {
-        throw std::runtime_error("Recursive compression block (data corrupted)");
-      }
-
-      int32_t compressedSize, originalSize;
-      if (!is.read(reinterpret_cast<char*>(&compressedSize), sizeof(int32_t))
-          || !is.read(reinterpret_cast<char*>(&originalSize), sizeof(int32_t))) {
-        break;
-      }
+  const int64_t durationNs = std::max<int64_t>(utils::FastNanoTime::Now() - startNs, 1);
+  const double megabytes = static_cast<double>(bytesRead) / (1 << 20);
+  LOG_INFO("Journal replayed up to seq={}: {:.1f} MB in {} ms ({:.1f} MB/s)", lastSeq, megabytes,
+           durationNs / 1'000'000, megabytes * 1e9 / static_cast<double>(durationNs));
+  return lastSeq;
+}
 
-      if (compressedSize > 1000000 || originalSize > 1000000) {
-        throw std::runtime_error("Bad compressed block size (data corrupted)");
-      }
+DiskSerializationProcessor::JournalPosition
+DiskSerializationProcessor::SeekJournal(int64_t snapshotId, int64_t afterSeq) {
+  // Index entries are only hints: position moves forward only to entries
+  // pointing inside written part of existing journal file
+  JournalPosition position;
+  JournalIndex::Entry entry;
+  for (int32_t fileIndex = 1;; fileIndex++) {
+    const std::string path = GetJournalPath(snapshotId, fileIndex);
+    std::error_code ec;
+    const auto fileSize = std::filesystem::file_size(path, ec);
+    if (ec || afterSeq == std::numeric_limits<int64_t>::max()
+        || !JournalIndex::FindFloor(GetJournalIndexPath(snapshotId, fileIndex), afterSeq + 1,
+                                    entry)
+        || entry.offset < 0 || static_cast<uint64_t>(entry.offset) >= fileSize) {
+      break;
+    }
+    position.fileIndex = fileIndex;
+    position.offset = entry.offset;
+    position.seq = entry.seq;
+    position.timestampNs = entry.timestampNs;
+  }
+  return position;
+}
 
-      std::vector<char> compressed(compressedSize);
-      if (!is.read(compressed.data(), compressedSize) || is.gcount() < compressedSize) {
-        throw std::runtime_error("Can not read full compressed block");
-      }
+void DiskSerializationProcessor::ReplayJournalFullAndThenEnableJouraling(
+  const common::config::InitialStateConfiguration* initialStateConfiguration,
+  IExchangeApi* api) {
+  int64_t seq = ReplayJournalFull(initialStateConfiguration, api);
+  EnableJournaling(seq, api);
+}
 
-      // Decompress
-      std::vector<char> original(originalSize);
-      const int decompressedSize =
-        LZ4_decompress_safe(compressed.data(), original.data(), compressedSize, originalSize);
+bool DiskSerializationProcessor::CheckSnapshotExists(int64_t snapshotId,
+                                                     SerializedModuleType type,
+                                                     int32_t instanceId) {
+  const std::string path = GetSnapshotPath(snapshotId, type, instanceId);
+  AwaitSnapshotsWritten();
+  const bool exists = std::filesystem::exists(path);
+  LOG_INFO("Checking snapshot file {} exists:{}", path, exists);
+  return exists;
+}
 
-      if (decompressedSize != originalSize) {
-        throw std::runtime_error("LZ4 decompression failed");
-      }
+void DiskSerializationProcessor::WritePayloadToJournal(const common::cmd::OrderCommand* cmd,
+                                                       int64_t dSeq) {
+  // Binary command is journaled as one record of its own (any size, no 5-longs
+  // frames): marker, stored size, original size (0 if not compressed), seq,
+  // timestamp, serviceFlags, eventsGroup, transferId, CRC32C of preceding
+  // header fields and data, data. Preceding commands are written first.
+  SubmitBatch(false);
+
+  auto& batch = CurrentBatch();
+  const int64_t currentSeq = baseSeq_ + dSeq;
+  batch.firstTimestampNs = cmd->timestamp;
+  batch.firstSeq = currentSeq;
+  batch.lastTimestampNs = cmd->timestamp;
+  batch.lastSeq = currentSeq;
+  batch.lastDSeq = dSeq;
+  journaledDSeq_ = dSeq;
+
+  constexpr int headerSize = 45;
+  const auto& payload = *cmd->payload;
+  const int originalLength = static_cast<int>(payload.size());
+  const int maxStoredSize = LZ4_compressBound(originalLength);
+  auto& record = batch.payloadRecord;
+  record.resize(headerSize + static_cast<size_t>(maxStoredSize));
+  char* const data = record.data() + headerSize;
+
+  int storedSize = originalLength;
+  int32_t storedOriginalLength = 0;
+  if (originalLength >= journalBatchCompressThreshold_) {
+    const int compressedSize = LZ4_compress_default(reinterpret_cast<const char*>(payload.data()),
+                                                    data, originalLength, maxStoredSize);
+    if (compressedSize <= 0) {
+      throw std::runtime_error("Journal payload compression failed");
+    }
+    // kept compressed only if it saves at least 1/8
+    if (compressedSize < originalLength - originalLength / 8) {
+      storedSize = compressedSize;
+      storedOriginalLength = originalLength;
+    }
+  }
+  if (storedOriginalLength == 0) {
+    std::memcpy(data, payload.data(), payload.size());
+  }
+  record.resize(headerSize + static_cast<size_t>(storedSize));
+
+  char* p = record.data();
+  *p++ = static_cast<char>(
+    static_cast<int8_t>(common::cmd::OrderCommandType::RESERVED_BINARY_PAYLOAD));
+  const auto put = [&p](const auto value) {
+    std::memcpy(p, &value, sizeof(value));
+    p += sizeof(value);
+  };
+  put(static_cast<int32_t>(storedSize));
+  put(storedOriginalLength);
+  put(currentSeq);
+  put(cmd->timestamp);
+  put(cmd->serviceFlags);
+  put(cmd->eventsGroup);
+  put(cmd->userCookie);
+  const uint32_t headerCrc = utils::Crc32c::Compute(record.data(), p - record.data());
+  put(utils::Crc32c::Compute(data, storedSize, headerCrc));
+
+  SubmitBatch(false);
+}
 
-      // Read compressed block recursively
-      std::istringstream decompressedStream(std::string(original.data(), originalSize));
-      ReadCommands(decompressedStream, api, lastSeq, true);
+void DiskSerializationProcessor::SubmitBatch(bool forceStartNextFile) {
+  auto& batch = CurrentBatch();
+  if (batch.length == 0 && batch.payloadRecord.empty() && !forceStartNextFile) {
+    return;
+  }
+  batch.forceStartNextFile = forceStartNextFile;
 
-    } else {
-      // Read command
-      int64_t seq, timestampNs, eventsGroup;
-      int32_t serviceFlags;
-
-      if (!is.read(reinterpret_cast<char*>(&seq), sizeof(int64_t))
-          || !is.read(reinterpret_cast<char*>(&timestampNs), sizeof(int64_t))
-          || !is.read(reinterpret_cast<char*>(&serviceFlags), sizeof(int32_t))
-          || !is.read(reinterpret_cast<char*>(&eventsGroup), sizeof(int64_t))) {
-        break;
-      }
+  if (!asyncWriter_) {
+    WriteBatch(batch);
+    FlushJournalData();
+    if (durabilityMode_ != DurabilityMode::NONE) {
+      SyncJournalFile();
+    }
+    return;
+  }
 
-      if (seq != lastSeq + 1) {
-        LOG_WARN("Sequence gap {}->{} ({})", lastSeq, seq, seq - lastSeq);
-      }
+  {
+    std::lock_guard<std::mutex> lock(writerMutex_);
+    submittedBatches_ = ++filledBatches_;
+  }
+  writerCondition_.notify_one();
 
-      lastSeq = seq;
+  // Wait for next buffer to be released by writer (writer is behind by all buffers)
+  AwaitBatchesWritten(filledBatches_ - static_cast<int64_t>(writeBatches_.size()) + 1);
+}
 
-      const auto cmdType = common::cmd::OrderCommandTypeFromCode(static_cast<int8_t>(cmdByte));
+void DiskSerializationProcessor::AwaitBatchesWritten(int64_t batches) {
+  while (writtenBatches_.load(std::memory_order_acquire) < batches) {
+    if (writerFailed_.load(std::memory_order_acquire)) {
+      std::rethrow_exception(writerError_);
+    }
+    std::this_thread::yield();
+  }
+}
 
-      // Handle different command types
-      // Match Java: all replay methods use serviceFlags and eventsGroup
-      if (cmdType == common::cmd::OrderCommandType::MOVE_ORDER) {
-        // Match Java: api.moveOrder(serviceFlags, eventsGroup, timestampNs,
-        // price, orderId, symbol, uid);
-        int64_t uid, orderId, price;
-        int32_t symbol;
-        if (!is.read(reinterpret_cast<char*>(&uid), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&symbol), sizeof(int32_t))
-            || !is.read(reinterpret_cast<char*>(&orderId), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&price), sizeof(int64_t))) {
-          break;
-        }
+void DiskSerializationProcessor::AwaitDurable(int64_t dSeq) {
+  if (!asyncWriter_) {
+    return;
+  }
+  while (durableDSeq_.load(std::memory_order_acquire) < dSeq) {
+    if (writerFailed_.load(std::memory_order_acquire)) {
+      throw std::runtime_error("Journal writer failed");
+    }
+    std::this_thread::yield();
+  }
+}
 
-        api->MoveOrderReplay(serviceFlags, eventsGroup, timestampNs, price, orderId, symbol, uid);
+void DiskSerializationProcessor::WriterThreadLoop() {
+  using Clock = std::chrono::steady_clock;
+  const auto groupCommitInterval = std::chrono::nanoseconds(groupCommitIntervalNs_);
+  int64_t written = 0;
+  int64_t writtenDSeq = -1;
+  Clock::time_point groupCommitDeadline;
 
-      } else if (cmdType == common::cmd::OrderCommandType::CANCEL_ORDER) {
-        // Match Java: api.cancelOrder(serviceFlags, eventsGroup, timestampNs,
-        // orderId, symbol, uid);
-        int64_t uid, orderId;
-        int32_t symbol;
-        if (!is.read(reinterpret_cast<char*>(&uid), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&symbol), sizeof(int32_t))
-            || !is.read(reinterpret_cast<char*>(&orderId), sizeof(int64_t))) {
-          break;
+  try {
+    while (true) {
+      bool haveBatch;
+      {
+        std::unique_lock<std::mutex> lock(writerMutex_);
+        const auto ready = [&] { return submittedBatches_ > written || writerStopping_; };
+        // unsynced bytes are only synced by deadline in GROUP_COMMIT mode
+        // (NONE never syncs: waiting until past deadline would spin)
+        if (durabilityMode_ == DurabilityMode::GROUP_COMMIT && unsyncedBytes_ > 0) {
+          writerCondition_.wait_until(lock, groupCommitDeadline, ready);
+        } else {
+          writerCondition_.wait(lock, ready);
         }
-
-        api->CancelOrderReplay(serviceFlags, eventsGroup, timestampNs, orderId, symbol, uid);
-
-      } else if (cmdType == common::cmd::OrderCommandType::REDUCE_ORDER) {
-        // Match Java: api.reduceOrder(serviceFlags, eventsGroup, timestampNs,
-        // reduceSize, orderId, symbol, uid);
-        int64_t uid, orderId, reduceSize;
-        int32_t symbol;
-        if (!is.read(reinterpret_cast<char*>(&uid), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&symbol), sizeof(int32_t))
-            || !is.read(reinterpret_cast<char*>(&orderId), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&reduceSize), sizeof(int64_t))) {
-          break;
+        haveBatch = submittedBatches_ > written;
+        if (!haveBatch && writerStopping_) {
+          lock.unlock();
+          SyncJournalFile();
+          return;
         }
+      }
 
-        api->ReduceOrderReplay(serviceFlags, eventsGroup, timestampNs, reduceSize, orderId, symbol,
-                               uid);
-
-      } else if (cmdType == common::cmd::OrderCommandType::PLACE_ORDER) {
-        // Match Java: api.placeNewOrder(serviceFlags, eventsGroup, timestampNs,
-        // orderId, userCookie, price, reservedBidPrice, size, orderAction,
-        // orderType, symbol, uid);
-        int64_t uid, orderId, price, reservedBidPrice, size;
-        int32_t symbol, userCookie;
-        uint8_t actionAndType;
-        if (!is.read(reinterpret_cast<char*>(&uid), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&symbol), sizeof(int32_t))
-            || !is.read(reinterpret_cast<char*>(&orderId), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&price), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&reservedBidPrice), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&size), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&userCookie), sizeof(int32_t))
-            || !is.read(reinterpret_cast<char*>(&actionAndType), 1)) {
-          break;
+      if (haveBatch) {
+        auto& batch = writeBatches_[written % static_cast<int64_t>(writeBatches_.size())];
+        const int64_t lastDSeq = batch.lastDSeq;
+        const bool wasSynced = unsyncedBytes_ == 0;
+        WriteBatch(batch);
+        FlushJournalData();
+        writtenBatches_.store(++written, std::memory_order_release);
+        writtenDSeq = lastDSeq;
+        if (wasSynced && unsyncedBytes_ > 0) {
+          groupCommitDeadline = Clock::now() + groupCommitInterval;
         }
+      }
 
-        const auto orderAction =
-          common::OrderActionFromCode(static_cast<uint8_t>(actionAndType & 0b1));
-        const auto orderType =
-          common::OrderTypeFromCode(static_cast<uint8_t>((actionAndType >> 1) & 0b1111));
+      if (durabilityMode_ == DurabilityMode::SYNC_EACH_BATCH
+          || (durabilityMode_ == DurabilityMode::GROUP_COMMIT
+              && (unsyncedBytes_ >= groupCommitMaxBytes_ || Clock::now() >= groupCommitDeadline))) {
+        SyncJournalFile();
+      }
+      if (durabilityMode_ == DurabilityMode::NONE || unsyncedBytes_ == 0) {
+        durableDSeq_.store(writtenDSeq, std::memory_order_release);
+      }
+    }
+  } catch (...) {
+    LOG_ERROR("Journal writer failed, journal is not written after seq={}", lastWrittenSeq_);
+    writerError_ = std::current_exception();
+    writerFailed_.store(true, std::memory_order_release);
+  }
+}
 
-        api->PlaceOrderReplay(serviceFlags, eventsGroup, timestampNs, orderId, userCookie, price,
-                              reservedBidPrice, size, orderAction, orderType, symbol, uid);
+void DiskSerializationProcessor::DirectWriterThreadLoop() {
+  using Clock = std::chrono::steady_clock;
+  const auto groupCommitInterval = std::chrono::nanoseconds(groupCommitIntervalNs_);
+  const bool groupCommit = durabilityMode_ == DurabilityMode::GROUP_COMMIT;
+  // submitted writes: io_uring ticket of last write, disruptor sequence of last command
+  std::deque<std::pair<int64_t, int64_t>> commits;
+  int64_t written = 0;
+  int64_t completedDSeq = -1;
+  Clock::time_point groupCommitDeadline;
 
-      } else if (cmdType == common::cmd::OrderCommandType::BALANCE_ADJUSTMENT) {
-        // Match Java: api.balanceAdjustment(serviceFlags, eventsGroup,
-        // timestampNs, uid, transactionId, currency, amount, adjustmentType);
-        int64_t uid, transactionId, amount;
-        int32_t currency;
-        uint8_t adjustmentTypeCode;
-        if (!is.read(reinterpret_cast<char*>(&uid), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&currency), sizeof(int32_t))
-            || !is.read(reinterpret_cast<char*>(&transactionId), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&amount), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&adjustmentTypeCode), 1)) {
-          break;
+  try {
+    while (true) {
+      int64_t submitted;
+      {
+        std::unique_lock<std::mutex> lock(writerMutex_);
+        const auto ready = [&] { return submittedBatches_ > written || writerStopping_; };
+        if (!commits.empty()) {
+          // writes in flight, completions are awaited instead
+        } else if (groupCommit && unsyncedBytes_ > 0) {
+          writerCondition_.wait_until(lock, groupCommitDeadline, ready);
+        } else {
+          writerCondition_.wait(lock, ready);
         }
-
-        const auto adjustmentType = common::BalanceAdjustmentTypeFromCode(adjustmentTypeCode);
-
-        api->BalanceAdjustmentReplay(serviceFlags, eventsGroup, timestampNs, uid, transactionId,
-                                     currency, amount, adjustmentType);
-
-      } else if (cmdType == common::cmd::OrderCommandType::ADD_USER) {
-        // Match Java: api.createUser(serviceFlags, eventsGroup, timestampNs,
-        // uid);
-        int64_t uid;
-        if (!is.read(reinterpret_cast<char*>(&uid), sizeof(int64_t))) {
-          break;
+        submitted = submittedBatches_;
+        if (submitted == written && commits.empty() && writerStopping_) {
+          lock.unlock();
+          SyncJournalFile();
+          return;
         }
+      }
 
-        api->CreateUserReplay(serviceFlags, eventsGroup, timestampNs, uid);
-
-      } else if (cmdType == common::cmd::OrderCommandType::SUSPEND_USER) {
-        // Match Java: api.suspendUser(serviceFlags, eventsGroup, timestampNs,
-        // uid);
-        int64_t uid;
-        if (!is.read(reinterpret_cast<char*>(&uid), sizeof(int64_t))) {
-          break;
+      if (submitted > written) {
+        // all submitted batches are copied into staging buffers (and released),
+        // padded to block boundary once and written together
+        const bool wasSynced = unsyncedBytes_ == 0;
+        int64_t lastDSeq = -1;
+        while (written < submitted) {
+          auto& batch = writeBatches_[written % static_cast<int64_t>(writeBatches_.size())];
+          lastDSeq = std::max(lastDSeq, batch.lastDSeq);
+          WriteBatch(batch);
+          writtenBatches_.store(++written, std::memory_order_release);
         }
-
-        api->SuspendUserReplay(serviceFlags, eventsGroup, timestampNs, uid);
-
-      } else if (cmdType == common::cmd::OrderCommandType::RESUME_USER) {
-        // Match Java: api.resumeUser(serviceFlags, eventsGroup, timestampNs,
-        // uid);
-        int64_t uid;
-        if (!is.read(reinterpret_cast<char*>(&uid), sizeof(int64_t))) {
-          break;
+        FlushJournalData();
+        commits.emplace_back(ioUring_->SubmittedTicket(), lastDSeq);
+        if (wasSynced && unsyncedBytes_ > 0) {
+          groupCommitDeadline = Clock::now() + groupCommitInterval;
         }
+      } else if (!commits.empty()) {
+        ioUring_->Reap(true);
+      }
 
-        api->ResumeUserReplay(serviceFlags, eventsGroup, timestampNs, uid);
+      if (groupCommit
+          && (unsyncedBytes_ >= groupCommitMaxBytes_ || Clock::now() >= groupCommitDeadline)) {
+        SyncJournalFile();  // waits for all writes
+      }
+      ioUring_->Reap(false);
+      while (!commits.empty() && commits.front().first <= ioUring_->CompletedTicket()) {
+        completedDSeq = std::max(completedDSeq, commits.front().second);
+        commits.pop_front();
+      }
+      // results follow write completions (GROUP_COMMIT: synced ones)
+      if (!groupCommit || unsyncedBytes_ == 0) {
+        durableDSeq_.store(completedDSeq, std::memory_order_release);
+      }
+    }
+  } catch (...) {
+    LOG_ERROR("Journal writer failed, journal is not written after seq={}", lastWrittenSeq_);
+    writerError_ = std::current_exception();
+    writerFailed_.store(true, std::memory_order_release);
+  }
+}
 
-      } else if (cmdType == common::cmd::OrderCommandType::BINARY_DATA_COMMAND) {
-        // Match Java: api.binaryData(serviceFlags, eventsGroup, timestampNs,
-        // lastFlag, word0, word1, word2, word3, word4);
-        int8_t lastFlag;
-        int64_t word0, word1, word2, word3, word4;
-        if (!is.read(reinterpret_cast<char*>(&lastFlag), 1)
-            || !is.read(reinterpret_cast<char*>(&word0), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&word1), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&word2), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&word3), sizeof(int64_t))
-            || !is.read(reinterpret_cast<char*>(&word4), sizeof(int64_t))) {
-          break;
-        }
+void DiskSerializationProcessor::WriteBatch(JournalWriteBatch& batch) {
+  if (retainedJournalFile_ && IsSnapshotStored(retainedUntilSnapshotId_)) {
+    ReleaseRetainedJournalFile();
+  }
 
-        api->BinaryData(serviceFlags, eventsGroup, timestampNs, lastFlag, word0, word1, word2,
-                        word3, word4);
+  if (batch.length > 0 || !batch.payloadRecord.empty()) {
+    if (!journalFile_) {
+      StartNewFile(batch.firstTimestampNs);
+    }
+    if (journalIndexFile_
+        && (writtenBytes_ == 0 || writtenBytes_ - lastIndexedBytes_ >= journalIndexInterval_)) {
+      JournalIndex::Append(*journalIndexFile_,
+                           {batch.firstSeq, batch.firstTimestampNs, writtenBytes_});
+      journalIndexFile_->flush();
+      lastIndexedBytes_ = writtenBytes_;
+    }
 
-      } else if (cmdType == common::cmd::OrderCommandType::RESET) {
-        // Match Java: api.reset(timestampNs);
-        api->ResetReplay(timestampNs);
+    const bool compress = batch.length >= static_cast<size_t>(journalBatchCompressThreshold_);
+    if (!batch.payloadRecord.empty()) {
+      // Binary command payload record, encoded by journaling handler
+      WriteJournalData(batch.payloadRecord.data(), batch.payloadRecord.size());
+      writtenBytes_ += batch.payloadRecord.size();
+      unsyncedBytes_ += batch.payloadRecord.size();
+    } else if (!compress && !compactJournal_ && !journalChecksums_) {
+      // Uncompressed write for single messages or small batches
+      WriteJournalData(batch.buffer.data(), batch.length);
+      writtenBytes_ += batch.length;
+      unsyncedBytes_ += batch.length;
+    } else {
+      // Block: marker, stored size, original size (0 if not compressed),
+      // [CRC32C of preceding header fields and data], data.
+      // Without checksums v1 records are only written as compressed blocks,
+      // v2 records always form a block, as they can not be decoded without
+      // block start.
+      const int originalLength = static_cast<int>(batch.length);
+      const char* blockData = batch.buffer.data();
+      int storedSize = originalLength;
+      int32_t storedOriginalLength = 0;
+      if (compress) {
+        const int compressedSize =
+          LZ4_compress_default(batch.buffer.data(), lz4WriteBuffer_.data(), originalLength,
+                               static_cast<int>(lz4WriteBuffer_.size()));
+        if (compressedSize <= 0) {
+          throw std::runtime_error("Journal block compression failed");
+        }
+        // varint records are dense, v2 block is kept compressed only if it
+        // saves at least 1/8 (otherwise decompression is not worth it)
+        if (!compactJournal_ || compressedSize < originalLength - originalLength / 8) {
+          storedSize = compressedSize;
+          blockData = lz4WriteBuffer_.data();
+          storedOriginalLength = originalLength;
+        }
+      }
 
-      } else {
-        LOG_WARN("Unexpected command type in journal replay: {}", static_cast<int>(cmdByte));
-        throw std::runtime_error("Unexpected command type in journal replay");
+      using common::cmd::OrderCommandType;
+      const auto marker = static_cast<int8_t>(
+        journalChecksums_
+          ? (compactJournal_ ? OrderCommandType::RESERVED_COMPACT_CHECKED
+                             : OrderCommandType::RESERVED_COMPRESSED_CHECKED)
+          : (compactJournal_ ? OrderCommandType::RESERVED_COMPACT
+                             : OrderCommandType::RESERVED_COMPRESSED));
+      char header[13];  // 1 + 4 + 4 [+ 4]
+      header[0] = static_cast<char>(marker);
+      std::memcpy(header + 1, &storedSize, sizeof(int32_t));
+      std::memcpy(header + 5, &storedOriginalLength, sizeof(int32_t));
+      int headerSize = 9;
+      if (journalChecksums_) {
+        const uint32_t crc =
+          utils::Crc32c::Compute(blockData, storedSize, utils::Crc32c::Compute(header, 9));
+        std::memcpy(header + 9, &crc, sizeof(uint32_t));
+        headerSize = 13;
       }
+      WriteJournalData(header, headerSize);
+      WriteJournalData(blockData, storedSize);
+      writtenBytes_ += storedSize + headerSize;
+      unsyncedBytes_ += storedSize + headerSize;
+    }
+    lastWrittenSeq_ = batch.lastSeq;
+  }
+
+  if (batch.nextSnapshot != nullptr) {
+    // Next journal files are based on new snapshot, previous snapshot journal
+    // is continued until new snapshot is stored (or even later one, if it fails)
+    if (!retainedJournalFile_) {
+      RetainJournalFile();
     }
+    retainedUntilSnapshotId_ = batch.nextSnapshot->snapshotId;
+    journalSnapshotDescriptor_ = batch.nextSnapshot;
+    baseSnapshotId_ = batch.nextSnapshot->snapshotId;
+    filesCounter_ = 0;
+  }
+
+  if (batch.forceStartNextFile || writtenBytes_ >= journalFileMaxSize_) {
+    StartNewFile(batch.lastTimestampNs);
+    writtenBytes_ = 0;
+  }
+
+  batch.length = 0;
+  batch.forceStartNextFile = false;
+  batch.nextSnapshot = nullptr;
+  // large payloads are not kept by batches
+  if (batch.payloadRecord.capacity() > batch.buffer.size()) {
+    std::vector<char>().swap(batch.payloadRecord);
+  } else {
+    batch.payloadRecord.clear();
   }
 }
 
-void DiskSerializationProcessor::ReplayJournalFullAndThenEnableJouraling(
-  const common::config::InitialStateConfiguration* initialStateConfiguration,
-  IExchangeApi* api) {
-  int64_t seq = ReplayJournalFull(initialStateConfiguration, api);
-  EnableJournaling(seq, api);
+void DiskSerializationProcessor::WriteJournalData(const char* data, size_t length) {
+  journalFile_->Write(data, length);
+  if (retainedJournalFile_) {
+    retainedJournalFile_->Write(data, length);
+  }
 }
 
-bool DiskSerializationProcessor::CheckSnapshotExists(int64_t snapshotId,
-                                                     SerializedModuleType type,
-                                                     int32_t instanceId) {
-  const std::string path = GetSnapshotPath(snapshotId, type, instanceId);
-  const bool exists = std::filesystem::exists(path);
-  LOG_INFO("Checking snapshot file {} exists:{}", path, exists);
-  return exists;
+void DiskSerializationProcessor::FlushJournalData() {
+  if (journalFile_) {
+    journalFile_->Flush();
+  }
+  if (retainedJournalFile_) {
+    retainedJournalFile_->Flush();
+  }
 }
 
-void DiskSerializationProcessor::FlushBufferSync(bool forceStartNextFile, int64_t timestampNs) {
-  if (journalWriteBufferPos_ < static_cast<size_t>(journalBatchCompressThreshold_)) {
-    // Uncompressed write for single messages or small batches
-    writtenBytes_ += journalWriteBufferPos_;
-    if (journalFile_ && journalFile_->is_open()) {
-      journalFile_->write(journalWriteBuffer_.data(), journalWriteBufferPos_);
-      journalFile_->flush();
+void DiskSerializationProcessor::RetainJournalFile() {
+  if (!journalFile_) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(journalMutex_);
+    if (lastJournalDescriptor_) {
+      lastJournalDescriptor_->seqLast = lastWrittenSeq_;
     }
-    journalWriteBufferPos_ = 0;
-  } else {
-    // Compressed write for bigger batches
-    const int originalLength = static_cast<int>(journalWriteBufferPos_);
-    const int maxCompressedSize = LZ4_compressBound(originalLength);
-    std::vector<char> compressed(maxCompressedSize);
-    const int compressedSize = LZ4_compress_default(journalWriteBuffer_.data(), compressed.data(),
-                                                    originalLength, maxCompressedSize);
-
-    if (compressedSize > 0 && journalFile_ && journalFile_->is_open()) {
-      // Write compressed block marker
-      const int8_t compressedMarker =
-        static_cast<int8_t>(common::cmd::OrderCommandType::RESERVED_COMPRESSED);
-      journalFile_->write(reinterpret_cast<const char*>(&compressedMarker), 1);
-      journalFile_->write(reinterpret_cast<const char*>(&compressedSize), sizeof(int32_t));
-      journalFile_->write(reinterpret_cast<const char*>(&originalLength), sizeof(int32_t));
-      journalFile_->write(compressed.data(), compressedSize);
-      journalFile_->flush();
-      writtenBytes_ += compressedSize + 9;  // 1 + 4 + 4
-    }
-    journalWriteBufferPos_ = 0;
-  }
-
-  if (forceStartNextFile || writtenBytes_ >= journalFileMaxSize_) {
-    StartNewFile(timestampNs);
-    writtenBytes_ = 0;
   }
+  // not indexed anymore, index entries are only hints for replay
+  retainedJournalFile_ = std::move(journalFile_);
+}
+
+void DiskSerializationProcessor::ReleaseRetainedJournalFile() {
+  if (durabilityMode_ != DurabilityMode::NONE && !retainedJournalFile_->Sync()) {
+    throw std::runtime_error("Journal file sync failed");
+  }
+  retainedJournalFile_->Close();
+  retainedJournalFile_.reset();
+  LOG_DEBUG("Snapshot {} is stored, previous snapshot journal is closed",
+            retainedUntilSnapshotId_);
+  std::lock_guard<std::mutex> lock(journalMutex_);
+  storedSnapshotModules_.erase(retainedUntilSnapshotId_);
+}
+
+bool DiskSerializationProcessor::IsSnapshotStored(int64_t snapshotId) {
+  std::lock_guard<std::mutex> lock(journalMutex_);
+  const auto it = storedSnapshotModules_.find(snapshotId);
+  return it != storedSnapshotModules_.end()
+         && it->second >= matchingEnginesNum_ + riskEnginesNum_;
 }
 
 void DiskSerializationProcessor::StartNewFile(int64_t timestampNs) {
   filesCounter_++;
-  if (journalFile_ && journalFile_->is_open()) {
+  if (journalFile_) {
     // Update seqLast for previous journal descriptor before closing
     // Match Java: seqLast is the last sequence number written to this journal
-    if (lastJournalDescriptor_) {
-      lastJournalDescriptor_->seqLast = lastWrittenSeq_;
+    {
+      std::lock_guard<std::mutex> lock(journalMutex_);
+      if (lastJournalDescriptor_) {
+        lastJournalDescriptor_->seqLast = lastWrittenSeq_;
+      }
+    }
+    if (durabilityMode_ != DurabilityMode::NONE) {
+      SyncJournalFile();
     }
-    journalFile_->close();
+    journalFile_->Close();
+    journalFile_.reset();
   }
+  journalIndexFile_.reset();
 
   const std::string fileName = GetJournalPath(baseSnapshotId_, filesCounter_);
   if (std::filesystem::exists(fileName)) {
     throw std::runtime_error("File already exists: " + fileName);
   }
 
-  journalFile_ =
-    std::make_unique<std::fstream>(fileName, std::ios::binary | std::ios::out | std::ios::trunc);
-  if (!journalFile_->is_open()) {
-    throw std::runtime_error("Can not open journal file: " + fileName);
+  const int64_t preallocateSize =
+    asyncWriter_ ? journalFileMaxSize_ + static_cast<int64_t>(writeBatches_[0].buffer.size()) : 0;
+  if (ioUring_) {
+    journalFile_ = std::make_unique<DirectJournalFile>(
+      fileName, ioUring_.get(), writeBatches_[0].buffer.size(),
+      durabilityMode_ == DurabilityMode::SYNC_EACH_BATCH, preallocateSize);
+  } else {
+    journalFile_ = std::make_unique<StreamJournalFile>(
+      fileName, asyncWriter_ || durabilityMode_ != DurabilityMode::NONE, preallocateSize);
   }
 
+  if (journalIndexInterval_ > 0) {
+    const std::string indexName = GetJournalIndexPath(baseSnapshotId_, filesCounter_);
+    journalIndexFile_ = std::make_unique<std::ofstream>(
+      indexName, std::ios::binary | std::ios::out | std::ios::trunc);
+    if (!journalIndexFile_->is_open()) {
+      LOG_WARN("Can not open journal index file: {}, journal is not indexed", indexName);
+      journalIndexFile_.reset();
+    }
+  }
+  lastIndexedBytes_ = 0;
+
   // Register new journal (matches Java: registerNextJournal(baseSnapshotId,
   // timestampNs))
   // Note: Java version uses baseSnapshotId as seq parameter, which represents
   // the starting sequence for this journal
+  std::lock_guard<std::mutex> lock(journalMutex_);
   RegisterNextJournal(baseSnapshotId_, timestampNs);
 }
 
+void DiskSerializationProcessor::SyncJournalFile() {
+  if (unsyncedBytes_ == 0 || !journalFile_) {
+    return;
+  }
+  FlushJournalData();
+  if (!journalFile_->Sync() || (retainedJournalFile_ && !retainedJournalFile_->Sync())) {
+    throw std::runtime_error("Journal file sync failed");
+  }
+  unsyncedBytes_ = 0;
+}
+
 void DiskSerializationProcessor::RegisterNextJournal(int64_t seq, int64_t timestampNs) {
   // Create new JournalDescriptor and add to linked list
   lastJournalDescriptor_ =
-    new JournalDescriptor(timestampNs, seq, lastSnapshotDescriptor_, lastJournalDescriptor_);
+    new JournalDescriptor(timestampNs, seq, journalSnapshotDescriptor_, lastJournalDescriptor_);
 
   // Add journal to snapshot's journals map
-  if (lastSnapshotDescriptor_) {
-    lastSnapshotDescriptor_->journals[seq] = lastJournalDescriptor_;
+  if (journalSnapshotDescriptor_) {
+    journalSnapshotDescriptor_->journals[seq] = lastJournalDescriptor_;
   }
 }
 
@@ -0,0 +1,286 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/common/cmd/OrderCommandType.h>
+#include <exchange/core/processors/journaling/JournalFile.h>
+#include <exchange/core/utils/Crc32c.h>
+#include <exchange/core/utils/Logger.h>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace exchange::core::processors::journaling {
+
+namespace {
+
+// marker(1) + record length(4) + CRC32C(4) of marker and length
+constexpr int64_t PADDING_HEADER_SIZE = 9;
+
+/**
+ * Second descriptor of journal file for preallocation and data sync
+ * (-1 if not supported by platform)
+ */
+int OpenJournalFd(const std::string& fileName) {
+#ifdef _WIN32
+  (void)fileName;
+  return -1;
+#else
+  const int fd = ::open(fileName.c_str(), O_WRONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Can not open journal file: " + fileName);
+  }
+  return fd;
+#endif
+}
+
+void CloseJournalFd(int& fd) {
+#ifndef _WIN32
+  if (fd >= 0) {
+    ::close(fd);
+  }
+#endif
+  fd = -1;
+}
+
+/**
+ * Reserve disk blocks for journal file without changing its size, so that
+ * appending writes do not allocate blocks (best effort, Linux only)
+ */
+void PreallocateJournalFile(int fd, int64_t size) {
+#ifdef __linux__
+  if (fd >= 0 && size > 0 && ::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, size) != 0) {
+    LOG_DEBUG("Journal file preallocation is not supported");
+  }
+#else
+  (void)fd;
+  (void)size;
+#endif
+}
+
+/**
+ * Flush written journal data to storage device
+ */
+bool SyncJournalFd(int fd) {
+#if defined(__linux__)
+  return fd < 0 || ::fdatasync(fd) == 0;
+#elif defined(_WIN32)
+  (void)fd;
+  return true;
+#else
+  return fd < 0 || ::fsync(fd) == 0;
+#endif
+}
+
+}  // namespace
+
+StreamJournalFile::StreamJournalFile(const std::string& path,
+                                     bool syncable,
+                                     int64_t preallocateSize)
+  : file_(path, std::ios::binary | std::ios::out | std::ios::trunc) {
+  if (!file_.is_open()) {
+    throw std::runtime_error("Can not open journal file: " + path);
+  }
+  if (syncable) {
+    fd_ = OpenJournalFd(path);
+    PreallocateJournalFile(fd_, preallocateSize);
+  }
+}
+
+StreamJournalFile::~StreamJournalFile() {
+  CloseJournalFd(fd_);
+}
+
+void StreamJournalFile::Write(const char* data, size_t length) {
+  file_.write(data, static_cast<std::streamsize>(length));
+}
+
+void StreamJournalFile::Flush() {
+  file_.flush();
+}
+
+bool StreamJournalFile::Sync() {
+  file_.flush();
+  return SyncJournalFd(fd_);
+}
+
+void StreamJournalFile::Close() {
+  file_.close();
+  CloseJournalFd(fd_);
+}
+
+DirectJournalFile::DirectJournalFile(const std::string& path,
+                                     utils::IoUring* ioUring,
+                                     size_t bufferSize,
+                                     bool dsync,
+                                     int64_t preallocateSize)
+  : path_(path)
+  , ioUring_(ioUring)
+  , bufferSize_(std::max((bufferSize + BLOCK_SIZE - 1) / BLOCK_SIZE, size_t{2}) * BLOCK_SIZE)
+  , dsync_(dsync) {
+#ifdef __linux__
+  fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0666);
+  if (fd_ < 0) {
+    throw std::runtime_error("Can not open journal file with O_DIRECT: " + path + " ("
+                             + std::strerror(errno) + ")");
+  }
+#else
+  throw std::runtime_error("Direct journal I/O is not supported on this platform");
+#endif
+  for (auto& buffer : buffers_) {
+    // extra block: padding header may not fit into the rest of the last block
+    buffer.data.reset(
+      static_cast<char*>(std::aligned_alloc(BLOCK_SIZE, bufferSize_ + BLOCK_SIZE)));
+    if (!buffer.data) {
+      CloseJournalFd(fd_);
+      throw std::bad_alloc();
+    }
+  }
+  PreallocateJournalFile(fd_, preallocateSize);
+}
+
+DirectJournalFile::~DirectJournalFile() {
+  if (fd_ < 0) {
+    return;
+  }
+  try {
+    Close();
+  } catch (const std::exception& ex) {
+    LOG_ERROR("Journal file {} is not completely written: {}", path_, ex.what());
+    // buffers are released only after kernel is done with them
+    for (const auto& buffer : buffers_) {
+      while (ioUring_->CompletedTicket() < buffer.ticket) {
+        try {
+          ioUring_->Reap(true);
+        } catch (const std::exception&) {
+        }
+      }
+    }
+    CloseJournalFd(fd_);
+  }
+}
+
+void DirectJournalFile::Write(const char* data, size_t length) {
+  Append(data, length);
+}
+
+void DirectJournalFile::Flush() {
+  if (flushed_) {
+    return;
+  }
+  flushed_ = true;
+  constexpr auto blockSize = static_cast<int64_t>(BLOCK_SIZE);
+  const size_t tail = filled_ % BLOCK_SIZE;
+  const int64_t dataEnd = offset_ + static_cast<int64_t>(filled_);
+  if (tail == 0 && dataEnd >= end_) {
+    Submit(filled_);
+    SwitchBuffer(0);
+    return;
+  }
+
+  // padding up to block boundary, covering padding of previous flush as well
+  int64_t paddedEnd = std::max((dataEnd + blockSize - 1) / blockSize * blockSize, end_);
+  if (paddedEnd - dataEnd < PADDING_HEADER_SIZE) {
+    paddedEnd += blockSize;
+  }
+  char* const padding = buffers_[current_].data.get() + filled_;
+  padding[0] =
+    static_cast<char>(static_cast<int8_t>(common::cmd::OrderCommandType::RESERVED_PADDING));
+  const auto length = static_cast<int32_t>(paddedEnd - dataEnd);
+  std::memcpy(padding + 1, &length, sizeof(int32_t));
+  const uint32_t crc = utils::Crc32c::Compute(padding, 5);
+  std::memcpy(padding + 5, &crc, sizeof(uint32_t));
+  std::memset(padding + PADDING_HEADER_SIZE, 0, static_cast<size_t>(length - PADDING_HEADER_SIZE));
+
+  Submit(static_cast<size_t>(paddedEnd - offset_));
+  // partial block is written again (without this padding) by the next write
+  SwitchBuffer(tail);
+}
+
+bool DirectJournalFile::Sync() {
+  Flush();
+  AwaitWrites();
+  return SyncJournalFd(fd_);
+}
+
+void DirectJournalFile::Close() {
+  if (fd_ < 0) {
+    return;
+  }
+  Flush();
+  AwaitWrites();
+  CloseJournalFd(fd_);
+}
+
+void DirectJournalFile::Append(const char* data, size_t length) {
+  flushed_ = flushed_ && length == 0;
+  while (length > 0) {
+    auto& buffer = buffers_[current_];
+    if (filled_ == 0) {
+      // previous write from this buffer must be completed
+      ioUring_->Await(buffer.ticket);
+    }
+    const size_t chunk = std::min(length, bufferSize_ - filled_);
+    std::memcpy(buffer.data.get() + filled_, data, chunk);
+    data += chunk;
+    filled_ += chunk;
+    length -= chunk;
+    if (filled_ == bufferSize_) {
+      Submit(filled_);
+      SwitchBuffer(0);
+    }
+  }
+}
+
+void DirectJournalFile::Submit(size_t length) {
+  if (length == 0) {
+    return;
+  }
+  if (offset_ < end_) {
+    // blocks of previous write (padded tail) are rewritten: same offset
+    // writes in flight may complete in any order
+    ioUring_->Await(buffers_[current_ ^ 1].ticket);
+  }
+  // whole number of blocks: buffer is full or data is padded
+  auto& buffer = buffers_[current_];
+  buffer.ticket = ioUring_->SubmitWrite(fd_, buffer.data.get(), static_cast<uint32_t>(length),
+                                        offset_, dsync_);
+  end_ = std::max(end_, offset_ + static_cast<int64_t>(length));
+}
+
+void DirectJournalFile::SwitchBuffer(size_t tail) {
+  // tail bytes of current buffer (partial block) start the other buffer
+  auto& next = buffers_[current_ ^ 1];
+  if (tail > 0) {
+    ioUring_->Await(next.ticket);
+    std::memcpy(next.data.get(), buffers_[current_].data.get() + filled_ - tail, tail);
+  }
+  offset_ += static_cast<int64_t>(filled_ - tail);
+  filled_ = tail;
+  current_ ^= 1;
+}
+
+void DirectJournalFile::AwaitWrites() {
+  ioUring_->Await(std::max(buffers_[0].ticket, buffers_[1].ticket));
+}
+
+}  // namespace exchange::core::processors::journaling
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/processors/journaling/JournalIndex.h>
+#include <fstream>
+
+namespace exchange::core::processors::journaling {
+
+namespace {
+
+bool ReadEntry(std::ifstream& in, int64_t index, JournalIndex::Entry& entry) {
+  int64_t values[3];
+  in.seekg(static_cast<std::streamoff>(index * JournalIndex::ENTRY_SIZE));
+  if (!in.read(reinterpret_cast<char*>(values), sizeof(values))) {
+    return false;
+  }
+  entry.seq = values[0];
+  entry.timestampNs = values[1];
+  entry.offset = values[2];
+  return true;
+}
+
+}  // namespace
+
+void JournalIndex::Append(std::ostream& out, const Entry& entry) {
+  const int64_t values[3] = {entry.seq, entry.timestampNs, entry.offset};
+  out.write(reinterpret_cast<const char*>(values), sizeof(values));
+}
+
+bool JournalIndex::FindFloor(const std::string& path, int64_t seq, Entry& entry) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in.is_open()) {
+    return false;
+  }
+  // partially written last entry is ignored
+  const int64_t entries = static_cast<int64_t>(in.tellg()) / static_cast<int64_t>(ENTRY_SIZE);
+
+  // last entry with sequence <= seq
+  int64_t low = 0;
+  int64_t high = entries - 1;
+  int64_t found = -1;
+  Entry probe;
+  while (low <= high) {
+    const int64_t mid = low + (high - low) / 2;
+    if (!ReadEntry(in, mid, probe)) {
+      return false;
+    }
+    if (probe.seq <= seq) {
+      found = mid;
+      entry = probe;
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+  return found >= 0;
+}
+
+}  // namespace exchange::core::processors::journaling
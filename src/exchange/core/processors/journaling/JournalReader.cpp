@@ -0,0 +1,548 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/common/BalanceAdjustmentType.h>
+#include <exchange/core/common/cmd/OrderCommandType.h>
+#include <exchange/core/processors/journaling/CompactJournalCodec.h>
+#include <exchange/core/processors/journaling/JournalReader.h>
+#include <exchange/core/utils/Crc32c.h>
+#include <exchange/core/utils/Logger.h>
+#include <exchange/core/utils/MappedFile.h>
+#include <lz4.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace exchange::core::processors::journaling {
+
+namespace {
+
+using common::cmd::OrderCommandType;
+
+// cmd(1) + seq(8) + timestamp(8) + serviceFlags(4) + eventsGroup(8)
+constexpr int32_t COMMAND_HEADER_SIZE = 29;
+// block marker(1) + storedSize(4) + originalSize(4)
+constexpr int32_t COMPRESSED_HEADER_SIZE = 9;
+// compressed header + CRC32C(4) of compressed header and stored data
+constexpr int32_t CHECKED_HEADER_SIZE = 13;
+constexpr int32_t MAX_BLOCK_SIZE = 1'000'000;
+// marker(1) + storedSize(4) + originalSize(4) + seq(8) + timestamp(8) + serviceFlags(4)
+// + eventsGroup(8) + transferId(4) + CRC32C(4) of preceding header fields and stored data
+constexpr int32_t PAYLOAD_HEADER_SIZE = 45;
+// marker(1) + record length(4) + CRC32C(4) of marker and length, zeros up to record length
+constexpr int32_t PADDING_HEADER_SIZE = 9;
+
+constexpr int8_t Code(OrderCommandType type) {
+  return static_cast<int8_t>(type);
+}
+
+constexpr bool IsBlockMarker(int8_t code) {
+  return code == Code(OrderCommandType::RESERVED_COMPRESSED)
+         || code == Code(OrderCommandType::RESERVED_COMPACT)
+         || code == Code(OrderCommandType::RESERVED_COMPRESSED_CHECKED)
+         || code == Code(OrderCommandType::RESERVED_COMPACT_CHECKED)
+         || code == Code(OrderCommandType::RESERVED_BINARY_PAYLOAD)
+         || code == Code(OrderCommandType::RESERVED_PADDING);
+}
+
+template <typename T>
+T Read(const char*& p) {
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  p += sizeof(T);
+  return value;
+}
+
+}  // namespace
+
+/**
+ * Part of journal file: run of uncompressed commands or compressed block
+ * (v1 records), block of v2 records (compressed or not), or binary command
+ * payload record
+ */
+struct JournalReader::Block {
+  const char* data;
+  size_t size;
+  int32_t originalSize;  // compressed block only, 0 for uncompressed commands
+  bool compact;          // v2 records
+  const char* payloadHeader = nullptr;  // payload record only, data is the payload
+  std::vector<char> decompressed;
+  // guarded by JournalReader::mutex_
+  bool queued = false;
+  bool done = false;
+  bool failed = false;
+
+  Block(const char* blockData, size_t blockSize, int32_t blockOriginalSize, bool compactRecords)
+    : data(blockData)
+    , size(blockSize)
+    , originalSize(blockOriginalSize)
+    , compact(compactRecords) {}
+
+  bool Decompress() {
+    decompressed.resize(originalSize);
+    return LZ4_decompress_safe(data, decompressed.data(), static_cast<int>(size), originalSize)
+           == originalSize;
+  }
+};
+
+JournalReader::JournalReader(int32_t decompressThreads,
+                             int32_t readAheadBlocks,
+                             int32_t batchSize)
+  : readAheadBlocks_(static_cast<size_t>(std::max(readAheadBlocks, 1)))
+  , batchSize_(static_cast<size_t>(std::max(batchSize, 1))) {
+  for (int32_t i = 0; i < decompressThreads; i++) {
+    workers_.emplace_back([this] { DecompressLoop(); });
+  }
+}
+
+JournalReader::~JournalReader() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  tasksCondition_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+int32_t JournalReader::CommandSize(int8_t cmdCode) {
+  switch (cmdCode) {
+    case Code(OrderCommandType::MOVE_ORDER):
+    case Code(OrderCommandType::REDUCE_ORDER):
+      return COMMAND_HEADER_SIZE + 28;
+    case Code(OrderCommandType::CANCEL_ORDER):
+      return COMMAND_HEADER_SIZE + 20;
+    case Code(OrderCommandType::PLACE_ORDER):
+      return COMMAND_HEADER_SIZE + 49;
+    case Code(OrderCommandType::BALANCE_ADJUSTMENT):
+      return COMMAND_HEADER_SIZE + 29;
+    case Code(OrderCommandType::ADD_USER):
+    case Code(OrderCommandType::SUSPEND_USER):
+    case Code(OrderCommandType::RESUME_USER):
+      return COMMAND_HEADER_SIZE + 8;
+    case Code(OrderCommandType::BINARY_DATA_COMMAND):
+      return COMMAND_HEADER_SIZE + 41;
+    case Code(OrderCommandType::RESET):
+    case Code(OrderCommandType::PERSIST_STATE_MATCHING):
+    case Code(OrderCommandType::PERSIST_STATE_RISK):
+      return COMMAND_HEADER_SIZE;
+    default:
+      return -1;
+  }
+}
+
+bool JournalReader::DecodeCommand(const char* data, JournalCommand& cmd) {
+  const char* p = data;
+  const auto code = Read<int8_t>(p);
+  cmd = JournalCommand{};
+  cmd.command = common::cmd::OrderCommandTypeFromCode(code);
+  cmd.seq = Read<int64_t>(p);
+  cmd.timestamp = Read<int64_t>(p);
+  cmd.serviceFlags = Read<int32_t>(p);
+  cmd.eventsGroup = Read<int64_t>(p);
+
+  switch (cmd.command) {
+    case OrderCommandType::MOVE_ORDER:
+      cmd.uid = Read<int64_t>(p);
+      cmd.symbol = Read<int32_t>(p);
+      cmd.orderId = Read<int64_t>(p);
+      cmd.price = Read<int64_t>(p);
+      return true;
+    case OrderCommandType::CANCEL_ORDER:
+      cmd.uid = Read<int64_t>(p);
+      cmd.symbol = Read<int32_t>(p);
+      cmd.orderId = Read<int64_t>(p);
+      return true;
+    case OrderCommandType::REDUCE_ORDER:
+      cmd.uid = Read<int64_t>(p);
+      cmd.symbol = Read<int32_t>(p);
+      cmd.orderId = Read<int64_t>(p);
+      cmd.size = Read<int64_t>(p);
+      return true;
+    case OrderCommandType::PLACE_ORDER: {
+      cmd.uid = Read<int64_t>(p);
+      cmd.symbol = Read<int32_t>(p);
+      cmd.orderId = Read<int64_t>(p);
+      cmd.price = Read<int64_t>(p);
+      cmd.reserveBidPrice = Read<int64_t>(p);
+      cmd.size = Read<int64_t>(p);
+      cmd.userCookie = Read<int32_t>(p);
+      const auto actionAndType = Read<uint8_t>(p);
+      cmd.action = common::OrderActionFromCode(static_cast<uint8_t>(actionAndType & 0b1));
+      cmd.orderType =
+        common::OrderTypeFromCode(static_cast<uint8_t>((actionAndType >> 1) & 0b1111));
+      return true;
+    }
+    case OrderCommandType::BALANCE_ADJUSTMENT: {
+      cmd.uid = Read<int64_t>(p);
+      cmd.symbol = Read<int32_t>(p);
+      cmd.orderId = Read<int64_t>(p);
+      cmd.price = Read<int64_t>(p);
+      const auto adjustmentType = common::BalanceAdjustmentTypeFromCode(Read<uint8_t>(p));
+      cmd.orderType =
+        common::OrderTypeFromCode(common::BalanceAdjustmentTypeToCode(adjustmentType));
+      return true;
+    }
+    case OrderCommandType::ADD_USER:
+    case OrderCommandType::SUSPEND_USER:
+    case OrderCommandType::RESUME_USER:
+      cmd.uid = Read<int64_t>(p);
+      cmd.orderId = -1;
+      cmd.symbol = -1;
+      return true;
+    case OrderCommandType::BINARY_DATA_COMMAND:
+      cmd.symbol = static_cast<int32_t>(Read<uint8_t>(p));
+      cmd.orderId = Read<int64_t>(p);
+      cmd.price = Read<int64_t>(p);
+      cmd.reserveBidPrice = Read<int64_t>(p);
+      cmd.size = Read<int64_t>(p);
+      cmd.uid = Read<int64_t>(p);
+      return true;
+    case OrderCommandType::RESET:
+      return true;
+    case OrderCommandType::PERSIST_STATE_MATCHING:
+    case OrderCommandType::PERSIST_STATE_RISK:
+      return false;
+    default:
+      throw std::runtime_error("Unexpected command type in journal replay");
+  }
+}
+
+int64_t JournalReader::ReadFile(const std::string& path,
+                                int64_t seqFrom,
+                                int64_t seqTo,
+                                int64_t& lastSeq,
+                                const BatchConsumer& consumer,
+                                int64_t startOffset) {
+  const utils::MappedFile file(path);
+  const char* const data = file.Data();
+  const size_t size = file.Size();
+  damagedAt_ = -1;
+
+  std::deque<std::unique_ptr<Block>> pending;
+  std::vector<JournalCommand> batch;
+  batch.reserve(batchSize_);
+
+  // Blocks can not be released while workers are decompressing them
+  struct PendingGuard {
+    JournalReader* reader;
+    std::deque<std::unique_ptr<Block>>& pending;
+    ~PendingGuard() {
+      std::unique_lock<std::mutex> lock(reader->mutex_);
+      for (auto& block : pending) {
+        if (block->queued) {
+          auto& tasks = reader->tasks_;
+          tasks.erase(std::find(tasks.begin(), tasks.end(), block.get()));
+          block->queued = false;
+          block->done = true;
+        }
+      }
+      reader->doneCondition_.wait(lock, [this] {
+        return std::all_of(pending.begin(), pending.end(), [this](const auto& block) {
+          return block->originalSize == 0 || block->done || reader->workers_.empty();
+        });
+      });
+    }
+  } guard{this, pending};
+
+  const auto flushBatch = [&] {
+    if (!batch.empty()) {
+      consumer(batch.data(), batch.size());
+      batch.clear();
+    }
+  };
+
+  // Hand over decoded command, returns false when seqTo is reached
+  const auto acceptCommand = [&](const JournalCommand& cmd, bool replay) {
+    if (cmd.seq <= seqFrom) {
+      return true;
+    }
+    if (cmd.seq != lastSeq + 1) {
+      LOG_WARN("Sequence gap {}->{} ({})", lastSeq, cmd.seq, cmd.seq - lastSeq);
+    }
+    lastSeq = cmd.seq;
+    if (replay) {
+      batch.push_back(cmd);
+      if (batch.size() >= batchSize_) {
+        flushBatch();
+      }
+    }
+    return cmd.seq < seqTo;
+  };
+
+  // Decode commands of one block, returns false when seqTo is reached
+  const auto decodeCommands = [&](const char* commands, size_t length, bool compact) {
+    const char* p = commands;
+    const char* const end = commands + length;
+    CompactJournalCodec::Deltas deltas;
+    while (p < end) {
+      JournalCommand cmd;
+      bool replay;
+      if (compact) {
+        replay = CompactJournalCodec::DecodeCommand(p, end, deltas, cmd);
+      } else {
+        const int32_t cmdSize = CommandSize(*p);
+        if (cmdSize < 0 || cmdSize > end - p) {
+          throw std::runtime_error("Bad command in journal block (data corrupted)");
+        }
+        replay = DecodeCommand(p, cmd);
+        p += cmdSize;
+      }
+      if (!acceptCommand(cmd, replay)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Single binary command carrying payload, handed over before payload is released
+  const auto decodePayload = [&](const char* header, const char* payload, size_t length) {
+    const char* p = header + 9;
+    JournalCommand cmd;
+    cmd.command = OrderCommandType::BINARY_DATA_COMMAND;
+    cmd.seq = Read<int64_t>(p);
+    cmd.timestamp = Read<int64_t>(p);
+    cmd.serviceFlags = Read<int32_t>(p);
+    cmd.eventsGroup = Read<int64_t>(p);
+    cmd.userCookie = Read<int32_t>(p);
+    cmd.symbol = -1;
+    cmd.payload = reinterpret_cast<const uint8_t*>(payload);
+    cmd.payloadLength = length;
+    const bool next = acceptCommand(cmd, true);
+    flushBatch();
+    return next;
+  };
+
+  const auto decodeFront = [&] {
+    Block* block = pending.front().get();
+    const char* commands = block->data;
+    size_t length = block->size;
+    if (block->originalSize > 0) {
+      if (workers_.empty()) {
+        block->failed = !block->Decompress();
+      } else {
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCondition_.wait(lock, [block] { return block->done; });
+      }
+      if (block->failed) {
+        throw std::runtime_error("LZ4 decompression failed");
+      }
+      commands = block->decompressed.data();
+      length = block->decompressed.size();
+    }
+    const bool next = block->payloadHeader != nullptr
+                        ? decodePayload(block->payloadHeader, commands, length)
+                        : decodeCommands(commands, length, block->compact);
+    pending.pop_front();
+    return next;
+  };
+
+  // Split file into blocks, decoding up to readAheadBlocks behind
+  const size_t startPos = std::min(static_cast<size_t>(std::max<int64_t>(startOffset, 0)), size);
+  size_t pos = startPos;
+  bool more = true;
+  bool truncated = false;
+  bool corrupted = false;
+  bool checkedFile = false;
+  while (more && pos < size) {
+    const int8_t marker = data[pos];
+    const bool checked = marker == Code(OrderCommandType::RESERVED_COMPRESSED_CHECKED)
+                         || marker == Code(OrderCommandType::RESERVED_COMPACT_CHECKED);
+    const bool compact = marker == Code(OrderCommandType::RESERVED_COMPACT)
+                         || marker == Code(OrderCommandType::RESERVED_COMPACT_CHECKED);
+    // binary command payload record is always checksummed, it may follow any block
+    const bool payloadRecord = marker == Code(OrderCommandType::RESERVED_BINARY_PAYLOAD);
+    // padding up to block boundary (direct journal I/O), checksummed, may follow any block
+    const bool padding = marker == Code(OrderCommandType::RESERVED_PADDING);
+    if (checkedFile && !checked && !payloadRecord && !padding) {
+      // checksummed journal contains blocks only: garbage after last valid
+      // block (e.g. zeros of torn write)
+      corrupted = true;
+      break;
+    }
+    if (padding) {
+      if (pos + PADDING_HEADER_SIZE > size) {
+        truncated = true;
+        break;
+      }
+      const char* header = data + pos + 1;
+      const auto length = Read<int32_t>(header);
+      const uint32_t crc = utils::Crc32c::Compute(data + pos, 5);
+      if (crc != Read<uint32_t>(header) || length < PADDING_HEADER_SIZE
+          || length > MAX_BLOCK_SIZE) {
+        corrupted = true;
+        break;
+      }
+      if (pos + length > size) {
+        truncated = true;
+        break;
+      }
+      if (std::any_of(data + pos + PADDING_HEADER_SIZE, data + pos + length,
+                      [](char c) { return c != 0; })) {
+        corrupted = true;
+        break;
+      }
+      pos += length;
+    } else if (payloadRecord) {
+      if (pos + PAYLOAD_HEADER_SIZE > size) {
+        truncated = true;
+        break;
+      }
+      const char* header = data + pos + 1;
+      const auto storedSize = Read<int32_t>(header);
+      const auto originalSize = Read<int32_t>(header);
+      if (storedSize <= 0 || originalSize < 0) {
+        corrupted = true;
+        break;
+      }
+      if (pos + PAYLOAD_HEADER_SIZE + storedSize > size) {
+        truncated = true;
+        break;
+      }
+      const char* const payload = data + pos + PAYLOAD_HEADER_SIZE;
+      uint32_t storedCrc;
+      std::memcpy(&storedCrc, payload - sizeof(uint32_t), sizeof(uint32_t));
+      const uint32_t crc = utils::Crc32c::Compute(
+        payload, storedSize, utils::Crc32c::Compute(data + pos, PAYLOAD_HEADER_SIZE - 4));
+      if (crc != storedCrc) {
+        corrupted = true;
+        break;
+      }
+      pending.push_back(std::make_unique<Block>(payload, storedSize, originalSize, false));
+      pending.back()->payloadHeader = data + pos;
+      if (originalSize > 0) {
+        Submit(pending.back().get());
+      }
+      pos += PAYLOAD_HEADER_SIZE + storedSize;
+    } else if (checked || compact || marker == Code(OrderCommandType::RESERVED_COMPRESSED)) {
+      const int32_t headerSize = checked ? CHECKED_HEADER_SIZE : COMPRESSED_HEADER_SIZE;
+      if (pos + headerSize > size) {
+        truncated = true;
+        break;
+      }
+      const char* header = data + pos + 1;
+      const auto storedSize = Read<int32_t>(header);
+      const auto originalSize = Read<int32_t>(header);
+      // v2 and checksummed blocks are stored uncompressed when originalSize is 0
+      if (storedSize <= 0 || originalSize < (compact || checked ? 0 : 1)
+          || storedSize > MAX_BLOCK_SIZE || originalSize > MAX_BLOCK_SIZE) {
+        if (checked) {
+          corrupted = true;
+          break;
+        }
+        throw std::runtime_error("Bad compressed block size (data corrupted)");
+      }
+      if (pos + headerSize + storedSize > size) {
+        truncated = true;
+        break;
+      }
+      if (checked) {
+        const uint32_t crc = utils::Crc32c::Compute(
+          data + pos + CHECKED_HEADER_SIZE, storedSize,
+          utils::Crc32c::Compute(data + pos, COMPRESSED_HEADER_SIZE));
+        if (crc != Read<uint32_t>(header)) {
+          corrupted = true;
+          break;
+        }
+        checkedFile = true;
+      }
+      pending.push_back(
+        std::make_unique<Block>(data + pos + headerSize, storedSize, originalSize, compact));
+      if (originalSize > 0) {
+        Submit(pending.back().get());
+      }
+      pos += headerSize + storedSize;
+    } else {
+      // Run of uncompressed commands up to next block
+      const size_t start = pos;
+      while (pos < size && !IsBlockMarker(data[pos])) {
+        const int32_t cmdSize = CommandSize(data[pos]);
+        if (cmdSize < 0) {
+          LOG_WARN("Unexpected command type in journal replay: {}", static_cast<int>(data[pos]));
+          throw std::runtime_error("Unexpected command type in journal replay");
+        }
+        if (pos + cmdSize > size) {
+          truncated = true;
+          break;
+        }
+        pos += cmdSize;
+      }
+      if (pos > start) {
+        pending.push_back(std::make_unique<Block>(data + start, pos - start, 0, false));
+      }
+      if (truncated) {
+        break;
+      }
+    }
+
+    while (more && pending.size() >= readAheadBlocks_) {
+      more = decodeFront();
+    }
+  }
+
+  while (more && !pending.empty()) {
+    more = decodeFront();
+  }
+  flushBatch();
+
+  if (truncated || corrupted) {
+    damagedAt_ = static_cast<int64_t>(pos);
+    LOG_WARN("Journal file {} is {} at {} of {} bytes", path,
+             truncated ? "truncated" : "corrupted", pos, size);
+  }
+  return static_cast<int64_t>(pos - startPos);
+}
+
+void JournalReader::Submit(Block* block) {
+  if (workers_.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    block->queued = true;
+    tasks_.push_back(block);
+  }
+  tasksCondition_.notify_one();
+}
+
+void JournalReader::DecompressLoop() {
+  while (true) {
+    Block* block;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      tasksCondition_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      block = tasks_.front();
+      tasks_.pop_front();
+      block->queued = false;
+    }
+
+    const bool ok = block->Decompress();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      block->done = true;
+      block->failed = !ok;
+    }
+    doneCondition_.notify_all();
+  }
+}
+
+}  // namespace exchange::core::processors::journaling
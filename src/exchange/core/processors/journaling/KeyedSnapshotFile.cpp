@@ -0,0 +1,205 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/common/VectorBytesOut.h>
+#include <exchange/core/processors/journaling/KeyedSnapshotFile.h>
+#include <exchange/core/processors/journaling/Lz4FrameBytesIn.h>
+#include <exchange/core/processors/journaling/Lz4FrameBytesOut.h>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+namespace exchange::core::processors::journaling {
+
+namespace {
+
+/**
+ * Sequential reader of one keyed snapshot file
+ */
+class KeyedSnapshotReader {
+public:
+  KeyedSnapshotReader(const std::string& path, int32_t chunkSize) : in_(path, chunkSize) {
+    if (in_.ReadLong() != KeyedSnapshotFile::MAGIC) {
+      throw std::runtime_error("Not a keyed snapshot file: " + path);
+    }
+    baseSnapshotId_ = in_.ReadLong();
+    ReadBytes(in_.ReadInt(), globalState_);
+  }
+
+  int64_t BaseSnapshotId() const {
+    return baseSnapshotId_;
+  }
+
+  const std::vector<uint8_t>& GlobalState() const {
+    return globalState_;
+  }
+
+  /**
+   * Read next entry, state is not changed for removed entry
+   * @return false at the end mark
+   */
+  bool Next(int64_t& key, bool& removed, std::vector<uint8_t>& state) {
+    key = in_.ReadLong();
+    const int32_t length = in_.ReadInt();
+    if (length == KeyedSnapshotFile::END_MARK) {
+      return false;
+    }
+    removed = (length == SnapshotEntriesWriter::REMOVED_ENTRY);
+    if (!removed) {
+      ReadBytes(length, state);
+    }
+    return true;
+  }
+
+private:
+  void ReadBytes(int32_t length, std::vector<uint8_t>& bytes) {
+    if (length < 0) {
+      throw std::runtime_error("Keyed snapshot is corrupted: negative length");
+    }
+    bytes.resize(static_cast<size_t>(length));
+    if (length > 0) {
+      in_.Read(bytes.data(), bytes.size());
+    }
+  }
+
+  Lz4FrameBytesIn in_;
+  int64_t baseSnapshotId_ = KeyedSnapshotFile::FULL_SNAPSHOT;
+  std::vector<uint8_t> globalState_;
+};
+
+void WriteHeader(common::BytesOut& bytes,
+                 int64_t baseSnapshotId,
+                 const std::vector<uint8_t>& globalState,
+                 size_t globalStateLength) {
+  bytes.WriteLong(KeyedSnapshotFile::MAGIC);
+  bytes.WriteLong(baseSnapshotId);
+  bytes.WriteInt(static_cast<int32_t>(globalStateLength));
+  bytes.Write(globalState.data(), globalStateLength);
+}
+
+void WriteEndMark(common::BytesOut& bytes) {
+  bytes.WriteLong(0);
+  bytes.WriteInt(KeyedSnapshotFile::END_MARK);
+}
+
+}  // namespace
+
+int64_t KeyedSnapshotFile::Write(const std::string& path,
+                                 int32_t chunkSize,
+                                 int64_t baseSnapshotId,
+                                 const IIncrementalSnapshotState& state) {
+  std::vector<uint8_t> globalState;
+  common::VectorBytesOut globalBytes(globalState);
+  state.WriteGlobalState(globalBytes);
+
+  Lz4FrameBytesOut bytesOut(path, chunkSize);
+  WriteHeader(bytesOut, baseSnapshotId, globalState, globalBytes.GetPosition());
+  SnapshotEntriesWriter writer(bytesOut);
+  state.WriteEntries(writer, baseSnapshotId != FULL_SNAPSHOT);
+  WriteEndMark(bytesOut);
+  bytesOut.Finish();
+  return writer.EntriesCount();
+}
+
+bool KeyedSnapshotFile::IsKeyedSnapshot(const std::string& path) {
+  uint32_t frameMagic = 0;
+  {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.read(reinterpret_cast<char*>(&frameMagic), sizeof(frameMagic))
+        || frameMagic != Lz4FrameBytesIn::FRAME_MAGIC) {
+      return false;
+    }
+  }
+  try {
+    Lz4FrameBytesIn bytesIn(path, 4096);
+    return bytesIn.ReadLong() == MAGIC;
+  } catch (const std::exception&) {
+    return false;  // plain snapshot shorter than magic
+  }
+}
+
+int32_t KeyedSnapshotFile::ReadChain(int64_t snapshotId,
+                                     const PathResolver& pathResolver,
+                                     int32_t chunkSize,
+                                     const GlobalStateConsumer& globalConsumer,
+                                     const EntryConsumer& entryConsumer) {
+  // Entries of incremental snapshots, latest version wins (nullopt - removed)
+  std::map<int64_t, std::optional<std::vector<uint8_t>>> changedEntries;
+  std::vector<uint8_t> state;
+  int64_t key = 0;
+  bool removed = false;
+
+  auto reader = std::make_unique<KeyedSnapshotReader>(pathResolver(snapshotId), chunkSize);
+  globalConsumer(reader->GlobalState());
+
+  int32_t files = 1;
+  while (reader->BaseSnapshotId() != FULL_SNAPSHOT) {
+    while (reader->Next(key, removed, state)) {
+      if (changedEntries.find(key) == changedEntries.end()) {
+        changedEntries.emplace(key, removed ? std::nullopt : std::make_optional(state));
+      }
+    }
+    const int64_t baseSnapshotId = reader->BaseSnapshotId();
+    reader.reset();
+    reader = std::make_unique<KeyedSnapshotReader>(pathResolver(baseSnapshotId), chunkSize);
+    files++;
+  }
+
+  // Full snapshot is streamed, entries replaced by later snapshots are skipped
+  while (reader->Next(key, removed, state)) {
+    if (changedEntries.find(key) == changedEntries.end()) {
+      entryConsumer(key, state);
+    }
+  }
+  for (const auto& [changedKey, changedState] : changedEntries) {
+    if (changedState.has_value()) {
+      entryConsumer(changedKey, *changedState);
+    }
+  }
+  return files;
+}
+
+void KeyedSnapshotFile::Compact(int64_t snapshotId,
+                                const PathResolver& pathResolver,
+                                int32_t chunkSize,
+                                const std::string& path) {
+  // Written into temporary file, chain files (including path) stay readable
+  const std::string tmpPath = path + ".tmp";
+  {
+    Lz4FrameBytesOut bytesOut(tmpPath, chunkSize);
+    ReadChain(
+      snapshotId, pathResolver, chunkSize,
+      [&bytesOut](const std::vector<uint8_t>& globalState) {
+        WriteHeader(bytesOut, FULL_SNAPSHOT, globalState, globalState.size());
+      },
+      [&bytesOut](int64_t key, const std::vector<uint8_t>& state) {
+        bytesOut.WriteLong(key);
+        bytesOut.WriteInt(static_cast<int32_t>(state.size()));
+        bytesOut.Write(state.data(), state.size());
+      });
+    WriteEndMark(bytesOut);
+    bytesOut.Finish();
+  }
+  if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    std::remove(tmpPath.c_str());
+    throw std::runtime_error("Can not replace snapshot file: " + path);
+  }
+}
+
+}  // namespace exchange::core::processors::journaling
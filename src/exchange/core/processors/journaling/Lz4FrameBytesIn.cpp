@@ -0,0 +1,91 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/processors/journaling/Lz4FrameBytesIn.h>
+#include <lz4frame.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace exchange::core::processors::journaling {
+
+Lz4FrameBytesIn::Lz4FrameBytesIn(const std::string& path, int32_t chunkSize)
+  : file_(path, std::ios::binary)
+  , in_(static_cast<size_t>(std::max(chunkSize, 4096)))
+  , out_(static_cast<size_t>(std::max(chunkSize, 4096))) {
+  if (!file_.is_open()) {
+    throw std::runtime_error("Can not open snapshot file: " + path);
+  }
+  LZ4F_dctx* context = nullptr;
+  const size_t result = LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+  if (LZ4F_isError(result)) {
+    throw std::runtime_error(std::string("LZ4F_createDecompressionContext failed: ")
+                             + LZ4F_getErrorName(result));
+  }
+  context_ = context;
+}
+
+Lz4FrameBytesIn::~Lz4FrameBytesIn() {
+  if (context_ != nullptr) {
+    LZ4F_freeDecompressionContext(context_);
+  }
+}
+
+void Lz4FrameBytesIn::Read(void* buffer, size_t length) {
+  char* dst = static_cast<char*>(buffer);
+  while (length > 0) {
+    if (outPosition_ == outLength_) {
+      Decompress();
+    }
+    const size_t n = std::min(length, outLength_ - outPosition_);
+    std::memcpy(dst, out_.data() + outPosition_, n);
+    outPosition_ += n;
+    dst += n;
+    length -= n;
+  }
+}
+
+void Lz4FrameBytesIn::Decompress() {
+  outPosition_ = 0;
+  outLength_ = 0;
+  while (outLength_ == 0) {
+    if (frameEnd_) {
+      throw std::runtime_error("Lz4FrameBytesIn: Read beyond end of data");
+    }
+    if (inPosition_ == inLength_) {
+      file_.read(in_.data(), static_cast<std::streamsize>(in_.size()));
+      inLength_ = static_cast<size_t>(file_.gcount());
+      inPosition_ = 0;
+      if (inLength_ == 0) {
+        throw std::runtime_error("Snapshot file is truncated");
+      }
+    }
+
+    size_t dstSize = out_.size();
+    size_t srcSize = inLength_ - inPosition_;
+    const size_t result = LZ4F_decompress(context_, out_.data(), &dstSize,
+                                          in_.data() + inPosition_, &srcSize, nullptr);
+    if (LZ4F_isError(result)) {
+      throw std::runtime_error(std::string("LZ4 decompression failed: ")
+                               + LZ4F_getErrorName(result));
+    }
+    inPosition_ += srcSize;
+    outLength_ = dstSize;
+    // 0 - frame is fully decoded (and content checksum verified)
+    frameEnd_ = result == 0;
+  }
+}
+
+}  // namespace exchange::core::processors::journaling
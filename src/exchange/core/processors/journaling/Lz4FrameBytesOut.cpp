@@ -0,0 +1,122 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/processors/journaling/Lz4FrameBytesOut.h>
+#include <lz4frame.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace exchange::core::processors::journaling {
+
+namespace {
+
+LZ4F_preferences_t FramePreferences() {
+  LZ4F_preferences_t prefs{};
+  prefs.frameInfo.blockSizeID = LZ4F_max4MB;
+  prefs.frameInfo.blockMode = LZ4F_blockIndependent;
+  prefs.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+  // every chunk is checksummed (verified before it is decompressed)
+  prefs.frameInfo.blockChecksumFlag = LZ4F_blockChecksumEnabled;
+  prefs.autoFlush = 1;
+  return prefs;
+}
+
+size_t CheckLz4(size_t result, const char* operation) {
+  if (LZ4F_isError(result)) {
+    throw std::runtime_error(std::string(operation) + " failed: " + LZ4F_getErrorName(result));
+  }
+  return result;
+}
+
+}  // namespace
+
+Lz4FrameBytesOut::Lz4FrameBytesOut(const std::string& path, int32_t chunkSize)
+  : file_(path, std::ios::binary | std::ios::out | std::ios::trunc)
+  , chunk_(static_cast<size_t>(std::max(chunkSize, 4096))) {
+  if (!file_.is_open()) {
+    throw std::runtime_error("Can not open snapshot file: " + path);
+  }
+
+  const LZ4F_preferences_t prefs = FramePreferences();
+  compressed_.resize(std::max<size_t>(LZ4F_compressBound(chunk_.size(), &prefs),
+                                      LZ4F_HEADER_SIZE_MAX));
+
+  LZ4F_cctx* context = nullptr;
+  CheckLz4(LZ4F_createCompressionContext(&context, LZ4F_VERSION), "LZ4F_createCompressionContext");
+  context_ = context;
+
+  WriteCompressed(CheckLz4(
+    LZ4F_compressBegin(context_, compressed_.data(), compressed_.size(), &prefs),
+    "LZ4F_compressBegin"));
+}
+
+Lz4FrameBytesOut::~Lz4FrameBytesOut() {
+  if (context_ != nullptr) {
+    LZ4F_freeCompressionContext(context_);
+  }
+}
+
+common::BytesOut& Lz4FrameBytesOut::Write(const void* buffer, size_t length) {
+  const char* src = static_cast<const char*>(buffer);
+  while (length > 0) {
+    const size_t n = std::min(length, chunk_.size() - chunkLength_);
+    std::memcpy(chunk_.data() + chunkLength_, src, n);
+    chunkLength_ += n;
+    src += n;
+    length -= n;
+    if (chunkLength_ == chunk_.size()) {
+      CompressChunk();
+    }
+  }
+  return *this;
+}
+
+int64_t Lz4FrameBytesOut::Finish() {
+  if (!finished_) {
+    CompressChunk();
+    WriteCompressed(
+      CheckLz4(LZ4F_compressEnd(context_, compressed_.data(), compressed_.size(), nullptr),
+               "LZ4F_compressEnd"));
+    file_.flush();
+    if (!file_.good()) {
+      throw std::runtime_error("Snapshot file write failed");
+    }
+    file_.close();
+    finished_ = true;
+  }
+  return fileSize_;
+}
+
+void Lz4FrameBytesOut::CompressChunk() {
+  if (chunkLength_ == 0) {
+    return;
+  }
+  WriteCompressed(CheckLz4(LZ4F_compressUpdate(context_, compressed_.data(), compressed_.size(),
+                                               chunk_.data(), chunkLength_, nullptr),
+                           "LZ4F_compressUpdate"));
+  written_ += static_cast<int64_t>(chunkLength_);
+  chunkLength_ = 0;
+}
+
+void Lz4FrameBytesOut::WriteCompressed(size_t length) {
+  file_.write(compressed_.data(), static_cast<std::streamsize>(length));
+  if (!file_.good()) {
+    throw std::runtime_error("Snapshot file write failed");
+  }
+  fileSize_ += static_cast<int64_t>(length);
+}
+
+}  // namespace exchange::core::processors::journaling
@@ -0,0 +1,133 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/utils/CoroutineFramePool.h>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace exchange::core::utils {
+
+namespace {
+
+constexpr size_t kClasses = 7;  // 64, 128, ..., 4096
+constexpr uint32_t kBatch = 32;  // blocks moved between thread cache and shared list
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+struct FreeList {
+  FreeBlock* head = nullptr;
+  uint32_t count = 0;
+
+  void Push(FreeBlock* block) {
+    block->next = head;
+    head = block;
+    count++;
+  }
+
+  FreeBlock* Pop() {
+    FreeBlock* block = head;
+    head = block->next;
+    count--;
+    return block;
+  }
+};
+
+struct SharedList {
+  std::mutex mutex;
+  FreeList list;
+};
+
+std::array<SharedList, kClasses> sharedLists;
+
+size_t ClassOf(size_t size) {
+  return size <= CoroutineFramePool::MIN_BLOCK_SIZE
+           ? 0
+           : static_cast<size_t>(std::bit_width(size - 1)) - 6;
+}
+
+size_t BlockSize(size_t sizeClass) {
+  return CoroutineFramePool::MIN_BLOCK_SIZE << sizeClass;
+}
+
+// Moves up to count blocks from one list to another
+void Transfer(FreeList& from, FreeList& to, uint32_t count) {
+  while (count-- > 0 && from.head != nullptr) {
+    to.Push(from.Pop());
+  }
+}
+
+class ThreadCache {
+public:
+  ~ThreadCache() {
+    for (size_t sizeClass = 0; sizeClass < kClasses; sizeClass++) {
+      auto& shared = sharedLists[sizeClass];
+      std::lock_guard<std::mutex> lock(shared.mutex);
+      Transfer(lists_[sizeClass], shared.list, lists_[sizeClass].count);
+    }
+  }
+
+  void* Allocate(size_t sizeClass) {
+    auto& list = lists_[sizeClass];
+    if (list.head == nullptr) {
+      auto& shared = sharedLists[sizeClass];
+      std::lock_guard<std::mutex> lock(shared.mutex);
+      Transfer(shared.list, list, kBatch);
+    }
+    if (list.head == nullptr) {
+      return ::operator new(BlockSize(sizeClass));
+    }
+    return list.Pop();
+  }
+
+  void Deallocate(void* ptr, size_t sizeClass) {
+    auto& list = lists_[sizeClass];
+    list.Push(static_cast<FreeBlock*>(ptr));
+    if (list.count > 2 * kBatch) {
+      auto& shared = sharedLists[sizeClass];
+      std::lock_guard<std::mutex> lock(shared.mutex);
+      Transfer(list, shared.list, kBatch);
+    }
+  }
+
+private:
+  std::array<FreeList, kClasses> lists_{};
+};
+
+thread_local ThreadCache threadCache;
+
+}  // namespace
+
+void* CoroutineFramePool::Allocate(size_t size) {
+  if (size > MAX_BLOCK_SIZE) {
+    return ::operator new(size);
+  }
+  return threadCache.Allocate(ClassOf(size));
+}
+
+void CoroutineFramePool::Deallocate(void* ptr, size_t size) noexcept {
+  if (size > MAX_BLOCK_SIZE) {
+    ::operator delete(ptr);
+    return;
+  }
+  threadCache.Deallocate(ptr, ClassOf(size));
+}
+
+}  // namespace exchange::core::utils
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/utils/Crc32c.h>
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__amd64__) || defined(_M_X64) || defined(_M_AMD64)
+#  define CRC32C_X86
+#  include <nmmintrin.h>
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  endif
+#endif
+
+namespace exchange::core::utils {
+
+namespace {
+
+constexpr uint32_t POLYNOMIAL = 0x82F63B78;  // reversed Castagnoli polynomial
+
+constexpr std::array<uint32_t, 256> MakeTable() {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 1) ? (crc >> 1) ^ POLYNOMIAL : crc >> 1;
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+constexpr std::array<uint32_t, 256> TABLE = MakeTable();
+
+uint32_t ComputeSoftware(const uint8_t* p, size_t length, uint32_t crc) {
+  while (length-- > 0) {
+    crc = TABLE[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#ifdef CRC32C_X86
+
+// Long buffers are processed as 3 interleaved streams (crc32 instruction has
+// latency 3, throughput 1), stream checksums are combined using tables
+// shifting crc over LONG/SHORT zero bytes (after Mark Adler's crc32c.c)
+constexpr size_t LONG = 8192;
+constexpr size_t SHORT = 256;
+
+uint32_t Gf2MatrixTimes(const uint32_t* mat, uint32_t vec) {
+  uint32_t sum = 0;
+  for (; vec != 0; vec >>= 1, mat++) {
+    if (vec & 1) {
+      sum ^= *mat;
+    }
+  }
+  return sum;
+}
+
+void Gf2MatrixSquare(uint32_t* square, const uint32_t* mat) {
+  for (int n = 0; n < 32; n++) {
+    square[n] = Gf2MatrixTimes(mat, mat[n]);
+  }
+}
+
+/**
+ * Table applying length zero bytes to crc, byte by byte
+ */
+struct ZerosTable {
+  uint32_t table[4][256];
+
+  explicit ZerosTable(size_t length) {
+    // operator for one zero bit, squared up to length zero bytes
+    uint32_t even[32];
+    uint32_t odd[32];
+    odd[0] = POLYNOMIAL;
+    for (int n = 1; n < 32; n++) {
+      odd[n] = 1u << (n - 1);
+    }
+    Gf2MatrixSquare(even, odd);
+    Gf2MatrixSquare(odd, even);
+    const uint32_t* op = odd;
+    do {
+      Gf2MatrixSquare(even, odd);
+      op = even;
+      length >>= 1;
+      if (length == 0) {
+        break;
+      }
+      Gf2MatrixSquare(odd, even);
+      op = odd;
+      length >>= 1;
+    } while (length != 0);
+
+    for (uint32_t n = 0; n < 256; n++) {
+      table[0][n] = Gf2MatrixTimes(op, n);
+      table[1][n] = Gf2MatrixTimes(op, n << 8);
+      table[2][n] = Gf2MatrixTimes(op, n << 16);
+      table[3][n] = Gf2MatrixTimes(op, n << 24);
+    }
+  }
+
+  uint32_t Shift(uint32_t crc) const {
+    return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^ table[2][(crc >> 16) & 0xFF]
+           ^ table[3][crc >> 24];
+  }
+};
+
+const ZerosTable LONG_ZEROS(LONG);
+const ZerosTable SHORT_ZEROS(SHORT);
+
+#  if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("sse4.2")))
+#  endif
+uint64_t Crc64(uint64_t crc, const uint8_t* p) {
+  uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+  return _mm_crc32_u64(crc, word);
+}
+
+#  if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("sse4.2")))
+#  endif
+uint32_t ComputeHardware(const uint8_t* p, size_t length, uint32_t crc) {
+  uint64_t crc0 = crc;
+  for (const size_t stride : {LONG, SHORT}) {
+    const ZerosTable& zeros = stride == LONG ? LONG_ZEROS : SHORT_ZEROS;
+    while (length >= 3 * stride) {
+      uint64_t crc1 = 0;
+      uint64_t crc2 = 0;
+      for (const uint8_t* const end = p + stride; p < end; p += sizeof(uint64_t)) {
+        crc0 = Crc64(crc0, p);
+        crc1 = Crc64(crc1, p + stride);
+        crc2 = Crc64(crc2, p + 2 * stride);
+      }
+      crc0 = zeros.Shift(static_cast<uint32_t>(crc0)) ^ crc1;
+      crc0 = zeros.Shift(static_cast<uint32_t>(crc0)) ^ crc2;
+      p += 2 * stride;
+      length -= 3 * stride;
+    }
+  }
+  for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t), p += sizeof(uint64_t)) {
+    crc0 = Crc64(crc0, p);
+  }
+  auto crc32 = static_cast<uint32_t>(crc0);
+  while (length-- > 0) {
+    crc32 = _mm_crc32_u8(crc32, *p++);
+  }
+  return crc32;
+}
+
+bool DetectSse42() {
+#  if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 20)) != 0;
+#  else
+  return __builtin_cpu_supports("sse4.2");
+#  endif
+}
+
+const bool HARDWARE = DetectSse42();
+
+#endif
+
+}  // namespace
+
+uint32_t Crc32c::Compute(const void* data, size_t length, uint32_t crc) {
+  const auto* p = static_cast<const uint8_t*>(data);
+  crc = ~crc;
+#ifdef CRC32C_X86
+  if (HARDWARE) {
+    return ~ComputeHardware(p, length, crc);
+  }
+#endif
+  return ~ComputeSoftware(p, length, crc);
+}
+
+bool Crc32c::HardwareAccelerated() {
+#ifdef CRC32C_X86
+  return HARDWARE;
+#else
+  return false;
+#endif
+}
+
+}  // namespace exchange::core::utils
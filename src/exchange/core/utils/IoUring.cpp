@@ -0,0 +1,217 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/utils/IoUring.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace exchange::core::utils {
+
+#ifdef __linux__
+
+namespace {
+
+template <typename T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+void* MapRing(int ringFd, size_t size, int64_t offset) {
+  void* ring =
+    ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, offset);
+  return ring == MAP_FAILED ? nullptr : ring;
+}
+
+}  // namespace
+
+IoUring::IoUring(uint32_t entries) {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  ringFd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+  if (ringFd_ < 0) {
+    throw std::runtime_error(std::string("io_uring_setup failed: ") + std::strerror(errno));
+  }
+  entries_ = params.sq_entries;
+
+  sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (singleMap) {
+    sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+  }
+  sqRing_ = MapRing(ringFd_, sqRingSize_, IORING_OFF_SQ_RING);
+  cqRing_ = singleMap ? sqRing_ : MapRing(ringFd_, cqRingSize_, IORING_OFF_CQ_RING);
+  sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = MapRing(ringFd_, sqesSize_, IORING_OFF_SQES);
+  if (sqRing_ == nullptr || cqRing_ == nullptr || sqes_ == nullptr) {
+    const std::string error = std::strerror(errno);
+    Close();
+    throw std::runtime_error("io_uring ring mapping failed: " + error);
+  }
+
+  sqHead_ = RingField<uint32_t>(sqRing_, params.sq_off.head);
+  sqTail_ = RingField<uint32_t>(sqRing_, params.sq_off.tail);
+  sqMask_ = *RingField<uint32_t>(sqRing_, params.sq_off.ring_mask);
+  sqArray_ = RingField<uint32_t>(sqRing_, params.sq_off.array);
+  cqHead_ = RingField<uint32_t>(cqRing_, params.cq_off.head);
+  cqTail_ = RingField<uint32_t>(cqRing_, params.cq_off.tail);
+  cqMask_ = *RingField<uint32_t>(cqRing_, params.cq_off.ring_mask);
+  cqes_ = RingField<io_uring_cqe>(cqRing_, params.cq_off.cqes);
+  inFlight_.reserve(entries_);
+}
+
+IoUring::~IoUring() {
+  Close();
+}
+
+void IoUring::Close() {
+  if (sqes_ != nullptr) {
+    ::munmap(sqes_, sqesSize_);
+  }
+  if (cqRing_ != nullptr && cqRing_ != sqRing_) {
+    ::munmap(cqRing_, cqRingSize_);
+  }
+  if (sqRing_ != nullptr) {
+    ::munmap(sqRing_, sqRingSize_);
+  }
+  if (ringFd_ >= 0) {
+    ::close(ringFd_);
+  }
+  sqes_ = cqRing_ = sqRing_ = nullptr;
+  ringFd_ = -1;
+}
+
+int IoUring::Enter(uint32_t toSubmit, uint32_t minComplete, uint32_t flags) {
+  while (true) {
+    const int result = static_cast<int>(
+      ::syscall(__NR_io_uring_enter, ringFd_, toSubmit, minComplete, flags, nullptr, 0));
+    if (result >= 0 || errno != EINTR) {
+      return result;
+    }
+  }
+}
+
+int64_t IoUring::SubmitWrite(int fd, const void* data, uint32_t length, int64_t offset,
+                             bool dsync) {
+  while (inFlight_.size() >= entries_) {
+    Reap(true);
+  }
+
+  // single submitter: entries are consumed by kernel before next one is added
+  const uint32_t tail = *sqTail_;
+  const uint32_t index = tail & sqMask_;
+  auto* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+  std::memset(sqe, 0, sizeof(io_uring_sqe));
+  sqe->opcode = IORING_OP_WRITE;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uint64_t>(data);
+  sqe->len = length;
+  sqe->off = static_cast<uint64_t>(offset);
+  sqe->rw_flags = dsync ? RWF_DSYNC : 0;
+  sqe->user_data = static_cast<uint64_t>(submittedTicket_ + 1);
+  sqArray_[index] = index;
+  __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+
+  uint32_t head;
+  while ((head = __atomic_load_n(sqHead_, __ATOMIC_ACQUIRE)) != tail + 1) {
+    if (Enter(tail + 1 - head, 0, 0) < 0) {
+      if (errno != EAGAIN && errno != EBUSY) {
+        throw std::runtime_error(std::string("io_uring_enter failed: ") + std::strerror(errno));
+      }
+      // no resources for new request: wait for a completion
+      Reap(true);
+    }
+  }
+  inFlight_.emplace_back(++submittedTicket_, length);
+  return submittedTicket_;
+}
+
+void IoUring::Reap(bool wait) {
+  uint32_t head = *cqHead_;
+  if (wait && !inFlight_.empty() && head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)
+      && Enter(0, 1, IORING_ENTER_GETEVENTS) < 0) {
+    throw std::runtime_error(std::string("io_uring_enter failed: ") + std::strerror(errno));
+  }
+
+  std::string error;
+  const uint32_t tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+  for (; head != tail; head++) {
+    const auto* cqe = static_cast<const io_uring_cqe*>(cqes_) + (head & cqMask_);
+    const auto ticket = static_cast<int64_t>(cqe->user_data);
+    const auto it = std::find_if(inFlight_.begin(), inFlight_.end(),
+                                 [ticket](const auto& write) { return write.first == ticket; });
+    if (it == inFlight_.end()) {
+      continue;
+    }
+    if (cqe->res < 0) {
+      error = std::string("write failed: ") + std::strerror(-cqe->res);
+    } else if (static_cast<uint32_t>(cqe->res) != it->second) {
+      error = "short write: " + std::to_string(cqe->res) + " of " + std::to_string(it->second);
+    }
+    inFlight_.erase(it);
+  }
+  __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+
+  // tickets in flight are ordered
+  completedTicket_ = inFlight_.empty() ? submittedTicket_ : inFlight_.front().first - 1;
+  if (!error.empty()) {
+    throw std::runtime_error("io_uring " + error);
+  }
+}
+
+void IoUring::Await(int64_t ticket) {
+  Reap(false);
+  while (completedTicket_ < ticket) {
+    Reap(true);
+  }
+}
+
+#else
+
+IoUring::IoUring(uint32_t entries) {
+  (void)entries;
+  throw std::runtime_error("io_uring is not supported on this platform");
+}
+
+IoUring::~IoUring() = default;
+
+void IoUring::Close() {}
+
+int IoUring::Enter(uint32_t, uint32_t, uint32_t) {
+  return -1;
+}
+
+int64_t IoUring::SubmitWrite(int, const void*, uint32_t, int64_t, bool) {
+  throw std::runtime_error("io_uring is not supported on this platform");
+}
+
+void IoUring::Reap(bool) {}
+
+void IoUring::Await(int64_t) {}
+
+#endif
+
+}  // namespace exchange::core::utils
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/collections/DenseIntIndex.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using exchange::core::collections::DenseIntIndex;
+
+TEST(DenseIntIndexTest, ShouldStoreOnlyKeysInDenseRange) {
+  DenseIntIndex<int> index(100);
+  int values[4] = {};
+
+  EXPECT_TRUE(index.InRange(0));
+  EXPECT_TRUE(index.InRange(99));
+  EXPECT_FALSE(index.InRange(100));
+  EXPECT_FALSE(index.InRange(-1));
+  EXPECT_FALSE(index.InRange(std::numeric_limits<int32_t>::min()));
+
+  index.Put(0, &values[0]);
+  index.Put(99, &values[1]);
+  index.Put(100, &values[2]);  // owning map resolves it
+  index.Put(-1, &values[3]);
+
+  EXPECT_EQ(index.Get(0), &values[0]);
+  EXPECT_EQ(index.Get(99), &values[1]);
+  EXPECT_EQ(index.Get(50), nullptr);
+  EXPECT_EQ(index.GetMaxDenseKey(), 100);
+}
+
+TEST(DenseIntIndexTest, ShouldGrowOnDemandAndKeepStoredValues) {
+  DenseIntIndex<int> index(1'000'000);
+  std::vector<int> values(1000);
+
+  // keys in descending and ascending order: table grows up to the largest key
+  for (int32_t key = 999; key >= 500; key--) {
+    index.Put(key * 7, &values[key]);
+  }
+  for (int32_t key = 0; key < 500; key++) {
+    index.Put(key * 7, &values[key]);
+  }
+
+  for (int32_t key = 0; key < 1000; key++) {
+    ASSERT_EQ(index.Get(key * 7), &values[key]) << "key=" << key * 7;
+    ASSERT_EQ(index.Get(key * 7 + 1), nullptr);
+  }
+  // in range, beyond the largest key put
+  EXPECT_EQ(index.Get(999'999), nullptr);
+}
+
+TEST(DenseIntIndexTest, ShouldReplaceAndClear) {
+  DenseIntIndex<int> index(10);
+  int first = 1;
+  int second = 2;
+
+  index.Put(3, &first);
+  index.Put(3, &second);
+  EXPECT_EQ(index.Get(3), &second);
+
+  index.Put(3, nullptr);
+  EXPECT_EQ(index.Get(3), nullptr);
+
+  index.Put(5, &first);
+  index.Clear();
+  EXPECT_EQ(index.Get(5), nullptr);
+  EXPECT_TRUE(index.InRange(5));
+
+  index.Put(5, &second);
+  EXPECT_EQ(index.Get(5), &second);
+}
+
+TEST(DenseIntIndexTest, ShouldBeDisabledWithZeroLimit) {
+  DenseIntIndex<int> index;
+  int value = 0;
+
+  EXPECT_FALSE(index.InRange(0));
+  index.Put(0, &value);
+  EXPECT_EQ(index.Get(0), nullptr);
+}
@@ -481,6 +481,53 @@ TEST_F(LongAdaptiveRadixTreeMapTest, ShouldExtendTo256andReduceTo48) {
   }
 }
 
+TEST_F(LongAdaptiveRadixTreeMapTest, ShouldBuildFromSortedKeys) {
+  std::mt19937 rand(1);
+  // dense keys, sparse keys, and node fan-outs of 4/16/48/256
+  for (int step : {1, 3, 250, 1000, 70000}) {
+    for (int num : {1, 2, 5, 17, 49, 300, 20000}) {
+      std::vector<int64_t> keys;
+      std::vector<int64_t*> values;
+      int64_t key = 1000000000LL + rand() % 1000000;
+      for (int i = 0; i < num; i++) {
+        keys.push_back(key);
+        values.push_back(new int64_t(key));
+        key += 1 + rand() % step;
+      }
+
+      LongAdaptiveRadixTreeMap<int64_t> bulk;
+      bulk.PutAllSorted(keys.data(), values.data(), keys.size());
+      bulk.ValidateInternalState();
+
+      // same structure as incremental inserts
+      LongAdaptiveRadixTreeMap<int64_t> incremental;
+      for (size_t i = 0; i < keys.size(); i++) {
+        incremental.Put(keys[i], values[i]);
+      }
+      ASSERT_EQ(bulk.PrintDiagram(), incremental.PrintDiagram());
+      ASSERT_EQ(bulk.EntriesList(), incremental.EntriesList());
+
+      // bulk built tree keeps working with regular updates
+      for (size_t i = 0; i < keys.size(); i += 2) {
+        bulk.Remove(keys[i]);
+      }
+      bulk.Put(key, values[0]);
+      bulk.ValidateInternalState();
+      ASSERT_EQ(bulk.Get(key), values[0]);
+      ASSERT_EQ(bulk.Size(INT32_MAX), static_cast<int>(keys.size() / 2 + 1));
+
+      for (auto* value : values) {
+        delete value;
+      }
+    }
+  }
+
+  LongAdaptiveRadixTreeMap<int64_t> map;
+  int64_t unsortedKeys[] = {5, 3};
+  int64_t* unsortedValues[] = {nullptr, nullptr};
+  EXPECT_THROW(map.PutAllSorted(unsortedKeys, unsortedValues, 2), std::invalid_argument);
+}
+
 TEST_F(LongAdaptiveRadixTreeMapTest, ShouldLoadManyItems) {
   std::mt19937 rand(1);
   std::uniform_int_distribution<int> dist(1, 1000);
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/ExchangeApi.h>
+#include <exchange/core/ExchangeCore.h>
+#include <exchange/core/common/api/ApiAddUser.h>
+#include <exchange/core/common/api/ApiCommandValue.h>
+#include <exchange/core/common/api/ApiPersistState.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/utils/InlineFunction.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace exchange::core;
+using namespace exchange::core::common;
+using namespace exchange::core::common::api;
+using namespace exchange::core::common::cmd;
+
+namespace {
+
+class CompletionCallbackTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    config_ = std::make_unique<config::ExchangeConfiguration>(
+      config::ExchangeConfiguration::Default());
+    core_ = std::make_unique<ExchangeCore>([](OrderCommand*, int64_t) {}, config_.get());
+    core_->Startup();
+  }
+
+  void TearDown() override {
+    core_->Shutdown();
+  }
+
+  IExchangeApi* Api() {
+    return core_->GetApi();
+  }
+
+  static void AwaitFlag(const std::atomic<bool>& flag) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!flag.load(std::memory_order_acquire)) {
+      ASSERT_LT(std::chrono::steady_clock::now(), deadline) << "callback was not invoked";
+      std::this_thread::yield();
+    }
+  }
+
+  std::unique_ptr<config::ExchangeConfiguration> config_;
+  std::unique_ptr<ExchangeCore> core_;
+};
+
+}  // namespace
+
+TEST(InlineFunctionTest, ShouldMoveAndDestroyCapturedState) {
+  using Function = utils::InlineFunction<int64_t(int64_t), 48>;
+  auto counter = std::make_shared<int64_t>(10);
+
+  Function function([counter](int64_t value) { return *counter + value; });
+  EXPECT_EQ(counter.use_count(), 2);
+
+  Function moved(std::move(function));
+  EXPECT_FALSE(function);
+  ASSERT_TRUE(moved);
+  EXPECT_EQ(moved(5), 15);
+  EXPECT_EQ(counter.use_count(), 2);
+
+  moved.Reset();
+  EXPECT_FALSE(moved);
+  EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST_F(CompletionCallbackTest, ShouldInvokeCallbackWithProcessedCommand) {
+  std::atomic<bool> done{false};
+  CommandResultCode resultCode = CommandResultCode::NEW;
+  int64_t uid = 0;
+
+  Api()->SubmitCommand(ApiCommandValue::AddUser(301), [&](const OrderCommand& cmd) {
+    resultCode = cmd.resultCode;
+    uid = cmd.uid;
+    done.store(true, std::memory_order_release);
+  });
+  AwaitFlag(done);
+  EXPECT_EQ(resultCode, CommandResultCode::SUCCESS);
+  EXPECT_EQ(uid, 301);
+
+  // polymorphic command, failed result is delivered the same way
+  done.store(false);
+  ApiAddUser duplicate(301);
+  Api()->SubmitCommand(&duplicate, [&](const OrderCommand& cmd) {
+    resultCode = cmd.resultCode;
+    done.store(true, std::memory_order_release);
+  });
+  AwaitFlag(done);
+  EXPECT_EQ(resultCode, CommandResultCode::USER_MGMT_USER_ALREADY_EXISTS);
+}
+
+TEST_F(CompletionCallbackTest, ShouldCompleteBatchWithOneCallback) {
+  constexpr int32_t kUsers = 100;
+  std::vector<ApiCommandValue> cmds;
+  for (int32_t i = 0; i < kUsers; i++) {
+    cmds.push_back(ApiCommandValue::AddUser(1000 + i));
+  }
+  cmds.push_back(ApiCommandValue::AddUser(1000));  // duplicate
+
+  std::atomic<bool> done{false};
+  std::atomic<int32_t> invocations{0};
+  std::vector<CommandResultCode> resultCodes;
+  Api()->SubmitCommandsBatch(cmds.data(), cmds.size(), [&](const CompletedBatch& batch) {
+    for (int32_t i = 0; i < batch.Size(); i++) {
+      resultCodes.push_back(batch.ResultCode(i));
+    }
+    invocations.fetch_add(1);
+    done.store(true, std::memory_order_release);
+  });
+  AwaitFlag(done);
+
+  EXPECT_EQ(invocations.load(), 1);
+  ASSERT_EQ(resultCodes.size(), cmds.size());
+  for (int32_t i = 0; i < kUsers; i++) {
+    EXPECT_EQ(resultCodes[i], CommandResultCode::SUCCESS);
+  }
+  EXPECT_EQ(resultCodes.back(), CommandResultCode::USER_MGMT_USER_ALREADY_EXISTS);
+}
+
+TEST_F(CompletionCallbackTest, ShouldReuseCallbackSlotsAcrossRingBufferLaps) {
+  // more commands than ring buffer slots, every callback invoked exactly once
+  const int64_t commands = 3L * config_->performanceCfg.ringBufferSize + 17;
+  std::atomic<int64_t> completed{0};
+  for (int64_t i = 0; i < commands; i++) {
+    Api()->SubmitCommand(ApiCommandValue::Nop(), [&completed](const OrderCommand&) {
+      completed.fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+
+  std::atomic<bool> done{false};
+  Api()->SubmitCommand(ApiCommandValue::Nop(), [&done](const OrderCommand&) {
+    done.store(true, std::memory_order_release);
+  });
+  AwaitFlag(done);
+  EXPECT_EQ(completed.load(), commands);
+}
+
+TEST_F(CompletionCallbackTest, ShouldKeepFutureResultAcrossRingBufferLaps) {
+  auto future = Api()->SubmitCommandAsync(ApiCommandValue::AddUser(401));
+  const auto lightFuture = Api()->SubmitCommandAsyncLight(ApiCommandValue::AddUser(401));
+
+  // results are read only after the ring buffer has wrapped several times
+  std::vector<ApiCommand*> cmds;
+  std::vector<std::unique_ptr<ApiAddUser>> users;
+  for (int64_t i = 0; i < 3L * config_->performanceCfg.ringBufferSize; i++) {
+    users.push_back(std::make_unique<ApiAddUser>(1000 + i));
+    cmds.push_back(users.back().get());
+  }
+  Api()->SubmitCommandsSync(cmds);
+
+  // std::future keeps result until it is read, lightweight one is overwritten
+  EXPECT_EQ(future.get(), CommandResultCode::SUCCESS);
+  EXPECT_THROW(lightFuture.get(), std::runtime_error);
+}
+
+TEST_F(CompletionCallbackTest, ShouldRejectUnsupportedSubmissions) {
+  auto noop = [](const OrderCommand&) {};
+  ApiPersistState persist(1, false);
+  EXPECT_THROW(Api()->SubmitCommand(&persist, noop), std::invalid_argument);
+  EXPECT_THROW(Api()->SubmitCommand(ApiCommandValue::Nop(), CompletionCallback()),
+               std::invalid_argument);
+
+  const std::vector<ApiCommandValue> cmds(config_->performanceCfg.ringBufferSize,
+                                          ApiCommandValue::Nop());
+  EXPECT_THROW(Api()->SubmitCommandsBatch(cmds.data(), cmds.size(), [](const CompletedBatch&) {}),
+               std::invalid_argument);
+  EXPECT_THROW(Api()->SubmitCommandsBatch(cmds.data(), 0, [](const CompletedBatch&) {}),
+               std::invalid_argument);
+}
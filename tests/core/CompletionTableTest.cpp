@@ -0,0 +1,141 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/CommandFuture.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace exchange::core;
+using namespace exchange::core::common::cmd;
+
+namespace {
+
+constexpr int32_t kSize = 1024;
+
+}  // namespace
+
+TEST(CompletionTableTest, ShouldCompleteFuture) {
+  CompletionTable table(kSize);
+  CommandFuture future(&table, 5);
+
+  ASSERT_TRUE(future.valid());
+  EXPECT_EQ(future.wait_for(std::chrono::milliseconds(1)), std::future_status::timeout);
+
+  table.Complete(5, CommandResultCode::SUCCESS);
+  EXPECT_EQ(future.wait_for(std::chrono::milliseconds(1)), std::future_status::ready);
+  EXPECT_EQ(future.get(), CommandResultCode::SUCCESS);
+}
+
+TEST(CompletionTableTest, ShouldKeepNegativeResultCodes) {
+  CompletionTable table(kSize);
+  const std::vector<CommandResultCode> codes = {
+    CommandResultCode::RISK_NSF, CommandResultCode::DROP,
+    CommandResultCode::MATCHING_UNKNOWN_ORDER_ID, CommandResultCode::ACCEPTED};
+  int64_t seq = 3L * kSize;
+  for (const auto code : codes) {
+    table.Complete(seq, code);
+    EXPECT_EQ(CommandFuture(&table, seq).get(), code);
+    seq++;
+  }
+}
+
+TEST(CompletionTableTest, ShouldNotCompleteWithResultOfPreviousLap) {
+  CompletionTable table(kSize);
+  table.Complete(7, CommandResultCode::SUCCESS);
+
+  CommandResultCode code = CommandResultCode::NEW;
+  EXPECT_EQ(table.Poll(7 + kSize, code), CompletionTable::State::PENDING);
+  EXPECT_EQ(table.Poll(7, code), CompletionTable::State::COMPLETED);
+}
+
+TEST(CompletionTableTest, ShouldDetectOverwrittenResult) {
+  CompletionTable table(kSize);
+  table.Complete(7, CommandResultCode::SUCCESS);
+  table.Complete(7 + kSize, CommandResultCode::RISK_NSF);
+
+  CommandFuture future(&table, 7);
+  EXPECT_THROW(future.get(), std::runtime_error);
+  EXPECT_EQ(CommandFuture(&table, 7 + kSize).get(), CommandResultCode::RISK_NSF);
+}
+
+TEST(CompletionTableTest, ShouldMergeTwoSequences) {
+  CompletionTable table(kSize);
+  CommandFuture future(&table, 10, 11);
+
+  table.Complete(10, CommandResultCode::SUCCESS);
+  EXPECT_EQ(future.wait_for(std::chrono::milliseconds(1)), std::future_status::timeout);
+
+  table.Complete(11, CommandResultCode::STATE_PERSIST_MATCHING_ENGINE_FAILED);
+  EXPECT_EQ(future.get(), CommandResultCode::STATE_PERSIST_MATCHING_ENGINE_FAILED);
+}
+
+TEST(CompletionTableTest, ShouldTakeMarkOnce) {
+  using Waiter = CompletionTable::Waiter;
+  CompletionTable table(kSize);
+  EXPECT_EQ(table.TakeMark(9), Waiter::NONE);
+
+  table.Mark(9, Waiter::PROMISE);
+  EXPECT_EQ(table.TakeMark(9), Waiter::PROMISE);
+  EXPECT_EQ(table.TakeMark(9), Waiter::NONE);
+  EXPECT_EQ(table.TakeMark(9 + kSize), Waiter::NONE);
+
+  table.Mark(10, Waiter::COMMAND_CALLBACK);
+  table.Mark(11, Waiter::BATCH_CALLBACK);
+  EXPECT_EQ(table.TakeMark(11), Waiter::BATCH_CALLBACK);
+  EXPECT_EQ(table.TakeMark(10), Waiter::COMMAND_CALLBACK);
+}
+
+TEST(CompletionTableTest, ShouldRejectInvalidSize) {
+  EXPECT_THROW(CompletionTable(1000), std::invalid_argument);
+  EXPECT_THROW(CompletionTable(0), std::invalid_argument);
+}
+
+TEST(CompletionTableTest, ShouldDeliverResultsAcrossThreads) {
+  // results thread completes sequences in order, waiter stays within one lap
+  // (as ring buffer gating guarantees for ExchangeApi)
+  constexpr int64_t kCommands = 200'000;
+  CompletionTable table(kSize);
+  std::atomic<int64_t> consumed{-1};
+
+  std::thread results([&table, &consumed]() {
+    for (int64_t seq = 0; seq < kCommands; seq++) {
+      while (seq - consumed.load(std::memory_order_acquire) > kSize) {
+        std::this_thread::yield();
+      }
+      const auto code =
+        (seq % 3 == 0) ? CommandResultCode::RISK_NSF : CommandResultCode::SUCCESS;
+      table.Complete(seq, code);
+    }
+  });
+
+  int64_t mismatches = 0;
+  for (int64_t seq = 0; seq < kCommands; seq++) {
+    const auto expected =
+      (seq % 3 == 0) ? CommandResultCode::RISK_NSF : CommandResultCode::SUCCESS;
+    if (CommandFuture(&table, seq).get() != expected) {
+      mismatches++;
+    }
+    consumed.store(seq, std::memory_order_release);
+  }
+  results.join();
+  EXPECT_EQ(mismatches, 0);
+}
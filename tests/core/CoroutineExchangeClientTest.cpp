@@ -0,0 +1,197 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/CoroutineExchangeClient.h>
+#include <exchange/core/ExchangeCore.h>
+#include <exchange/core/common/CoreSymbolSpecification.h>
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/SymbolType.h>
+#include <exchange/core/common/api/ApiBinaryDataCommand.h>
+#include <exchange/core/common/api/ApiCommandValue.h>
+#include <exchange/core/common/api/ApiPersistState.h>
+#include <exchange/core/common/api/binary/BatchAddSymbolsCommand.h>
+#include <exchange/core/common/api/reports/SingleUserReportQuery.h>
+#include <exchange/core/common/api/reports/SingleUserReportResult.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/utils/CoroutineFramePool.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace exchange::core;
+using namespace exchange::core::common;
+using namespace exchange::core::common::api;
+using namespace exchange::core::common::api::reports;
+using namespace exchange::core::common::cmd;
+
+namespace {
+
+constexpr int32_t kCurrencyXbt = 11;
+constexpr int32_t kCurrencyLtc = 15;
+constexpr int32_t kSymbol = 241;
+
+class CoroutineExchangeClientTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    config_ = std::make_unique<config::ExchangeConfiguration>(
+      config::ExchangeConfiguration::Default());
+    core_ = std::make_unique<ExchangeCore>([](OrderCommand*, int64_t) {}, config_.get());
+    core_->Startup();
+    client_ = std::make_unique<CoroutineExchangeClient>(core_->GetApi(), &executor_);
+  }
+
+  void TearDown() override {
+    core_->Shutdown();
+  }
+
+  // Event loop of the test: polls executor until flag is set
+  void RunUntil(const std::atomic<bool>& flag) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!flag.load(std::memory_order_acquire)) {
+      ASSERT_LT(std::chrono::steady_clock::now(), deadline) << "coroutine was not resumed";
+      if (executor_.Poll() == 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  std::unique_ptr<config::ExchangeConfiguration> config_;
+  std::unique_ptr<ExchangeCore> core_;
+  PollingCoroutineExecutor executor_;
+  std::unique_ptr<CoroutineExchangeClient> client_;
+};
+
+struct TradingResults {
+  std::vector<CommandResultCode> resultCodes;
+  std::shared_ptr<L2MarketData> orderBook;
+  std::unique_ptr<SingleUserReportResult> report;
+  std::thread::id resumedOn;
+};
+
+ExchangeTask Trade(CoroutineExchangeClient& client,
+                   TradingResults& results,
+                   std::atomic<bool>& finished) {
+  common::CoreSymbolSpecification symbolSpec;
+  symbolSpec.symbolId = kSymbol;
+  symbolSpec.type = SymbolType::CURRENCY_EXCHANGE_PAIR;
+  symbolSpec.baseCurrency = kCurrencyXbt;
+  symbolSpec.quoteCurrency = kCurrencyLtc;
+  symbolSpec.baseScaleK = 1'000'000L;
+  symbolSpec.quoteScaleK = 10'000L;
+  ApiBinaryDataCommand addSymbols(1, std::make_unique<binary::BatchAddSymbolsCommand>(&symbolSpec));
+
+  results.resultCodes.push_back(co_await client.Submit(&addSymbols));
+  results.resultCodes.push_back(co_await client.Submit(ApiCommandValue::AddUser(301)));
+  results.resultCodes.push_back(co_await client.Submit(
+    ApiCommandValue::AdjustUserBalance(301, kCurrencyLtc, 2'000'000'000L, 1L)));
+  results.resultCodes.push_back(co_await client.PlaceOrder(
+    301, kSymbol, 5001, OrderAction::BID, OrderType::GTC, 15'400, 15'400, 12));
+  results.orderBook = co_await client.RequestOrderBook(kSymbol, 10);
+  results.resultCodes.push_back(co_await client.CancelOrder(301, kSymbol, 5001));
+  results.report = co_await client.ProcessReport<SingleUserReportQuery, SingleUserReportResult>(
+    std::make_unique<SingleUserReportQuery>(301), 0);
+  results.resumedOn = std::this_thread::get_id();
+  finished.store(true, std::memory_order_release);
+}
+
+ExchangeTask SubmitPersist(CoroutineExchangeClient& client,
+                           bool& rejected,
+                           std::atomic<bool>& finished) {
+  ApiPersistState persist(1, false);
+  try {
+    co_await client.Submit(&persist);
+  } catch (const std::invalid_argument&) {
+    rejected = true;
+  }
+  finished.store(true, std::memory_order_release);
+}
+
+ExchangeTask AddUser(CoroutineExchangeClient& client,
+                     int64_t uid,
+                     std::atomic<int64_t>& succeeded) {
+  if (co_await client.Submit(ApiCommandValue::AddUser(uid)) == CommandResultCode::SUCCESS) {
+    succeeded.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace
+
+TEST(CoroutineFramePoolTest, ShouldReuseFreedBlocks) {
+  void* block = utils::CoroutineFramePool::Allocate(200);
+  utils::CoroutineFramePool::Deallocate(block, 200);
+
+  // same size class (129..256 bytes)
+  void* reused = utils::CoroutineFramePool::Allocate(250);
+  EXPECT_EQ(reused, block);
+  utils::CoroutineFramePool::Deallocate(reused, 250);
+
+  // larger than pooled sizes
+  void* large = utils::CoroutineFramePool::Allocate(utils::CoroutineFramePool::MAX_BLOCK_SIZE + 1);
+  ASSERT_NE(large, nullptr);
+  utils::CoroutineFramePool::Deallocate(large, utils::CoroutineFramePool::MAX_BLOCK_SIZE + 1);
+}
+
+TEST_F(CoroutineExchangeClientTest, ShouldAwaitCommandsOrderBookAndReport) {
+  TradingResults results;
+  std::atomic<bool> finished{false};
+  Trade(*client_, results, finished);
+  RunUntil(finished);
+
+  ASSERT_EQ(results.resultCodes.size(), 5u);
+  for (const auto resultCode : results.resultCodes) {
+    EXPECT_EQ(resultCode, CommandResultCode::SUCCESS);
+  }
+  ASSERT_NE(results.orderBook, nullptr);
+  EXPECT_EQ(results.orderBook->bidSize, 1);
+  EXPECT_EQ(results.orderBook->askSize, 0);
+
+  ASSERT_NE(results.report, nullptr);
+  ASSERT_NE(results.report->accounts, nullptr);
+  EXPECT_EQ(results.report->accounts->at(kCurrencyLtc), 2'000'000'000L);
+
+  // resumed by executor on the polling thread
+  EXPECT_EQ(results.resumedOn, std::this_thread::get_id());
+}
+
+TEST_F(CoroutineExchangeClientTest, ShouldRethrowSubmitErrorInCoroutine) {
+  bool rejected = false;
+  std::atomic<bool> finished{false};
+  SubmitPersist(*client_, rejected, finished);
+  RunUntil(finished);
+  EXPECT_TRUE(rejected);
+}
+
+TEST_F(CoroutineExchangeClientTest, ShouldResumeManyOutstandingCoroutines) {
+  // more outstanding requests than ring buffer slots
+  const int64_t coroutines = 2L * config_->performanceCfg.ringBufferSize;
+  std::atomic<int64_t> succeeded{0};
+  for (int64_t uid = 1; uid <= coroutines; uid++) {
+    AddUser(*client_, uid, succeeded);
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (succeeded.load(std::memory_order_relaxed) != coroutines) {
+    ASSERT_LT(std::chrono::steady_clock::now(), deadline);
+    executor_.Poll();
+  }
+}
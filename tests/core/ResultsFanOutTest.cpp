@@ -0,0 +1,209 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <exchange/core/ExchangeApi.h>
+#include <exchange/core/ExchangeCore.h>
+#include <exchange/core/common/api/ApiBinaryDataCommand.h>
+#include <exchange/core/common/api/ApiCommandValue.h>
+#include <exchange/core/common/api/binary/BatchAddAccountsCommand.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/cmd/OrderCommandType.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace exchange::core;
+using namespace exchange::core::common;
+using namespace exchange::core::common::cmd;
+
+namespace {
+
+constexpr int32_t kUsers = 100;
+
+bool AwaitCount(const std::atomic<int32_t>& counter, int32_t expected) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (counter.load(std::memory_order_acquire) < expected) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(ResultsFanOutTest, ShouldDeliverResultsToEveryConsumer) {
+  auto config = config::ExchangeConfiguration::Default();
+  std::atomic<int32_t> trades{0};
+  std::atomic<int32_t> audit{0};
+  const auto counter = [](std::atomic<int32_t>& count) {
+    return [&count](OrderCommand* cmd, int64_t) {
+      if (cmd->command == OrderCommandType::ADD_USER) {
+        count.fetch_add(1, std::memory_order_release);
+      }
+    };
+  };
+
+  ExchangeCore core(std::vector<ExchangeCore::ResultsConsumer>{counter(trades), counter(audit)},
+                    &config);
+  core.Startup();
+  for (int32_t uid = 1; uid <= kUsers; uid++) {
+    EXPECT_EQ(core.GetApi()->SubmitCommandAsync(api::ApiCommandValue::AddUser(uid)).get(),
+              CommandResultCode::SUCCESS);
+  }
+
+  EXPECT_TRUE(AwaitCount(trades, kUsers));
+  EXPECT_TRUE(AwaitCount(audit, kUsers));
+  core.Shutdown();
+}
+
+TEST(ResultsFanOutTest, ShouldNotDelayAcksBySlowConsumer) {
+  auto config = config::ExchangeConfiguration::Default();
+  std::atomic<bool> released{false};
+  std::atomic<int32_t> consumed{0};
+  ExchangeCore::ResultsConsumer marketData = [&](OrderCommand* cmd, int64_t) {
+    // stuck until released
+    while (!released.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+    if (cmd->command == OrderCommandType::ADD_USER) {
+      consumed.fetch_add(1, std::memory_order_release);
+    }
+  };
+
+  ExchangeCore core(std::vector<ExchangeCore::ResultsConsumer>{marketData}, &config);
+  // consumer is released before core is destroyed, also on failed assertion
+  struct Release {
+    std::atomic<bool>& released;
+    ~Release() {
+      released.store(true, std::memory_order_release);
+    }
+  } release{released};
+  core.Startup();
+  for (int32_t uid = 1; uid <= kUsers; uid++) {
+    auto future = core.GetApi()->SubmitCommandAsync(api::ApiCommandValue::AddUser(uid));
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_EQ(future.get(), CommandResultCode::SUCCESS);
+  }
+  EXPECT_EQ(consumed.load(), 0);
+
+  released.store(true, std::memory_order_release);
+  EXPECT_TRUE(AwaitCount(consumed, kUsers));
+  core.Shutdown();
+}
+
+TEST(ResultsFanOutTest, ShouldKeepPayloadForConsumersAfterAck) {
+  auto config = config::ExchangeConfiguration::Default();
+  std::atomic<bool> released{false};
+  std::atomic<int32_t> consumed{0};
+  // consumers read binary payload while (or after) completion processor acks the command
+  std::vector<uint8_t> auditPayload;
+  std::vector<uint8_t> marketDataPayload;
+  const auto payloadReader = [&](std::vector<uint8_t>& copy, bool waitRelease) {
+    return [&, target = &copy, waitRelease](OrderCommand* cmd, int64_t) {
+      if (cmd->command != OrderCommandType::BINARY_DATA_COMMAND) {
+        return;
+      }
+      while (waitRelease && !released.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      if (cmd->payload != nullptr) {
+        *target = *cmd->payload;
+      }
+      consumed.fetch_add(1, std::memory_order_release);
+    };
+  };
+
+  ExchangeCore core(std::vector<ExchangeCore::ResultsConsumer>{
+                      payloadReader(auditPayload, false), payloadReader(marketDataPayload, true)},
+                    &config);
+  struct Release {
+    std::atomic<bool>& released;
+    ~Release() {
+      released.store(true, std::memory_order_release);
+    }
+  } release{released};
+  core.Startup();
+
+  ankerl::unordered_dense::map<int64_t, ankerl::unordered_dense::map<int32_t, int64_t>> users;
+  for (int32_t uid = 1; uid <= kUsers; uid++) {
+    users[uid][1] = 1'000 + uid;
+  }
+  auto batch = std::make_unique<api::binary::BatchAddAccountsCommand>(users);
+  const auto future = core.GetApi()->SubmitCommandAsyncLight(
+    new api::ApiBinaryDataCommand(1, std::move(batch)));
+  ASSERT_EQ(future.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  EXPECT_EQ(future.get(), CommandResultCode::SUCCESS);
+
+  // acked before slow consumer has seen the command
+  released.store(true, std::memory_order_release);
+  ASSERT_TRUE(AwaitCount(consumed, 2));
+  EXPECT_FALSE(auditPayload.empty());
+  EXPECT_EQ(marketDataPayload, auditPayload);
+  core.Shutdown();
+}
+
+TEST(ResultsFanOutTest, ShouldReleasePayloadAfterLastConsumer) {
+  auto config = config::ExchangeConfiguration::Default();
+  std::atomic<int32_t> nops{0};
+  std::vector<uint8_t> payload;
+  OrderCommand* binaryCmd = nullptr;
+  const auto auditConsumer = [&](OrderCommand* cmd, int64_t) {
+    if (cmd->command == OrderCommandType::BINARY_DATA_COMMAND) {
+      binaryCmd = cmd;
+      payload = *cmd->payload;
+    } else if (cmd->command == OrderCommandType::NOP) {
+      nops.fetch_add(1, std::memory_order_release);
+    }
+  };
+  const auto marketDataConsumer = [&](OrderCommand* cmd, int64_t) {
+    if (cmd->command == OrderCommandType::NOP) {
+      nops.fetch_add(1, std::memory_order_release);
+    }
+  };
+
+  ExchangeCore core(std::vector<ExchangeCore::ResultsConsumer>{auditConsumer, marketDataConsumer},
+                    &config);
+  core.Startup();
+
+  ankerl::unordered_dense::map<int64_t, ankerl::unordered_dense::map<int32_t, int64_t>> users;
+  for (int32_t uid = 1; uid <= kUsers; uid++) {
+    users[uid][1] = 1'000 + uid;
+  }
+  auto batch = std::make_unique<api::binary::BatchAddAccountsCommand>(users);
+  auto* exchangeApi = core.GetApi();
+  const auto future =
+    exchangeApi->SubmitCommandAsyncLight(new api::ApiBinaryDataCommand(1, std::move(batch)));
+  EXPECT_EQ(future.get(), CommandResultCode::SUCCESS);
+
+  // every processor has moved past binary command once all of them have seen next one
+  EXPECT_EQ(exchangeApi->SubmitCommandAsyncLight(api::ApiCommandValue::Nop()).get(),
+            CommandResultCode::SUCCESS);
+  ASSERT_TRUE(AwaitCount(nops, 2));
+  EXPECT_FALSE(payload.empty());
+  ASSERT_NE(binaryCmd, nullptr);
+  EXPECT_EQ(binaryCmd->payload, nullptr);
+  core.Shutdown();
+}
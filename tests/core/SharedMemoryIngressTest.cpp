@@ -0,0 +1,190 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/ExchangeCore.h>
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/ingress/SharedMemoryBridge.h>
+#include <exchange/core/ingress/SharedMemoryIngress.h>
+#include <exchange/core/ingress/SharedMemoryRing.h>
+#include <exchange/core/ingress/WireFrameReader.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace exchange::core;
+using namespace exchange::core::common;
+using namespace exchange::core::common::cmd;
+using namespace exchange::core::ingress;
+
+namespace {
+
+struct TestRecord {
+  uint32_t producer;
+  uint32_t value;
+};
+
+std::string SegmentName(const char* test) {
+  return std::string("exchange-test-") + test + "-"
+         + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+std::vector<ShmResultRecord> AwaitResults(SharedMemoryIngressClient& client, size_t count) {
+  std::vector<ShmResultRecord> results(count);
+  size_t received = 0;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (received < count) {
+    received += client.PollResults(results.data() + received, count - received);
+    if (std::chrono::steady_clock::now() > deadline) {
+      ADD_FAILURE() << "received " << received << " of " << count << " results";
+      break;
+    }
+    std::this_thread::yield();
+  }
+  return results;
+}
+
+}  // namespace
+
+TEST(SharedMemoryRingTest, ShouldPollInOrderAndReportFullRing) {
+  using Ring = SharedMemoryRing<TestRecord>;
+  std::vector<uint64_t> memory(Ring::Footprint(4) / sizeof(uint64_t) + 1);
+  auto* ring = Ring::Init(memory.data(), 4);
+
+  for (uint32_t i = 0; i < 4; i++) {
+    ASSERT_TRUE(ring->TryOffer({0, i}));
+  }
+  EXPECT_FALSE(ring->TryOffer({0, 99}));
+
+  TestRecord records[8];
+  ASSERT_EQ(ring->Poll(records, 3), 3u);
+  // freed slots are reused on the next lap
+  for (uint32_t i = 4; i < 7; i++) {
+    ASSERT_TRUE(ring->TryOffer({0, i}));
+  }
+  EXPECT_FALSE(ring->TryOffer({0, 99}));
+  ASSERT_EQ(ring->Poll(records + 3, 8), 4u);
+  for (uint32_t i = 0; i < 7; i++) {
+    EXPECT_EQ(records[i].value, i);
+  }
+  EXPECT_EQ(ring->Poll(records, 8), 0u);
+  EXPECT_THROW(Ring::Init(memory.data(), 3), std::invalid_argument);
+}
+
+TEST(SharedMemoryRingTest, ShouldKeepOrderOfEveryProducer) {
+  using Ring = SharedMemoryRing<TestRecord>;
+  constexpr uint32_t kProducers = 4;
+  constexpr uint32_t kRecords = 50'000;
+  std::vector<uint64_t> memory(Ring::Footprint(256) / sizeof(uint64_t) + 1);
+  auto* ring = Ring::Init(memory.data(), 256);
+
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < kProducers; p++) {
+    producers.emplace_back([ring, p]() {
+      for (uint32_t i = 0; i < kRecords; i++) {
+        while (!ring->TryOffer({p, i})) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<uint32_t> expected(kProducers, 0);
+  TestRecord records[64];
+  uint32_t received = 0;
+  while (received < kProducers * kRecords) {
+    const size_t n = ring->Poll(records, 64);
+    for (size_t i = 0; i < n; i++) {
+      ASSERT_EQ(records[i].value, expected[records[i].producer]++);
+    }
+    received += static_cast<uint32_t>(n);
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+}
+
+TEST(SharedMemoryIngressTest, ShouldShareRingsBetweenMappings) {
+  const std::string name = SegmentName("mappings");
+  SharedMemoryIngress owner(name, 2, 64, 16);
+  SharedMemoryIngressClient client(name, 1);
+
+  std::vector<uint8_t> frame;
+  WireFrameWriter(frame).CancelOrder(7, 5, 100, 0);
+  ASSERT_TRUE(client.TrySubmit(42, frame.data(), frame.size()));
+
+  ShmCommandRecord command;
+  ASSERT_EQ(owner.Commands().Poll(&command, 1), 1u);
+  EXPECT_EQ(command.correlationId, 42u);
+  EXPECT_EQ(command.clientId, 1u);
+  ASSERT_EQ(command.frameLength, frame.size());
+
+  ASSERT_TRUE(owner.Results(1).TryOffer({42, 9, 100, 0}));
+  ShmResultRecord result;
+  ASSERT_EQ(client.PollResults(&result, 1), 1u);
+  EXPECT_EQ(result.correlationId, 42u);
+  EXPECT_EQ(result.seq, 9);
+
+  EXPECT_THROW(owner.Results(2), std::invalid_argument);
+  EXPECT_THROW(SharedMemoryIngressClient(name, 2), std::invalid_argument);
+  EXPECT_THROW(SharedMemoryIngressClient(SegmentName("missing"), 0), std::runtime_error);
+}
+
+TEST(SharedMemoryIngressTest, ShouldRouteResultsThroughBridge) {
+  const std::string name = SegmentName("bridge");
+  auto config =
+    std::make_unique<config::ExchangeConfiguration>(config::ExchangeConfiguration::Default());
+  config->performanceCfg.sharedMemoryIngressName = name;
+  config->performanceCfg.sharedMemoryIngressClients = 2;
+  auto core = std::make_unique<ExchangeCore>([](OrderCommand*, int64_t) {}, config.get());
+  core->Startup();
+
+  SharedMemoryIngressClient client(name, 1);
+  std::vector<uint8_t> place;
+  WireFrameWriter(place).PlaceOrder(301, 5, 100, OrderAction::BID, OrderType::GTC, 1000, 1000,
+                                    1, 0, 0);
+  std::vector<uint8_t> cancel;
+  WireFrameWriter(cancel).CancelOrder(301, 5, 100, 0);
+  std::vector<uint8_t> invalid = cancel;
+  invalid[2] = 99;  // unknown template
+
+  ASSERT_TRUE(client.TrySubmit(1, place.data(), place.size()));
+  ASSERT_TRUE(client.TrySubmit(2, invalid.data(), invalid.size()));
+  ASSERT_TRUE(client.TrySubmit(3, cancel.data(), cancel.size()));
+
+  auto results = AwaitResults(client, 3);
+  core->Shutdown();
+  ASSERT_EQ(results.size(), 3u);
+  // invalid frame is answered by bridge thread, others by results thread
+  std::sort(results.begin(), results.end(),
+            [](const auto& a, const auto& b) { return a.correlationId < b.correlationId; });
+
+  EXPECT_EQ(results[0].resultCode, CommandResultCodeToInt(CommandResultCode::AUTH_INVALID_USER));
+  EXPECT_EQ(results[1].seq, -1);
+  EXPECT_EQ(results[1].resultCode, SharedMemoryBridge::INVALID_FRAME);
+  EXPECT_GT(results[2].seq, results[0].seq);
+  EXPECT_EQ(results[2].resultCode,
+            CommandResultCodeToInt(CommandResultCode::MATCHING_INVALID_ORDER_BOOK_ID));
+}
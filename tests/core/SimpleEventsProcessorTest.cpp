@@ -15,7 +15,9 @@
  */
 
 #include <exchange/core/IEventsHandler.h>
+#include <exchange/core/IEventsViewHandler.h>
 #include <exchange/core/SimpleEventsProcessor.h>
+#include <exchange/core/common/L2MarketData.h>
 #include <exchange/core/common/MatcherEventType.h>
 #include <exchange/core/common/MatcherTradeEvent.h>
 #include <exchange/core/common/OrderAction.h>
@@ -28,7 +30,10 @@
 #include <exchange/core/common/cmd/OrderCommandType.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
 #include <memory>
+#include <new>
 #include <vector>
 
 using namespace exchange::core;
@@ -39,6 +44,32 @@ using ::testing::_;
 using ::testing::SaveArg;
 using ::testing::StrictMock;
 
+namespace {
+
+// heap allocations are counted while enabled
+std::atomic<bool> countAllocations{false};
+std::atomic<int64_t> allocations{0};
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  if (countAllocations.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
 // Mock class for IEventsHandler
 class MockEventsHandler : public IEventsHandler {
 public:
@@ -403,3 +434,133 @@ TEST_F(SimpleEventsProcessorTest, ShouldHandlerWithSingleReject) {
 
   delete reject;
 }
+
+// Collects values of events views (views are valid during the call only)
+class RecordingViewHandler : public IEventsViewHandler {
+public:
+  void CommandResult(const CommandResultView& commandResult) override {
+    results++;
+    lastCommand = commandResult.command.command;
+    lastOrderId = commandResult.command.orderId;
+    lastResultCode = commandResult.command.resultCode;
+    lastSeq = commandResult.seq;
+  }
+
+  void TradeEvent(const TradeEventView& tradeEvent) override {
+    tradeEvents++;
+    totalVolume = tradeEvent.totalVolume;
+    takerOrderCompleted = tradeEvent.takerOrderCompleted;
+    trades = 0;
+    for (const Trade trade : tradeEvent.trades) {
+      lastTrade = trade;
+      trades++;
+    }
+  }
+
+  void RejectEvent(const exchange::core::RejectEvent& rejectEvent) override {
+    rejectedVolume = rejectEvent.rejectedVolume;
+  }
+
+  void ReduceEvent(const exchange::core::ReduceEvent& reduceEvent) override {
+    reducedVolume = reduceEvent.reducedVolume;
+  }
+
+  void OrderBook(const OrderBookView& orderBook) override {
+    orderBooks++;
+    askLevels = orderBook.AskPrices().size();
+    bidLevels = orderBook.BidPrices().size();
+    bestBidVolume = orderBook.BidVolumes().empty() ? 0 : orderBook.BidVolumes()[0];
+  }
+
+  int64_t results = 0;
+  OrderCommandType lastCommand = OrderCommandType::NOP;
+  int64_t lastOrderId = 0;
+  CommandResultCode lastResultCode = CommandResultCode::NEW;
+  int64_t lastSeq = 0;
+  int64_t tradeEvents = 0;
+  int64_t totalVolume = 0;
+  bool takerOrderCompleted = false;
+  int64_t trades = 0;
+  Trade lastTrade{};
+  int64_t rejectedVolume = 0;
+  int64_t reducedVolume = 0;
+  int64_t orderBooks = 0;
+  size_t askLevels = 0;
+  size_t bidLevels = 0;
+  int64_t bestBidVolume = 0;
+};
+
+TEST_F(SimpleEventsProcessorTest, ShouldPassViewsOfCommandAndMatcherEvents) {
+  OrderCommand cmd = SamplePlaceOrderCommand();
+  std::unique_ptr<MatcherTradeEvent> firstTrade(
+    CreateMatcherTradeEvent(MatcherEventType::TRADE, false, 276810L, 10332L, true, 20100L, 8272L));
+  std::unique_ptr<MatcherTradeEvent> reject(
+    CreateMatcherTradeEvent(MatcherEventType::REJECT, true, 0, 0, false, 52201L, 100L));
+  std::unique_ptr<MatcherTradeEvent> secondTrade(
+    CreateMatcherTradeEvent(MatcherEventType::TRADE, true, 100293L, 1982L, false, 20110L, 3121L));
+  cmd.matcherEvent = firstTrade.get();
+  firstTrade->nextEvent = reject.get();
+  reject->nextEvent = secondTrade.get();
+
+  cmd.marketData = std::make_shared<L2MarketData>(1, 2);
+  cmd.marketData->askPrices[0] = 20200L;
+  cmd.marketData->bidPrices[0] = 20000L;
+  cmd.marketData->bidVolumes[0] = 77L;
+  cmd.marketData->bidPrices[1] = 19900L;
+
+  RecordingViewHandler handler;
+  SimpleEventsProcessor processor(&handler);
+  processor.Accept(&cmd, 192837L);
+
+  EXPECT_EQ(handler.results, 1);
+  EXPECT_EQ(handler.lastCommand, OrderCommandType::PLACE_ORDER);
+  EXPECT_EQ(handler.lastOrderId, 123L);
+  EXPECT_EQ(handler.lastResultCode, CommandResultCode::SUCCESS);
+  EXPECT_EQ(handler.lastSeq, 192837L);
+
+  EXPECT_EQ(handler.tradeEvents, 1);
+  EXPECT_EQ(handler.totalVolume, 11393L);
+  EXPECT_TRUE(handler.takerOrderCompleted);
+  EXPECT_EQ(handler.trades, 2);  // REJECT event in between is skipped
+  EXPECT_EQ(handler.lastTrade.makerOrderId, 100293L);
+  EXPECT_EQ(handler.lastTrade.volume, 3121L);
+  EXPECT_EQ(handler.rejectedVolume, 100L);
+
+  EXPECT_EQ(handler.orderBooks, 1);
+  EXPECT_EQ(handler.askLevels, 1u);
+  EXPECT_EQ(handler.bidLevels, 2u);
+  EXPECT_EQ(handler.bestBidVolume, 77L);
+}
+
+TEST_F(SimpleEventsProcessorTest, ShouldNotAllocateWithViewHandler) {
+  OrderCommand place = SamplePlaceOrderCommand();
+  std::unique_ptr<MatcherTradeEvent> trade(
+    CreateMatcherTradeEvent(MatcherEventType::TRADE, true, 276810L, 10332L, true, 20100L, 8272L));
+  place.matcherEvent = trade.get();
+  place.marketData = std::make_shared<L2MarketData>(4, 4);
+
+  OrderCommand reduce = SampleReduceCommand();
+  std::unique_ptr<MatcherTradeEvent> reduceEvent(
+    CreateMatcherTradeEvent(MatcherEventType::REDUCE, true, 0, 0, false, 20100L, 3200L));
+  reduce.matcherEvent = reduceEvent.get();
+
+  OrderCommand cancel = SampleCancelCommand();
+
+  RecordingViewHandler handler;
+  SimpleEventsProcessor processor(&handler);
+
+  allocations = 0;
+  countAllocations = true;
+  for (int64_t seq = 0; seq < 1000; seq += 3) {
+    processor.Accept(&place, seq);
+    processor.Accept(&reduce, seq + 1);
+    processor.Accept(&cancel, seq + 2);
+  }
+  countAllocations = false;
+
+  EXPECT_EQ(allocations.load(), 0);
+  EXPECT_EQ(handler.results, 1002);
+  EXPECT_EQ(handler.tradeEvents, 334);
+  EXPECT_EQ(handler.orderBooks, 334);
+  EXPECT_EQ(handler.reducedVolume, 3200L);
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/cmd/OrderCommandType.h>
+#include <exchange/core/ingress/WireFrameReader.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace exchange::core;
+using namespace exchange::core::common;
+using namespace exchange::core::common::cmd;
+using namespace exchange::core::ingress;
+
+namespace {
+
+constexpr size_t kMaxBatch = 16;
+
+std::vector<OrderCommand> DecodeAll(const std::vector<uint8_t>& buffer) {
+  WireFrameReader reader(buffer.data(), buffer.size());
+  std::vector<OrderCommand> cmds(reader.Validate(kMaxBatch));
+  for (auto& cmd : cmds) {
+    reader.DecodeNext(cmd);
+  }
+  EXPECT_TRUE(reader.AtEnd());
+  return cmds;
+}
+
+void ExpectRejected(const std::vector<uint8_t>& buffer) {
+  WireFrameReader reader(buffer.data(), buffer.size());
+  EXPECT_THROW(reader.Validate(kMaxBatch), std::invalid_argument);
+}
+
+}  // namespace
+
+TEST(WireFrameReaderTest, ShouldDecodeAllCommandTypes) {
+  std::vector<uint8_t> buffer;
+  WireFrameWriter writer(buffer);
+  writer.PlaceOrder(301, 5, 1001, OrderAction::BID, OrderType::GTC, 1500, 1600, 7, 42, 11);
+  writer.CancelOrder(302, 5, 1002, 12);
+  writer.MoveOrder(303, 6, 1003, 1450, 13);
+  writer.ReduceOrder(304, 6, 1004, 3, 14);
+
+  const auto cmds = DecodeAll(buffer);
+  ASSERT_EQ(cmds.size(), 4u);
+
+  EXPECT_EQ(cmds[0].command, OrderCommandType::PLACE_ORDER);
+  EXPECT_EQ(cmds[0].uid, 301);
+  EXPECT_EQ(cmds[0].symbol, 5);
+  EXPECT_EQ(cmds[0].orderId, 1001);
+  EXPECT_EQ(cmds[0].action, OrderAction::BID);
+  EXPECT_EQ(cmds[0].orderType, OrderType::GTC);
+  EXPECT_EQ(cmds[0].price, 1500);
+  EXPECT_EQ(cmds[0].reserveBidPrice, 1600);
+  EXPECT_EQ(cmds[0].size, 7);
+  EXPECT_EQ(cmds[0].userCookie, 42);
+  EXPECT_EQ(cmds[0].timestamp, 11);
+  EXPECT_EQ(cmds[0].resultCode, CommandResultCode::NEW);
+
+  EXPECT_EQ(cmds[1].command, OrderCommandType::CANCEL_ORDER);
+  EXPECT_EQ(cmds[1].uid, 302);
+  EXPECT_EQ(cmds[1].symbol, 5);
+  EXPECT_EQ(cmds[1].orderId, 1002);
+  EXPECT_EQ(cmds[1].timestamp, 12);
+
+  EXPECT_EQ(cmds[2].command, OrderCommandType::MOVE_ORDER);
+  EXPECT_EQ(cmds[2].uid, 303);
+  EXPECT_EQ(cmds[2].symbol, 6);
+  EXPECT_EQ(cmds[2].orderId, 1003);
+  EXPECT_EQ(cmds[2].price, 1450);
+  EXPECT_EQ(cmds[2].timestamp, 13);
+
+  EXPECT_EQ(cmds[3].command, OrderCommandType::REDUCE_ORDER);
+  EXPECT_EQ(cmds[3].uid, 304);
+  EXPECT_EQ(cmds[3].symbol, 6);
+  EXPECT_EQ(cmds[3].orderId, 1004);
+  EXPECT_EQ(cmds[3].size, 3);
+  EXPECT_EQ(cmds[3].timestamp, 14);
+}
+
+TEST(WireFrameReaderTest, ShouldDecodeBatchFrames) {
+  std::vector<uint8_t> buffer;
+  WireFrameWriter writer(buffer);
+  writer.CancelOrder(1, 5, 10, 0);
+  writer.Batch(3);
+  for (int64_t orderId = 11; orderId <= 13; orderId++) {
+    writer.CancelOrder(1, 5, orderId, 0);
+  }
+  writer.CancelOrder(1, 5, 14, 0);
+
+  const auto cmds = DecodeAll(buffer);
+  ASSERT_EQ(cmds.size(), 5u);
+  for (size_t i = 0; i < cmds.size(); i++) {
+    EXPECT_EQ(cmds[i].orderId, 10 + static_cast<int64_t>(i));
+  }
+}
+
+TEST(WireFrameReaderTest, ShouldNotSplitBatchBetweenChunks) {
+  std::vector<uint8_t> buffer;
+  WireFrameWriter writer(buffer);
+  writer.CancelOrder(1, 5, 10, 0);
+  writer.Batch(4);
+  for (int64_t orderId = 11; orderId <= 14; orderId++) {
+    writer.CancelOrder(1, 5, orderId, 0);
+  }
+
+  WireFrameReader reader(buffer.data(), buffer.size());
+  ASSERT_EQ(reader.Validate(kMaxBatch), 5u);
+  EXPECT_EQ(reader.CommandsUpTo(3), 1u);
+  EXPECT_EQ(reader.CommandsUpTo(5), 5u);
+
+  OrderCommand cmd;
+  reader.DecodeNext(cmd);
+  EXPECT_EQ(reader.CommandsUpTo(3), 4u);
+}
+
+TEST(WireFrameReaderTest, ShouldSkipTrailingBlockBytesOfNewerVersion) {
+  std::vector<uint8_t> buffer;
+  WireFrameWriter writer(buffer);
+  writer.CancelOrder(1, 5, 10, 0);
+  // extend block by 8 bytes, as a later schema version appending a field would
+  buffer[0] = static_cast<uint8_t>(WireFormat::CANCEL_ORDER_BLOCK + 8);
+  buffer.insert(buffer.end(), 8, 0xFF);
+  writer.CancelOrder(1, 5, 11, 0);
+
+  const auto cmds = DecodeAll(buffer);
+  ASSERT_EQ(cmds.size(), 2u);
+  EXPECT_EQ(cmds[1].orderId, 11);
+}
+
+TEST(WireFrameReaderTest, ShouldRejectMalformedFrames) {
+  std::vector<uint8_t> valid;
+  WireFrameWriter(valid).PlaceOrder(1, 5, 10, OrderAction::ASK, OrderType::IOC, 100, 0, 1, 0, 0);
+
+  auto truncated = valid;
+  truncated.pop_back();
+  ExpectRejected(truncated);
+
+  auto shortHeader = valid;
+  shortHeader.resize(WireFormat::HEADER_SIZE - 1);
+  ExpectRejected(shortHeader);
+
+  auto wrongSchema = valid;
+  wrongSchema[4] ^= 0x01;
+  ExpectRejected(wrongSchema);
+
+  auto unknownTemplate = valid;
+  unknownTemplate[2] = 99;
+  ExpectRejected(unknownTemplate);
+
+  auto shortBlock = valid;
+  shortBlock[0] = static_cast<uint8_t>(WireFormat::CANCEL_ORDER_BLOCK);
+  ExpectRejected(shortBlock);
+
+  auto badAction = valid;
+  badAction[WireFormat::HEADER_SIZE + 56] = 7;
+  ExpectRejected(badAction);
+
+  auto badOrderType = valid;
+  badOrderType[WireFormat::HEADER_SIZE + 57] = 9;
+  ExpectRejected(badOrderType);
+}
+
+TEST(WireFrameReaderTest, ShouldRejectInvalidBatches) {
+  std::vector<uint8_t> empty;
+  WireFrameWriter(empty).Batch(0);
+  ExpectRejected(empty);
+
+  std::vector<uint8_t> oversized;
+  WireFrameWriter oversizedWriter(oversized);
+  oversizedWriter.Batch(kMaxBatch + 1);
+  for (size_t i = 0; i <= kMaxBatch; i++) {
+    oversizedWriter.CancelOrder(1, 5, 10, 0);
+  }
+  ExpectRejected(oversized);
+
+  std::vector<uint8_t> nested;
+  WireFrameWriter nestedWriter(nested);
+  nestedWriter.Batch(2);
+  nestedWriter.Batch(1);
+  nestedWriter.CancelOrder(1, 5, 10, 0);
+  ExpectRejected(nested);
+
+  std::vector<uint8_t> missingFrames;
+  WireFrameWriter missingWriter(missingFrames);
+  missingWriter.Batch(2);
+  missingWriter.CancelOrder(1, 5, 10, 0);
+  ExpectRejected(missingFrames);
+}
@@ -191,6 +191,10 @@ TEST_F(OrderBookDirectImplExchangeTest, SequentialBidsTest) {
   TestSequentialBids();
 }
 
+TEST_F(OrderBookDirectImplExchangeTest, SnapshotRestoreTest) {
+  TestSnapshotRestore();
+}
+
 TEST_F(OrderBookDirectImplExchangeTest, MultipleCommandsCompareTest) {
   TestMultipleCommandsCompare();
 }
@@ -191,4 +191,8 @@ TEST_F(OrderBookDirectImplMarginTest, SequentialBidsTest) {
   TestSequentialBids();
 }
 
+TEST_F(OrderBookDirectImplMarginTest, SnapshotRestoreTest) {
+  TestSnapshotRestore();
+}
+
 }  // namespace exchange::core::tests::orderbook
@@ -15,14 +15,18 @@
  */
 
 #include "OrderBookDirectImplTest.h"
+#include <exchange/core/collections/objpool/ObjectsPool.h>
 #include <exchange/core/common/L2MarketData.h>
 #include <exchange/core/common/OrderAction.h>
 #include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/VectorBytesIn.h>
+#include <exchange/core/common/VectorBytesOut.h>
 #include <exchange/core/common/cmd/CommandResultCode.h>
 #include <exchange/core/common/cmd/OrderCommand.h>
 #include <exchange/core/common/config/LoggingConfiguration.h>
 #include <exchange/core/orderbook/IOrderBook.h>
 #include <exchange/core/orderbook/OrderBookDirectImpl.h>
+#include <exchange/core/orderbook/OrderBookEventsHelper.h>
 #include <exchange/core/orderbook/OrderBookNaiveImpl.h>
 #include <exchange/core/utils/Logger.h>
 #include <unordered_map>
@@ -192,4 +196,52 @@ void OrderBookDirectImplTest::TestMultipleCommandsCompare() {
   }
 }
 
+void OrderBookDirectImplTest::TestSnapshotRestore() {
+  const int tranNum = 20000;
+  const int targetOrderBookOrders = 1000;
+  const int numUsers = 100;
+
+  ClearOrderBook();
+  auto genResult = TestOrdersGenerator::GenerateCommands(
+    tranNum, targetOrderBookOrders, numUsers, TestOrdersGenerator::UID_PLAIN_MAPPER, 0, true, false,
+    TestOrdersGenerator::CreateAsyncProgressLogger(tranNum), 1825793762);
+  auto& allCommands = genResult.GetCommands();
+
+  const auto loggingCfg = exchange::core::common::config::LoggingConfiguration::Default();
+  auto* restorePool = exchange::core::collections::objpool::ObjectsPool::CreateDefaultTestPool();
+  auto* eventsHelper = OrderBookEventsHelper::NonPooledEventsHelper();
+
+  for (size_t idx = 0; idx < allCommands.size(); idx++) {
+    auto& cmd = allCommands[idx];
+    cmd.orderId += 100;
+    cmd.resultCode = CommandResultCode::VALID_FOR_MATCHING_ENGINE;
+    IOrderBook::ProcessCommand(orderBook_.get(), &cmd);
+    MatcherTradeEventGuard guard(cmd);  // Auto-cleanup
+
+    if (idx % 5000 != 4999) {
+      continue;
+    }
+
+    // Restored order book (bulk built) must be identical and keep working
+    std::vector<uint8_t> data;
+    VectorBytesOut bytesOut(data);
+    orderBook_->WriteMarshallable(bytesOut);
+    VectorBytesIn bytesIn(data);
+    auto restored = IOrderBook::Create(&bytesIn, restorePool, eventsHelper, &loggingCfg);
+    restored->ValidateInternalState();
+    ASSERT_EQ(restored->GetStateHash(), orderBook_->GetStateHash());
+    ASSERT_EQ(*restored->GetL2MarketDataSnapshot(INT32_MAX),
+              *orderBook_->GetL2MarketDataSnapshot(INT32_MAX));
+
+    for (size_t next = idx + 1; next < std::min(idx + 1000, allCommands.size()); next++) {
+      OrderCommand cmdCopy = allCommands[next].Copy();
+      cmdCopy.orderId += 100;
+      cmdCopy.resultCode = CommandResultCode::VALID_FOR_MATCHING_ENGINE;
+      IOrderBook::ProcessCommand(restored.get(), &cmdCopy);
+      MatcherTradeEventGuard restoredGuard(cmdCopy);
+    }
+    restored->ValidateInternalState();
+  }
+}
+
 }  // namespace exchange::core::tests::orderbook
@@ -30,6 +30,7 @@ protected:
   void TestSequentialAsks();
   void TestSequentialBids();
   void TestMultipleCommandsCompare();
+  void TestSnapshotRestore();
 };
 
 }  // namespace exchange::core::tests::orderbook
@@ -16,12 +16,15 @@
 
 #include "PerfJournaling.h"
 #include <exchange/core/common/config/PerformanceConfiguration.h>
+#include <exchange/core/common/config/SerializationConfiguration.h>
+#include <exchange/core/processors/journaling/DiskSerializationProcessorConfiguration.h>
 #include "../util/JournalingTestsModule.h"
 #include "../util/TestConstants.h"
 #include "../util/TestDataParameters.h"
 #include "../util/TestOrdersGeneratorConfig.h"
 
 using namespace exchange::core::tests::util;
+using exchange::core::processors::journaling::DiskSerializationProcessorConfiguration;
 
 namespace exchange::core::tests::perf {
 
@@ -49,6 +52,22 @@ void PerfJournaling::TestJournalingExchange() {
   JournalingTestsModule::JournalingTestImpl(perfCfg, testParams, 10);
 }
 
+void PerfJournaling::TestJournalingExchangeV2Format() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
+  perfCfg.matchingEnginesNum = 1;
+  perfCfg.riskEnginesNum = 1;
+
+  auto testParams = TestDataParameters::SinglePairExchange();
+  testParams.preFillMode = PreFillMode::ORDERS_NUMBER_PLUS_QUARTER;
+
+  DiskSerializationProcessorConfiguration diskCfg;
+  diskCfg.journalFormat = DiskSerializationProcessorConfiguration::JournalFormat::V2;
+  JournalingTestsModule::JournalingTestImpl(
+    perfCfg, testParams, 10,
+    exchange::core::common::config::SerializationConfiguration::DiskJournaling(diskCfg));
+}
+
 void PerfJournaling::TestJournalingMultiSymbolSmall() {
   auto perfCfg =
     exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
@@ -115,6 +134,10 @@ TEST_F(PerfJournaling, TestJournalingExchange) {
   TestJournalingExchange();
 }
 
+TEST_F(PerfJournaling, TestJournalingExchangeV2Format) {
+  TestJournalingExchangeV2Format();
+}
+
 TEST_F(PerfJournaling, TestJournalingMultiSymbolSmall) {
   TestJournalingMultiSymbolSmall();
 }
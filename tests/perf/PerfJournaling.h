@@ -40,6 +40,13 @@ public:
    */
   void TestJournalingExchange();
 
+  /**
+   * Same as TestJournalingExchange, but journal is written in v2 format
+   * (replayed by default v1 configuration). Compare "Recovery" journal size
+   * and time with TestJournalingExchange.
+   */
+  void TestJournalingExchangeV2Format();
+
   /**
    * Journaling test for small multi-symbol configuration
    * - 1K symbols
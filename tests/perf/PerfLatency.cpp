@@ -117,6 +117,38 @@ void PerfLatency::TestLatencyMarginFixed8M() {
     16);        // 16 warmup cycles
 }
 
+void PerfLatency::TestLatencyFirstMillionOrdersCold() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::LatencyPerformanceBuilder();
+  perfCfg.ringBufferSize = 2 * 1024;
+  perfCfg.matchingEnginesNum = 1;
+  perfCfg.riskEnginesNum = 1;
+  perfCfg.msgsInGroupLimit = 256;
+
+  auto testParams = TestDataParameters::SinglePairExchange();
+
+  LatencyTestsModule::FirstOrdersLatencyTest(
+    perfCfg, testParams, exchange::core::common::config::InitialStateConfiguration::CleanTest(),
+    exchange::core::common::config::SerializationConfiguration::Default(), 1'000'000, 1'000'000);
+}
+
+void PerfLatency::TestLatencyFirstMillionOrdersWarmedUp() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::LatencyPerformanceBuilder();
+  perfCfg.ringBufferSize = 2 * 1024;
+  perfCfg.matchingEnginesNum = 1;
+  perfCfg.riskEnginesNum = 1;
+  perfCfg.msgsInGroupLimit = 256;
+  perfCfg.preallocateObjectPools = true;
+  perfCfg.warmUpOrdersNum = 1'000'000;
+
+  auto testParams = TestDataParameters::SinglePairExchange();
+
+  LatencyTestsModule::FirstOrdersLatencyTest(
+    perfCfg, testParams, exchange::core::common::config::InitialStateConfiguration::CleanTest(),
+    exchange::core::common::config::SerializationConfiguration::Default(), 1'000'000, 1'000'000);
+}
+
 // Register tests
 TEST_F(PerfLatency, TestLatencyMargin) {
   TestLatencyMargin();
@@ -145,4 +177,13 @@ TEST_F(PerfLatency, TestLatencyMarginFixed8M) {
   TestLatencyMarginFixed8M();
 }
 
+// Cold start vs warmed-up start: latency of the first 1M orders
+TEST_F(PerfLatency, TestLatencyFirstMillionOrdersCold) {
+  TestLatencyFirstMillionOrdersCold();
+}
+
+TEST_F(PerfLatency, TestLatencyFirstMillionOrdersWarmedUp) {
+  TestLatencyFirstMillionOrdersWarmedUp();
+}
+
 }  // namespace exchange::core::tests::perf
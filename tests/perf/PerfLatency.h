@@ -84,6 +84,20 @@ public:
    * Useful for generating accurate flame graphs at specific TPS rates
    */
   void TestLatencyMarginFixed8M();
+
+  /**
+   * Latency of the first 1M orders after a cold start
+   * - one symbol (exchange mode), no warmup cycles
+   * - no pools pre-allocation and no startup warm-up flow
+   */
+  void TestLatencyFirstMillionOrdersCold();
+
+  /**
+   * Latency of the first 1M orders after a warmed-up start
+   * - one symbol (exchange mode), no warmup cycles
+   * - pools pre-allocated and synthetic warm-up flow executed on startup
+   */
+  void TestLatencyFirstMillionOrdersWarmedUp();
 };
 
 }  // namespace exchange::core::tests::perf
@@ -18,7 +18,9 @@
 #include <exchange/core/common/config/InitialStateConfiguration.h>
 #include <exchange/core/common/config/PerformanceConfiguration.h>
 #include <exchange/core/common/config/SerializationConfiguration.h>
+#include <exchange/core/utils/Logger.h>
 #include "../util/ExchangeTestContainer.h"
+#include "../util/JournalingTestsModule.h"
 #include "../util/LatencyTestsModule.h"
 #include "../util/TestDataParameters.h"
 
@@ -60,6 +62,44 @@ void PerfLatencyJournaling::TestLatencyExchangeJournaling() {
     exchange::core::common::config::SerializationConfiguration::DiskJournaling(), 6);
 }
 
+void PerfLatencyJournaling::TestLatencyExchangeJournalingAsyncWriter() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::LatencyPerformanceBuilder();
+  perfCfg.ringBufferSize = 32 * 1024;
+  perfCfg.matchingEnginesNum = 1;
+  perfCfg.riskEnginesNum = 1;
+  perfCfg.msgsInGroupLimit = 256;
+
+  auto testParams = TestDataParameters::SinglePairExchange();
+
+  LatencyTestsModule::LatencyTestImpl(
+    perfCfg, testParams,
+    exchange::core::common::config::InitialStateConfiguration::CleanStartJournaling(
+      ExchangeTestContainer::TimeBasedExchangeId()),
+    exchange::core::common::config::SerializationConfiguration::DiskJournalingAsync(), 6);
+}
+
+void PerfLatencyJournaling::TestLatencyExchangeDurabilityModes() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::LatencyPerformanceBuilder();
+  perfCfg.ringBufferSize = 32 * 1024;
+  perfCfg.matchingEnginesNum = 1;
+  perfCfg.riskEnginesNum = 1;
+  perfCfg.msgsInGroupLimit = 256;
+
+  auto testParams = TestDataParameters::SinglePairExchange();
+
+  for (const auto& [modeName, serializationCfg] :
+       JournalingTestsModule::DurabilityModesConfigurations()) {
+    LOG_INFO("----------- journal durability: {} -----------", modeName);
+    LatencyTestsModule::LatencyTestImpl(
+      perfCfg, testParams,
+      exchange::core::common::config::InitialStateConfiguration::CleanStartJournaling(
+        ExchangeTestContainer::TimeBasedExchangeId()),
+      serializationCfg, 3);
+  }
+}
+
 void PerfLatencyJournaling::TestLatencyMultiSymbolMediumJournaling() {
   auto perfCfg =
     exchange::core::common::config::PerformanceConfiguration::LatencyPerformanceBuilder();
@@ -120,6 +160,14 @@ TEST_F(PerfLatencyJournaling, TestLatencyExchangeJournaling) {
   TestLatencyExchangeJournaling();
 }
 
+TEST_F(PerfLatencyJournaling, TestLatencyExchangeJournalingAsyncWriter) {
+  TestLatencyExchangeJournalingAsyncWriter();
+}
+
+TEST_F(PerfLatencyJournaling, TestLatencyExchangeDurabilityModes) {
+  TestLatencyExchangeDurabilityModes();
+}
+
 TEST_F(PerfLatencyJournaling, TestLatencyMultiSymbolMediumJournaling) {
   TestLatencyMultiSymbolMediumJournaling();
 }
@@ -36,6 +36,18 @@ public:
    */
   void TestLatencyExchangeJournaling();
 
+  /**
+   * Latency test with journaling for Exchange mode,
+   * journal is written by asynchronous writer thread
+   */
+  void TestLatencyExchangeJournalingAsyncWriter();
+
+  /**
+   * Latency test with journaling for Exchange mode, for every journal
+   * writer and durability mode (page cache only, fdatasync, group commit)
+   */
+  void TestLatencyExchangeDurabilityModes();
+
   /**
    * Latency test with journaling for medium multi-symbol configuration
    */
@@ -16,6 +16,7 @@
 
 #include "PerfPersistence.h"
 #include <exchange/core/common/config/PerformanceConfiguration.h>
+#include <exchange/core/common/config/SerializationConfiguration.h>
 #include "../util/PersistenceTestsModule.h"
 #include "../util/TestDataParameters.h"
 #include "../util/TestOrdersGeneratorConfig.h"
@@ -67,6 +68,68 @@ void PerfPersistence::TestPersistenceMultiSymbolMedium() {
   PersistenceTestsModule::PersistenceTestImpl(perfCfg, testParams, 25);
 }
 
+void PerfPersistence::TestPersistenceExchangeForked() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
+  perfCfg.ringBufferSize = 32 * 1024;
+  perfCfg.matchingEnginesNum = 1;
+  perfCfg.riskEnginesNum = 1;
+  perfCfg.msgsInGroupLimit = 512;
+
+  auto testParams = TestDataParameters::SinglePairExchange();
+  testParams.preFillMode = PreFillMode::ORDERS_NUMBER_PLUS_QUARTER;
+
+  PersistenceTestsModule::PersistenceTestImpl(
+    perfCfg, testParams, 10,
+    exchange::core::common::config::SerializationConfiguration::DiskSnapshotOnlyForked());
+}
+
+void PerfPersistence::TestPersistenceMultiSymbolMediumForked() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
+  perfCfg.ringBufferSize = 32 * 1024;
+  perfCfg.matchingEnginesNum = 4;
+  perfCfg.riskEnginesNum = 2;
+  perfCfg.msgsInGroupLimit = 1024;
+
+  auto testParams = TestDataParameters::Medium();
+  testParams.allowedSymbolTypes = AllowedSymbolTypes::BOTH;
+  testParams.preFillMode = PreFillMode::ORDERS_NUMBER_PLUS_QUARTER;
+
+  PersistenceTestsModule::PersistenceTestImpl(
+    perfCfg, testParams, 25,
+    exchange::core::common::config::SerializationConfiguration::DiskSnapshotOnlyForked());
+}
+
+void PerfPersistence::TestPersistenceExchangeIncremental() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
+  perfCfg.ringBufferSize = 32 * 1024;
+  perfCfg.matchingEnginesNum = 1;
+  perfCfg.riskEnginesNum = 1;
+  perfCfg.msgsInGroupLimit = 512;
+
+  auto testParams = TestDataParameters::SinglePairExchange();
+  testParams.preFillMode = PreFillMode::ORDERS_NUMBER_PLUS_QUARTER;
+
+  PersistenceTestsModule::IncrementalPersistenceTestImpl(perfCfg, testParams, 3, 10);
+}
+
+void PerfPersistence::TestPersistenceMultiSymbolMediumIncremental() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
+  perfCfg.ringBufferSize = 32 * 1024;
+  perfCfg.matchingEnginesNum = 4;
+  perfCfg.riskEnginesNum = 2;
+  perfCfg.msgsInGroupLimit = 1024;
+
+  auto testParams = TestDataParameters::Medium();
+  testParams.allowedSymbolTypes = AllowedSymbolTypes::BOTH;
+  testParams.preFillMode = PreFillMode::ORDERS_NUMBER_PLUS_QUARTER;
+
+  PersistenceTestsModule::IncrementalPersistenceTestImpl(perfCfg, testParams, 3, 10);
+}
+
 void PerfPersistence::TestPersistenceMultiSymbolLarge() {
   auto perfCfg =
     exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
@@ -81,6 +144,20 @@ void PerfPersistence::TestPersistenceMultiSymbolLarge() {
   PersistenceTestsModule::PersistenceTestImpl(perfCfg, testParams, 25);
 }
 
+void PerfPersistence::TestPersistenceRestore10M() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
+  perfCfg.ringBufferSize = 32 * 1024;
+  perfCfg.matchingEnginesNum = 4;
+  perfCfg.riskEnginesNum = 4;
+  perfCfg.msgsInGroupLimit = 1024;
+
+  auto testParams = TestDataParameters::Large();
+  testParams.targetOrderBookOrdersTotal = 10'000'000;
+
+  PersistenceTestsModule::PersistenceTestImpl(perfCfg, testParams, 5);
+}
+
 void PerfPersistence::TestPersistenceMultiSymbolHuge() {
   auto perfCfg =
     exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
@@ -108,10 +185,32 @@ TEST_F(PerfPersistence, TestPersistenceMultiSymbolMedium) {
   TestPersistenceMultiSymbolMedium();
 }
 
+TEST_F(PerfPersistence, TestPersistenceExchangeForked) {
+  TestPersistenceExchangeForked();
+}
+
+TEST_F(PerfPersistence, TestPersistenceMultiSymbolMediumForked) {
+  TestPersistenceMultiSymbolMediumForked();
+}
+
+TEST_F(PerfPersistence, TestPersistenceExchangeIncremental) {
+  TestPersistenceExchangeIncremental();
+}
+
+TEST_F(PerfPersistence, TestPersistenceMultiSymbolMediumIncremental) {
+  TestPersistenceMultiSymbolMediumIncremental();
+}
+
 TEST_F(PerfPersistence, TestPersistenceMultiSymbolLarge) {
   TestPersistenceMultiSymbolLarge();
 }
 
+// Disabled by default - requires 16GB+ RAM, check "Restore" time in the log
+// Run with: --gtest_also_run_disabled_tests to enable
+TEST_F(PerfPersistence, DISABLED_TestPersistenceRestore10M) {
+  TestPersistenceRestore10M();
+}
+
 // Disabled by default - requires 12+ threads CPU, 32GB RAM, and takes hours to
 // complete Run with: --gtest_also_run_disabled_tests to enable
 TEST_F(PerfPersistence, DISABLED_TestPersistenceMultiSymbolHuge) {
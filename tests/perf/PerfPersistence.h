@@ -50,11 +50,33 @@ public:
    */
   void TestPersistenceMultiSymbolMedium();
 
+  /**
+   * Same as TestPersistenceExchange / TestPersistenceMultiSymbolMedium,
+   * but snapshots are written by forked process (FORK snapshot mode).
+   * Compare "Snapshot stall" with the inline snapshot tests.
+   */
+  void TestPersistenceExchangeForked();
+  void TestPersistenceMultiSymbolMediumForked();
+
+  /**
+   * Incremental snapshots: full snapshot after prefill, then 10 incremental
+   * snapshots while benchmark commands are applied, restore from the chain.
+   * Compare incremental snapshot size and stall with the full one.
+   */
+  void TestPersistenceExchangeIncremental();
+  void TestPersistenceMultiSymbolMediumIncremental();
+
   /**
    * Persistence test for large multi-symbol configuration
    */
   void TestPersistenceMultiSymbolLarge();
 
+  /**
+   * Restore time test: 10M resting orders and 10M accounts in snapshot
+   * (Large configuration with more orders). Compare "Restore" time in the log.
+   */
+  void TestPersistenceRestore10M();
+
   /**
    * Persistence test for huge multi-symbol configuration
    */
@@ -111,6 +111,18 @@ void PerfThroughput::TestThroughputMultiSymbolLarge() {
          // standard: 3 iterations for complex multi-symbol tests)
 }
 
+void PerfThroughput::TestThroughputMultiSymbolLargePrefetch() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
+  perfCfg.prefetchDistance = 8;
+
+  auto testParams = TestDataParameters::Large();
+
+  ThroughputTestsModule::ThroughputTestImpl(
+    perfCfg, testParams, exchange::core::common::config::InitialStateConfiguration::CleanTest(),
+    exchange::core::common::config::SerializationConfiguration::Default(), 3);
+}
+
 void PerfThroughput::TestThroughputMultiSymbolHuge() {
   auto perfCfg =
     exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
@@ -147,6 +159,10 @@ TEST_F(PerfThroughput, TestThroughputMultiSymbolLarge) {
   TestThroughputMultiSymbolLarge();
 }
 
+TEST_F(PerfThroughput, TestThroughputMultiSymbolLargePrefetch) {
+  TestThroughputMultiSymbolLargePrefetch();
+}
+
 // Disabled by default - requires 12+ threads CPU, 32GB RAM, and takes hours to
 // complete Run with: --gtest_also_run_disabled_tests to enable
 TEST_F(PerfThroughput, DISABLED_TestThroughputMultiSymbolHuge) {
@@ -61,6 +61,12 @@ public:
    */
   void TestThroughputMultiSymbolLarge();
 
+  /**
+   * Same as TestThroughputMultiSymbolLarge, with R1 prefetch lookahead
+   * enabled (dataset exceeds CPU caches) - compare results of both tests.
+   */
+  void TestThroughputMultiSymbolLargePrefetch();
+
   /**
    * This is high load throughput test for verifying exchange core scalability:
    * - 10M active users (33M currency accounts)
@@ -18,7 +18,9 @@
 #include <exchange/core/common/config/InitialStateConfiguration.h>
 #include <exchange/core/common/config/PerformanceConfiguration.h>
 #include <exchange/core/common/config/SerializationConfiguration.h>
+#include <exchange/core/utils/Logger.h>
 #include "../util/ExchangeTestContainer.h"
+#include "../util/JournalingTestsModule.h"
 #include "../util/TestDataParameters.h"
 #include "../util/ThroughputTestsModule.h"
 
@@ -60,6 +62,44 @@ void PerfThroughputJournaling::TestThroughputExchange() {
     exchange::core::common::config::SerializationConfiguration::DiskJournaling(), 50);
 }
 
+void PerfThroughputJournaling::TestThroughputExchangeAsyncWriter() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
+  perfCfg.ringBufferSize = 32 * 1024;
+  perfCfg.matchingEnginesNum = 1;
+  perfCfg.riskEnginesNum = 1;
+  perfCfg.msgsInGroupLimit = 1536;
+
+  auto testParams = TestDataParameters::SinglePairExchange();
+
+  ThroughputTestsModule::ThroughputTestImpl(
+    perfCfg, testParams,
+    exchange::core::common::config::InitialStateConfiguration::CleanStartJournaling(
+      ExchangeTestContainer::TimeBasedExchangeId()),
+    exchange::core::common::config::SerializationConfiguration::DiskJournalingAsync(), 50);
+}
+
+void PerfThroughputJournaling::TestThroughputExchangeDurabilityModes() {
+  auto perfCfg =
+    exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
+  perfCfg.ringBufferSize = 32 * 1024;
+  perfCfg.matchingEnginesNum = 1;
+  perfCfg.riskEnginesNum = 1;
+  perfCfg.msgsInGroupLimit = 1536;
+
+  auto testParams = TestDataParameters::SinglePairExchange();
+
+  for (const auto& [modeName, serializationCfg] :
+       JournalingTestsModule::DurabilityModesConfigurations()) {
+    LOG_INFO("----------- journal durability: {} -----------", modeName);
+    ThroughputTestsModule::ThroughputTestImpl(
+      perfCfg, testParams,
+      exchange::core::common::config::InitialStateConfiguration::CleanStartJournaling(
+        ExchangeTestContainer::TimeBasedExchangeId()),
+      serializationCfg, 25);
+  }
+}
+
 void PerfThroughputJournaling::TestThroughputMultiSymbolMedium() {
   auto perfCfg =
     exchange::core::common::config::PerformanceConfiguration::ThroughputPerformanceBuilder();
@@ -108,6 +148,14 @@ TEST_F(PerfThroughputJournaling, TestThroughputExchange) {
   TestThroughputExchange();
 }
 
+TEST_F(PerfThroughputJournaling, TestThroughputExchangeAsyncWriter) {
+  TestThroughputExchangeAsyncWriter();
+}
+
+TEST_F(PerfThroughputJournaling, TestThroughputExchangeDurabilityModes) {
+  TestThroughputExchangeDurabilityModes();
+}
+
 TEST_F(PerfThroughputJournaling, TestThroughputMultiSymbolMedium) {
   TestThroughputMultiSymbolMedium();
 }
@@ -39,6 +39,18 @@ public:
    */
   void TestThroughputExchange();
 
+  /**
+   * Throughput test with journaling for Exchange mode,
+   * journal is written by asynchronous writer thread
+   */
+  void TestThroughputExchangeAsyncWriter();
+
+  /**
+   * Throughput test with journaling for Exchange mode, for every journal
+   * writer and durability mode (page cache only, fdatasync, group commit)
+   */
+  void TestThroughputExchangeDurabilityModes();
+
   /**
    * Throughput test with journaling for medium multi-symbol configuration
    * This is medium load throughput test for verifying "triple million"
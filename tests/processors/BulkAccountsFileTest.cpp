@@ -0,0 +1,173 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <exchange/core/common/UserProfile.h>
+#include <exchange/core/common/VectorBytesIn.h>
+#include <exchange/core/common/VectorBytesOut.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <exchange/core/processors/BulkAccountsFile.h>
+#include <exchange/core/processors/UserProfileService.h>
+#include <gtest/gtest.h>
+#include <ankerl/unordered_dense.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace exchange::core;
+using namespace exchange::core::processors;
+
+namespace {
+
+using Adjustments = ankerl::unordered_dense::map<int32_t, int64_t>;
+
+constexpr int64_t kShards = 4;
+
+class BulkAccountsFileTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    path_ = (std::filesystem::temp_directory_path() / "bulk_accounts_test.eca").string();
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(path_);
+  }
+
+  // users with 1..3 accounts (currencies ascending, as BatchAddAccountsCommand applies them)
+  static std::vector<BulkAccountsFile::Row> GenerateRows(int32_t users) {
+    std::mt19937_64 random(1);
+    std::vector<BulkAccountsFile::Row> rows;
+    for (int64_t uid = 1; uid <= users; uid++) {
+      const int32_t accounts = 1 + static_cast<int32_t>(random() % 3);
+      for (int32_t currency = 0; currency < accounts; currency++) {
+        rows.push_back({uid, 10 + currency * 3, static_cast<int64_t>(random() % 1'000'000)});
+      }
+    }
+    return rows;
+  }
+
+  std::string path_;
+};
+
+}  // namespace
+
+TEST_F(BulkAccountsFileTest, ShouldReadColumnsWritten) {
+  const auto rows = GenerateRows(100);
+  BulkAccountsFile::Write(path_, rows);
+
+  const BulkAccountsFile file(path_);
+  ASSERT_EQ(file.Rows(), rows.size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    EXPECT_EQ(file.Uid(i), rows[i].uid);
+    EXPECT_EQ(file.Currency(i), rows[i].currency);
+    EXPECT_EQ(file.Balance(i), rows[i].balance);
+  }
+}
+
+TEST_F(BulkAccountsFileTest, ShouldLoadSameStateAsBalanceAdjustments) {
+  const auto rows = GenerateRows(5000);
+  BulkAccountsFile::Write(path_, rows);
+  const BulkAccountsFile file(path_);
+
+  size_t loadedRows = 0;
+  size_t loadedUsers = 0;
+  for (int32_t shardId = 0; shardId < kShards; shardId++) {
+    UserProfileService loaded;
+    Adjustments loadedAdjustments;
+    loadedRows += loaded.LoadAccounts(file, shardId, kShards - 1, loadedAdjustments);
+    loadedUsers += loaded.userProfiles.size();
+
+    // BatchAddAccountsCommand path: add user, then adjust balance per account
+    UserProfileService expected;
+    Adjustments expectedAdjustments;
+    for (const auto& row : rows) {
+      if ((row.uid & (kShards - 1)) != shardId) {
+        continue;
+      }
+      expected.AddUser(row.uid);
+      ASSERT_EQ(expected.BalanceAdjustment(row.uid, row.currency, row.balance,
+                                           UserProfileService::BATCH_ADD_FUNDING_BASE
+                                             + row.currency),
+                common::cmd::CommandResultCode::SUCCESS);
+      expectedAdjustments[row.currency] -= row.balance;
+    }
+
+    EXPECT_EQ(loaded.userProfiles.size(), expected.userProfiles.size());
+    EXPECT_EQ(loaded.GetStateHash(), expected.GetStateHash());
+    EXPECT_EQ(loadedAdjustments, expectedAdjustments);
+
+    // loaded profiles are part of snapshot
+    std::vector<uint8_t> snapshot;
+    common::VectorBytesOut out(snapshot);
+    loaded.WriteMarshallable(out);
+    common::VectorBytesIn in(snapshot);
+    UserProfileService restored(&in);
+    EXPECT_EQ(restored.GetStateHash(), loaded.GetStateHash());
+  }
+  EXPECT_EQ(loadedRows, rows.size());
+  EXPECT_EQ(loadedUsers, 5000u);
+}
+
+TEST_F(BulkAccountsFileTest, ShouldMergeScatteredRowsOfUser) {
+  BulkAccountsFile::Write(path_, {{7, 20, 500}, {8, 10, 1}, {7, 10, 300}, {7, 20, 25}});
+  const BulkAccountsFile file(path_);
+
+  UserProfileService service;
+  Adjustments adjustments;
+  EXPECT_EQ(service.LoadAccounts(file, 0, 0, adjustments), 4u);
+
+  ASSERT_EQ(service.userProfiles.size(), 2u);
+  common::UserProfile* profile = service.GetUserProfile(7);
+  ASSERT_NE(profile, nullptr);
+  EXPECT_EQ(profile->accounts[10], 300);
+  EXPECT_EQ(profile->accounts[20], 525);
+  EXPECT_EQ(profile->adjustmentsCounter, UserProfileService::BATCH_ADD_FUNDING_BASE + 20);
+  EXPECT_EQ(adjustments[10], -301);
+  EXPECT_EQ(adjustments[20], -525);
+}
+
+TEST_F(BulkAccountsFileTest, ShouldRejectNegativeBalance) {
+  BulkAccountsFile::Write(path_, {{1, 10, 100}, {2, 10, -1}});
+  const BulkAccountsFile file(path_);
+
+  UserProfileService service;
+  Adjustments adjustments;
+  EXPECT_THROW(service.LoadAccounts(file, 0, 0, adjustments), std::runtime_error);
+}
+
+TEST_F(BulkAccountsFileTest, ShouldRejectDamagedFile) {
+  BulkAccountsFile::Write(path_, GenerateRows(10));
+  const auto size = std::filesystem::file_size(path_);
+
+  std::filesystem::resize_file(path_, size - 1);
+  EXPECT_THROW(BulkAccountsFile{path_}, std::runtime_error);
+
+  std::filesystem::resize_file(path_, size + 4);
+  EXPECT_THROW(BulkAccountsFile{path_}, std::runtime_error);
+
+  {
+    std::fstream f(path_, std::ios::binary | std::ios::in | std::ios::out);
+    f.put('X');
+  }
+  std::filesystem::resize_file(path_, size);
+  EXPECT_THROW(BulkAccountsFile{path_}, std::runtime_error);
+
+  EXPECT_THROW(BulkAccountsFile{path_ + ".missing"}, std::runtime_error);
+}
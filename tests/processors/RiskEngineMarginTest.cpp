@@ -0,0 +1,261 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/common/CoreSymbolSpecification.h>
+#include <exchange/core/common/L2MarketData.h>
+#include <exchange/core/common/MatcherEventType.h>
+#include <exchange/core/common/MatcherTradeEvent.h>
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/SymbolType.h>
+#include <exchange/core/common/UserProfile.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/processors/RiskEngine.h>
+#include <exchange/core/processors/SharedPool.h>
+#include <exchange/core/processors/journaling/DummySerializationProcessor.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace exchange::core;
+using common::OrderAction;
+using common::cmd::CommandResultCode;
+
+namespace {
+
+constexpr int32_t USD = 840;
+constexpr int32_t EUR = 978;
+
+// futures in USD (margin buy/sell 100/120 and 50/60, 10/10) and in EUR (1000/1000)
+constexpr int32_t SYMBOL_A = 1;
+constexpr int32_t SYMBOL_B = 2;
+constexpr int32_t SYMBOL_D = 3;
+constexpr int32_t SYMBOL_EUR = 4;
+
+constexpr int64_t UID = 1;
+constexpr int64_t MAKER_UID = 2;
+
+}  // namespace
+
+/**
+ * R1 margin check of futures orders: free margin of other positions in the
+ * quote currency (P&L minus required margin) is cached per user and currency,
+ * invalidated by price changes and position changes.
+ * Orders are placed at the exact balance needed: one less is rejected.
+ */
+class RiskEngineMarginTest : public ::testing::Test {
+protected:
+  RiskEngineMarginTest()
+    : config_(common::config::ExchangeConfiguration::Default())
+    , sharedPool_(processors::SharedPool::CreateTestSharedPool())
+    , engine_(0,
+              1,
+              processors::journaling::DummySerializationProcessor::Instance(),
+              sharedPool_.get(),
+              &config_) {
+    AddFutures(SYMBOL_A, USD, 100, 120);
+    AddFutures(SYMBOL_B, USD, 50, 60);
+    AddFutures(SYMBOL_D, USD, 10, 10);
+    AddFutures(SYMBOL_EUR, EUR, 1000, 1000);
+    engine_.GetUserProfileService()->AddUser(UID);
+    engine_.GetUserProfileService()->AddUser(MAKER_UID);
+    Profile(MAKER_UID)->accounts[USD] = 1'000'000;
+  }
+
+  void AddFutures(int32_t symbol, int32_t currency, int64_t marginBuy, int64_t marginSell) {
+    specs_.push_back(std::make_unique<common::CoreSymbolSpecification>(
+      symbol, common::SymbolType::FUTURES_CONTRACT, 0, currency, 1, 1, 0, 0, marginBuy,
+      marginSell));
+    engine_.GetSymbolSpecificationProvider()->AddSymbol(specs_.back().get());
+  }
+
+  common::UserProfile* Profile(int64_t uid) {
+    return engine_.GetUserProfileService()->GetUserProfile(uid);
+  }
+
+  CommandResultCode Place(int64_t uid, int32_t symbol, OrderAction action, int64_t size) {
+    auto cmd =
+      common::cmd::OrderCommand::NewOrder(common::OrderType::GTC, ++seq_, uid, 10'000, 10'000,
+                                          size, action);
+    cmd.symbol = symbol;
+    engine_.PreProcessCommand(seq_, &cmd);
+    return cmd.resultCode;
+  }
+
+  /**
+   * Order of uid (size 1) is accepted with balance, rejected with balance - 1
+   */
+  void ExpectRequiredBalance(int64_t uid, int32_t symbol, int32_t currency, int64_t balance) {
+    Profile(uid)->accounts[currency] = balance - 1;
+    EXPECT_EQ(Place(uid, symbol, OrderAction::BID, 1), CommandResultCode::RISK_NSF);
+    Profile(uid)->accounts[currency] = balance;
+    EXPECT_EQ(Place(uid, symbol, OrderAction::BID, 1),
+              CommandResultCode::VALID_FOR_MATCHING_ENGINE);
+  }
+
+  /**
+   * R2 event of taker order (trade with MAKER_UID or reduce)
+   */
+  void MatcherEvent(common::MatcherEventType type,
+                    int64_t uid,
+                    int32_t symbol,
+                    OrderAction action,
+                    int64_t size,
+                    int64_t price) {
+    common::MatcherTradeEvent event;
+    event.eventType = type;
+    event.matchedOrderUid = type == common::MatcherEventType::TRADE ? MAKER_UID : 0;
+    event.size = size;
+    event.price = price;
+    common::cmd::OrderCommand cmd;
+    cmd.command = common::cmd::OrderCommandType::PLACE_ORDER;
+    cmd.uid = uid;
+    cmd.symbol = symbol;
+    cmd.action = action;
+    cmd.matcherEvent = &event;
+    engine_.PostProcessCommand(++seq_, &cmd);
+  }
+
+  void TopOfBook(int32_t symbol, int64_t bidPrice, int64_t askPrice) {
+    common::cmd::OrderCommand cmd;
+    cmd.command = common::cmd::OrderCommandType::PLACE_ORDER;
+    cmd.symbol = symbol;
+    cmd.marketData = std::make_shared<common::L2MarketData>(1, 1);
+    cmd.marketData->askPrices[0] = askPrice;
+    cmd.marketData->bidPrices[0] = bidPrice;
+    engine_.PostProcessCommand(++seq_, &cmd);
+  }
+
+  /**
+   * UID is long 2 of SYMBOL_A bought at 10'000 (margin 200)
+   */
+  void OpenLongPosition() {
+    Profile(UID)->accounts[USD] = 200;
+    ASSERT_EQ(Place(MAKER_UID, SYMBOL_A, OrderAction::ASK, 2),
+              CommandResultCode::VALID_FOR_MATCHING_ENGINE);
+    ASSERT_EQ(Place(UID, SYMBOL_A, OrderAction::BID, 2),
+              CommandResultCode::VALID_FOR_MATCHING_ENGINE);
+    MatcherEvent(common::MatcherEventType::TRADE, UID, SYMBOL_A, OrderAction::BID, 2, 10'000);
+  }
+
+  common::config::ExchangeConfiguration config_;
+  std::unique_ptr<processors::SharedPool> sharedPool_;
+  std::vector<std::unique_ptr<common::CoreSymbolSpecification>> specs_;
+  processors::RiskEngine engine_;
+  int64_t seq_ = 0;
+};
+
+TEST_F(RiskEngineMarginTest, ShouldCountOtherPositionsOfQuoteCurrencyOnly) {
+  OpenLongPosition();
+  // P&L of position A: 2 * 10'050 - 20'000 = 100
+  TopOfBook(SYMBOL_A, 10'050, 10'060);
+  // pending bid 3 of B (margin 150), pending bid 1 in EUR is not counted
+  Profile(UID)->accounts[EUR] = 1'000;
+  ASSERT_EQ(Place(UID, SYMBOL_EUR, OrderAction::BID, 1),
+            CommandResultCode::VALID_FOR_MATCHING_ENGINE);
+  Profile(UID)->accounts[USD] = 150 - 100 + 200;
+  ASSERT_EQ(Place(UID, SYMBOL_B, OrderAction::BID, 3),
+            CommandResultCode::VALID_FOR_MATCHING_ENGINE);
+
+  // B margin 150 -> 200: A P&L 100 minus A margin 200, own margin covered
+  ExpectRequiredBalance(UID, SYMBOL_B, USD, 200 - 100 + 200);
+  // D margin 0 -> 10: A 100 - 200, B pending 4 (margin 200)
+  ExpectRequiredBalance(UID, SYMBOL_D, USD, 10 - 100 + 200 + 200);
+}
+
+TEST_F(RiskEngineMarginTest, ShouldRecalculateFreeMarginWhenPriceChanges) {
+  OpenLongPosition();
+  TopOfBook(SYMBOL_A, 10'050, 10'060);
+  ExpectRequiredBalance(UID, SYMBOL_B, USD, 50 - 100 + 200);
+
+  // same top of book: cached free margin is still valid
+  TopOfBook(SYMBOL_A, 10'050, 10'060);
+  ExpectRequiredBalance(UID, SYMBOL_B, USD, 100 - 100 + 200);
+
+  // A bid drops to 9'900: P&L -200
+  TopOfBook(SYMBOL_A, 9'900, 10'060);
+  ExpectRequiredBalance(UID, SYMBOL_B, USD, 150 + 200 + 200);
+}
+
+TEST_F(RiskEngineMarginTest, ShouldAdjustCachedFreeMarginByPendingHold) {
+  // free margin of USD is cached by the first order (no positions), then
+  // reduced by margin of its pending bid 3 of B
+  Profile(UID)->accounts[USD] = 150;
+  ASSERT_EQ(Place(UID, SYMBOL_B, OrderAction::BID, 3),
+            CommandResultCode::VALID_FOR_MATCHING_ENGINE);
+  ExpectRequiredBalance(UID, SYMBOL_D, USD, 10 + 150);
+
+  // ask 2 of B does not increase its margin: accepted with any balance
+  Profile(UID)->accounts[USD] = 0;
+  EXPECT_EQ(Place(UID, SYMBOL_B, OrderAction::ASK, 2),
+            CommandResultCode::VALID_FOR_MATCHING_ENGINE);
+  // D bid 1 -> 2 (margin 20), B margin 150, D margin 10 of other position
+  ExpectRequiredBalance(UID, SYMBOL_D, USD, 20 + 150);
+}
+
+TEST_F(RiskEngineMarginTest, ShouldInvalidateFreeMarginWhenPendingOrdersAreReleased) {
+  Profile(UID)->accounts[USD] = 150;
+  ASSERT_EQ(Place(UID, SYMBOL_B, OrderAction::BID, 3),
+            CommandResultCode::VALID_FOR_MATCHING_ENGINE);
+  ExpectRequiredBalance(UID, SYMBOL_D, USD, 10 + 150);
+
+  // bid of B reduced 3 -> 2 (margin 100)
+  MatcherEvent(common::MatcherEventType::REDUCE, UID, SYMBOL_B, OrderAction::BID, 1, 0);
+  ExpectRequiredBalance(UID, SYMBOL_D, USD, 20 + 100);
+
+  // bid of B cancelled: position record is removed
+  MatcherEvent(common::MatcherEventType::REDUCE, UID, SYMBOL_B, OrderAction::BID, 2, 0);
+  EXPECT_EQ(Profile(UID)->positions.count(SYMBOL_B), 0u);
+  ExpectRequiredBalance(UID, SYMBOL_D, USD, 30);
+}
+
+TEST_F(RiskEngineMarginTest, ShouldRemoveEmptyPositionOfRejectedOrder) {
+  Profile(UID)->accounts[USD] = 150;
+  ASSERT_EQ(Place(UID, SYMBOL_B, OrderAction::BID, 3),
+            CommandResultCode::VALID_FOR_MATCHING_ENGINE);
+
+  Profile(UID)->accounts[USD] = 0;
+  EXPECT_EQ(Place(UID, SYMBOL_D, OrderAction::BID, 1), CommandResultCode::RISK_NSF);
+  EXPECT_EQ(Profile(UID)->positions.count(SYMBOL_D), 0u);
+  EXPECT_EQ(Profile(UID)->positions.count(SYMBOL_B), 1u);
+  ExpectRequiredBalance(UID, SYMBOL_D, USD, 10 + 150);
+}
+
+TEST_F(RiskEngineMarginTest, ShouldInvalidateFreeMarginOfTradingUsers) {
+  // taker is long 2 of A, maker is short 2 of A (both at 10'000)
+  OpenLongPosition();
+  TopOfBook(SYMBOL_A, 10'050, 10'060);
+  // taker: A P&L 100, margin 200
+  ExpectRequiredBalance(UID, SYMBOL_D, USD, 10 - 100 + 200);
+  // maker: A P&L at ask 10'060 is -120, margin of sell risk 2 * 120
+  ExpectRequiredBalance(MAKER_UID, SYMBOL_B, USD, 50 + 120 + 240);
+
+  // taker sells 1 to maker at 10'000 (orders reduce risk, no margin required)
+  ASSERT_EQ(Place(MAKER_UID, SYMBOL_A, OrderAction::BID, 1),
+            CommandResultCode::VALID_FOR_MATCHING_ENGINE);
+  Profile(UID)->accounts[USD] = 0;
+  ASSERT_EQ(Place(UID, SYMBOL_A, OrderAction::ASK, 1),
+            CommandResultCode::VALID_FOR_MATCHING_ENGINE);
+  MatcherEvent(common::MatcherEventType::TRADE, UID, SYMBOL_A, OrderAction::ASK, 1, 10'000);
+
+  // taker: long 1 (P&L 50, margin 100), D margin 10 -> 20
+  ExpectRequiredBalance(UID, SYMBOL_D, USD, 20 - 50 + 100);
+  // maker: short 1 (P&L -60, margin 120), B margin 50 -> 100
+  ExpectRequiredBalance(MAKER_UID, SYMBOL_B, USD, 100 + 60 + 120);
+}
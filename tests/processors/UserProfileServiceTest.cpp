@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/common/UserProfile.h>
+#include <exchange/core/common/UserStatus.h>
+#include <exchange/core/common/VectorBytesIn.h>
+#include <exchange/core/common/VectorBytesOut.h>
+#include <exchange/core/common/cmd/CommandResultCode.h>
+#include <exchange/core/processors/UserProfileService.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+using namespace exchange::core;
+using namespace exchange::core::processors;
+using common::cmd::CommandResultCode;
+
+namespace {
+
+// every uid of the map is found, by the dense index or by the map
+void ExpectAllFound(UserProfileService& service) {
+  for (const auto& [uid, profile] : service.userProfiles) {
+    ASSERT_EQ(service.GetUserProfile(uid), profile) << "uid=" << uid;
+  }
+}
+
+}  // namespace
+
+TEST(UserProfileServiceTest, ShouldFindDenseAndSparseUids) {
+  UserProfileService service;
+  const std::vector<int64_t> sparseUids = {-5, 1'000'000'000, INT64_MAX, INT64_MIN};
+  for (int64_t uid = 0; uid < 10'000; uid++) {
+    ASSERT_EQ(service.AddUser(uid), CommandResultCode::SUCCESS);
+  }
+  for (const int64_t uid : sparseUids) {
+    ASSERT_EQ(service.AddUser(uid), CommandResultCode::SUCCESS);
+  }
+
+  ExpectAllFound(service);
+  EXPECT_EQ(service.userProfiles.size(), 10'000u + sparseUids.size());
+  EXPECT_EQ(service.GetUserProfile(10'000), nullptr);
+  EXPECT_EQ(service.GetUserProfile(-1), nullptr);
+  EXPECT_EQ(service.AddUser(9'999), CommandResultCode::USER_MGMT_USER_ALREADY_EXISTS);
+  EXPECT_EQ(service.AddUser(-5), CommandResultCode::USER_MGMT_USER_ALREADY_EXISTS);
+}
+
+TEST(UserProfileServiceTest, ShouldIndexUidAddedBeforeItWasCovered) {
+  UserProfileService service;
+  // beyond dense index of a few users, covered once there are enough users
+  constexpr int64_t kEarlyUid = 10'000;
+  ASSERT_EQ(service.AddUser(kEarlyUid), CommandResultCode::SUCCESS);
+  for (int64_t uid = 1; uid <= 9'000; uid++) {
+    ASSERT_EQ(service.AddUser(uid), CommandResultCode::SUCCESS);
+  }
+  ExpectAllFound(service);
+
+  // removed from both indexes, then added back
+  ASSERT_EQ(service.SuspendUser(kEarlyUid), CommandResultCode::SUCCESS);
+  EXPECT_EQ(service.GetUserProfile(kEarlyUid), nullptr);
+  ASSERT_EQ(service.SuspendUser(5), CommandResultCode::SUCCESS);
+  EXPECT_EQ(service.GetUserProfile(5), nullptr);
+  EXPECT_EQ(service.userProfiles.size(), 8'999u);
+
+  ASSERT_EQ(service.ResumeUser(kEarlyUid), CommandResultCode::SUCCESS);
+  common::UserProfile* suspended = service.GetUserProfileOrAddSuspended(5);
+  ASSERT_NE(suspended, nullptr);
+  EXPECT_EQ(suspended->userStatus, common::UserStatus::SUSPENDED);
+  EXPECT_EQ(service.GetUserProfile(5), suspended);
+  ExpectAllFound(service);
+}
+
+TEST(UserProfileServiceTest, ShouldRebuildDenseIndexOnResetAndRestore) {
+  UserProfileService service;
+  for (int64_t uid = 1; uid <= 5'000; uid++) {
+    ASSERT_EQ(service.AddUser(uid), CommandResultCode::SUCCESS);
+    ASSERT_EQ(service.BalanceAdjustment(uid, 840, uid, 1), CommandResultCode::SUCCESS);
+  }
+
+  std::vector<uint8_t> snapshot;
+  common::VectorBytesOut out(snapshot);
+  service.WriteMarshallable(out);
+
+  service.Reset();
+  EXPECT_EQ(service.GetUserProfile(1), nullptr);
+  EXPECT_EQ(service.GetUserProfile(5'000), nullptr);
+
+  common::VectorBytesIn in(snapshot);
+  UserProfileService restored(&in);
+  ExpectAllFound(restored);
+  ASSERT_EQ(restored.userProfiles.size(), 5'000u);
+  for (int64_t uid = 1; uid <= 5'000; uid++) {
+    common::UserProfile* profile = restored.GetUserProfile(uid);
+    ASSERT_NE(profile, nullptr);
+    EXPECT_EQ(profile->accounts[840], uid);
+  }
+}
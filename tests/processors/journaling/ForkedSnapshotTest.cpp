@@ -0,0 +1,171 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <exchange/core/common/BytesIn.h>
+#include <exchange/core/common/BytesOut.h>
+#include <exchange/core/common/WriteBytesMarshallable.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/common/config/InitialStateConfiguration.h>
+#include <exchange/core/processors/journaling/DiskSerializationProcessor.h>
+#include <exchange/core/processors/journaling/DiskSerializationProcessorConfiguration.h>
+#include <gtest/gtest.h>
+#include <signal.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace exchange::core::common;
+using namespace exchange::core::common::config;
+using namespace exchange::core::processors::journaling;
+using ModuleType = ISerializationProcessor::SerializedModuleType;
+using SnapshotMode = DiskSerializationProcessorConfiguration::SnapshotMode;
+
+namespace {
+
+constexpr int64_t SNAPSHOT_ID = 7;
+
+/**
+ * State is written slowly, content is pid of the writer process
+ */
+class WriterPidState : public WriteBytesMarshallable {
+public:
+  void WriteMarshallable(BytesOut& bytes) const override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    bytes.WriteLong(::getpid());
+  }
+};
+
+/**
+ * State can not be written (child process fails)
+ */
+class FailingState : public WriteBytesMarshallable {
+public:
+  void WriteMarshallable(BytesOut&) const override {
+    throw std::runtime_error("state is not serializable");
+  }
+};
+
+}  // namespace
+
+class ForkedSnapshotTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    folder_ = (std::filesystem::temp_directory_path() / "forked_snapshot").string();
+    std::filesystem::remove_all(folder_);
+    exchangeCfg_.initStateCfg = InitialStateConfiguration::CleanStart("FORKED");
+    diskCfg_.snapshotMode = SnapshotMode::FORK;
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(folder_);
+  }
+
+  /**
+   * Snapshot files registered in main log
+   */
+  int32_t RegisteredFiles() const {
+    std::ifstream mainLog(folder_ + "/FORKED.eca");
+    int32_t files = 0;
+    for (std::string line; std::getline(mainLog, line);) {
+      files += line.find("snapshotId=" + std::to_string(SNAPSHOT_ID)) != std::string::npos;
+    }
+    return files;
+  }
+
+  int64_t LoadWriterPid(ModuleType type, int32_t instanceId) {
+    DiskSerializationProcessor processor(&exchangeCfg_, &diskCfg_);
+    int64_t pid = 0;
+    static_cast<ISerializationProcessor&>(processor).LoadData(
+      SNAPSHOT_ID, type, instanceId, [&pid](BytesIn* bytes) { pid = bytes->ReadLong(); });
+    return pid;
+  }
+
+  std::string folder_;
+  ExchangeConfiguration exchangeCfg_ = ExchangeConfiguration::Default();
+  DiskSerializationProcessorConfiguration diskCfg_{
+    (std::filesystem::temp_directory_path() / "forked_snapshot").string()};
+};
+
+TEST_F(ForkedSnapshotTest, ShouldRegisterSnapshotWhenChildrenAreReapedAutomatically) {
+  // writer is reaped automatically, waitpid fails with ECHILD
+  const auto previousHandler = ::signal(SIGCHLD, SIG_IGN);
+  {
+    DiskSerializationProcessor processor(&exchangeCfg_, &diskCfg_);
+    WriterPidState state;
+    EXPECT_TRUE(processor.StoreData(SNAPSHOT_ID, 1, 0, ModuleType::RISK_ENGINE, 0, &state));
+    EXPECT_TRUE(processor.StoreData(SNAPSHOT_ID, 1, 0, ModuleType::MATCHING_ENGINE_ROUTER, 0,
+                                    &state));
+    // destructor waits for snapshot writers
+  }
+  ::signal(SIGCHLD, previousHandler);
+
+  EXPECT_EQ(RegisteredFiles(), 2);
+  EXPECT_NE(LoadWriterPid(ModuleType::RISK_ENGINE, 0), ::getpid());
+}
+
+TEST_F(ForkedSnapshotTest, ShouldForkOnceForAllEngineInstances) {
+  constexpr int32_t engines = 3;
+  exchangeCfg_.performanceCfg.matchingEnginesNum = engines;
+  {
+    DiskSerializationProcessor processor(&exchangeCfg_, &diskCfg_);
+    WriterPidState state;
+    // engine threads processing the same persist command
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < engines; i++) {
+      threads.emplace_back([&processor, &state, i] {
+        EXPECT_TRUE(
+          processor.StoreData(SNAPSHOT_ID, 1, 0, ModuleType::MATCHING_ENGINE_ROUTER, i, &state));
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  EXPECT_EQ(RegisteredFiles(), engines);
+  const int64_t writerPid = LoadWriterPid(ModuleType::MATCHING_ENGINE_ROUTER, 0);
+  EXPECT_NE(writerPid, ::getpid());
+  for (int32_t i = 1; i < engines; i++) {
+    EXPECT_EQ(LoadWriterPid(ModuleType::MATCHING_ENGINE_ROUTER, i), writerPid);
+  }
+}
+
+TEST_F(ForkedSnapshotTest, ShouldReportWriterFailureToAllInstances) {
+  exchangeCfg_.performanceCfg.riskEnginesNum = 2;
+  {
+    DiskSerializationProcessor processor(&exchangeCfg_, &diskCfg_);
+    WriterPidState state;
+    FailingState failingState;
+    std::thread first([&processor, &state] {
+      EXPECT_TRUE(processor.StoreData(SNAPSHOT_ID, 1, 0, ModuleType::RISK_ENGINE, 0, &state));
+    });
+    EXPECT_TRUE(
+      processor.StoreData(SNAPSHOT_ID, 1, 0, ModuleType::RISK_ENGINE, 1, &failingState));
+    first.join();
+  }
+
+  // file of the first instance is complete, but writer exit status is shared:
+  // snapshot is not registered for any instance
+  EXPECT_TRUE(std::filesystem::exists(folder_ + "/FORKED_snapshot_7_RE0.ecs"));
+  EXPECT_EQ(RegisteredFiles(), 0);
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/ExchangeApi.h>
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/cmd/OrderCommandType.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/common/config/InitialStateConfiguration.h>
+#include <exchange/core/processors/journaling/DiskSerializationProcessor.h>
+#include <exchange/core/processors/journaling/DiskSerializationProcessorConfiguration.h>
+#include <exchange/core/processors/journaling/JournalCommand.h>
+#include <exchange/core/processors/journaling/JournalReader.h>
+#include <exchange/core/utils/Crc32c.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace exchange::core::common;
+using namespace exchange::core::common::cmd;
+using namespace exchange::core::common::config;
+using namespace exchange::core::processors::journaling;
+using exchange::core::utils::Crc32c;
+using JournalFormat = DiskSerializationProcessorConfiguration::JournalFormat;
+using JournalIo = DiskSerializationProcessorConfiguration::JournalIo;
+
+namespace {
+
+constexpr int64_t FIRST_SEQ = 1;
+constexpr int32_t COMMANDS_NUM = 20'000;
+
+std::vector<char> ReadAll(const std::string& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void WriteAll(const std::string& path, const std::vector<char>& data, size_t length) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(data.data(), static_cast<std::streamsize>(length));
+}
+
+/**
+ * Start of padding record ending the file (direct journal I/O), or file size
+ */
+size_t TrailingPaddingStart(const std::vector<char>& data) {
+  // marker(1) + record length(4) + CRC32C(4), up to one block of zeros
+  for (size_t length = 9; length <= std::min(data.size(), size_t{4096 + 9}); length++) {
+    const char* const record = data.data() + data.size() - length;
+    int32_t recordLength;
+    uint32_t crc;
+    std::memcpy(&recordLength, record + 1, sizeof(recordLength));
+    std::memcpy(&crc, record + 5, sizeof(crc));
+    if (record[0] == static_cast<char>(OrderCommandType::RESERVED_PADDING)
+        && static_cast<size_t>(recordLength) == length && crc == Crc32c::Compute(record, 5)) {
+      return data.size() - length;
+    }
+  }
+  return data.size();
+}
+
+}  // namespace
+
+/**
+ * Journal written with checksums is damaged at random offsets (torn write,
+ * flipped byte): replay must return exact prefix of journaled commands and
+ * report where damaged tail starts, truncating file there must give a file
+ * which is read completely.
+ * Direct journal I/O (if available) writes the same blocks with padding.
+ */
+class JournalFaultInjectionTest
+  : public ::testing::TestWithParam<std::tuple<JournalFormat, JournalIo>> {
+protected:
+  void SetUp() override {
+    folder_ = (std::filesystem::temp_directory_path() / "journal_fault_injection").string();
+    std::filesystem::remove_all(folder_);
+    WriteJournal();
+    original_ = ReadAll(journalPath_);
+    ASSERT_FALSE(original_.empty());
+    // damage of trailing padding loses no commands
+    commandsEnd_ = directIo_ ? TrailingPaddingStart(original_) : original_.size();
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(folder_);
+  }
+
+  void WriteJournal() {
+    auto exchangeCfg = ExchangeConfiguration::Default();
+    exchangeCfg.initStateCfg = InitialStateConfiguration::CleanStartJournaling("FAULTS");
+    // small buffers: many blocks, compressed and stored ones
+    DiskSerializationProcessorConfiguration diskCfg(folder_, 16 * 1024);
+    diskCfg.journalFormat = std::get<0>(GetParam());
+    diskCfg.journalIo = std::get<1>(GetParam());
+    diskCfg.journalChecksums = true;
+    diskCfg.journalIndexInterval = 0;
+
+    DiskSerializationProcessor processor(&exchangeCfg, &diskCfg);
+    processor.EnableJournaling(FIRST_SEQ - 1, nullptr);
+    directIo_ = processor.IsDirectJournalIo();
+
+    std::mt19937_64 random(1);
+    int64_t timestamp = 1'700'000'000'000'000'000LL;
+    for (int64_t seq = FIRST_SEQ; seq < FIRST_SEQ + COMMANDS_NUM; seq++) {
+      OrderCommand cmd;
+      if (random() % 500 == 0) {
+        // binary command payload record, compressible or not, up to few buffers long
+        auto& payload = payloads_.emplace_back(4 + random() % 40'000);
+        const bool compressible = random() % 2 == 0;
+        for (size_t i = 0; i < payload.size(); i++) {
+          payload[i] = static_cast<uint8_t>(compressible ? i % 7 : random());
+        }
+        cmd.command = OrderCommandType::BINARY_DATA_COMMAND;
+        cmd.payload = &payload;
+        cmd.symbol = -1;
+        cmd.userCookie = static_cast<int32_t>(seq);
+        timestamp += 100;
+        cmd.timestamp = timestamp;
+        expected_.push_back(cmd);
+        processor.WriteToJournal(&cmd, seq, false);
+        continue;
+      }
+      switch (random() % 3) {
+        case 0:
+          cmd.command = OrderCommandType::PLACE_ORDER;
+          cmd.price = 10'000 + static_cast<int64_t>(random() % 100);
+          cmd.reserveBidPrice = cmd.price;
+          cmd.size = 1 + static_cast<int64_t>(random() % 50);
+          cmd.action = random() % 2 ? OrderAction::BID : OrderAction::ASK;
+          cmd.orderType = OrderType::GTC;
+          break;
+        case 1:
+          cmd.command = OrderCommandType::MOVE_ORDER;
+          cmd.price = 10'000 + static_cast<int64_t>(random() % 100);
+          break;
+        default:
+          cmd.command = OrderCommandType::CANCEL_ORDER;
+          break;
+      }
+      cmd.orderId = seq;
+      cmd.uid = 1 + static_cast<int64_t>(random() % 1000);
+      cmd.symbol = 100 + static_cast<int32_t>(random() % 5);
+      timestamp += 100 + static_cast<int64_t>(random() % 2000);
+      cmd.timestamp = timestamp;
+      expected_.push_back(cmd);
+      // random batch sizes (end of batch flushes journal buffer)
+      processor.WriteToJournal(&cmd, seq, random() % 64 == 0);
+    }
+    OrderCommand shutdown;
+    shutdown.command = OrderCommandType::SHUTDOWN_SIGNAL;
+    processor.WriteToJournal(&shutdown, FIRST_SEQ + COMMANDS_NUM, true);
+
+    journalPath_ = folder_ + "/FAULTS_journal_0_0001.ecj";
+  }
+
+  /**
+   * Read journal file, check that commands are exact prefix of written ones
+   * @return number of read commands
+   */
+  size_t ReadAndCheckPrefix(JournalReader& reader) {
+    std::vector<JournalCommand> commands;
+    std::deque<std::vector<uint8_t>> payloads;
+    int64_t lastSeq = FIRST_SEQ - 1;
+    reader.ReadFile(journalPath_, std::numeric_limits<int64_t>::min(),
+                    std::numeric_limits<int64_t>::max(), lastSeq,
+                    [&commands, &payloads](const JournalCommand* cmds, size_t count) {
+                      commands.insert(commands.end(), cmds, cmds + count);
+                      // payload is valid only during the call
+                      for (size_t i = commands.size() - count; i < commands.size(); i++) {
+                        auto& cmd = commands[i];
+                        if (cmd.payload != nullptr) {
+                          cmd.payload =
+                            payloads.emplace_back(cmd.payload, cmd.payload + cmd.payloadLength)
+                              .data();
+                        }
+                      }
+                    });
+    EXPECT_LE(commands.size(), expected_.size());
+    for (size_t i = 0; i < commands.size() && i < expected_.size(); i++) {
+      const auto& cmd = commands[i];
+      const auto& exp = expected_[i];
+      EXPECT_EQ(cmd.seq, FIRST_SEQ + static_cast<int64_t>(i));
+      EXPECT_EQ(cmd.command, exp.command);
+      EXPECT_EQ(cmd.orderId, exp.orderId);
+      EXPECT_EQ(cmd.uid, exp.uid);
+      EXPECT_EQ(cmd.symbol, exp.symbol);
+      EXPECT_EQ(cmd.timestamp, exp.timestamp);
+      if (exp.payload != nullptr) {
+        EXPECT_EQ(cmd.userCookie, exp.userCookie);
+        EXPECT_EQ(cmd.payloadLength, exp.payload->size());
+        EXPECT_TRUE(cmd.payloadLength == exp.payload->size()
+                    && std::memcmp(cmd.payload, exp.payload->data(), cmd.payloadLength) == 0);
+      } else if (exp.command != OrderCommandType::CANCEL_ORDER) {
+        EXPECT_EQ(cmd.price, exp.price);
+      }
+      if (exp.command == OrderCommandType::PLACE_ORDER) {
+        EXPECT_EQ(cmd.size, exp.size);
+        EXPECT_EQ(cmd.action, exp.action);
+      }
+      if (::testing::Test::HasFailure()) {
+        ADD_FAILURE() << "command mismatch at seq " << cmd.seq;
+        break;
+      }
+    }
+    return commands.size();
+  }
+
+  /**
+   * Recovery: file is truncated at damaged tail and read again
+   */
+  void RecoverAndCheck(JournalReader& reader, size_t commandsBefore) {
+    const int64_t damagedAt = reader.DamagedAt();
+    if (damagedAt >= 0) {
+      std::filesystem::resize_file(journalPath_, static_cast<uintmax_t>(damagedAt));
+    }
+    EXPECT_EQ(ReadAndCheckPrefix(reader), commandsBefore);
+    EXPECT_EQ(reader.DamagedAt(), -1);
+  }
+
+  std::string folder_;
+  std::string journalPath_;
+  std::vector<OrderCommand> expected_;
+  std::deque<std::vector<uint8_t>> payloads_;
+  std::vector<char> original_;
+  bool directIo_ = false;
+  size_t commandsEnd_ = 0;  // end of last command record
+};
+
+TEST_P(JournalFaultInjectionTest, ShouldReadUndamagedJournal) {
+  JournalReader reader(2, 8, 256);
+  EXPECT_EQ(ReadAndCheckPrefix(reader), expected_.size());
+  EXPECT_EQ(reader.DamagedAt(), -1);
+}
+
+TEST_P(JournalFaultInjectionTest, ShouldRecoverFromTruncatedTail) {
+  JournalReader reader(2, 8, 256);
+  std::mt19937_64 random(2);
+  for (int i = 0; i < 100 && !HasFailure(); i++) {
+    const size_t length = random() % original_.size();
+    WriteAll(journalPath_, original_, length);
+    const size_t commands = ReadAndCheckPrefix(reader);
+    if (length < commandsEnd_) {
+      EXPECT_LT(commands, expected_.size());
+    }
+    EXPECT_LE(reader.DamagedAt(), static_cast<int64_t>(length));
+    RecoverAndCheck(reader, commands);
+  }
+}
+
+TEST_P(JournalFaultInjectionTest, ShouldStopAtCorruptedBlock) {
+  JournalReader reader(2, 8, 256);
+  std::mt19937_64 random(3);
+  for (int i = 0; i < 200 && !HasFailure(); i++) {
+    // marker of the first block identifies journal format, it is not damaged
+    const size_t offset = 1 + random() % (original_.size() - 1);
+    auto damaged = original_;
+    damaged[offset] = static_cast<char>(damaged[offset] ^ (1 + random() % 255));
+    WriteAll(journalPath_, damaged, damaged.size());
+    const size_t commands = ReadAndCheckPrefix(reader);
+    if (offset < commandsEnd_) {
+      EXPECT_LT(commands, expected_.size());
+    }
+    EXPECT_GE(reader.DamagedAt(), 0);
+    EXPECT_LE(reader.DamagedAt(), static_cast<int64_t>(offset));
+    RecoverAndCheck(reader, commands);
+  }
+}
+
+TEST_P(JournalFaultInjectionTest, ShouldStopAtGarbageAfterLastBlock) {
+  // preallocated or partially written space filled with zeros
+  auto damaged = original_;
+  damaged.resize(original_.size() + 4096, 0);
+  WriteAll(journalPath_, damaged, damaged.size());
+  JournalReader reader(2, 8, 256);
+  EXPECT_EQ(ReadAndCheckPrefix(reader), expected_.size());
+  EXPECT_EQ(reader.DamagedAt(), static_cast<int64_t>(original_.size()));
+  RecoverAndCheck(reader, expected_.size());
+}
+
+TEST_P(JournalFaultInjectionTest, ShouldPadDirectJournalToBlockBoundary) {
+  if (!directIo_) {
+    GTEST_SKIP() << "direct journal I/O is not configured or not available";
+  }
+  EXPECT_EQ(original_.size() % 4096, 0u);
+  EXPECT_LT(commandsEnd_, original_.size());
+  // padded tail of a write is rewritten by the next one: padding ends the file only
+  EXPECT_LT(original_.size() - commandsEnd_, 4096u + 9);
+  JournalReader reader(2, 8, 256);
+  EXPECT_EQ(ReadAndCheckPrefix(reader), expected_.size());
+  EXPECT_EQ(reader.DamagedAt(), -1);
+}
+
+INSTANTIATE_TEST_SUITE_P(JournalFormats,
+                         JournalFaultInjectionTest,
+                         ::testing::Combine(::testing::Values(JournalFormat::V1, JournalFormat::V2),
+                                            ::testing::Values(JournalIo::STREAM,
+                                                              JournalIo::IO_URING_DIRECT)));
+
+TEST(Crc32cTest, ShouldMatchReferenceValues) {
+  const std::string digits = "123456789";
+  EXPECT_EQ(Crc32c::Compute(digits.data(), digits.size()), 0xE3069283u);
+  EXPECT_EQ(Crc32c::Compute(digits.data() + 4, 5, Crc32c::Compute(digits.data(), 4)),
+            0xE3069283u);
+
+  // long buffer (interleaved streams) equals bytewise computation
+  std::vector<uint8_t> data(100'000);
+  std::mt19937 random(4);
+  for (auto& b : data) {
+    b = static_cast<uint8_t>(random());
+  }
+  uint32_t crc = 0;
+  for (const auto b : data) {
+    crc = Crc32c::Compute(&b, 1, crc);
+  }
+  EXPECT_EQ(Crc32c::Compute(data.data(), data.size()), crc);
+}
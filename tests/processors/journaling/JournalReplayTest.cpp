@@ -0,0 +1,584 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <disruptor/BusySpinWaitStrategy.h>
+#include <exchange/core/ExchangeApi.h>
+#include <exchange/core/common/BytesOut.h>
+#include <exchange/core/common/OrderAction.h>
+#include <exchange/core/common/OrderType.h>
+#include <exchange/core/common/WriteBytesMarshallable.h>
+#include <exchange/core/common/cmd/OrderCommand.h>
+#include <exchange/core/common/cmd/OrderCommandType.h>
+#include <exchange/core/common/config/ExchangeConfiguration.h>
+#include <exchange/core/common/config/InitialStateConfiguration.h>
+#include <exchange/core/processors/journaling/DiskSerializationProcessor.h>
+#include <exchange/core/processors/journaling/DiskSerializationProcessorConfiguration.h>
+#include <exchange/core/processors/journaling/JournalCommand.h>
+#include <exchange/core/processors/journaling/JournalIndex.h>
+#include <exchange/core/processors/journaling/JournalReader.h>
+#include <gtest/gtest.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace exchange::core;
+using namespace exchange::core::common;
+using namespace exchange::core::common::cmd;
+using namespace exchange::core::common::config;
+using namespace exchange::core::processors::journaling;
+using SnapshotMode = DiskSerializationProcessorConfiguration::SnapshotMode;
+using DurabilityMode = DiskSerializationProcessorConfiguration::DurabilityMode;
+using JournalIo = DiskSerializationProcessorConfiguration::JournalIo;
+
+namespace {
+
+constexpr int64_t COMMANDS_NUM = 10'000;
+constexpr int64_t SNAPSHOT_ID = 42;
+
+// Small index interval and journal files: many index entries in several files
+constexpr int32_t INDEX_INTERVAL = 1024;
+constexpr int64_t JOURNAL_FILE_MAX_SIZE = 16 * 1024;
+
+/**
+ * Records replayed commands instead of publishing them
+ */
+class RecordingApi : public exchange::core::ExchangeApi<disruptor::BusySpinWaitStrategy> {
+public:
+  RecordingApi() : ExchangeApi(nullptr) {}
+
+  void GroupingControl(int64_t timestampNs, int64_t mode) override {}
+
+  void ReplayCommandsBatch(const JournalCommand* cmds, size_t count) override {
+    for (size_t i = 0; i < count; i++) {
+      const auto& cmd = cmds[i];
+      seqs.push_back(cmd.seq);
+      for (const int64_t value :
+           {cmd.seq, static_cast<int64_t>(cmd.command), static_cast<int64_t>(cmd.serviceFlags),
+            cmd.eventsGroup, cmd.timestamp, cmd.orderId, static_cast<int64_t>(cmd.symbol),
+            cmd.price, cmd.size, cmd.reserveBidPrice, static_cast<int64_t>(cmd.action),
+            static_cast<int64_t>(cmd.orderType), cmd.uid, static_cast<int64_t>(cmd.userCookie)}) {
+        stateHash = stateHash * 31 + std::hash<int64_t>{}(value);
+      }
+    }
+  }
+
+  std::vector<int64_t> seqs;
+  size_t stateHash = 0;  // all fields of replayed commands, order sensitive
+};
+
+/**
+ * Small non-empty state
+ */
+class MarkerState : public WriteBytesMarshallable {
+public:
+  void WriteMarshallable(BytesOut& bytes) const override {
+    bytes.WriteLong(SNAPSHOT_ID);
+  }
+};
+
+/**
+ * Snapshot writer never finishes (exchange is killed while it is running)
+ */
+class StalledState : public WriteBytesMarshallable {
+public:
+  void WriteMarshallable(BytesOut& bytes) const override {
+    std::this_thread::sleep_for(std::chrono::seconds(30));
+  }
+};
+
+void WriteCommand(DiskSerializationProcessor& processor, OrderCommandType type, int64_t seq) {
+  OrderCommand cmd;
+  cmd.command = type;
+  cmd.uid = seq;
+  cmd.orderId = type == OrderCommandType::ADD_USER ? 0 : SNAPSHOT_ID;
+  cmd.timestamp = 1'700'000'000'000'000'000LL + seq;
+  processor.WriteToJournal(&cmd, seq, seq % 100 == 0);
+}
+
+/**
+ * Orders, balance adjustments and users, fields change with every command
+ */
+void WriteMixedCommand(DiskSerializationProcessor& processor, int64_t seq) {
+  static constexpr OrderCommandType TYPES[] = {
+    OrderCommandType::ADD_USER, OrderCommandType::BALANCE_ADJUSTMENT,
+    OrderCommandType::PLACE_ORDER, OrderCommandType::MOVE_ORDER,
+    OrderCommandType::REDUCE_ORDER, OrderCommandType::CANCEL_ORDER};
+  OrderCommand cmd;
+  cmd.command = TYPES[seq % std::size(TYPES)];
+  cmd.uid = seq / 10;
+  cmd.symbol = static_cast<int32_t>(seq % 3);
+  cmd.orderId = seq / 2;
+  cmd.price = 10'000 + seq % 97;
+  cmd.reserveBidPrice = cmd.price + seq % 5;
+  cmd.size = 1 + seq % 13;
+  cmd.action = seq % 4 < 2 ? OrderAction::BID : OrderAction::ASK;
+  cmd.orderType = cmd.command == OrderCommandType::BALANCE_ADJUSTMENT ? OrderTypeFromCode(0)
+                                                                      : OrderType::GTC;
+  cmd.userCookie = static_cast<int32_t>(seq % 1000);
+  cmd.eventsGroup = seq / 50;
+  cmd.timestamp = 1'700'000'000'000'000'000LL + seq * 1'000 + seq % 7;
+  processor.WriteToJournal(&cmd, seq, seq % 100 == 0);
+}
+
+std::vector<int64_t> SeqRange(int64_t from, int64_t to) {
+  std::vector<int64_t> seqs;
+  for (int64_t seq = from; seq <= to; seq++) {
+    seqs.push_back(seq);
+  }
+  return seqs;
+}
+
+}  // namespace
+
+class JournalReplayTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    folder_ = (std::filesystem::temp_directory_path() / "journal_replay").string();
+    std::filesystem::remove_all(folder_);
+    exchangeCfg_.initStateCfg = InitialStateConfiguration::CleanStartJournaling("REPLAY");
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(folder_);
+  }
+
+  /**
+   * Replay journal of snapshot taken at baseSeq into fresh processor
+   */
+  void Replay(int64_t snapshotId, int64_t baseSeq, RecordingApi& api) {
+    auto exchangeCfg = exchangeCfg_;
+    exchangeCfg.initStateCfg =
+      InitialStateConfiguration::LastKnownStateFromJournal("REPLAY", snapshotId, baseSeq);
+    DiskSerializationProcessorConfiguration diskCfg(folder_);
+    DiskSerializationProcessor processor(&exchangeCfg, &diskCfg);
+    processor.ReplayJournalFull(&exchangeCfg.initStateCfg, &api);
+  }
+
+  std::vector<int64_t> Replay(int64_t snapshotId, int64_t baseSeq) {
+    RecordingApi api;
+    Replay(snapshotId, baseSeq, api);
+    return api.seqs;
+  }
+
+  /**
+   * Journal of clean start (snapshot 0) with commands 1..COMMANDS_NUM,
+   * indexed every INDEX_INTERVAL bytes, rotated every JOURNAL_FILE_MAX_SIZE
+   * @return true if journal was written with direct journal I/O
+   */
+  bool WriteIndexedJournal(JournalIo journalIo = JournalIo::STREAM) {
+    DiskSerializationProcessorConfiguration diskCfg(folder_);
+    diskCfg.journalIndexInterval = INDEX_INTERVAL;
+    diskCfg.journalFileMaxSize = JOURNAL_FILE_MAX_SIZE;
+    diskCfg.journalIo = journalIo;
+    DiskSerializationProcessor processor(&exchangeCfg_, &diskCfg);
+    processor.EnableJournaling(0, nullptr);
+    for (int64_t seq = 1; seq <= COMMANDS_NUM; seq++) {
+      WriteMixedCommand(processor, seq);
+    }
+    WriteCommand(processor, OrderCommandType::SHUTDOWN_SIGNAL, COMMANDS_NUM + 1);
+    return processor.IsDirectJournalIo();
+  }
+
+  int32_t LastJournalFile() const {
+    int32_t fileIndex = 1;
+    while (std::filesystem::exists(JournalPath(fileIndex + 1, ".ecj"))) {
+      fileIndex++;
+    }
+    return fileIndex;
+  }
+
+  /**
+   * Sequence of last command in journal file (-1 if none)
+   */
+  int64_t LastJournaledSeq(int32_t fileIndex) const {
+    JournalReader reader(1, 4, 256);
+    int64_t lastSeq = -1;
+    reader.ReadFile(JournalPath(fileIndex, ".ecj"), std::numeric_limits<int64_t>::min(),
+                    std::numeric_limits<int64_t>::max(), lastSeq,
+                    [](const JournalCommand*, size_t) {});
+    return lastSeq;
+  }
+
+  static std::string ReadFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  }
+
+  std::string JournalPath(int32_t fileIndex, const char* extension) const {
+    return folder_ + "/REPLAY_journal_0_000" + std::to_string(fileIndex) + extension;
+  }
+
+  /**
+   * Sequence of first index entry of journal file
+   */
+  int64_t FirstIndexedSeq(int32_t fileIndex) const {
+    std::ifstream in(JournalPath(fileIndex, ".eci"), std::ios::binary);
+    int64_t seq = -1;
+    in.read(reinterpret_cast<char*>(&seq), sizeof(seq));
+    return seq;
+  }
+
+  DiskSerializationProcessor::JournalPosition Seek(int64_t afterSeq) {
+    DiskSerializationProcessorConfiguration diskCfg(folder_);
+    DiskSerializationProcessor processor(&exchangeCfg_, &diskCfg);
+    return processor.SeekJournal(0, afterSeq);
+  }
+
+  /**
+   * Step replays between consecutive bounds into the same api
+   */
+  void ReplaySteps(const std::vector<int64_t>& bounds, RecordingApi& api) {
+    DiskSerializationProcessorConfiguration diskCfg(folder_);
+    DiskSerializationProcessor processor(&exchangeCfg_, &diskCfg);
+    for (size_t i = 1; i < bounds.size(); i++) {
+      processor.ReplayJournalStep(0, bounds[i - 1], bounds[i], &api);
+    }
+  }
+
+  std::vector<int64_t> ReplayStep(int64_t seqFrom, int64_t seqTo) {
+    RecordingApi api;
+    ReplaySteps({seqFrom, seqTo}, api);
+    return api.seqs;
+  }
+
+  std::string folder_;
+  ExchangeConfiguration exchangeCfg_ = ExchangeConfiguration::Default();
+};
+
+/**
+ * Forked snapshot writer is still running when exchange process is killed:
+ * new snapshot is never stored, recovery from previous snapshot must replay
+ * commands journaled after persist command as well.
+ */
+TEST_F(JournalReplayTest, ShouldRecoverCommandsJournaledWhileForkedSnapshotIsWritten) {
+  constexpr int64_t persistSeq = COMMANDS_NUM + 1;
+  constexpr int64_t lastSeq = 2 * COMMANDS_NUM + 1;
+
+  const pid_t pid = ::fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // exchange process: own process group, killed together with snapshot writer
+    ::setpgid(0, 0);
+    DiskSerializationProcessorConfiguration diskCfg(folder_);
+    diskCfg.snapshotMode = SnapshotMode::FORK;
+    DiskSerializationProcessor processor(&exchangeCfg_, &diskCfg);
+    processor.EnableJournaling(0, nullptr);
+    for (int64_t seq = 1; seq <= COMMANDS_NUM; seq++) {
+      WriteCommand(processor, OrderCommandType::ADD_USER, seq);
+    }
+    WriteCommand(processor, OrderCommandType::PERSIST_STATE_RISK, persistSeq);
+    StalledState state;
+    processor.StoreData(SNAPSHOT_ID, persistSeq, 0,
+                        DiskSerializationProcessor::SerializedModuleType::RISK_ENGINE, 0, &state);
+    for (int64_t seq = persistSeq + 1; seq <= lastSeq; seq++) {
+      WriteCommand(processor, OrderCommandType::ADD_USER, seq);
+    }
+    WriteCommand(processor, OrderCommandType::SHUTDOWN_SIGNAL, lastSeq + 1);
+    ::kill(0, SIGKILL);
+    ::_exit(1);
+  }
+
+  int status = 0;
+  ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+  ASSERT_TRUE(WIFSIGNALED(status));
+  EXPECT_FALSE(std::filesystem::exists(folder_ + "/REPLAY_snapshot_42_RE0.ecs"));
+
+  auto expected = SeqRange(1, COMMANDS_NUM);
+  const auto afterPersist = SeqRange(persistSeq + 1, lastSeq);
+  expected.insert(expected.end(), afterPersist.begin(), afterPersist.end());
+  EXPECT_EQ(Replay(0, 0), expected);
+
+  // journal of new snapshot is complete as well (used once snapshot is stored)
+  EXPECT_EQ(Replay(SNAPSHOT_ID, persistSeq), afterPersist);
+}
+
+/**
+ * Once all engines of new snapshot are stored, previous snapshot journal is
+ * not continued anymore
+ */
+TEST_F(JournalReplayTest, ShouldStopPreviousSnapshotJournalOnceSnapshotIsStored) {
+  constexpr int64_t persistSeq = COMMANDS_NUM + 1;
+  constexpr int64_t lastSeq = 2 * COMMANDS_NUM + 1;
+  {
+    DiskSerializationProcessorConfiguration diskCfg(folder_);
+    DiskSerializationProcessor processor(&exchangeCfg_, &diskCfg);
+    processor.EnableJournaling(0, nullptr);
+    for (int64_t seq = 1; seq <= COMMANDS_NUM; seq++) {
+      WriteCommand(processor, OrderCommandType::ADD_USER, seq);
+    }
+    WriteCommand(processor, OrderCommandType::PERSIST_STATE_RISK, persistSeq);
+    MarkerState state;
+    const auto& perfCfg = exchangeCfg_.performanceCfg;
+    for (int32_t i = 0; i < perfCfg.matchingEnginesNum; i++) {
+      ASSERT_TRUE(processor.StoreData(
+        SNAPSHOT_ID, persistSeq, 0,
+        DiskSerializationProcessor::SerializedModuleType::MATCHING_ENGINE_ROUTER, i, &state));
+    }
+    for (int32_t i = 0; i < perfCfg.riskEnginesNum; i++) {
+      ASSERT_TRUE(processor.StoreData(SNAPSHOT_ID, persistSeq, 0,
+                                      DiskSerializationProcessor::SerializedModuleType::RISK_ENGINE,
+                                      i, &state));
+    }
+    for (int64_t seq = persistSeq + 1; seq <= lastSeq; seq++) {
+      WriteCommand(processor, OrderCommandType::ADD_USER, seq);
+    }
+    WriteCommand(processor, OrderCommandType::SHUTDOWN_SIGNAL, lastSeq + 1);
+  }
+
+  // snapshot is stored before next commands are written
+  EXPECT_EQ(Replay(0, 0), SeqRange(1, COMMANDS_NUM));
+  EXPECT_EQ(Replay(SNAPSHOT_ID, persistSeq), SeqRange(persistSeq + 1, lastSeq));
+}
+
+/**
+ * Step replay starts at indexed position: in the first block, in the middle
+ * of a file and in the next file after rotation
+ */
+TEST_F(JournalReplayTest, ShouldSeekWithJournalIndex) {
+  WriteIndexedJournal();
+  ASSERT_TRUE(std::filesystem::exists(JournalPath(3, ".ecj")));
+  const int64_t secondFileSeq = FirstIndexedSeq(2);
+  const int64_t thirdFileSeq = FirstIndexedSeq(3);
+  ASSERT_GT(secondFileSeq, 1);
+  ASSERT_GT(thirdFileSeq, secondFileSeq);
+
+  // first block
+  auto position = Seek(3);
+  EXPECT_EQ(position.fileIndex, 1);
+  EXPECT_EQ(position.offset, 0);
+  EXPECT_EQ(ReplayStep(3, 50), SeqRange(4, 50));
+
+  // middle of first file
+  const int64_t midSeq = secondFileSeq / 2;
+  position = Seek(midSeq);
+  EXPECT_EQ(position.fileIndex, 1);
+  EXPECT_GT(position.offset, 0);
+  EXPECT_LE(position.seq, midSeq + 1);
+  EXPECT_EQ(ReplayStep(midSeq, midSeq + 500), SeqRange(midSeq + 1, midSeq + 500));
+
+  // next file, from its first command and from its middle
+  position = Seek(secondFileSeq - 1);
+  EXPECT_EQ(position.fileIndex, 2);
+  EXPECT_EQ(position.offset, 0);
+  EXPECT_EQ(ReplayStep(secondFileSeq - 1, thirdFileSeq + 10),
+            SeqRange(secondFileSeq, thirdFileSeq + 10));
+
+  const int64_t secondFileMidSeq = (secondFileSeq + thirdFileSeq) / 2;
+  position = Seek(secondFileMidSeq);
+  EXPECT_EQ(position.fileIndex, 2);
+  EXPECT_GT(position.offset, 0);
+  EXPECT_EQ(ReplayStep(secondFileMidSeq, COMMANDS_NUM),
+            SeqRange(secondFileMidSeq + 1, COMMANDS_NUM));
+}
+
+/**
+ * Index is only a hint: without it or with an entry pointing beyond the end
+ * of journal file, replay starts earlier and still skips commands <= seqFrom
+ */
+TEST_F(JournalReplayTest, ShouldReplayFromEarlierPositionIfIndexIsNotUsable) {
+  WriteIndexedJournal();
+  const int64_t secondFileSeq = FirstIndexedSeq(2);
+  const int64_t afterSeq = (secondFileSeq + FirstIndexedSeq(3)) / 2;
+  const auto expected = SeqRange(afterSeq + 1, COMMANDS_NUM);
+
+  // missing index of second file: last indexed position of first file
+  std::filesystem::remove(JournalPath(2, ".eci"));
+  auto position = Seek(afterSeq);
+  EXPECT_EQ(position.fileIndex, 1);
+  EXPECT_GT(position.offset, 0);
+  EXPECT_EQ(ReplayStep(afterSeq, COMMANDS_NUM), expected);
+
+  // missing index of first file: start of journal
+  std::filesystem::remove(JournalPath(1, ".eci"));
+  position = Seek(afterSeq);
+  EXPECT_EQ(position.fileIndex, 1);
+  EXPECT_EQ(position.offset, 0);
+  EXPECT_EQ(ReplayStep(afterSeq, COMMANDS_NUM), expected);
+}
+
+TEST_F(JournalReplayTest, ShouldIgnoreIndexEntryBeyondEndOfJournalFile) {
+  WriteIndexedJournal();
+  const int32_t lastFile = LastJournalFile();
+  const int64_t afterSeq = COMMANDS_NUM - 5;
+  ASSERT_LT(FirstIndexedSeq(lastFile), afterSeq);
+
+  // entry of a block not written yet (index is not synced with journal)
+  {
+    const auto fileSize =
+      static_cast<int64_t>(std::filesystem::file_size(JournalPath(lastFile, ".ecj")));
+    std::ofstream index(JournalPath(lastFile, ".eci"), std::ios::binary | std::ios::app);
+    JournalIndex::Append(index, {afterSeq, 0, fileSize + INDEX_INTERVAL});
+  }
+
+  // last indexed position of previous file is used
+  const auto position = Seek(afterSeq);
+  EXPECT_EQ(position.fileIndex, lastFile - 1);
+  EXPECT_EQ(ReplayStep(afterSeq, COMMANDS_NUM), SeqRange(afterSeq + 1, COMMANDS_NUM));
+}
+
+/**
+ * Default configuration writes only v1 records and unchecked LZ4 blocks,
+ * which releases without v2 format and checksums can replay
+ */
+TEST_F(JournalReplayTest, ShouldWriteJournalReadableByEarlierReleasesByDefault) {
+  WriteIndexedJournal();
+  for (int32_t fileIndex = 1; fileIndex <= LastJournalFile(); fileIndex++) {
+    std::ifstream in(JournalPath(fileIndex, ".ecj"), std::ios::binary);
+    const std::vector<char> data((std::istreambuf_iterator<char>(in)),
+                                 std::istreambuf_iterator<char>());
+    size_t pos = 0;
+    while (pos < data.size()) {
+      const auto code = static_cast<int8_t>(data[pos]);
+      if (code == static_cast<int8_t>(OrderCommandType::RESERVED_COMPRESSED)) {
+        // marker, stored size, original size, LZ4 data
+        int32_t storedSize;
+        std::memcpy(&storedSize, &data[pos + 1], sizeof(storedSize));
+        pos += 9 + static_cast<size_t>(storedSize);
+      } else {
+        const int32_t size = JournalReader::CommandSize(code);
+        ASSERT_GT(size, 0) << "file " << fileIndex << " offset " << pos << " code " << +code;
+        pos += static_cast<size_t>(size);
+      }
+    }
+    EXPECT_EQ(pos, data.size());
+  }
+}
+
+/**
+ * Consecutive step replays (each one starting at an indexed position inside
+ * the journal) replay exactly the same commands as full replay
+ */
+TEST_F(JournalReplayTest, ShouldReplayStepsLikeFullReplay) {
+  WriteIndexedJournal();
+  RecordingApi full;
+  Replay(0, 0, full);
+  ASSERT_EQ(full.seqs, SeqRange(1, COMMANDS_NUM));
+
+  const int64_t secondFileSeq = FirstIndexedSeq(2);
+  ASSERT_GT(secondFileSeq, 4);
+  const std::vector<int64_t> bounds = {
+    0, 1, 2, secondFileSeq / 2, secondFileSeq - 1, secondFileSeq, 6543, 6600, 9999, COMMANDS_NUM};
+  RecordingApi steps;
+  ReplaySteps(bounds, steps);
+  EXPECT_EQ(steps.seqs, full.seqs);
+  EXPECT_EQ(steps.stateHash, full.stateHash);
+
+  // every step replays (seqFrom, seqTo] and stops after seqTo
+  for (size_t i = 1; i < bounds.size(); i++) {
+    EXPECT_EQ(ReplayStep(bounds[i - 1], bounds[i]), SeqRange(bounds[i - 1] + 1, bounds[i]));
+  }
+
+  // empty step, step ending after the end of journal
+  EXPECT_TRUE(ReplayStep(500, 500).empty());
+  EXPECT_TRUE(ReplayStep(600, 500).empty());
+  EXPECT_EQ(ReplayStep(COMMANDS_NUM - 10, COMMANDS_NUM + 1'000),
+            SeqRange(COMMANDS_NUM - 9, COMMANDS_NUM));
+}
+
+/**
+ * Journal written with O_DIRECT by io_uring consists of 4 KB writes, padded
+ * tail block of a flush is rewritten by the next one: file is the journal
+ * written through page cache followed by padding of the last flush, full,
+ * indexed and step replay give the same commands
+ */
+TEST_F(JournalReplayTest, ShouldReplayDirectJournalLikeStreamJournal) {
+  WriteIndexedJournal();
+  RecordingApi stream;
+  Replay(0, 0, stream);
+  std::vector<std::string> streamFiles;
+  for (int32_t fileIndex = 1; fileIndex <= LastJournalFile(); fileIndex++) {
+    streamFiles.push_back(ReadFile(JournalPath(fileIndex, ".ecj")));
+  }
+  std::filesystem::remove_all(folder_);
+
+  if (!WriteIndexedJournal(JournalIo::IO_URING_DIRECT)) {
+    GTEST_SKIP() << "io_uring or O_DIRECT is not available";
+  }
+  const int32_t lastFile = LastJournalFile();
+  ASSERT_GT(lastFile, 1);
+  ASSERT_EQ(static_cast<size_t>(lastFile), streamFiles.size());
+  for (int32_t fileIndex = 1; fileIndex <= lastFile; fileIndex++) {
+    const std::string direct = ReadFile(JournalPath(fileIndex, ".ecj"));
+    const std::string& expected = streamFiles[fileIndex - 1];
+    EXPECT_EQ(direct.size() % 4096, 0u);
+    // padding (9 bytes header at least) is written on close only
+    ASSERT_GE(direct.size(), expected.size() + 9);
+    EXPECT_LT(direct.size(), expected.size() + 4096 + 9);
+    EXPECT_EQ(direct.compare(0, expected.size(), expected), 0) << "file " << fileIndex;
+  }
+
+  RecordingApi direct;
+  Replay(0, 0, direct);
+  ASSERT_EQ(direct.seqs, SeqRange(1, COMMANDS_NUM));
+  EXPECT_EQ(direct.stateHash, stream.stateHash);
+
+  // index entries are offsets of the same blocks
+  const int64_t secondFileSeq = FirstIndexedSeq(2);
+  const int64_t midSeq = secondFileSeq / 2;
+  const auto position = Seek(midSeq);
+  EXPECT_EQ(position.fileIndex, 1);
+  EXPECT_GT(position.offset, 0);
+  EXPECT_EQ(ReplayStep(midSeq, midSeq + 500), SeqRange(midSeq + 1, midSeq + 500));
+
+  RecordingApi steps;
+  ReplaySteps({0, midSeq, secondFileSeq - 1, secondFileSeq, (secondFileSeq + COMMANDS_NUM) / 2,
+               COMMANDS_NUM},
+              steps);
+  EXPECT_EQ(steps.seqs, direct.seqs);
+  EXPECT_EQ(steps.stateHash, direct.stateHash);
+}
+
+/**
+ * With direct journal I/O results of a command are released only after the
+ * io_uring write containing it is completed: journal file read right after
+ * AwaitJournalWrite already contains the command, in every durability mode
+ */
+TEST_F(JournalReplayTest, ShouldReleaseResultsOnceDirectWriteIsCompleted) {
+  for (const auto durabilityMode :
+       {DurabilityMode::NONE, DurabilityMode::SYNC_EACH_BATCH, DurabilityMode::GROUP_COMMIT}) {
+    std::filesystem::remove_all(folder_);
+    DiskSerializationProcessorConfiguration diskCfg(folder_);
+    diskCfg.journalIo = JournalIo::IO_URING_DIRECT;
+    diskCfg.durabilityMode = durabilityMode;
+    DiskSerializationProcessor processor(&exchangeCfg_, &diskCfg);
+    if (!processor.IsDirectJournalIo()) {
+      GTEST_SKIP() << "io_uring or O_DIRECT is not available";
+    }
+    processor.EnableJournaling(0, nullptr);
+    for (int64_t seq = 1; seq <= 2'000; seq++) {
+      OrderCommand cmd;
+      cmd.command = OrderCommandType::ADD_USER;
+      cmd.uid = seq;
+      processor.WriteToJournal(&cmd, seq, seq % 100 == 0);
+      if (seq % 100 == 0) {
+        processor.AwaitJournalWrite(&cmd, seq);
+        ASSERT_GE(LastJournaledSeq(1), seq) << static_cast<int>(durabilityMode);
+      }
+    }
+  }
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2025 Justin Zhu
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <exchange/core/common/BytesOut.h>
+#include <exchange/core/common/VectorBytesIn.h>
+#include <exchange/core/common/WriteBytesMarshallable.h>
+#include <exchange/core/processors/journaling/IIncrementalSnapshotState.h>
+#include <exchange/core/processors/journaling/KeyedSnapshotFile.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace exchange::core::common;
+using namespace exchange::core::processors::journaling;
+
+namespace {
+
+// small chunks: entries are split between LZ4 frame blocks
+constexpr int32_t CHUNK_SIZE = 32;
+
+class LongEntry : public WriteBytesMarshallable {
+public:
+  explicit LongEntry(int64_t value) : value_(value) {}
+
+  void WriteMarshallable(BytesOut& bytes) const override {
+    bytes.WriteLong(value_);
+  }
+
+private:
+  int64_t value_;
+};
+
+/**
+ * Keyed state with tracked changes (like user profiles or order books)
+ */
+class MapState : public IIncrementalSnapshotState {
+public:
+  void Put(int64_t key, int64_t value) {
+    entries[key] = value;
+    changed_.insert(key);
+  }
+
+  void Remove(int64_t key) {
+    entries.erase(key);
+    changed_.insert(key);
+  }
+
+  void WriteGlobalState(BytesOut& bytes) const override {
+    bytes.WriteLong(version);
+  }
+
+  void WriteEntries(SnapshotEntriesWriter& writer, bool changedOnly) const override {
+    if (!changedOnly) {
+      for (const auto& [key, value] : entries) {
+        writer.Write(key, LongEntry(value));
+      }
+      return;
+    }
+    for (const int64_t key : changed_) {
+      const auto it = entries.find(key);
+      if (it != entries.end()) {
+        writer.Write(key, LongEntry(it->second));
+      } else {
+        writer.WriteRemoved(key);
+      }
+    }
+  }
+
+  bool ChangesTracked() const override {
+    return true;
+  }
+
+  void ClearChanges() override {
+    changed_.clear();
+  }
+
+  int64_t version = 0;
+  std::map<int64_t, int64_t> entries;
+
+private:
+  std::set<int64_t> changed_;
+};
+
+int64_t ReadLong(const std::vector<uint8_t>& bytes) {
+  VectorBytesIn bytesIn(bytes);
+  return bytesIn.ReadLong();
+}
+
+}  // namespace
+
+class KeyedSnapshotFileTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    folder_ = std::filesystem::temp_directory_path() / "keyed_snapshot_file";
+    std::filesystem::remove_all(folder_);
+    std::filesystem::create_directories(folder_);
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(folder_);
+  }
+
+  std::string Path(int64_t snapshotId) const {
+    return (folder_ / ("snapshot_" + std::to_string(snapshotId) + ".ecs")).string();
+  }
+
+  /**
+   * Store state as snapshot (incremental one if base is given)
+   * @return number of written entries
+   */
+  int64_t Store(int64_t snapshotId, int64_t baseSnapshotId) {
+    state_.version = snapshotId;
+    const int64_t entries =
+      KeyedSnapshotFile::Write(Path(snapshotId), CHUNK_SIZE, baseSnapshotId, state_);
+    state_.ClearChanges();
+    return entries;
+  }
+
+  /**
+   * Full snapshot 1 with entries 1..5, incremental snapshots 2..4 adding,
+   * modifying and removing entries (including added and re-added ones)
+   */
+  void StoreChain() {
+    for (int64_t key = 1; key <= 5; key++) {
+      state_.Put(key, key * 100);
+    }
+    ASSERT_EQ(Store(1, KeyedSnapshotFile::FULL_SNAPSHOT), 5);
+
+    state_.Put(2, 201);
+    state_.Remove(3);
+    state_.Put(6, 600);
+    ASSERT_EQ(Store(2, 1), 3);
+
+    state_.Put(6, 601);
+    state_.Remove(1);
+    state_.Put(3, 302);
+    ASSERT_EQ(Store(3, 2), 3);
+
+    state_.Remove(6);
+    state_.Put(4, 403);
+    ASSERT_EQ(Store(4, 3), 2);
+  }
+
+  /**
+   * Merged state of snapshot chain ending with snapshotId
+   */
+  MapState ReadChain(int64_t snapshotId, int32_t expectedFiles) {
+    MapState merged;
+    const int32_t files = KeyedSnapshotFile::ReadChain(
+      snapshotId, [this](int64_t id) { return Path(id); }, CHUNK_SIZE,
+      [&merged](const std::vector<uint8_t>& state) { merged.version = ReadLong(state); },
+      [&merged](int64_t key, const std::vector<uint8_t>& state) {
+        EXPECT_EQ(merged.entries.count(key), 0u) << "duplicate key " << key;
+        merged.entries[key] = ReadLong(state);
+      });
+    EXPECT_EQ(files, expectedFiles);
+    return merged;
+  }
+
+  std::filesystem::path folder_;
+  MapState state_;
+};
+
+TEST_F(KeyedSnapshotFileTest, ShouldMergeIncrementalSnapshotChain) {
+  StoreChain();
+  EXPECT_TRUE(KeyedSnapshotFile::IsKeyedSnapshot(Path(1)));
+  EXPECT_TRUE(KeyedSnapshotFile::IsKeyedSnapshot(Path(4)));
+
+  const MapState merged = ReadChain(4, 4);
+  EXPECT_EQ(merged.version, 4);
+  const std::map<int64_t, int64_t> expected = {{2, 201}, {3, 302}, {4, 403}, {5, 500}};
+  EXPECT_EQ(merged.entries, expected);
+  EXPECT_EQ(merged.entries, state_.entries);
+
+  // chain ending with an earlier snapshot
+  const MapState second = ReadChain(2, 2);
+  EXPECT_EQ(second.version, 2);
+  const std::map<int64_t, int64_t> expectedSecond = {
+    {1, 100}, {2, 201}, {4, 400}, {5, 500}, {6, 600}};
+  EXPECT_EQ(second.entries, expectedSecond);
+
+  EXPECT_EQ(ReadChain(1, 1).entries.size(), 5u);
+}
+
+TEST_F(KeyedSnapshotFileTest, ShouldCompactChainIntoEquivalentFullSnapshot) {
+  StoreChain();
+  const MapState merged = ReadChain(4, 4);
+
+  KeyedSnapshotFile::Compact(4, [this](int64_t id) { return Path(id); }, CHUNK_SIZE, Path(4));
+  EXPECT_FALSE(std::filesystem::exists(Path(4) + ".tmp"));
+  EXPECT_TRUE(KeyedSnapshotFile::IsKeyedSnapshot(Path(4)));
+
+  // compacted snapshot is full: readable without the rest of the chain
+  for (int64_t snapshotId = 1; snapshotId <= 3; snapshotId++) {
+    std::filesystem::remove(Path(snapshotId));
+  }
+  const MapState compacted = ReadChain(4, 1);
+  EXPECT_EQ(compacted.version, merged.version);
+  EXPECT_EQ(compacted.entries, merged.entries);
+
+  // and is a valid base of next incremental snapshot
+  state_.Remove(2);
+  state_.Put(7, 700);
+  ASSERT_EQ(Store(5, 4), 2);
+  const std::map<int64_t, int64_t> expected = {{3, 302}, {4, 403}, {5, 500}, {7, 700}};
+  EXPECT_EQ(ReadChain(5, 2).entries, expected);
+}
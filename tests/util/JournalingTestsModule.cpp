@@ -18,8 +18,10 @@
 #include <exchange/core/common/api/ApiPersistState.h>
 #include <exchange/core/common/config/InitialStateConfiguration.h>
 #include <exchange/core/common/config/SerializationConfiguration.h>
+#include <exchange/core/processors/journaling/DiskSerializationProcessorConfiguration.h>
 #include <exchange/core/utils/FastNanoTime.h>
 #include <exchange/core/utils/Logger.h>
+#include <filesystem>
 #include <iomanip>
 #include <sstream>
 #include "ExchangeTestContainer.h"
@@ -27,10 +29,30 @@
 
 namespace exchange::core::tests::util {
 
+namespace {
+
+// Total size of journal files written for exchangeId
+int64_t JournalSizeBytes(const std::string& exchangeId) {
+  using exchange::core::processors::journaling::DiskSerializationProcessorConfiguration;
+  int64_t size = 0;
+  const std::filesystem::path folder(DiskSerializationProcessorConfiguration::DEFAULT_FOLDER);
+  for (const auto& entry : std::filesystem::directory_iterator(folder)) {
+    const auto fileName = entry.path().filename().string();
+    if (entry.is_regular_file() && fileName.rfind(exchangeId, 0) == 0
+        && entry.path().extension() == ".ecj") {
+      size += static_cast<int64_t>(entry.file_size());
+    }
+  }
+  return size;
+}
+
+}  // namespace
+
 void JournalingTestsModule::JournalingTestImpl(
   const exchange::core::common::config::PerformanceConfiguration& performanceCfg,
   const TestDataParameters& testDataParameters,
-  int iterations) {
+  int iterations,
+  const exchange::core::common::config::SerializationConfiguration& serializationCfg) {
   for (int iteration = 0; iteration < iterations; iteration++) {
     // Match Java: log.debug(" ----------- journaling test --- iteration {} of
     // {}
@@ -49,9 +71,8 @@ void JournalingTestsModule::JournalingTestImpl(
       exchange::core::common::config::InitialStateConfiguration::CleanStartJournaling(exchangeId);
 
     {
-      auto container = ExchangeTestContainer::Create(
-        performanceCfg, firstStartConfig,
-        exchange::core::common::config::SerializationConfiguration::DiskJournaling());
+      auto container =
+        ExchangeTestContainer::Create(performanceCfg, firstStartConfig, serializationCfg);
 
       // Load symbols, users and prefill orders
       container->LoadSymbolsUsersAndPrefillOrders(testDataFutures);
@@ -189,6 +210,12 @@ void JournalingTestsModule::JournalingTestImpl(
       loadTimeStr << std::fixed << std::setprecision(3) << loadTimeSec;
       LOG_DEBUG("Load+start+replay time: {}s", loadTimeStr.str());
 
+      // Recovery speed relative to replayed journal size
+      const double journalGb = static_cast<double>(JournalSizeBytes(exchangeId)) / (1 << 30);
+      if (journalGb > 0) {
+        LOG_INFO("Recovery: {:.3f} GB journal, {:.2f} s/GB", journalGb, loadTimeSec / journalGb);
+      }
+
       // Match Java: final long restoredStateHash =
       // recreatedContainer.requestStateHash();
       // Match Java: assertThat(restoredStateHash, is(originalFinalStateHash));
@@ -262,4 +289,34 @@ void JournalingTestsModule::JournalingTestImpl(
   }
 }
 
+std::vector<std::pair<std::string, exchange::core::common::config::SerializationConfiguration>>
+JournalingTestsModule::DurabilityModesConfigurations() {
+  using exchange::core::common::config::SerializationConfiguration;
+  using exchange::core::processors::journaling::DiskSerializationProcessorConfiguration;
+  using DurabilityMode = DiskSerializationProcessorConfiguration::DurabilityMode;
+  using JournalIo = DiskSerializationProcessorConfiguration::JournalIo;
+
+  const auto diskConfig = [](bool asyncWriter, DurabilityMode durabilityMode,
+                             JournalIo journalIo = JournalIo::STREAM) {
+    DiskSerializationProcessorConfiguration cfg;
+    cfg.asyncJournalWriter = asyncWriter;
+    cfg.durabilityMode = durabilityMode;
+    cfg.journalIo = journalIo;
+    return SerializationConfiguration::DiskJournaling(cfg);
+  };
+
+  // io_uring entries fall back to async stream writer where not available
+  return {{"sync writer, no fsync", diskConfig(false, DurabilityMode::NONE)},
+          {"async writer, no fsync", diskConfig(true, DurabilityMode::NONE)},
+          {"sync writer, fdatasync each batch", diskConfig(false, DurabilityMode::SYNC_EACH_BATCH)},
+          {"async writer, fdatasync each batch", diskConfig(true, DurabilityMode::SYNC_EACH_BATCH)},
+          {"group commit", diskConfig(true, DurabilityMode::GROUP_COMMIT)},
+          {"io_uring O_DIRECT, no fsync",
+           diskConfig(true, DurabilityMode::NONE, JournalIo::IO_URING_DIRECT)},
+          {"io_uring O_DIRECT, RWF_DSYNC each batch",
+           diskConfig(true, DurabilityMode::SYNC_EACH_BATCH, JournalIo::IO_URING_DIRECT)},
+          {"io_uring O_DIRECT, group commit",
+           diskConfig(true, DurabilityMode::GROUP_COMMIT, JournalIo::IO_URING_DIRECT)}};
+}
+
 }  // namespace exchange::core::tests::util
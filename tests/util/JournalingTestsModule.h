@@ -17,6 +17,10 @@
 #pragma once
 
 #include <exchange/core/common/config/PerformanceConfiguration.h>
+#include <exchange/core/common/config/SerializationConfiguration.h>
+#include <string>
+#include <utility>
+#include <vector>
 #include "TestDataParameters.h"
 
 namespace exchange::core::tests::util {
@@ -31,11 +35,24 @@ public:
    * @param performanceCfg - performance configuration
    * @param testDataParameters - test data parameters
    * @param iterations - number of test iterations
+   * @param serializationCfg - configuration journal is written with
+   *                           (replayed with default disk journaling configuration)
    */
-  static void
-  JournalingTestImpl(const exchange::core::common::config::PerformanceConfiguration& performanceCfg,
-                     const TestDataParameters& testDataParameters,
-                     int iterations);
+  static void JournalingTestImpl(
+    const exchange::core::common::config::PerformanceConfiguration& performanceCfg,
+    const TestDataParameters& testDataParameters,
+    int iterations,
+    const exchange::core::common::config::SerializationConfiguration& serializationCfg =
+      exchange::core::common::config::SerializationConfiguration::DiskJournaling());
+
+  /**
+   * Disk journaling configurations (name, configuration) for each journal
+   * writer, journal I/O and durability mode, used for comparing throughput
+   * and latency
+   */
+  static std::vector<
+    std::pair<std::string, exchange::core::common::config::SerializationConfiguration>>
+  DurabilityModesConfigurations();
 };
 
 }  // namespace exchange::core::tests::util
@@ -612,6 +612,91 @@ void LatencyTestsModule::LatencyTestFixedTps(
   testIteration(fixedTps, false);
 }
 
+void LatencyTestsModule::FirstOrdersLatencyTest(
+  const exchange::core::common::config::PerformanceConfiguration& performanceCfg,
+  const TestDataParameters& testDataParameters,
+  const exchange::core::common::config::InitialStateConfiguration& initialStateCfg,
+  const exchange::core::common::config::SerializationConfiguration& serializationCfg,
+  int fixedTps,
+  int ordersNum) {
+  constexpr int WINDOWS_NUM = 10;
+
+  auto testDataFutures = ExchangeTestContainer::PrepareTestDataAsync(testDataParameters, 1);
+
+  // Startup (including optional pools pre-allocation and warm-up flow) is part of
+  // Create(), so measured orders are the first real orders the core receives
+  auto container = ExchangeTestContainer::Create(performanceCfg, initialStateCfg, serializationCfg);
+
+  utils::FastNanoTime::Initialize();
+  auto getNanoTime = []() -> int64_t { return utils::FastNanoTime::Now(); };
+
+  container->LoadSymbolsUsersAndPrefillOrdersNoLog(testDataFutures);
+
+  auto genResult = testDataFutures.genResult.get();
+  auto benchmarkCommands = genResult->GetApiCommandsBenchmark().get();
+  const size_t measuredNum = std::min(benchmarkCommands.size(), static_cast<size_t>(ordersNum));
+
+  // Latencies are kept in arrival order to build per-window statistics
+  std::vector<int64_t> latencies;
+  latencies.reserve(measuredNum);
+  CountDownLatch latchBenchmark(static_cast<int64_t>(measuredNum));
+
+  container->SetConsumer([&latencies, &latchBenchmark, getNanoTime](
+                           exchange::core::common::cmd::OrderCommand* cmd, int64_t seq) {
+    auto latency = getNanoTime() - cmd->timestamp;
+    latencies.push_back(std::min(latency, static_cast<int64_t>(INT_MAX)));
+    latchBenchmark.countDown();
+  });
+
+  const int nanosPerCmd = 1'000'000'000 / fixedTps;
+  int64_t plannedTimestamp = getNanoTime();
+  for (size_t i = 0; i < measuredNum; i++) {
+    auto* cmd = benchmarkCommands[i];
+    while (getNanoTime() < plannedTimestamp) {
+      // spin until its time to send next command
+    }
+    cmd->timestamp = plannedTimestamp;
+    container->GetApi()->SubmitCommand(cmd);
+    plannedTimestamp += nanosPerCmd;
+  }
+
+  latchBenchmark.await();
+  container->SetConsumer(nullptr);
+
+  auto makeReport = [](std::vector<int64_t> sorted) -> std::string {
+    if (sorted.empty()) {
+      return "no data";
+    }
+    std::sort(sorted.begin(), sorted.end());
+    auto getPercentile = [&sorted](double percentile) -> int64_t {
+      size_t index = static_cast<size_t>(std::round((percentile / 100.0) * (sorted.size() - 1)));
+      return sorted[std::min(index, sorted.size() - 1)];
+    };
+    std::ostringstream report;
+    report << "50%:" << LatencyTools::FormatNanos(getPercentile(50.0)) << " ";
+    report << "99%:" << LatencyTools::FormatNanos(getPercentile(99.0)) << " ";
+    report << "99.9%:" << LatencyTools::FormatNanos(getPercentile(99.9)) << " ";
+    report << "99.99%:" << LatencyTools::FormatNanos(getPercentile(99.99)) << " ";
+    report << "W:" << LatencyTools::FormatNanos(sorted.back());
+    return report.str();
+  };
+
+  LOG_INFO("First {} orders at {} TPS (preallocate={} warmUpOrders={}): {}", measuredNum,
+           fixedTps, performanceCfg.preallocateObjectPools, performanceCfg.warmUpOrdersNum,
+           makeReport(latencies));
+
+  const size_t windowSize = std::max<size_t>(1, measuredNum / WINDOWS_NUM);
+  for (size_t from = 0; from < latencies.size(); from += windowSize) {
+    const size_t to = std::min(from + windowSize, latencies.size());
+    std::vector<int64_t> window(latencies.begin() + from, latencies.begin() + to);
+    LOG_INFO("  orders [{}..{}): {}", from, to, makeReport(std::move(window)));
+  }
+
+  for (auto* cmd : benchmarkCommands) {
+    delete cmd;
+  }
+}
+
 void LatencyTestsModule::HiccupTestImpl(
   const exchange::core::common::config::PerformanceConfiguration& performanceCfg,
   const TestDataParameters& testDataParameters,
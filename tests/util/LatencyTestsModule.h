@@ -72,6 +72,25 @@ public:
     const exchange::core::common::config::SerializationConfiguration& serializationCfg,
     int fixedTps,
     int warmupCycles);
+
+  /**
+   * Measure latency of the very first orders after startup (no warmup cycles).
+   * Reports total percentiles and per-window percentiles to show how cold
+   * start spikes (page faults, pool growth, cold caches) decay.
+   * @param performanceCfg - performance configuration
+   * @param testDataParameters - test data parameters
+   * @param initialStateCfg - initial state configuration
+   * @param serializationCfg - serialization configuration
+   * @param fixedTps - fixed TPS rate
+   * @param ordersNum - number of first orders to measure (e.g., 1'000'000)
+   */
+  static void FirstOrdersLatencyTest(
+    const exchange::core::common::config::PerformanceConfiguration& performanceCfg,
+    const TestDataParameters& testDataParameters,
+    const exchange::core::common::config::InitialStateConfiguration& initialStateCfg,
+    const exchange::core::common::config::SerializationConfiguration& serializationCfg,
+    int fixedTps,
+    int ordersNum);
 };
 
 }  // namespace exchange::core::tests::util
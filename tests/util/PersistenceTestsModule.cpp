@@ -18,17 +18,59 @@
 #include <exchange/core/common/api/ApiPersistState.h>
 #include <exchange/core/common/config/InitialStateConfiguration.h>
 #include <exchange/core/common/config/SerializationConfiguration.h>
+#include <exchange/core/processors/journaling/DiskSerializationProcessorConfiguration.h>
 #include <exchange/core/utils/FastNanoTime.h>
+#include <exchange/core/utils/Logger.h>
+#include <algorithm>
 #include <array>
+#include <filesystem>
 #include <thread>
+#include <vector>
 #include "ExchangeTestContainer.h"
 
 namespace exchange::core::tests::util {
 
+namespace {
+
+/**
+ * Persist state, returns pipeline stall (ms)
+ */
+double PersistState(ExchangeTestContainer* container, int64_t stateId) {
+  auto persistState =
+    std::make_unique<exchange::core::common::api::ApiPersistState>(stateId, false);
+  const int64_t persistStartNs = exchange::core::utils::FastNanoTime::Now();
+  auto future = container->GetApi()->SubmitCommandAsync(persistState.release());
+  if (future.get() != exchange::core::common::cmd::CommandResultCode::SUCCESS) {
+    throw std::runtime_error("Failed to create snapshot");
+  }
+  return (exchange::core::utils::FastNanoTime::Now() - persistStartNs) / 1'000'000.0;
+}
+
+/**
+ * Total size of snapshot files of all engines (KB)
+ */
+int64_t SnapshotFilesSizeKb(const std::string& exchangeId, int64_t stateId) {
+  const std::string prefix = exchangeId + "_snapshot_" + std::to_string(stateId) + "_";
+  int64_t size = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(
+         exchange::core::processors::journaling::DiskSerializationProcessorConfiguration::
+           DEFAULT_FOLDER)) {
+    const std::string fileName = entry.path().filename().string();
+    if (fileName.rfind(prefix, 0) == 0 && entry.path().extension() == ".ecs") {
+      size += static_cast<int64_t>(entry.file_size());
+    }
+  }
+  return size / 1024;
+}
+
+}  // namespace
+
 void PersistenceTestsModule::PersistenceTestImpl(
   const exchange::core::common::config::PerformanceConfiguration& performanceCfg,
   const TestDataParameters& testDataParameters,
-  int iterations) {
+  int iterations,
+  const exchange::core::common::config::SerializationConfiguration& serializationCfg) {
+  std::vector<double> stallsMs;
   for (int iteration = 0; iteration < iterations; iteration++) {
     auto testDataFutures =
       ExchangeTestContainer::PrepareTestDataAsync(testDataParameters, iteration);
@@ -47,21 +89,16 @@ void PersistenceTestsModule::PersistenceTestImpl(
     float originalPerfMt;
 
     {
-      auto container = ExchangeTestContainer::Create(
-        performanceCfg, firstStartConfig,
-        exchange::core::common::config::SerializationConfiguration::DiskSnapshotOnly());
+      auto container =
+        ExchangeTestContainer::Create(performanceCfg, firstStartConfig, serializationCfg);
 
       // Load symbols, users and prefill orders
       container->LoadSymbolsUsersAndPrefillOrders(testDataFutures);
 
-      // Create snapshot
-      auto persistState =
-        std::make_unique<exchange::core::common::api::ApiPersistState>(stateId, false);
-      auto future = container->GetApi()->SubmitCommandAsync(persistState.release());
-      auto result = future.get();
-      if (result != exchange::core::common::cmd::CommandResultCode::SUCCESS) {
-        throw std::runtime_error("Failed to create snapshot");
-      }
+      // Create snapshot, pipeline is stalled until persist commands are processed
+      const double stallMs = PersistState(container.get(), stateId);
+      stallsMs.push_back(stallMs);
+      LOG_INFO("Snapshot stall: {:.3f} ms", stallMs);
 
       // Get original prefill state hash
       originalPrefillStateHash = container->RequestStateHash();
@@ -126,12 +163,15 @@ void PersistenceTestsModule::PersistenceTestImpl(
                                                                                   stateId, 0);
 
     {
+      const int64_t restoreStartNs = exchange::core::utils::FastNanoTime::Now();
       auto recreatedContainer = ExchangeTestContainer::Create(
         performanceCfg, fromSnapshotConfig,
         exchange::core::common::config::SerializationConfiguration::DiskSnapshotOnly());
 
       // Wait for core to be ready
       recreatedContainer->TotalBalanceReport();
+      LOG_INFO("Restore: {:.3f} ms",
+               (exchange::core::utils::FastNanoTime::Now() - restoreStartNs) / 1'000'000.0);
 
       // Verify restored state hash
       long restoredPrefillStateHash = recreatedContainer->RequestStateHash();
@@ -197,6 +237,99 @@ void PersistenceTestsModule::PersistenceTestImpl(
 
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
   }
+
+  // Compare runs with different snapshot modes (e.g. TestPersistenceExchange vs
+  // TestPersistenceExchangeForked) to see how much of the stall is saved by forking
+  if (!stallsMs.empty()) {
+    double totalMs = 0;
+    for (const double stallMs : stallsMs) {
+      totalMs += stallMs;
+    }
+    LOG_INFO("Snapshot stall over {} iterations: avg {:.3f} ms, max {:.3f} ms", stallsMs.size(),
+             totalMs / stallsMs.size(), *std::max_element(stallsMs.begin(), stallsMs.end()));
+  }
+}
+
+void PersistenceTestsModule::IncrementalPersistenceTestImpl(
+  const exchange::core::common::config::PerformanceConfiguration& performanceCfg,
+  const TestDataParameters& testDataParameters,
+  int iterations,
+  int snapshots) {
+  const auto serializationCfg =
+    exchange::core::common::config::SerializationConfiguration::DiskSnapshotOnlyIncremental();
+
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    auto testDataFutures =
+      ExchangeTestContainer::PrepareTestDataAsync(testDataParameters, iteration);
+
+    // full snapshot id, incremental snapshots are baseStateId + 1 ... + snapshots
+    const int64_t baseStateId = exchange::core::utils::FastNanoTime::NowMillis() * 1000;
+    const int64_t lastStateId = baseStateId + snapshots;
+
+    std::array<char, 32> exchangeIdBuffer{};
+    snprintf(exchangeIdBuffer.data(), exchangeIdBuffer.size(), "%012llX",
+             static_cast<unsigned long long>(exchange::core::utils::FastNanoTime::NowMillis()));
+    std::string exchangeId(exchangeIdBuffer.data());
+
+    int32_t originalStateHash;
+
+    {
+      auto container = ExchangeTestContainer::Create(
+        performanceCfg,
+        exchange::core::common::config::InitialStateConfiguration::CleanStart(exchangeId),
+        serializationCfg);
+
+      container->LoadSymbolsUsersAndPrefillOrders(testDataFutures);
+
+      const double fullStallMs = PersistState(container.get(), baseStateId);
+      LOG_INFO("Full snapshot: {} KB, stall {:.3f} ms",
+               SnapshotFilesSizeKb(exchangeId, baseStateId), fullStallMs);
+
+      // Benchmark commands are applied in parts, snapshot after every part
+      auto genResult = testDataFutures.genResult.get();
+      auto benchmarkCommands = genResult->GetApiCommandsBenchmark().get();
+      const size_t partSize = benchmarkCommands.size() / std::max(snapshots, 1) + 1;
+      for (int i = 1; i <= snapshots; i++) {
+        const size_t from = std::min(benchmarkCommands.size(), (i - 1) * partSize);
+        const size_t to = std::min(benchmarkCommands.size(), i * partSize);
+        const std::vector<exchange::core::common::api::ApiCommand*> part(
+          benchmarkCommands.begin() + from, benchmarkCommands.begin() + to);
+        container->GetApi()->SubmitCommandsSync(part);
+
+        const double stallMs = PersistState(container.get(), baseStateId + i);
+        LOG_INFO("Incremental snapshot {} ({} commands): {} KB, stall {:.3f} ms", i, to - from,
+                 SnapshotFilesSizeKb(exchangeId, baseStateId + i), stallMs);
+      }
+
+      for (auto* cmd : benchmarkCommands) {
+        delete cmd;
+      }
+
+      originalStateHash = container->RequestStateHash();
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    {
+      const int64_t restoreStartNs = exchange::core::utils::FastNanoTime::Now();
+      auto recreatedContainer = ExchangeTestContainer::Create(
+        performanceCfg,
+        exchange::core::common::config::InitialStateConfiguration::FromSnapshotOnly(
+          exchangeId, lastStateId, 0),
+        serializationCfg);
+
+      // Wait for core to be ready
+      recreatedContainer->TotalBalanceReport();
+      LOG_INFO("Restore from snapshot chain: {:.3f} ms",
+               (exchange::core::utils::FastNanoTime::Now() - restoreStartNs) / 1'000'000.0);
+
+      if (recreatedContainer->RequestStateHash() != originalStateHash) {
+        throw std::runtime_error("State hash mismatch after restore from incremental snapshot");
+      }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  }
 }
 
 }  // namespace exchange::core::tests::util
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <exchange/core/common/config/PerformanceConfiguration.h>
+#include <exchange/core/common/config/SerializationConfiguration.h>
 #include "TestDataParameters.h"
 
 namespace exchange::core::tests::util {
@@ -27,15 +28,32 @@ namespace exchange::core::tests::util {
 class PersistenceTestsModule {
 public:
   /**
-   * Run persistence test implementation
+   * Run persistence test implementation. Pipeline stall of every snapshot is
+   * logged, with average and maximum over all iterations at the end.
    * @param performanceCfg - performance configuration
    * @param testDataParameters - test data parameters
    * @param iterations - number of test iterations
+   * @param serializationCfg - serialization configuration used for creating snapshot
    */
   static void PersistenceTestImpl(
     const exchange::core::common::config::PerformanceConfiguration& performanceCfg,
     const TestDataParameters& testDataParameters,
-    int iterations);
+    int iterations,
+    const exchange::core::common::config::SerializationConfiguration& serializationCfg =
+      exchange::core::common::config::SerializationConfiguration::DiskSnapshotOnly());
+
+  /**
+   * Incremental snapshots test: full snapshot after prefill, then incremental
+   * snapshot after every part of benchmark commands. State is restored from
+   * the last snapshot (merged chain) and compared with the original one.
+   * Size and stall of every snapshot are logged.
+   * @param snapshots - number of incremental snapshots per iteration
+   */
+  static void IncrementalPersistenceTestImpl(
+    const exchange::core::common::config::PerformanceConfiguration& performanceCfg,
+    const TestDataParameters& testDataParameters,
+    int iterations,
+    int snapshots);
 };
 
 }  // namespace exchange::core::tests::util